@@ -9,7 +9,7 @@ solution "SampSharp"
         kind "SharedLib"
 
         language "C++"
-        links { "mono-2.0", "rt" }
+        links { "mono-2.0", "rt", "pthread" }
 
         includedirs {
             "src/SampSharp/includes",
@@ -22,7 +22,7 @@ solution "SampSharp"
             "-std=c++11"
         }
 
-        files { "src/SampSharp**.cpp", "src/SampSharp/includes/sampgdk/sampgdk.c" }
+        files { "src/SampSharp/**.cpp", "src/SampSharp/includes/sampgdk/sampgdk.c" }
 
         configuration "x64"
             defines { "__i386__" }
@@ -38,3 +38,34 @@ solution "SampSharp"
             targetdir "bin"
             defines { "NDEBUG", "LINUX", "_GNU_SOURCE", "SAMPGDK_AMALGAMATION" }
             flags { "Optimize" }
+
+    -- Headless server emulator used to load test the plugin
+    project "SampSharpHost"
+        targetname "SampSharpHost"
+        kind "ConsoleApp"
+
+        language "C++"
+        links { "dl", "pthread", "rt" }
+
+        includedirs {
+            "src/SampSharp/includes",
+            "src/SampSharp/includes/sdk",
+            "src/SampSharp/includes/sdk/amx"
+        }
+        buildoptions {
+            "-std=c++11"
+        }
+
+        files { "src/SampSharpHost/**.cpp", "src/SampSharp/IpcChannel.cpp" }
+
+        configuration "Debug"
+            objdir "obj/Debug"
+            targetdir "env"
+            defines { "DEBUG", "LINUX", "_GNU_SOURCE" }
+            flags { "Symbols" }
+
+        configuration "Release"
+            objdir "obj/Release"
+            targetdir "bin"
+            defines { "NDEBUG", "LINUX", "_GNU_SOURCE" }
+            flags { "Optimize" }
@@ -31,5 +31,87 @@ namespace SampSharp.GameMode.API
         void Print(string msg);
 
         void SetCodepage(string codepage);
+
+        bool HeightMapLoad(string path);
+
+        void HeightMapUnload();
+
+        float HeightMapFindZ(float x, float y);
+
+        float HeightMapFindAverageZ(float x, float y);
+
+        float HeightMapFindBilinearZ(float x, float y);
+
+        void HeightMapFindZArray(float[] points, float[] heights, int mode);
+
+        bool HeightMapSetZ(float x, float y, float z);
+
+        bool HeightMapSave(string path);
+
+        void PlayerSnapshotAttach(float[] floats, int[] ints);
+
+        void PlayerSnapshotDetach();
+
+        int PlayerSnapshotCapture();
+
+        void CommandBufferAttach(int[] buffer);
+
+        void CommandBufferDetach();
+
+        int CommandBufferFlush();
+
+        int StreamerAddObject(int modelid, float x, float y, float z, float rotationX, float rotationY,
+            float rotationZ, int virtualWorld, int interior, float streamDistance, float drawDistance);
+
+        int StreamerAddPickup(int modelid, int type, float x, float y, float z, int virtualWorld, int interior,
+            float streamDistance);
+
+        int StreamerAddLabel(string text, int color, float x, float y, float z, float drawDistance, int virtualWorld,
+            int interior, bool testLOS, float streamDistance);
+
+        bool StreamerRemove(int id);
+
+        bool StreamerSetPosition(int id, float x, float y, float z);
+
+        bool StreamerSetRotation(int id, float rotationX, float rotationY, float rotationZ);
+
+        bool StreamerSetLabelText(int id, string text, int color);
+
+        void StreamerSetBudget(int budget);
+
+        void StreamerUpdate(int playerid);
+
+        bool StreamerIsVisible(int id, int playerid);
+
+        int StreamerFindPickup(int pickupid);
+
+        int StreamerGetVisibleCount(int playerid);
+
+        int ProximityQueryRadius(int kind, float x, float y, float z, float range, int world, int[] result);
+
+        int ProximityQueryBox(int kind, float minX, float minY, float minZ, float maxX, float maxY, float maxZ,
+            int world, int[] result);
+
+        int ProximityNearest(int kind, float x, float y, float z, int count, int world, int[] result);
+
+        void ProximityInvalidate();
+
+        void PlayerUpdateSetDefaultInterval(int interval);
+
+        int PlayerUpdateGetDefaultInterval();
+
+        bool PlayerUpdateSetInterval(int playerid, int interval);
+
+        int PlayerUpdateGetInterval(int playerid);
+
+        void NativeProfilerStart(int sampleInterval);
+
+        void NativeProfilerStop();
+
+        void NativeProfilerReset();
+
+        int NativeProfilerGetStats(long[] result);
+
+        void NativeProfilerDump(int count);
     }
 }
\ No newline at end of file
@@ -41,5 +41,128 @@ namespace SampSharp.GameMode.API
 
         [MethodImpl(MethodImplOptions.InternalCall)]
         public static extern void SetCodepage(string codepage);
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        public static extern bool HeightMapLoad(string path);
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        public static extern void HeightMapUnload();
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        public static extern float HeightMapFindZ(float x, float y);
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        public static extern float HeightMapFindAverageZ(float x, float y);
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        public static extern float HeightMapFindBilinearZ(float x, float y);
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        public static extern void HeightMapFindZArray(float[] points, float[] heights, int mode);
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        public static extern bool HeightMapSetZ(float x, float y, float z);
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        public static extern bool HeightMapSave(string path);
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        public static extern void PlayerSnapshotAttach(float[] floats, int[] ints);
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        public static extern void PlayerSnapshotDetach();
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        public static extern int PlayerSnapshotCapture();
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        public static extern void CommandBufferAttach(int[] buffer);
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        public static extern void CommandBufferDetach();
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        public static extern int CommandBufferFlush();
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        public static extern int StreamerAddObject(int modelid, float x, float y, float z, float rotationX,
+            float rotationY, float rotationZ, int virtualWorld, int interior, float streamDistance, float drawDistance);
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        public static extern int StreamerAddPickup(int modelid, int type, float x, float y, float z, int virtualWorld,
+            int interior, float streamDistance);
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        public static extern int StreamerAddLabel(string text, int color, float x, float y, float z,
+            float drawDistance, int virtualWorld, int interior, bool testLOS, float streamDistance);
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        public static extern bool StreamerRemove(int id);
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        public static extern bool StreamerSetPosition(int id, float x, float y, float z);
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        public static extern bool StreamerSetRotation(int id, float rotationX, float rotationY, float rotationZ);
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        public static extern bool StreamerSetLabelText(int id, string text, int color);
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        public static extern void StreamerSetBudget(int budget);
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        public static extern void StreamerUpdate(int playerid);
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        public static extern bool StreamerIsVisible(int id, int playerid);
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        public static extern int StreamerFindPickup(int pickupid);
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        public static extern int StreamerGetVisibleCount(int playerid);
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        public static extern int ProximityQueryRadius(int kind, float x, float y, float z, float range, int world,
+            int[] result);
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        public static extern int ProximityQueryBox(int kind, float minX, float minY, float minZ, float maxX,
+            float maxY, float maxZ, int world, int[] result);
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        public static extern int ProximityNearest(int kind, float x, float y, float z, int count, int world,
+            int[] result);
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        public static extern void ProximityInvalidate();
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        public static extern void PlayerUpdateSetDefaultInterval(int interval);
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        public static extern int PlayerUpdateGetDefaultInterval();
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        public static extern bool PlayerUpdateSetInterval(int playerid, int interval);
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        public static extern int PlayerUpdateGetInterval(int playerid);
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        public static extern void NativeProfilerStart(int sampleInterval);
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        public static extern void NativeProfilerStop();
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        public static extern void NativeProfilerReset();
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        public static extern int NativeProfilerGetStats(long[] result);
+
+        [MethodImpl(MethodImplOptions.InternalCall)]
+        public static extern void NativeProfilerDump(int count);
     }
 }
\ No newline at end of file
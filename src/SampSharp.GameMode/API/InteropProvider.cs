@@ -71,5 +71,207 @@ namespace SampSharp.GameMode.API
         {
             Provider.SetCodepage(codepage);
         }
+
+        public static bool HeightMapLoad(string path)
+        {
+            return Provider.HeightMapLoad(path);
+        }
+
+        public static void HeightMapUnload()
+        {
+            Provider.HeightMapUnload();
+        }
+
+        public static float HeightMapFindZ(float x, float y)
+        {
+            return Provider.HeightMapFindZ(x, y);
+        }
+
+        public static float HeightMapFindAverageZ(float x, float y)
+        {
+            return Provider.HeightMapFindAverageZ(x, y);
+        }
+
+        public static float HeightMapFindBilinearZ(float x, float y)
+        {
+            return Provider.HeightMapFindBilinearZ(x, y);
+        }
+
+        public static void HeightMapFindZArray(float[] points, float[] heights, int mode)
+        {
+            Provider.HeightMapFindZArray(points, heights, mode);
+        }
+
+        public static bool HeightMapSetZ(float x, float y, float z)
+        {
+            return Provider.HeightMapSetZ(x, y, z);
+        }
+
+        public static bool HeightMapSave(string path)
+        {
+            return Provider.HeightMapSave(path);
+        }
+
+        public static void PlayerSnapshotAttach(float[] floats, int[] ints)
+        {
+            Provider.PlayerSnapshotAttach(floats, ints);
+        }
+
+        public static void PlayerSnapshotDetach()
+        {
+            Provider.PlayerSnapshotDetach();
+        }
+
+        public static int PlayerSnapshotCapture()
+        {
+            return Provider.PlayerSnapshotCapture();
+        }
+
+        public static void CommandBufferAttach(int[] buffer)
+        {
+            Provider.CommandBufferAttach(buffer);
+        }
+
+        public static void CommandBufferDetach()
+        {
+            Provider.CommandBufferDetach();
+        }
+
+        public static int CommandBufferFlush()
+        {
+            return Provider.CommandBufferFlush();
+        }
+
+        public static int StreamerAddObject(int modelid, float x, float y, float z, float rotationX, float rotationY,
+            float rotationZ, int virtualWorld, int interior, float streamDistance, float drawDistance)
+        {
+            return Provider.StreamerAddObject(modelid, x, y, z, rotationX, rotationY, rotationZ, virtualWorld,
+                interior, streamDistance, drawDistance);
+        }
+
+        public static int StreamerAddPickup(int modelid, int type, float x, float y, float z, int virtualWorld,
+            int interior, float streamDistance)
+        {
+            return Provider.StreamerAddPickup(modelid, type, x, y, z, virtualWorld, interior, streamDistance);
+        }
+
+        public static int StreamerAddLabel(string text, int color, float x, float y, float z, float drawDistance,
+            int virtualWorld, int interior, bool testLOS, float streamDistance)
+        {
+            return Provider.StreamerAddLabel(text, color, x, y, z, drawDistance, virtualWorld, interior, testLOS,
+                streamDistance);
+        }
+
+        public static bool StreamerRemove(int id)
+        {
+            return Provider.StreamerRemove(id);
+        }
+
+        public static bool StreamerSetPosition(int id, float x, float y, float z)
+        {
+            return Provider.StreamerSetPosition(id, x, y, z);
+        }
+
+        public static bool StreamerSetRotation(int id, float rotationX, float rotationY, float rotationZ)
+        {
+            return Provider.StreamerSetRotation(id, rotationX, rotationY, rotationZ);
+        }
+
+        public static bool StreamerSetLabelText(int id, string text, int color)
+        {
+            return Provider.StreamerSetLabelText(id, text, color);
+        }
+
+        public static void StreamerSetBudget(int budget)
+        {
+            Provider.StreamerSetBudget(budget);
+        }
+
+        public static void StreamerUpdate(int playerid)
+        {
+            Provider.StreamerUpdate(playerid);
+        }
+
+        public static bool StreamerIsVisible(int id, int playerid)
+        {
+            return Provider.StreamerIsVisible(id, playerid);
+        }
+
+        public static int StreamerFindPickup(int pickupid)
+        {
+            return Provider.StreamerFindPickup(pickupid);
+        }
+
+        public static int StreamerGetVisibleCount(int playerid)
+        {
+            return Provider.StreamerGetVisibleCount(playerid);
+        }
+
+        public static int ProximityQueryRadius(int kind, float x, float y, float z, float range, int world,
+            int[] result)
+        {
+            return Provider.ProximityQueryRadius(kind, x, y, z, range, world, result);
+        }
+
+        public static int ProximityQueryBox(int kind, float minX, float minY, float minZ, float maxX, float maxY,
+            float maxZ, int world, int[] result)
+        {
+            return Provider.ProximityQueryBox(kind, minX, minY, minZ, maxX, maxY, maxZ, world, result);
+        }
+
+        public static int ProximityNearest(int kind, float x, float y, float z, int count, int world, int[] result)
+        {
+            return Provider.ProximityNearest(kind, x, y, z, count, world, result);
+        }
+
+        public static void ProximityInvalidate()
+        {
+            Provider.ProximityInvalidate();
+        }
+
+        public static void PlayerUpdateSetDefaultInterval(int interval)
+        {
+            Provider.PlayerUpdateSetDefaultInterval(interval);
+        }
+
+        public static int PlayerUpdateGetDefaultInterval()
+        {
+            return Provider.PlayerUpdateGetDefaultInterval();
+        }
+
+        public static bool PlayerUpdateSetInterval(int playerid, int interval)
+        {
+            return Provider.PlayerUpdateSetInterval(playerid, interval);
+        }
+
+        public static int PlayerUpdateGetInterval(int playerid)
+        {
+            return Provider.PlayerUpdateGetInterval(playerid);
+        }
+
+        public static void NativeProfilerStart(int sampleInterval)
+        {
+            Provider.NativeProfilerStart(sampleInterval);
+        }
+
+        public static void NativeProfilerStop()
+        {
+            Provider.NativeProfilerStop();
+        }
+
+        public static void NativeProfilerReset()
+        {
+            Provider.NativeProfilerReset();
+        }
+
+        public static int NativeProfilerGetStats(long[] result)
+        {
+            return Provider.NativeProfilerGetStats(result);
+        }
+
+        public static void NativeProfilerDump(int count)
+        {
+            Provider.NativeProfilerDump(count);
+        }
     }
 }
\ No newline at end of file
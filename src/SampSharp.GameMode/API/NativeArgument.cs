@@ -0,0 +1,101 @@
+﻿// SampSharp
+// Copyright 2017 Tim Potze
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//     http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+using System.Runtime.InteropServices;
+
+namespace SampSharp.GameMode.API
+{
+    /// <summary>
+    ///     Represents an argument of a native call queued in the <see cref="NativeCommandBuffer" />. Values of type
+    ///     <see cref="int" />, <see cref="float" />, <see cref="bool" /> and <see cref="string" /> are implicitly converted
+    ///     to a <see cref="NativeArgument" /> without boxing.
+    /// </summary>
+    public struct NativeArgument
+    {
+        internal enum ArgumentKind : byte
+        {
+            Integer,
+            Float,
+            Boolean,
+            String
+        }
+
+        private NativeArgument(int value, string text, ArgumentKind kind)
+        {
+            Value = value;
+            Text = text;
+            Kind = kind;
+        }
+
+        internal int Value { get; }
+
+        internal string Text { get; }
+
+        internal ArgumentKind Kind { get; }
+
+        /// <summary>
+        ///     Performs an implicit conversion from <see cref="int" /> to <see cref="NativeArgument" />.
+        /// </summary>
+        /// <param name="value">The value.</param>
+        /// <returns>The result of the conversion.</returns>
+        public static implicit operator NativeArgument(int value)
+        {
+            return new NativeArgument(value, null, ArgumentKind.Integer);
+        }
+
+        /// <summary>
+        ///     Performs an implicit conversion from <see cref="float" /> to <see cref="NativeArgument" />.
+        /// </summary>
+        /// <param name="value">The value.</param>
+        /// <returns>The result of the conversion.</returns>
+        public static implicit operator NativeArgument(float value)
+        {
+            return new NativeArgument(FloatToInt(value), null, ArgumentKind.Float);
+        }
+
+        /// <summary>
+        ///     Performs an implicit conversion from <see cref="bool" /> to <see cref="NativeArgument" />.
+        /// </summary>
+        /// <param name="value">The value.</param>
+        /// <returns>The result of the conversion.</returns>
+        public static implicit operator NativeArgument(bool value)
+        {
+            return new NativeArgument(value ? 1 : 0, null, ArgumentKind.Boolean);
+        }
+
+        /// <summary>
+        ///     Performs an implicit conversion from <see cref="string" /> to <see cref="NativeArgument" />.
+        /// </summary>
+        /// <param name="value">The value.</param>
+        /// <returns>The result of the conversion.</returns>
+        public static implicit operator NativeArgument(string value)
+        {
+            return new NativeArgument(0, value ?? string.Empty, ArgumentKind.String);
+        }
+
+        internal static int FloatToInt(float value)
+        {
+            return new ValueUnion {Float = value}.Integer;
+        }
+
+        [StructLayout(LayoutKind.Explicit)]
+        private struct ValueUnion
+        {
+            [FieldOffset(0)]
+            public int Integer;
+            [FieldOffset(0)]
+            public float Float;
+        }
+    }
+}
\ No newline at end of file
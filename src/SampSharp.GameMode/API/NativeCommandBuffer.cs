@@ -0,0 +1,282 @@
+﻿// SampSharp
+// Copyright 2017 Tim Potze
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//     http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+using System;
+using SampSharp.GameMode.Tools;
+
+namespace SampSharp.GameMode.API
+{
+    /// <summary>
+    ///     Queues calls to natives whose return value is not needed, so they can be executed by the plugin in a single
+    ///     batch instead of each taking a call into the plugin.
+    /// </summary>
+    /// <remarks>
+    ///     The plugin executes the queued calls when the callback, timer tick or server tick which queued them returns,
+    ///     when <see cref="Flush" /> is called or right before a native is invoked directly. Queued and directly invoked
+    ///     natives therefore run in the order in which they were issued. Only natives with <see cref="int" />,
+    ///     <see cref="float" />, <see cref="bool" /> and <see cref="string" /> parameters can be queued.
+    /// </remarks>
+    public static class NativeCommandBuffer
+    {
+        private const int DefaultCapacity = 16384;
+
+        // The first element holds the number of elements used by queued commands. Every command consists of a native
+        // handle followed by its arguments; strings are stored as their length followed by their characters, two per
+        // element. The buffer is shared with the plugin.
+        private static int[] _buffer;
+
+        /// <summary>
+        ///     Gets the number of elements used by the queued calls.
+        /// </summary>
+        public static int Length => _buffer?[0] ?? 0;
+
+        /// <summary>
+        ///     Queues a call to the specified native.
+        /// </summary>
+        /// <param name="native">The native.</param>
+        public static void Add(INative native)
+        {
+            if (Sync.IsRequired)
+            {
+                Sync.RunSync(() => Add(native));
+                return;
+            }
+
+            GetParameterTypes(native, 0);
+            Commit(Begin(native, 0));
+        }
+
+        /// <summary>
+        ///     Queues a call to the specified native.
+        /// </summary>
+        /// <param name="native">The native.</param>
+        /// <param name="argument0">The first argument.</param>
+        public static void Add(INative native, NativeArgument argument0)
+        {
+            if (Sync.IsRequired)
+            {
+                Sync.RunSync(() => Add(native, argument0));
+                return;
+            }
+
+            var types = GetParameterTypes(native, 1);
+            var position = Begin(native, GetSize(argument0));
+            position = Write(position, argument0, types[0]);
+            Commit(position);
+        }
+
+        /// <summary>
+        ///     Queues a call to the specified native.
+        /// </summary>
+        /// <param name="native">The native.</param>
+        /// <param name="argument0">The first argument.</param>
+        /// <param name="argument1">The second argument.</param>
+        public static void Add(INative native, NativeArgument argument0, NativeArgument argument1)
+        {
+            if (Sync.IsRequired)
+            {
+                Sync.RunSync(() => Add(native, argument0, argument1));
+                return;
+            }
+
+            var types = GetParameterTypes(native, 2);
+            var position = Begin(native, GetSize(argument0) + GetSize(argument1));
+            position = Write(position, argument0, types[0]);
+            position = Write(position, argument1, types[1]);
+            Commit(position);
+        }
+
+        /// <summary>
+        ///     Queues a call to the specified native.
+        /// </summary>
+        /// <param name="native">The native.</param>
+        /// <param name="argument0">The first argument.</param>
+        /// <param name="argument1">The second argument.</param>
+        /// <param name="argument2">The third argument.</param>
+        public static void Add(INative native, NativeArgument argument0, NativeArgument argument1,
+            NativeArgument argument2)
+        {
+            if (Sync.IsRequired)
+            {
+                Sync.RunSync(() => Add(native, argument0, argument1, argument2));
+                return;
+            }
+
+            var types = GetParameterTypes(native, 3);
+            var position = Begin(native, GetSize(argument0) + GetSize(argument1) + GetSize(argument2));
+            position = Write(position, argument0, types[0]);
+            position = Write(position, argument1, types[1]);
+            position = Write(position, argument2, types[2]);
+            Commit(position);
+        }
+
+        /// <summary>
+        ///     Queues a call to the specified native.
+        /// </summary>
+        /// <param name="native">The native.</param>
+        /// <param name="argument0">The first argument.</param>
+        /// <param name="argument1">The second argument.</param>
+        /// <param name="argument2">The third argument.</param>
+        /// <param name="argument3">The fourth argument.</param>
+        public static void Add(INative native, NativeArgument argument0, NativeArgument argument1,
+            NativeArgument argument2, NativeArgument argument3)
+        {
+            if (Sync.IsRequired)
+            {
+                Sync.RunSync(() => Add(native, argument0, argument1, argument2, argument3));
+                return;
+            }
+
+            var types = GetParameterTypes(native, 4);
+            var position = Begin(native,
+                GetSize(argument0) + GetSize(argument1) + GetSize(argument2) + GetSize(argument3));
+            position = Write(position, argument0, types[0]);
+            position = Write(position, argument1, types[1]);
+            position = Write(position, argument2, types[2]);
+            position = Write(position, argument3, types[3]);
+            Commit(position);
+        }
+
+        /// <summary>
+        ///     Queues a call to the specified native.
+        /// </summary>
+        /// <param name="native">The native.</param>
+        /// <param name="arguments">The arguments.</param>
+        public static void Add(INative native, params NativeArgument[] arguments)
+        {
+            if (arguments == null) throw new ArgumentNullException(nameof(arguments));
+
+            if (Sync.IsRequired)
+            {
+                Sync.RunSync(() => Add(native, arguments));
+                return;
+            }
+
+            var types = GetParameterTypes(native, arguments.Length);
+
+            var size = 0;
+            foreach (var argument in arguments)
+                size += GetSize(argument);
+
+            var position = Begin(native, size);
+            for (var i = 0; i < arguments.Length; i++)
+                position = Write(position, arguments[i], types[i]);
+            Commit(position);
+        }
+
+        /// <summary>
+        ///     Executes the queued calls.
+        /// </summary>
+        /// <returns>The number of natives executed.</returns>
+        public static int Flush()
+        {
+            if (Sync.IsRequired)
+                return Sync.RunSync(() => Flush());
+
+            return Length == 0 ? 0 : InteropProvider.CommandBufferFlush();
+        }
+
+        private static Type[] GetParameterTypes(INative native, int count)
+        {
+            if (native == null) throw new ArgumentNullException(nameof(native));
+
+            var types = native.ParameterTypes ?? Type.EmptyTypes;
+            if (types.Length != count)
+                throw new ArgumentException($"Native {native.Name} takes {types.Length} arguments, not {count}.",
+                    nameof(native));
+
+            return types;
+        }
+
+        private static int GetSize(NativeArgument argument)
+        {
+            return argument.Kind == NativeArgument.ArgumentKind.String ? 1 + (argument.Text.Length + 1)/2 : 1;
+        }
+
+        private static int Begin(INative native, int size)
+        {
+            // The command consists of the native handle followed by the arguments.
+            size++;
+
+            if (_buffer == null)
+                Attach(Math.Max(DefaultCapacity, size + 1));
+
+            var position = _buffer[0] + 1;
+            if (position + size > _buffer.Length)
+            {
+                Flush();
+                position = _buffer[0] + 1;
+            }
+
+            // Natives executed by the plugin may invoke callbacks which queue calls of their own, so the buffer is
+            // not necessarily empty after a flush.
+            while (position + size > _buffer.Length)
+            {
+                Attach(Math.Max(_buffer.Length*2, size + 1));
+                position = _buffer[0] + 1;
+            }
+
+            _buffer[position] = native.Handle;
+            return position + 1;
+        }
+
+        private static int Write(int position, NativeArgument argument, Type type)
+        {
+            var buffer = _buffer;
+
+            if (type == typeof (int) && argument.Kind == NativeArgument.ArgumentKind.Integer ||
+                type == typeof (float) && argument.Kind == NativeArgument.ArgumentKind.Float ||
+                type == typeof (bool) && argument.Kind == NativeArgument.ArgumentKind.Boolean)
+            {
+                buffer[position] = argument.Value;
+                return position + 1;
+            }
+
+            if (type == typeof (float) && argument.Kind == NativeArgument.ArgumentKind.Integer)
+            {
+                buffer[position] = NativeArgument.FloatToInt(argument.Value);
+                return position + 1;
+            }
+
+            if (type == typeof (string) && argument.Kind == NativeArgument.ArgumentKind.String)
+            {
+                var text = argument.Text;
+                buffer[position++] = text.Length;
+
+                var i = 0;
+                for (; i + 1 < text.Length; i += 2)
+                    buffer[position++] = text[i] | (text[i + 1] << 16);
+                if (i < text.Length)
+                    buffer[position++] = text[i];
+
+                return position;
+            }
+
+            throw new ArgumentException($"Argument of kind {argument.Kind} cannot be passed as {type}.");
+        }
+
+        private static void Commit(int position)
+        {
+            _buffer[0] = position - 1;
+        }
+
+        private static void Attach(int capacity)
+        {
+            // The plugin executes the calls in the previous buffer before replacing it; calls queued while doing so
+            // end up in the new buffer.
+            _buffer = new int[capacity];
+            InteropProvider.CommandBufferAttach(_buffer);
+        }
+    }
+}
\ No newline at end of file
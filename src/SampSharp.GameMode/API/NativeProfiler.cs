@@ -0,0 +1,117 @@
+﻿// SampSharp
+// Copyright 2017 Tim Potze
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//     http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+using System;
+using System.Linq;
+
+namespace SampSharp.GameMode.API
+{
+    /// <summary>
+    ///     Contains methods for finding out which natives the game mode spends its time in.
+    /// </summary>
+    /// <remarks>
+    ///     While the profiler runs, the plugin counts the calls of every native and times one of every sample interval
+    ///     calls of each native, separating the time spent inside the native from the time spent converting its
+    ///     arguments and results. Totals are estimated from the timed calls. The profiler costs nothing while it's
+    ///     stopped.
+    /// </remarks>
+    public static class NativeProfiler
+    {
+        /// <summary>
+        ///     The default sample interval.
+        /// </summary>
+        public const int DefaultSampleInterval = 16;
+
+        private const int Fields = 6;
+
+        private static long[] _buffer = new long[Fields * 64];
+
+        /// <summary>
+        ///     Gets a value indicating whether the profiler is running.
+        /// </summary>
+        public static bool IsRunning { get; private set; }
+
+        /// <summary>
+        ///     Starts the profiler.
+        /// </summary>
+        /// <param name="sampleInterval">Every how many calls of a native a call is timed.</param>
+        public static void Start(int sampleInterval = DefaultSampleInterval)
+        {
+            if (sampleInterval < 1)
+                throw new ArgumentOutOfRangeException(nameof(sampleInterval));
+
+            InteropProvider.NativeProfilerStart(sampleInterval);
+            IsRunning = true;
+        }
+
+        /// <summary>
+        ///     Stops the profiler. The statistics are kept.
+        /// </summary>
+        public static void Stop()
+        {
+            InteropProvider.NativeProfilerStop();
+            IsRunning = false;
+        }
+
+        /// <summary>
+        ///     Forgets the statistics.
+        /// </summary>
+        public static void Reset()
+        {
+            InteropProvider.NativeProfilerReset();
+        }
+
+        /// <summary>
+        ///     Gets the statistics of every native called while the profiler was running, by estimated total time,
+        ///     highest first.
+        /// </summary>
+        /// <returns>The statistics.</returns>
+        public static NativeStatistics[] GetStatistics()
+        {
+            int count;
+            while ((count = InteropProvider.NativeProfilerGetStats(_buffer)) * Fields > _buffer.Length)
+                _buffer = new long[count * Fields * 2];
+
+            var result = new NativeStatistics[count];
+            for (var i = 0; i < count; i++)
+            {
+                var offset = i * Fields;
+                var handle = (int) _buffer[offset];
+
+                result[i] = new NativeStatistics(handle, Native.Get(handle)?.Name, _buffer[offset + 1],
+                    _buffer[offset + 2], FromNanoseconds(_buffer[offset + 3]), FromNanoseconds(_buffer[offset + 4]),
+                    FromNanoseconds(_buffer[offset + 5]));
+            }
+
+            return result.OrderByDescending(s => s.EstimatedTotalTime).ToArray();
+        }
+
+        /// <summary>
+        ///     Prints the natives with the highest estimated total time to the server log.
+        /// </summary>
+        /// <param name="count">The maximum number of natives to print.</param>
+        public static void Dump(int count = 20)
+        {
+            if (count < 0)
+                throw new ArgumentOutOfRangeException(nameof(count));
+
+            InteropProvider.NativeProfilerDump(count);
+        }
+
+        private static TimeSpan FromNanoseconds(long nanoseconds)
+        {
+            return TimeSpan.FromTicks(nanoseconds / 100);
+        }
+    }
+}
\ No newline at end of file
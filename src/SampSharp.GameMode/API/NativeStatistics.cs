@@ -0,0 +1,110 @@
+﻿// SampSharp
+// Copyright 2017 Tim Potze
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//     http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+using System;
+
+namespace SampSharp.GameMode.API
+{
+    /// <summary>
+    ///     Contains the statistics of a native collected by the <see cref="NativeProfiler" />.
+    /// </summary>
+    public class NativeStatistics
+    {
+        /// <summary>
+        ///     Initializes a new instance of the <see cref="NativeStatistics" /> class.
+        /// </summary>
+        /// <param name="handle">The handle of the native.</param>
+        /// <param name="name">The name of the native.</param>
+        /// <param name="calls">The number of calls.</param>
+        /// <param name="sampledCalls">The number of timed calls.</param>
+        /// <param name="invokeTime">The time spent inside the native in timed calls.</param>
+        /// <param name="maxInvokeTime">The longest time spent inside the native in a timed call.</param>
+        /// <param name="marshalTime">The time spent converting arguments and results in timed calls.</param>
+        public NativeStatistics(int handle, string name, long calls, long sampledCalls, TimeSpan invokeTime,
+            TimeSpan maxInvokeTime, TimeSpan marshalTime)
+        {
+            Handle = handle;
+            Name = name;
+            Calls = calls;
+            SampledCalls = sampledCalls;
+            InvokeTime = invokeTime;
+            MaxInvokeTime = maxInvokeTime;
+            MarshalTime = marshalTime;
+        }
+
+        /// <summary>
+        ///     Gets the handle of the native.
+        /// </summary>
+        public int Handle { get; }
+
+        /// <summary>
+        ///     Gets the name of the native, or null if it wasn't loaded through <see cref="Native" />.
+        /// </summary>
+        public string Name { get; }
+
+        /// <summary>
+        ///     Gets the number of calls.
+        /// </summary>
+        public long Calls { get; }
+
+        /// <summary>
+        ///     Gets the number of timed calls.
+        /// </summary>
+        public long SampledCalls { get; }
+
+        /// <summary>
+        ///     Gets the time spent inside the native in timed calls.
+        /// </summary>
+        public TimeSpan InvokeTime { get; }
+
+        /// <summary>
+        ///     Gets the longest time spent inside the native in a timed call.
+        /// </summary>
+        public TimeSpan MaxInvokeTime { get; }
+
+        /// <summary>
+        ///     Gets the time spent converting arguments and results in timed calls.
+        /// </summary>
+        public TimeSpan MarshalTime { get; }
+
+        /// <summary>
+        ///     Gets the estimated time spent in all calls, inside the native and converting arguments and results.
+        /// </summary>
+        public TimeSpan EstimatedTotalTime
+        {
+            get
+            {
+                if (SampledCalls == 0)
+                    return TimeSpan.Zero;
+
+                return TimeSpan.FromTicks((long) ((InvokeTime + MarshalTime).Ticks * ((double) Calls / SampledCalls)));
+            }
+        }
+
+        #region Overrides of Object
+
+        /// <summary>
+        ///     Returns a string that represents the current object.
+        /// </summary>
+        /// <returns>
+        ///     A string that represents the current object.
+        /// </returns>
+        public override string ToString()
+        {
+            return $"{Name ?? Handle.ToString()}: {Calls} calls, {EstimatedTotalTime.TotalMilliseconds:0.00} ms";
+        }
+
+        #endregion
+    }
+}
\ No newline at end of file
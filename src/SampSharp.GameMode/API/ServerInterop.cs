@@ -55,5 +55,206 @@ namespace SampSharp.GameMode.API
         {
             Interop.SetCodepage(codepage);
         }
+
+        public bool HeightMapLoad(string path)
+        {
+            return Interop.HeightMapLoad(path);
+        }
+
+        public void HeightMapUnload()
+        {
+            Interop.HeightMapUnload();
+        }
+
+        public float HeightMapFindZ(float x, float y)
+        {
+            return Interop.HeightMapFindZ(x, y);
+        }
+
+        public float HeightMapFindAverageZ(float x, float y)
+        {
+            return Interop.HeightMapFindAverageZ(x, y);
+        }
+
+        public float HeightMapFindBilinearZ(float x, float y)
+        {
+            return Interop.HeightMapFindBilinearZ(x, y);
+        }
+
+        public void HeightMapFindZArray(float[] points, float[] heights, int mode)
+        {
+            Interop.HeightMapFindZArray(points, heights, mode);
+        }
+
+        public bool HeightMapSetZ(float x, float y, float z)
+        {
+            return Interop.HeightMapSetZ(x, y, z);
+        }
+
+        public bool HeightMapSave(string path)
+        {
+            return Interop.HeightMapSave(path);
+        }
+
+        public void PlayerSnapshotAttach(float[] floats, int[] ints)
+        {
+            Interop.PlayerSnapshotAttach(floats, ints);
+        }
+
+        public void PlayerSnapshotDetach()
+        {
+            Interop.PlayerSnapshotDetach();
+        }
+
+        public int PlayerSnapshotCapture()
+        {
+            return Interop.PlayerSnapshotCapture();
+        }
+
+        public void CommandBufferAttach(int[] buffer)
+        {
+            Interop.CommandBufferAttach(buffer);
+        }
+
+        public void CommandBufferDetach()
+        {
+            Interop.CommandBufferDetach();
+        }
+
+        public int CommandBufferFlush()
+        {
+            return Interop.CommandBufferFlush();
+        }
+
+        public int StreamerAddObject(int modelid, float x, float y, float z, float rotationX, float rotationY,
+            float rotationZ, int virtualWorld, int interior, float streamDistance, float drawDistance)
+        {
+            return Interop.StreamerAddObject(modelid, x, y, z, rotationX, rotationY, rotationZ, virtualWorld, interior,
+                streamDistance, drawDistance);
+        }
+
+        public int StreamerAddPickup(int modelid, int type, float x, float y, float z, int virtualWorld, int interior,
+            float streamDistance)
+        {
+            return Interop.StreamerAddPickup(modelid, type, x, y, z, virtualWorld, interior, streamDistance);
+        }
+
+        public int StreamerAddLabel(string text, int color, float x, float y, float z, float drawDistance,
+            int virtualWorld, int interior, bool testLOS, float streamDistance)
+        {
+            return Interop.StreamerAddLabel(text, color, x, y, z, drawDistance, virtualWorld, interior, testLOS,
+                streamDistance);
+        }
+
+        public bool StreamerRemove(int id)
+        {
+            return Interop.StreamerRemove(id);
+        }
+
+        public bool StreamerSetPosition(int id, float x, float y, float z)
+        {
+            return Interop.StreamerSetPosition(id, x, y, z);
+        }
+
+        public bool StreamerSetRotation(int id, float rotationX, float rotationY, float rotationZ)
+        {
+            return Interop.StreamerSetRotation(id, rotationX, rotationY, rotationZ);
+        }
+
+        public bool StreamerSetLabelText(int id, string text, int color)
+        {
+            return Interop.StreamerSetLabelText(id, text, color);
+        }
+
+        public void StreamerSetBudget(int budget)
+        {
+            Interop.StreamerSetBudget(budget);
+        }
+
+        public void StreamerUpdate(int playerid)
+        {
+            Interop.StreamerUpdate(playerid);
+        }
+
+        public bool StreamerIsVisible(int id, int playerid)
+        {
+            return Interop.StreamerIsVisible(id, playerid);
+        }
+
+        public int StreamerFindPickup(int pickupid)
+        {
+            return Interop.StreamerFindPickup(pickupid);
+        }
+
+        public int StreamerGetVisibleCount(int playerid)
+        {
+            return Interop.StreamerGetVisibleCount(playerid);
+        }
+
+        public int ProximityQueryRadius(int kind, float x, float y, float z, float range, int world, int[] result)
+        {
+            return Interop.ProximityQueryRadius(kind, x, y, z, range, world, result);
+        }
+
+        public int ProximityQueryBox(int kind, float minX, float minY, float minZ, float maxX, float maxY, float maxZ,
+            int world, int[] result)
+        {
+            return Interop.ProximityQueryBox(kind, minX, minY, minZ, maxX, maxY, maxZ, world, result);
+        }
+
+        public int ProximityNearest(int kind, float x, float y, float z, int count, int world, int[] result)
+        {
+            return Interop.ProximityNearest(kind, x, y, z, count, world, result);
+        }
+
+        public void ProximityInvalidate()
+        {
+            Interop.ProximityInvalidate();
+        }
+
+        public void PlayerUpdateSetDefaultInterval(int interval)
+        {
+            Interop.PlayerUpdateSetDefaultInterval(interval);
+        }
+
+        public int PlayerUpdateGetDefaultInterval()
+        {
+            return Interop.PlayerUpdateGetDefaultInterval();
+        }
+
+        public bool PlayerUpdateSetInterval(int playerid, int interval)
+        {
+            return Interop.PlayerUpdateSetInterval(playerid, interval);
+        }
+
+        public int PlayerUpdateGetInterval(int playerid)
+        {
+            return Interop.PlayerUpdateGetInterval(playerid);
+        }
+
+        public void NativeProfilerStart(int sampleInterval)
+        {
+            Interop.NativeProfilerStart(sampleInterval);
+        }
+
+        public void NativeProfilerStop()
+        {
+            Interop.NativeProfilerStop();
+        }
+
+        public void NativeProfilerReset()
+        {
+            Interop.NativeProfilerReset();
+        }
+
+        public int NativeProfilerGetStats(long[] result)
+        {
+            return Interop.NativeProfilerGetStats(result);
+        }
+
+        public void NativeProfilerDump(int count)
+        {
+            Interop.NativeProfilerDump(count);
+        }
     }
 }
\ No newline at end of file
@@ -22,6 +22,27 @@ namespace SampSharp.GameMode
 {
     public abstract partial class BaseMode
     {
+        private KeyStateChangedEventArgs _keyStateChangedEventArgs;
+        private PlayerUpdateEventArgs _playerUpdateEventArgs;
+        private PlayerEventArgs _playerStreamInEventArgs;
+        private PlayerEventArgs _playerStreamOutEventArgs;
+        private UnoccupiedVehicleEventArgs _unoccupiedVehicleEventArgs;
+        private WeaponShotEventArgs _weaponShotEventArgs;
+
+        private static T Take<T>(ref T cache) where T : class
+        {
+            // The cached instance is taken out of its slot while it is in use so a reentrant callback allocates a new one.
+            var value = cache;
+            cache = null;
+            return value;
+        }
+
+        private void Return<T>(ref T cache, T value) where T : class
+        {
+            if (ReuseEventArgs)
+                cache = value;
+        }
+
         internal bool OnTimerTick(int timerid, object args)
         {
             // Pass straight trough to TimerTick. Set the args as sender.
@@ -236,6 +257,14 @@ namespace SampSharp.GameMode
 
         internal bool OnPlayerPickUpPickup(int playerid, int pickupid)
         {
+            var streamedPickup = StreamedPickup.FindByPickupId(pickupid);
+
+            if (streamedPickup != null)
+            {
+                streamedPickup.OnPickUp(new PlayerEventArgs(BasePlayer.FindOrCreate(playerid)));
+                return true;
+            }
+
             var pickup = Pickup.Find(pickupid);
 
             if (pickup == null)
@@ -314,11 +343,16 @@ namespace SampSharp.GameMode
             if (vehicle == null)
                 return true;
 
-            var args = new UnoccupiedVehicleEventArgs(BasePlayer.FindOrCreate(playerid), passengerSeat,
-                new Vector3(newX, newY, newZ), new Vector3(velX, velY, velZ));
+            var player = BasePlayer.FindOrCreate(playerid);
+            var position = new Vector3(newX, newY, newZ);
+            var velocity = new Vector3(velX, velY, velZ);
+            var args = Take(ref _unoccupiedVehicleEventArgs)?.Reset(player, passengerSeat, position, velocity) ??
+                       new UnoccupiedVehicleEventArgs(player, passengerSeat, position, velocity);
             OnUnoccupiedVehicleUpdated(vehicle, args);
 
-            return !args.PreventPropagation;
+            var result = !args.PreventPropagation;
+            Return(ref _unoccupiedVehicleEventArgs, args);
+            return result;
         }
 
         internal bool OnPlayerSelectedMenuRow(int playerid, int row)
@@ -345,9 +379,11 @@ namespace SampSharp.GameMode
 
         internal bool OnPlayerKeyStateChange(int playerid, int newkeys, int oldkeys)
         {
-            OnPlayerKeyStateChanged(BasePlayer.FindOrCreate(playerid),
-                new KeyStateChangedEventArgs((Keys) newkeys, (Keys) oldkeys));
+            var args = Take(ref _keyStateChangedEventArgs)?.Reset((Keys) newkeys, (Keys) oldkeys) ??
+                       new KeyStateChangedEventArgs((Keys) newkeys, (Keys) oldkeys);
+            OnPlayerKeyStateChanged(BasePlayer.FindOrCreate(playerid), args);
 
+            Return(ref _keyStateChangedEventArgs, args);
             return true;
         }
 
@@ -360,26 +396,32 @@ namespace SampSharp.GameMode
 
         internal bool OnPlayerUpdate(int playerid)
         {
-            var args = new PlayerUpdateEventArgs();
+            var args = Take(ref _playerUpdateEventArgs)?.Reset() ?? new PlayerUpdateEventArgs();
 
             OnPlayerUpdate(BasePlayer.FindOrCreate(playerid), args);
 
-            return !args.PreventPropagation;
+            var result = !args.PreventPropagation;
+            Return(ref _playerUpdateEventArgs, args);
+            return result;
         }
 
         internal bool OnPlayerStreamIn(int playerid, int forplayerid)
         {
-            OnPlayerStreamIn(BasePlayer.FindOrCreate(playerid),
-                new PlayerEventArgs(BasePlayer.FindOrCreate(forplayerid)));
+            var forplayer = BasePlayer.FindOrCreate(forplayerid);
+            var args = Take(ref _playerStreamInEventArgs)?.Reset(forplayer) ?? new PlayerEventArgs(forplayer);
+            OnPlayerStreamIn(BasePlayer.FindOrCreate(playerid), args);
 
+            Return(ref _playerStreamInEventArgs, args);
             return true;
         }
 
         internal bool OnPlayerStreamOut(int playerid, int forplayerid)
         {
-            OnPlayerStreamOut(BasePlayer.FindOrCreate(playerid),
-                new PlayerEventArgs(BasePlayer.FindOrCreate(forplayerid)));
+            var forplayer = BasePlayer.FindOrCreate(forplayerid);
+            var args = Take(ref _playerStreamOutEventArgs)?.Reset(forplayer) ?? new PlayerEventArgs(forplayer);
+            OnPlayerStreamOut(BasePlayer.FindOrCreate(playerid), args);
 
+            Return(ref _playerStreamOutEventArgs, args);
             return true;
         }
 
@@ -569,12 +611,15 @@ namespace SampSharp.GameMode
         internal bool OnPlayerWeaponShot(int playerid, int weaponid, int hittype, int hitid, float fX, float fY,
             float fZ)
         {
-            var args = new WeaponShotEventArgs((Weapon) weaponid, (BulletHitType) hittype, hitid,
-                new Vector3(fX, fY, fZ));
+            var position = new Vector3(fX, fY, fZ);
+            var args = Take(ref _weaponShotEventArgs)?.Reset((Weapon) weaponid, (BulletHitType) hittype, hitid,
+                position) ?? new WeaponShotEventArgs((Weapon) weaponid, (BulletHitType) hittype, hitid, position);
 
             OnPlayerWeaponShot(BasePlayer.FindOrCreate(playerid), args);
 
-            return !args.PreventDamage;
+            var result = !args.PreventDamage;
+            Return(ref _weaponShotEventArgs, args);
+            return result;
         }
 
         internal bool OnIncomingConnection(int playerid, string ipAddress, int port)
@@ -636,6 +681,10 @@ namespace SampSharp.GameMode
         {
             OnTick(EventArgs.Empty);
 
+            // Apply the textdraw changes retained during this tick.
+            TextDraw.FlushRetained();
+            PlayerTextDraw.FlushRetained();
+
             return true;
         }
 
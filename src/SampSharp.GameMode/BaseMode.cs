@@ -77,6 +77,15 @@ namespace SampSharp.GameMode
         ///     Gets the <see cref="GameModeServiceContainer" /> holding all the service providers attached to the game mode.
         /// </summary>
         public virtual GameModeServiceContainer Services { get; } = new GameModeServiceContainer();
+
+        /// <summary>
+        ///     Gets or sets a value indicating whether the event arguments of high-frequency callbacks should be reused.
+        ///     If enabled, the <see cref="PlayerUpdate" />, <see cref="PlayerKeyStateChanged" />,
+        ///     <see cref="PlayerWeaponShot" />, <see cref="UnoccupiedVehicleUpdated" />, <see cref="PlayerStreamIn" /> and
+        ///     <see cref="PlayerStreamOut" /> events receive a recycled instance of their event arguments. Handlers must not
+        ///     keep a reference to these arguments after the handler has returned.
+        /// </summary>
+        public bool ReuseEventArgs { get; set; }
         
         #region Implementation of IDisposable
 
@@ -100,10 +109,10 @@ namespace SampSharp.GameMode
         /// <param name="assembly">The assembly.</param>
         public void AutoloadControllersForAssembly(Assembly assembly)
         {
-            foreach (var type in assembly.GetExportedTypes()
+            foreach (var type in TypeScanCache.GetTypes(assembly, "controllers", a => a.GetExportedTypes()
                 .Where(t => t.IsClass &&
                             typeof (IController).IsAssignableFrom(t) &&
-                            t.GetCustomAttribute<ControllerAttribute>() != null))
+                            t.GetCustomAttribute<ControllerAttribute>() != null)))
             {
                 FrameworkLog.WriteLine(FrameworkMessageLevel.Debug, $"Autoloading type {type}...");
                 _controllers.Override(Activator.CreateInstance(type) as IController);
@@ -144,8 +153,8 @@ namespace SampSharp.GameMode
             foreach (var poolType in new[] {typeof (BaseMode), GetType()}.Concat(_extensions.Select(e => e.GetType()))
                 .Select(t => t.Assembly)
                 .Distinct()
-                .SelectMany(a => a.GetTypes())
-                .Where(t => t.IsClass && t.GetCustomAttribute<PooledTypeAttribute>() != null)
+                .SelectMany(a => TypeScanCache.GetTypes(a, "pools", s => s.GetTypes()
+                    .Where(t => t.IsClass && t.GetCustomAttribute<PooledTypeAttribute>() != null)))
                 .Distinct())
             {
                 // If poolType or subclass of poolType is already in types, continue.
@@ -471,6 +471,10 @@ namespace SampSharp.GameMode
         /// <summary>
         ///     Occurs when a callback throws an exception.
         /// </summary>
+        /// <remarks>
+        ///     This event occurs for every exception, including the exceptions which aren't printed because many
+        ///     exceptions of the same kind are thrown at once.
+        /// </remarks>
         public event EventHandler<ExceptionEventArgs> CallbackException;
 
         /// <summary>
@@ -97,7 +97,7 @@ namespace SampSharp.GameMode.Controllers
         {
             if (disposing)
             {
-                foreach (var player in BasePlayer.All)
+                foreach (var player in BasePlayer.All.Snapshot())
                 {
                     player.Dispose();
                 }
@@ -73,7 +73,7 @@ namespace SampSharp.GameMode.Controllers
         {
             if (disposing)
             {
-                foreach (var vehicle in BaseVehicle.All)
+                foreach (var vehicle in BaseVehicle.All.Snapshot())
                 {
                     vehicle.Dispose();
                 }
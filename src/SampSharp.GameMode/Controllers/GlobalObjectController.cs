@@ -50,7 +50,7 @@ namespace SampSharp.GameMode.Controllers
         {
             if (disposing)
             {
-                foreach (var o in GlobalObject.All)
+                foreach (var o in GlobalObject.All.Snapshot())
                 {
                     o.Dispose();
                 }
@@ -48,7 +48,7 @@ namespace SampSharp.GameMode.Controllers
         {
             if (disposing)
             {
-                foreach (var pickup in Pickup.All)
+                foreach (var pickup in Pickup.All.Snapshot())
                 {
                     pickup.Dispose();
                 }
@@ -62,7 +62,7 @@ namespace SampSharp.GameMode.Controllers
         {
             if (disposing)
             {
-                foreach (var o in PlayerObject.All)
+                foreach (var o in PlayerObject.All.Snapshot())
                 {
                     o.Dispose();
                 }
@@ -56,7 +56,7 @@ namespace SampSharp.GameMode.Controllers
         {
             if (disposing)
             {
-                foreach (var td in PlayerTextDraw.All)
+                foreach (var td in PlayerTextDraw.All.Snapshot())
                 {
                     td.Dispose();
                 }
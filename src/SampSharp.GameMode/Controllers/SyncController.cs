@@ -42,7 +42,7 @@ namespace SampSharp.GameMode.Controllers
             gameMode.Tick += _gameMode_Tick;
             gameMode.Exited += (sender, args) =>
             {
-                foreach (var t in Sync.SyncTask.All)
+                foreach (var t in Sync.SyncTask.All.Snapshot())
                 {
                     t.Dispose();
                 }
@@ -64,7 +64,7 @@ namespace SampSharp.GameMode.Controllers
         {
             if (!_waiting) return;
 
-            foreach (var t in Sync.SyncTask.All)
+            foreach (var t in Sync.SyncTask.All.Snapshot())
             {
                 t.Run();
                 t.Dispose();
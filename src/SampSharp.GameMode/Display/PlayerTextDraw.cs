@@ -13,9 +13,9 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 using System;
+using System.Collections.Generic;
 using SampSharp.GameMode.Definitions;
 using SampSharp.GameMode.Events;
-using SampSharp.GameMode.Helpers;
 using SampSharp.GameMode.Pools;
 using SampSharp.GameMode.SAMP;
 using SampSharp.GameMode.World;
@@ -25,6 +25,7 @@ namespace SampSharp.GameMode.Display
     /// <summary>
     ///     Represents a player-textdraw.
     /// </summary>
+    [PoolCapacity(Max)]
     public partial class PlayerTextDraw : IdentifiedOwnedPool<PlayerTextDraw, BasePlayer>
     {
         /// <summary>
@@ -63,9 +64,12 @@ namespace SampSharp.GameMode.Display
 
         #region Fields
 
+        private static readonly List<PlayerTextDraw> RetainedChanges = new List<PlayerTextDraw>();
+
         private TextDrawAlignment? _alignment;
         private Color? _backColor;
         private Color? _boxColor;
+        private TextDrawFields _dirty;
         private TextDrawFont? _font;
         private Color? _foreColor;
         private float? _height;
@@ -81,6 +85,7 @@ namespace SampSharp.GameMode.Display
         private bool? _selectable;
         private int? _shadow;
         private string _text;
+        private bool _isRetained;
         private bool? _useBox;
         private bool _visible;
         private float? _width;
@@ -159,6 +164,21 @@ namespace SampSharp.GameMode.Display
         /// <remarks>The textdraw will automatically be recreated once .Show is called.</remarks>
         public bool AutoDestroy { get; set; }
 
+        /// <summary>
+        ///     Gets or sets whether changes to the properties of this player-textdraw are retained until the end of the
+        ///     tick. When retained, the changes are applied at once and the player-textdraw is shown again only once.
+        ///     Use <see cref="Flush" /> to apply the changes earlier.
+        /// </summary>
+        public bool IsRetained
+        {
+            get { return _isRetained; }
+            set
+            {
+                _isRetained = value;
+                if (!value) Flush();
+            }
+        }
+
         /// <summary>
         ///     Gets or sets the <see cref="TextDrawAlignment" /> of this player-textdraw.
         /// </summary>
@@ -168,9 +188,7 @@ namespace SampSharp.GameMode.Display
             set
             {
                 _alignment = value;
-                if (Id == -1) return;
-                PlayerTextDrawInternal.Instance.PlayerTextDrawAlignment(Owner.Id, Id, (int) value);
-                Update();
+                Invalidate(TextDrawFields.Alignment);
             }
         }
 
@@ -183,9 +201,7 @@ namespace SampSharp.GameMode.Display
             set
             {
                 _backColor = value;
-                if (Id == -1) return;
-                PlayerTextDrawInternal.Instance.PlayerTextDrawBackgroundColor(Owner.Id, Id, value);
-                Update();
+                Invalidate(TextDrawFields.BackColor);
             }
         }
 
@@ -198,9 +214,7 @@ namespace SampSharp.GameMode.Display
             set
             {
                 _foreColor = value;
-                if (Id == -1) return;
-                PlayerTextDrawInternal.Instance.PlayerTextDrawColor(Owner.Id, Id, value);
-                Update();
+                Invalidate(TextDrawFields.ForeColor);
             }
         }
 
@@ -213,9 +227,7 @@ namespace SampSharp.GameMode.Display
             set
             {
                 _boxColor = value;
-                if (Id == -1) return;
-                PlayerTextDrawInternal.Instance.PlayerTextDrawBoxColor(Owner.Id, Id, value);
-                Update();
+                Invalidate(TextDrawFields.BoxColor);
             }
         }
 
@@ -228,9 +240,7 @@ namespace SampSharp.GameMode.Display
             set
             {
                 _font = value;
-                if (Id == -1) return;
-                PlayerTextDrawInternal.Instance.PlayerTextDrawFont(Owner.Id, Id, (int) value);
-                Update();
+                Invalidate(TextDrawFields.Font);
             }
         }
 
@@ -243,9 +253,7 @@ namespace SampSharp.GameMode.Display
             set
             {
                 _letterSize = value;
-                if (Id == -1) return;
-                PlayerTextDrawInternal.Instance.PlayerTextDrawLetterSize(Owner.Id, Id, value.X, value.Y);
-                Update();
+                Invalidate(TextDrawFields.LetterSize);
             }
         }
 
@@ -258,9 +266,7 @@ namespace SampSharp.GameMode.Display
             set
             {
                 _outline = value;
-                if (Id == -1) return;
-                PlayerTextDrawInternal.Instance.PlayerTextDrawSetOutline(Owner.Id, Id, value);
-                Update();
+                Invalidate(TextDrawFields.Outline);
             }
         }
 
@@ -273,9 +279,7 @@ namespace SampSharp.GameMode.Display
             set
             {
                 _proportional = value;
-                if (Id == -1) return;
-                PlayerTextDrawInternal.Instance.PlayerTextDrawSetProportional(Owner.Id, Id, value);
-                Update();
+                Invalidate(TextDrawFields.Proportional);
             }
         }
 
@@ -288,9 +292,7 @@ namespace SampSharp.GameMode.Display
             set
             {
                 _shadow = value;
-                if (Id == -1) return;
-                PlayerTextDrawInternal.Instance.PlayerTextDrawSetShadow(Owner.Id, Id, value);
-                Update();
+                Invalidate(TextDrawFields.Shadow);
             }
         }
 
@@ -303,9 +305,7 @@ namespace SampSharp.GameMode.Display
             set
             {
                 _text = value;
-                if (Id == -1) return;
-                PlayerTextDrawInternal.Instance.PlayerTextDrawSetString(Owner.Id, Id, value);
-                Update();
+                Invalidate(TextDrawFields.Text);
             }
         }
 
@@ -318,8 +318,7 @@ namespace SampSharp.GameMode.Display
             set
             {
                 _position = value;
-                if (Id == -1) return;
-                Refresh();
+                Invalidate(TextDrawFields.Position);
             }
         }
 
@@ -332,9 +331,7 @@ namespace SampSharp.GameMode.Display
             set
             {
                 _width = value;
-                if (Id == -1) return;
-                PlayerTextDrawInternal.Instance.PlayerTextDrawTextSize(Owner.Id, Id, value, Height);
-                Update();
+                Invalidate(TextDrawFields.TextSize);
             }
         }
 
@@ -347,9 +344,7 @@ namespace SampSharp.GameMode.Display
             set
             {
                 _height = value;
-                if (Id == -1) return;
-                PlayerTextDrawInternal.Instance.PlayerTextDrawTextSize(Owner.Id, Id, Width, value);
-                Update();
+                Invalidate(TextDrawFields.TextSize);
             }
         }
 
@@ -362,9 +357,7 @@ namespace SampSharp.GameMode.Display
             set
             {
                 _useBox = value;
-                if (Id == -1) return;
-                PlayerTextDrawInternal.Instance.PlayerTextDrawUseBox(Owner.Id, Id, value);
-                Update();
+                Invalidate(TextDrawFields.UseBox);
             }
         }
 
@@ -377,9 +370,7 @@ namespace SampSharp.GameMode.Display
             set
             {
                 _selectable = value;
-                if (Id == -1) return;
-                PlayerTextDrawInternal.Instance.PlayerTextDrawSetSelectable(Owner.Id, Id, value);
-                Update();
+                Invalidate(TextDrawFields.Selectable);
             }
         }
 
@@ -392,9 +383,7 @@ namespace SampSharp.GameMode.Display
             set
             {
                 _previewModel = value;
-                if (Id == -1) return;
-                PlayerTextDrawInternal.Instance.PlayerTextDrawSetPreviewModel(Owner.Id, Id, value);
-                Update();
+                Invalidate(TextDrawFields.PreviewModel);
             }
         }
 
@@ -407,9 +396,7 @@ namespace SampSharp.GameMode.Display
             set
             {
                 _previewRotation = value;
-                if (Id == -1) return;
-                PlayerTextDrawInternal.Instance.PlayerTextDrawSetPreviewRot(Owner.Id, Id, value.X, value.Y, value.Z, PreviewZoom);
-                Update();
+                Invalidate(TextDrawFields.PreviewRotation);
             }
         }
 
@@ -422,10 +409,7 @@ namespace SampSharp.GameMode.Display
             set
             {
                 _previewZoom = value;
-                if (Id == -1) return;
-                PlayerTextDrawInternal.Instance.PlayerTextDrawSetPreviewRot(Owner.Id, Id, PreviewRotation.X, PreviewRotation.Y,
-                    PreviewRotation.Z, value);
-                Update();
+                Invalidate(TextDrawFields.PreviewRotation);
             }
         }
 
@@ -438,9 +422,7 @@ namespace SampSharp.GameMode.Display
             set
             {
                 _previewPrimaryColor = value;
-                if (Id == -1) return;
-                PlayerTextDrawInternal.Instance.PlayerTextDrawSetPreviewVehCol(Owner.Id, Id, value, PreviewSecondaryColor);
-                Update();
+                Invalidate(TextDrawFields.PreviewVehicleColor);
             }
         }
 
@@ -453,9 +435,7 @@ namespace SampSharp.GameMode.Display
             set
             {
                 _previewSecondaryColor = value;
-                if (Id == -1) return;
-                PlayerTextDrawInternal.Instance.PlayerTextDrawSetPreviewVehCol(Owner.Id, Id, PreviewPrimaryColor, value);
-                Update();
+                Invalidate(TextDrawFields.PreviewVehicleColor);
             }
         }
 
@@ -484,6 +464,7 @@ namespace SampSharp.GameMode.Display
             AssertNotDisposed();
 
             if (Id == -1) Refresh();
+            else ApplyChanges();
             _visible = true;
 
             PlayerTextDrawInternal.Instance.PlayerTextDrawShow(Owner.Id, Id);
@@ -513,32 +494,22 @@ namespace SampSharp.GameMode.Display
         /// </summary>
         protected virtual void Refresh()
         {
-            if (Id != -1) PlayerTextDrawInternal.Instance.PlayerTextDrawDestroy(Owner.Id, Id);
-            Id = PlayerTextDrawInternal.Instance.CreatePlayerTextDraw(Owner.Id, Position.X, Position.Y, FixString(Text));
-
-            //Reset properties
-            _font.Do(x => Font = x);
-            _alignment.Do(x => Alignment = x);
-            _backColor.Do(x => BackColor = x);
-            _foreColor.Do(x => ForeColor = x);
-            _boxColor.Do(x => BoxColor = x);
-            _letterSize.Do(x => LetterSize = x);
-            _outline.Do(x => Outline = x);
-            _proportional.Do(x => Proportional = x);
-            _shadow.Do(x => Shadow = x);
-            _width.Do(x => Width = x);
-            _height.Do(x => Height = x);
-            _useBox.Do(x => UseBox = x);
-            _selectable.Do(x => Selectable = x);
-            _previewModel.Do(x => PreviewModel = x);
-            _previewRotation.Do(x => PreviewRotation = x);
-            _previewZoom.Do(x => PreviewZoom = x);
-            _previewPrimaryColor.Do(x => PreviewPrimaryColor = x);
-            _previewSecondaryColor.Do(x => PreviewSecondaryColor = x);
-
+            Recreate();
             Update();
         }
 
+        /// <summary>
+        ///     Applies the retained changes to the properties of this player-textdraw and updates it on the client's
+        ///     screen.
+        /// </summary>
+        public virtual void Flush()
+        {
+            if ((_dirty & TextDrawFields.Position) != 0)
+                Refresh();
+            else if (ApplyChanges())
+                Update();
+        }
+
         /// <summary>
         ///     Fixes a string so no SA-MP bugs will occur during application.
         /// </summary>
@@ -567,6 +538,107 @@ namespace SampSharp.GameMode.Display
             if (_visible) Show();
         }
 
+        /// <summary>
+        ///     Applies the retained changes of all player-textdraws.
+        /// </summary>
+        internal static void FlushRetained()
+        {
+            if (RetainedChanges.Count == 0)
+                return;
+
+            var textDraws = RetainedChanges.ToArray();
+            RetainedChanges.Clear();
+
+            foreach (var textDraw in textDraws)
+                if (!textDraw.IsDisposed)
+                    textDraw.Flush();
+        }
+
+        private void Invalidate(TextDrawFields fields)
+        {
+            if (Id == -1) return;
+
+            if (IsRetained)
+            {
+                if (_dirty == TextDrawFields.None)
+                    RetainedChanges.Add(this);
+
+                _dirty |= fields;
+                return;
+            }
+
+            _dirty |= fields;
+            Flush();
+        }
+
+        private bool ApplyChanges()
+        {
+            var fields = _dirty;
+            _dirty = TextDrawFields.None;
+
+            if (fields == TextDrawFields.None || Id == -1)
+                return false;
+
+            if ((fields & TextDrawFields.Position) != 0)
+                Recreate();
+            else
+                Apply(fields);
+
+            return true;
+        }
+
+        private void Recreate()
+        {
+            if (Id != -1) PlayerTextDrawInternal.Instance.PlayerTextDrawDestroy(Owner.Id, Id);
+            Id = PlayerTextDrawInternal.Instance.CreatePlayerTextDraw(Owner.Id, Position.X, Position.Y, FixString(Text));
+
+            _dirty = TextDrawFields.None;
+
+            //Reset properties
+            Apply(~(TextDrawFields.Text | TextDrawFields.Position));
+        }
+
+        private void Apply(TextDrawFields fields)
+        {
+            var td = PlayerTextDrawInternal.Instance;
+            var playerid = Owner.Id;
+
+            if ((fields & TextDrawFields.Font) != 0 && _font.HasValue)
+                td.PlayerTextDrawFont(playerid, Id, (int) Font);
+            if ((fields & TextDrawFields.Alignment) != 0 && _alignment.HasValue)
+                td.PlayerTextDrawAlignment(playerid, Id, (int) Alignment);
+            if ((fields & TextDrawFields.BackColor) != 0 && _backColor.HasValue)
+                td.PlayerTextDrawBackgroundColor(playerid, Id, BackColor);
+            if ((fields & TextDrawFields.ForeColor) != 0 && _foreColor.HasValue)
+                td.PlayerTextDrawColor(playerid, Id, ForeColor);
+            if ((fields & TextDrawFields.BoxColor) != 0 && _boxColor.HasValue)
+                td.PlayerTextDrawBoxColor(playerid, Id, BoxColor);
+            if ((fields & TextDrawFields.LetterSize) != 0 && _letterSize.HasValue)
+                td.PlayerTextDrawLetterSize(playerid, Id, LetterSize.X, LetterSize.Y);
+            if ((fields & TextDrawFields.Outline) != 0 && _outline.HasValue)
+                td.PlayerTextDrawSetOutline(playerid, Id, Outline);
+            if ((fields & TextDrawFields.Proportional) != 0 && _proportional.HasValue)
+                td.PlayerTextDrawSetProportional(playerid, Id, Proportional);
+            if ((fields & TextDrawFields.Shadow) != 0 && _shadow.HasValue)
+                td.PlayerTextDrawSetShadow(playerid, Id, Shadow);
+            if ((fields & TextDrawFields.TextSize) != 0 && (_width.HasValue || _height.HasValue))
+                td.PlayerTextDrawTextSize(playerid, Id, Width, Height);
+            if ((fields & TextDrawFields.UseBox) != 0 && _useBox.HasValue)
+                td.PlayerTextDrawUseBox(playerid, Id, UseBox);
+            if ((fields & TextDrawFields.Selectable) != 0 && _selectable.HasValue)
+                td.PlayerTextDrawSetSelectable(playerid, Id, Selectable);
+            if ((fields & TextDrawFields.PreviewModel) != 0 && _previewModel.HasValue)
+                td.PlayerTextDrawSetPreviewModel(playerid, Id, PreviewModel);
+            if ((fields & TextDrawFields.PreviewRotation) != 0 && (_previewRotation.HasValue || _previewZoom.HasValue))
+                td.PlayerTextDrawSetPreviewRot(playerid, Id, PreviewRotation.X, PreviewRotation.Y, PreviewRotation.Z,
+                    PreviewZoom);
+            if ((fields & TextDrawFields.PreviewVehicleColor) != 0 &&
+                (_previewPrimaryColor.HasValue || _previewSecondaryColor.HasValue))
+                td.PlayerTextDrawSetPreviewVehCol(playerid, Id, PreviewPrimaryColor, PreviewSecondaryColor);
+            if ((fields & TextDrawFields.Text) != 0)
+                td.PlayerTextDrawSetString(playerid, Id, Text);
+        }
+
         #endregion
     }
 }
\ No newline at end of file
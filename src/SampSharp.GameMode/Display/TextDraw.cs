@@ -16,7 +16,6 @@ using System;
 using System.Collections.Generic;
 using SampSharp.GameMode.Definitions;
 using SampSharp.GameMode.Events;
-using SampSharp.GameMode.Helpers;
 using SampSharp.GameMode.Pools;
 using SampSharp.GameMode.SAMP;
 using SampSharp.GameMode.World;
@@ -26,6 +25,7 @@ namespace SampSharp.GameMode.Display
     /// <summary>
     ///     Represents a textdraw.
     /// </summary>
+    [PoolCapacity(Max)]
     public partial class TextDraw : IdentifiedPool<TextDraw>
     {
         /// <summary>
@@ -63,11 +63,13 @@ namespace SampSharp.GameMode.Display
 
         #region Fields
 
+        private static readonly List<TextDraw> RetainedChanges = new List<TextDraw>();
         private readonly List<BasePlayer> _playersShownTo = new List<BasePlayer>();
 
         private TextDrawAlignment? _alignment;
         private Color? _backColor;
         private Color? _boxColor;
+        private TextDrawFields _dirty;
         private TextDrawFont? _font;
         private Color? _foreColor;
         private float? _height;
@@ -83,6 +85,7 @@ namespace SampSharp.GameMode.Display
         private bool? _selectable;
         private int? _shadow;
         private string _text;
+        private bool _isRetained;
         private bool? _useBox;
         private float? _width;
 
@@ -142,6 +145,21 @@ namespace SampSharp.GameMode.Display
         /// </summary>
         public bool IsApplyFixes { get; set; }
 
+        /// <summary>
+        ///     Gets or sets whether changes to the properties of this textdraw are retained until the end of the tick.
+        ///     When retained, the changes are applied at once and the textdraw is shown again only once to every player
+        ///     it is shown to. Use <see cref="Flush" /> to apply the changes earlier.
+        /// </summary>
+        public bool IsRetained
+        {
+            get { return _isRetained; }
+            set
+            {
+                _isRetained = value;
+                if (!value) Flush();
+            }
+        }
+
         /// <summary>
         ///     Gets or sets the <see cref="TextDrawAlignment" /> of this textdraw.
         /// </summary>
@@ -151,9 +169,7 @@ namespace SampSharp.GameMode.Display
             set
             {
                 _alignment = value;
-                if (Id == -1) return;
-                TextDrawInternal.Instance.TextDrawAlignment(Id, (int) value);
-                UpdateClients();
+                Invalidate(TextDrawFields.Alignment);
             }
         }
 
@@ -166,9 +182,7 @@ namespace SampSharp.GameMode.Display
             set
             {
                 _backColor = value;
-                if (Id == -1) return;
-                TextDrawInternal.Instance.TextDrawBackgroundColor(Id, value);
-                UpdateClients();
+                Invalidate(TextDrawFields.BackColor);
             }
         }
 
@@ -181,9 +195,7 @@ namespace SampSharp.GameMode.Display
             set
             {
                 _foreColor = value;
-                if (Id == -1) return;
-                TextDrawInternal.Instance.TextDrawColor(Id, value);
-                UpdateClients();
+                Invalidate(TextDrawFields.ForeColor);
             }
         }
 
@@ -196,9 +208,7 @@ namespace SampSharp.GameMode.Display
             set
             {
                 _boxColor = value;
-                if (Id == -1) return;
-                TextDrawInternal.Instance.TextDrawBoxColor(Id, value);
-                UpdateClients();
+                Invalidate(TextDrawFields.BoxColor);
             }
         }
 
@@ -211,9 +221,7 @@ namespace SampSharp.GameMode.Display
             set
             {
                 _font = value;
-                if (Id == -1) return;
-                TextDrawInternal.Instance.TextDrawFont(Id, (int) value);
-                UpdateClients();
+                Invalidate(TextDrawFields.Font);
             }
         }
 
@@ -227,9 +235,7 @@ namespace SampSharp.GameMode.Display
             set
             {
                 _letterSize = value;
-                if (Id == -1) return;
-                TextDrawInternal.Instance.TextDrawLetterSize(Id, value.X, value.Y);
-                UpdateClients();
+                Invalidate(TextDrawFields.LetterSize);
             }
         }
 
@@ -242,9 +248,7 @@ namespace SampSharp.GameMode.Display
             set
             {
                 _outline = value;
-                if (Id == -1) return;
-                TextDrawInternal.Instance.TextDrawSetOutline(Id, value);
-                UpdateClients();
+                Invalidate(TextDrawFields.Outline);
             }
         }
 
@@ -257,9 +261,7 @@ namespace SampSharp.GameMode.Display
             set
             {
                 _proportional = value;
-                if (Id == -1) return;
-                TextDrawInternal.Instance.TextDrawSetProportional(Id, value);
-                UpdateClients();
+                Invalidate(TextDrawFields.Proportional);
             }
         }
 
@@ -272,9 +274,7 @@ namespace SampSharp.GameMode.Display
             set
             {
                 _shadow = value;
-                if (Id == -1) return;
-                TextDrawInternal.Instance.TextDrawSetShadow(Id, value);
-                UpdateClients();
+                Invalidate(TextDrawFields.Shadow);
             }
         }
 
@@ -287,9 +287,7 @@ namespace SampSharp.GameMode.Display
             set
             {
                 _text = value;
-                if (Id == -1) return;
-                TextDrawInternal.Instance.TextDrawSetString(Id, value);
-                UpdateClients();
+                Invalidate(TextDrawFields.Text);
             }
         }
 
@@ -302,8 +300,7 @@ namespace SampSharp.GameMode.Display
             set
             {
                 _position = value;
-                if (Id == -1) return;
-                Refresh();
+                Invalidate(TextDrawFields.Position);
             }
         }
 
@@ -316,9 +313,7 @@ namespace SampSharp.GameMode.Display
             set
             {
                 _width = value;
-                if (Id == -1) return;
-                TextDrawInternal.Instance.TextDrawTextSize(Id, value, Height);
-                UpdateClients();
+                Invalidate(TextDrawFields.TextSize);
             }
         }
 
@@ -331,9 +326,7 @@ namespace SampSharp.GameMode.Display
             set
             {
                 _height = value;
-                if (Id == -1) return;
-                TextDrawInternal.Instance.TextDrawTextSize(Id, Width, value);
-                UpdateClients();
+                Invalidate(TextDrawFields.TextSize);
             }
         }
 
@@ -346,9 +339,7 @@ namespace SampSharp.GameMode.Display
             set
             {
                 _useBox = value;
-                if (Id == -1) return;
-                TextDrawInternal.Instance.TextDrawUseBox(Id, value);
-                UpdateClients();
+                Invalidate(TextDrawFields.UseBox);
             }
         }
 
@@ -361,9 +352,7 @@ namespace SampSharp.GameMode.Display
             set
             {
                 _selectable = value;
-                if (Id == -1) return;
-                TextDrawInternal.Instance.TextDrawSetSelectable(Id, value);
-                UpdateClients();
+                Invalidate(TextDrawFields.Selectable);
             }
         }
 
@@ -376,9 +365,7 @@ namespace SampSharp.GameMode.Display
             set
             {
                 _previewModel = value;
-                if (Id == -1) return;
-                TextDrawInternal.Instance.TextDrawSetPreviewModel(Id, value);
-                UpdateClients();
+                Invalidate(TextDrawFields.PreviewModel);
             }
         }
 
@@ -391,9 +378,7 @@ namespace SampSharp.GameMode.Display
             set
             {
                 _previewRotation = value;
-                if (Id == -1) return;
-                TextDrawInternal.Instance.TextDrawSetPreviewRot(Id, value.X, value.Y, value.Z, PreviewZoom);
-                UpdateClients();
+                Invalidate(TextDrawFields.PreviewRotation);
             }
         }
 
@@ -406,9 +391,7 @@ namespace SampSharp.GameMode.Display
             set
             {
                 _previewZoom = value;
-                if (Id == -1) return;
-                TextDrawInternal.Instance.TextDrawSetPreviewRot(Id, PreviewRotation.X, PreviewRotation.Y, PreviewRotation.Z, value);
-                UpdateClients();
+                Invalidate(TextDrawFields.PreviewRotation);
             }
         }
 
@@ -421,9 +404,7 @@ namespace SampSharp.GameMode.Display
             set
             {
                 _previewPrimaryColor = value;
-                if (Id == -1) return;
-                TextDrawInternal.Instance.TextDrawSetPreviewVehCol(Id, value, PreviewSecondaryColor);
-                UpdateClients();
+                Invalidate(TextDrawFields.PreviewVehicleColor);
             }
         }
 
@@ -436,9 +417,7 @@ namespace SampSharp.GameMode.Display
             set
             {
                 _previewSecondaryColor = value;
-                if (Id == -1) return;
-                TextDrawInternal.Instance.TextDrawSetPreviewVehCol(Id, PreviewPrimaryColor, value);
-                UpdateClients();
+                Invalidate(TextDrawFields.PreviewVehicleColor);
             }
         }
 
@@ -467,6 +446,7 @@ namespace SampSharp.GameMode.Display
             AssertNotDisposed();
 
             if (Id == -1) Refresh();
+            else ApplyChanges();
 
             _playersShownTo.Clear();
             _playersShownTo.AddRange(BasePlayer.All);
@@ -485,6 +465,7 @@ namespace SampSharp.GameMode.Display
                 throw new ArgumentNullException(nameof(player));
 
             if (Id == -1) Refresh();
+            else Flush();
 
             if (!_playersShownTo.Contains(player))
                 _playersShownTo.Add(player);
@@ -526,32 +507,21 @@ namespace SampSharp.GameMode.Display
         /// </summary>
         protected virtual void Refresh()
         {
-            if (Id != -1) TextDrawInternal.Instance.TextDrawDestroy(Id);
-            Id = TextDrawInternal.Instance.TextDrawCreate(Position.X, Position.Y, FixString(Text));
-
-            //Reset properties
-            _font.Do(x => Font = x);
-            _alignment.Do(x => Alignment = x);
-            _backColor.Do(x => BackColor = x);
-            _foreColor.Do(x => ForeColor = x);
-            _boxColor.Do(x => BoxColor = x);
-            _letterSize.Do(x => LetterSize = x);
-            _outline.Do(x => Outline = x);
-            _proportional.Do(x => Proportional = x);
-            _shadow.Do(x => Shadow = x);
-            _width.Do(x => Width = x);
-            _height.Do(x => Height = x);
-            _useBox.Do(x => UseBox = x);
-            _selectable.Do(x => Selectable = x);
-            _previewModel.Do(x => PreviewModel = x);
-            _previewRotation.Do(x => PreviewRotation = x);
-            _previewZoom.Do(x => PreviewZoom = x);
-            _previewPrimaryColor.Do(x => PreviewPrimaryColor = x);
-            _previewSecondaryColor.Do(x => PreviewSecondaryColor = x);
-
+            Recreate();
             UpdateClients();
         }
 
+        /// <summary>
+        ///     Applies the retained changes to the properties of this textdraw and updates it on all client's screens.
+        /// </summary>
+        public virtual void Flush()
+        {
+            if ((_dirty & TextDrawFields.Position) != 0)
+                Refresh();
+            else if (ApplyChanges())
+                UpdateClients();
+        }
+
         /// <summary>
         ///     Fixes a string so no SA-MP bugs will occur during application.
         /// </summary>
@@ -581,6 +551,105 @@ namespace SampSharp.GameMode.Display
                 Show(p);
         }
 
+        /// <summary>
+        ///     Applies the retained changes of all textdraws.
+        /// </summary>
+        internal static void FlushRetained()
+        {
+            if (RetainedChanges.Count == 0)
+                return;
+
+            var textDraws = RetainedChanges.ToArray();
+            RetainedChanges.Clear();
+
+            foreach (var textDraw in textDraws)
+                if (!textDraw.IsDisposed)
+                    textDraw.Flush();
+        }
+
+        private void Invalidate(TextDrawFields fields)
+        {
+            if (Id == -1) return;
+
+            if (IsRetained)
+            {
+                if (_dirty == TextDrawFields.None)
+                    RetainedChanges.Add(this);
+
+                _dirty |= fields;
+                return;
+            }
+
+            _dirty |= fields;
+            Flush();
+        }
+
+        private bool ApplyChanges()
+        {
+            var fields = _dirty;
+            _dirty = TextDrawFields.None;
+
+            if (fields == TextDrawFields.None || Id == -1)
+                return false;
+
+            if ((fields & TextDrawFields.Position) != 0)
+                Recreate();
+            else
+                Apply(fields);
+
+            return true;
+        }
+
+        private void Recreate()
+        {
+            if (Id != -1) TextDrawInternal.Instance.TextDrawDestroy(Id);
+            Id = TextDrawInternal.Instance.TextDrawCreate(Position.X, Position.Y, FixString(Text));
+
+            _dirty = TextDrawFields.None;
+
+            //Reset properties
+            Apply(~(TextDrawFields.Text | TextDrawFields.Position));
+        }
+
+        private void Apply(TextDrawFields fields)
+        {
+            var td = TextDrawInternal.Instance;
+
+            if ((fields & TextDrawFields.Font) != 0 && _font.HasValue)
+                td.TextDrawFont(Id, (int) Font);
+            if ((fields & TextDrawFields.Alignment) != 0 && _alignment.HasValue)
+                td.TextDrawAlignment(Id, (int) Alignment);
+            if ((fields & TextDrawFields.BackColor) != 0 && _backColor.HasValue)
+                td.TextDrawBackgroundColor(Id, BackColor);
+            if ((fields & TextDrawFields.ForeColor) != 0 && _foreColor.HasValue)
+                td.TextDrawColor(Id, ForeColor);
+            if ((fields & TextDrawFields.BoxColor) != 0 && _boxColor.HasValue)
+                td.TextDrawBoxColor(Id, BoxColor);
+            if ((fields & TextDrawFields.LetterSize) != 0 && _letterSize.HasValue)
+                td.TextDrawLetterSize(Id, LetterSize.X, LetterSize.Y);
+            if ((fields & TextDrawFields.Outline) != 0 && _outline.HasValue)
+                td.TextDrawSetOutline(Id, Outline);
+            if ((fields & TextDrawFields.Proportional) != 0 && _proportional.HasValue)
+                td.TextDrawSetProportional(Id, Proportional);
+            if ((fields & TextDrawFields.Shadow) != 0 && _shadow.HasValue)
+                td.TextDrawSetShadow(Id, Shadow);
+            if ((fields & TextDrawFields.TextSize) != 0 && (_width.HasValue || _height.HasValue))
+                td.TextDrawTextSize(Id, Width, Height);
+            if ((fields & TextDrawFields.UseBox) != 0 && _useBox.HasValue)
+                td.TextDrawUseBox(Id, UseBox);
+            if ((fields & TextDrawFields.Selectable) != 0 && _selectable.HasValue)
+                td.TextDrawSetSelectable(Id, Selectable);
+            if ((fields & TextDrawFields.PreviewModel) != 0 && _previewModel.HasValue)
+                td.TextDrawSetPreviewModel(Id, PreviewModel);
+            if ((fields & TextDrawFields.PreviewRotation) != 0 && (_previewRotation.HasValue || _previewZoom.HasValue))
+                td.TextDrawSetPreviewRot(Id, PreviewRotation.X, PreviewRotation.Y, PreviewRotation.Z, PreviewZoom);
+            if ((fields & TextDrawFields.PreviewVehicleColor) != 0 &&
+                (_previewPrimaryColor.HasValue || _previewSecondaryColor.HasValue))
+                td.TextDrawSetPreviewVehCol(Id, PreviewPrimaryColor, PreviewSecondaryColor);
+            if ((fields & TextDrawFields.Text) != 0)
+                td.TextDrawSetString(Id, Text);
+        }
+
         #endregion
     }
 }
\ No newline at end of file
@@ -0,0 +1,48 @@
+﻿// SampSharp
+// Copyright 2017 Tim Potze
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//     http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+using System;
+
+namespace SampSharp.GameMode.Display
+{
+    /// <summary>
+    ///     Contains the properties of a textdraw which are applied by a single native.
+    /// </summary>
+    [Flags]
+    internal enum TextDrawFields
+    {
+        None = 0,
+        Font = 1 << 0,
+        Alignment = 1 << 1,
+        BackColor = 1 << 2,
+        ForeColor = 1 << 3,
+        BoxColor = 1 << 4,
+        LetterSize = 1 << 5,
+        Outline = 1 << 6,
+        Proportional = 1 << 7,
+        Shadow = 1 << 8,
+        TextSize = 1 << 9,
+        UseBox = 1 << 10,
+        Selectable = 1 << 11,
+        PreviewModel = 1 << 12,
+        PreviewRotation = 1 << 13,
+        PreviewVehicleColor = 1 << 14,
+        Text = 1 << 15,
+
+        /// <summary>
+        ///     The position can only be changed by recreating the textdraw.
+        /// </summary>
+        Position = 1 << 16
+    }
+}
\ No newline at end of file
@@ -50,5 +50,12 @@ namespace SampSharp.GameMode.Events
         ///     The old keys.
         /// </value>
         public Keys OldKeys { get; private set; }
+
+        internal KeyStateChangedEventArgs Reset(Keys newKeys, Keys oldKeys)
+        {
+            NewKeys = newKeys;
+            OldKeys = oldKeys;
+            return this;
+        }
     }
 }
\ No newline at end of file
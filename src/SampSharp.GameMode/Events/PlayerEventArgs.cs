@@ -38,6 +38,12 @@ namespace SampSharp.GameMode.Events
         /// <summary>
         ///     Gets the player involved.
         /// </summary>
-        public BasePlayer Player { get; private set; }
+        public BasePlayer Player { get; internal set; }
+
+        internal PlayerEventArgs Reset(BasePlayer player)
+        {
+            Player = player;
+            return this;
+        }
     }
 }
\ No newline at end of file
@@ -26,5 +26,11 @@ namespace SampSharp.GameMode.Events
         ///     Gets or sets whether to stop syncing the update to other players.
         /// </summary>
         public bool PreventPropagation { get; set; }
+
+        internal PlayerUpdateEventArgs Reset()
+        {
+            PreventPropagation = false;
+            return this;
+        }
     }
 }
\ No newline at end of file
@@ -57,5 +57,16 @@ namespace SampSharp.GameMode.Events
         ///     Gets or sets whether to stop the vehicle syncing its position to other players.
         /// </summary>
         public bool PreventPropagation { get; set; }
+
+        internal UnoccupiedVehicleEventArgs Reset(BasePlayer player, int passengerSeat, Vector3 newPosition,
+            Vector3 newVelocity)
+        {
+            Player = player;
+            PassengerSeat = passengerSeat;
+            NewPosition = newPosition;
+            NewVelocity = newVelocity;
+            PreventPropagation = false;
+            return this;
+        }
     }
 }
\ No newline at end of file
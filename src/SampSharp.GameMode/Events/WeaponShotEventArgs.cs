@@ -56,5 +56,15 @@ namespace SampSharp.GameMode.Events
         ///     Gets or sets whether the bullets should be prevented from causing damage.
         /// </summary>
         public bool PreventDamage { get; set; }
+
+        internal WeaponShotEventArgs Reset(Weapon weapon, BulletHitType hittype, int hitid, Vector3 position)
+        {
+            Position = position;
+            Weapon = weapon;
+            BulletHitType = hittype;
+            HitId = hitid;
+            PreventDamage = false;
+            return this;
+        }
     }
 }
\ No newline at end of file
@@ -33,5 +33,7 @@ namespace SampSharp.GameMode
                 }
             }
         }
+
+        public static string TypeCacheDirectory => Server.Config.Get("typecache", "gamemode/typecache");
     }
 }
\ No newline at end of file
@@ -29,11 +29,25 @@ namespace SampSharp.GameMode.Pools
         where TInstance : IdentifiedOwnedPool<TInstance, TOwner>
         where TOwner : class, IIdentifiable
     {
-        private static readonly PoolContainer<TInstance> UnownedContainer = new PoolContainer<TInstance>();
+        // ReSharper disable once StaticMemberInGenericType
+        private static readonly int Capacity = PoolCapacityAttribute.GetCapacity(typeof (TInstance));
+
+        private static readonly PoolContainer<TInstance> UnownedContainer = new PoolContainer<TInstance>(Capacity);
+
+        // The containers of owners are stored at the id of the owner. Owners of which the slot is unavailable are
+        // stored in the Containers dictionary instead.
+        private static readonly TOwner[] SlotOwners = new TOwner[PoolCapacityAttribute.GetCapacity(typeof (TOwner))];
+
+        private static readonly PoolContainer<TInstance>[] SlotContainers =
+            new PoolContainer<TInstance>[SlotOwners.Length];
 
         private static readonly Dictionary<TOwner, PoolContainer<TInstance>> Containers =
             new Dictionary<TOwner, PoolContainer<TInstance>>();
 
+        // All containers, including the unowned container, for enumerating all instances.
+        private static readonly List<PoolContainer<TInstance>> AllContainers =
+            new List<PoolContainer<TInstance>> {UnownedContainer};
+
         private int _id;
         private TOwner _owner;
 
@@ -53,10 +67,10 @@ namespace SampSharp.GameMode.Pools
         protected static Type InstanceType { get; private set; }
 
         /// <summary>
-        ///     Gets a collection containing all instances.
+        ///     Gets a live collection containing all instances. Use <see cref="PoolCollection{TInstance}.Snapshot" /> when
+        ///     the pool is modified while iterating.
         /// </summary>
-        public static IEnumerable<TInstance> All
-            => Containers.SelectMany(c => c.Value).Concat(UnownedContainer).ToArray();
+        public static PoolCollection<TInstance> All => new PoolCollection<TInstance>(AllContainers);
 
         /// <summary>
         ///     Gets the identifier of this instance.
@@ -96,13 +110,15 @@ namespace SampSharp.GameMode.Pools
                 }
                 else
                 {
+                    var pool = GetPool(_owner, false);
+
                     if (_id == PoolContainer<TInstance>.UnidentifiedId)
-                        Containers[_owner].RemoveUnidentified((TInstance) this);
+                        pool.RemoveUnidentified((TInstance) this);
                     else
-                        Containers[_owner].Remove(_id);
+                        pool.Remove(_id);
 
-                    if (!Containers[_owner].Any())
-                        Containers.Remove(_owner);
+                    if (pool.Count == 0)
+                        RemovePool(_owner, pool);
                 }
 
                 GetPool(value).Add(_id, (TInstance) this);
@@ -115,13 +131,48 @@ namespace SampSharp.GameMode.Pools
         {
             if (owner == null) return UnownedContainer;
 
+            var id = owner.Id;
+            var hasSlot = (uint) id < (uint) SlotOwners.Length;
+            if (hasSlot && SlotOwners[id] == owner)
+                return SlotContainers[id];
+
             PoolContainer<TInstance> pool;
-            if (!Containers.TryGetValue(owner, out pool) && createIfNotExists)
-                pool = Containers[owner] = new PoolContainer<TInstance>();
+            if (Containers.Count > 0 && Containers.TryGetValue(owner, out pool))
+                return pool;
+
+            if (!createIfNotExists)
+                return null;
+
+            pool = new PoolContainer<TInstance>(Capacity);
+            AllContainers.Add(pool);
+
+            if (hasSlot && SlotOwners[id] == null)
+            {
+                SlotOwners[id] = owner;
+                SlotContainers[id] = pool;
+            }
+            else
+                Containers[owner] = pool;
 
             return pool;
         }
 
+        private static void RemovePool(TOwner owner, PoolContainer<TInstance> pool)
+        {
+            if (owner == null) return;
+
+            AllContainers.Remove(pool);
+
+            var id = owner.Id;
+            if ((uint) id < (uint) SlotOwners.Length && SlotOwners[id] == owner)
+            {
+                SlotOwners[id] = null;
+                SlotContainers[id] = null;
+            }
+            else
+                Containers.Remove(owner);
+        }
+
         /// <summary>
         ///     Removes this instance from the pool.
         /// </summary>
@@ -135,8 +186,8 @@ namespace SampSharp.GameMode.Pools
             else
                 pool.Remove(_id);
 
-            if (_id != PoolContainer<TInstance>.UnidentifiedId && !pool.Any())
-                Containers.Remove(_owner);
+            if (_id != PoolContainer<TInstance>.UnidentifiedId && pool.Count == 0)
+                RemovePool(_owner, pool);
         }
 
         /// <summary>
@@ -164,7 +215,7 @@ namespace SampSharp.GameMode.Pools
         /// <returns>All instances of the given type within this <see cref="IdentifiedOwnedPool{TInstance,TOwner}" />.</returns>
         public static IEnumerable<T2> GetAll<T2>()
         {
-            return All.OfType<T2>();
+            return All.Snapshot().OfType<T2>();
         }
 
         /// <summary>
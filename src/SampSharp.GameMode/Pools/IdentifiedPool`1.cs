@@ -27,7 +27,11 @@ namespace SampSharp.GameMode.Pools
     public abstract class IdentifiedPool<TInstance> : Disposable, IIdentifiable
         where TInstance : IdentifiedPool<TInstance>
     {
-        private static readonly PoolContainer<TInstance> Container = new PoolContainer<TInstance>();
+        private static readonly PoolContainer<TInstance> Container =
+            new PoolContainer<TInstance>(PoolCapacityAttribute.GetCapacity(typeof (TInstance)));
+
+        private static readonly List<PoolContainer<TInstance>> Containers =
+            new List<PoolContainer<TInstance>> {Container};
         private int _id;
 
 
@@ -47,9 +51,10 @@ namespace SampSharp.GameMode.Pools
         public static Type InstanceType { get; private set; }
 
         /// <summary>
-        ///     Gets a collection containing all instances.
+        ///     Gets a live collection containing all instances. Use <see cref="PoolCollection{TInstance}.Snapshot" /> when
+        ///     the pool is modified while iterating.
         /// </summary>
-        public static IEnumerable<TInstance> All => Container.ToArray();
+        public static PoolCollection<TInstance> All => new PoolCollection<TInstance>(Containers);
 
         /// <summary>
         ///     Gets the identifier of this instance.
@@ -99,7 +104,7 @@ namespace SampSharp.GameMode.Pools
         /// <returns>All instances of the given type within this <see cref="IdentifiedPool{T}" />.</returns>
         public static IEnumerable<T2> GetAll<T2>()
         {
-            return All.OfType<T2>();
+            return All.Snapshot().OfType<T2>();
         }
 
         /// <summary>
@@ -0,0 +1,52 @@
+﻿// SampSharp
+// Copyright 2017 Tim Potze
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//     http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+using System;
+
+namespace SampSharp.GameMode.Pools
+{
+    /// <summary>
+    ///     Indicates the number of identifiers available to the pooled type. Instances with an identifier below the
+    ///     capacity are stored in an array indexed by their identifier.
+    /// </summary>
+    /// <seealso cref="System.Attribute" />
+    [AttributeUsage(AttributeTargets.Class)]
+    public class PoolCapacityAttribute : Attribute
+    {
+        /// <summary>
+        ///     Initializes a new instance of the <see cref="PoolCapacityAttribute" /> class.
+        /// </summary>
+        /// <param name="capacity">The capacity.</param>
+        public PoolCapacityAttribute(int capacity)
+        {
+            Capacity = capacity;
+        }
+
+        /// <summary>
+        ///     Gets the capacity.
+        /// </summary>
+        public int Capacity { get; }
+
+        /// <summary>
+        ///     Gets the capacity of the specified pooled type, or 0 if the type has no <see cref="PoolCapacityAttribute" />.
+        /// </summary>
+        /// <param name="type">The pooled type.</param>
+        /// <returns>The capacity of the specified type.</returns>
+        internal static int GetCapacity(Type type)
+        {
+            var attribute = (PoolCapacityAttribute) GetCustomAttribute(type, typeof (PoolCapacityAttribute));
+            return attribute?.Capacity ?? 0;
+        }
+    }
+}
\ No newline at end of file
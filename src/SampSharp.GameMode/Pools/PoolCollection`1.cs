@@ -0,0 +1,166 @@
+﻿// SampSharp
+// Copyright 2017 Tim Potze
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//     http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+using System;
+using System.Collections;
+using System.Collections.Generic;
+
+namespace SampSharp.GameMode.Pools
+{
+    /// <summary>
+    ///     Represents a live view of the instances in one or more <see cref="PoolContainer{TInstance}" /> instances. The view
+    ///     enumerates the containers directly; modifying the pool during the enumeration throws an
+    ///     <see cref="InvalidOperationException" />. Use <see cref="Snapshot" /> to iterate over a copy instead.
+    /// </summary>
+    /// <typeparam name="TInstance">The type of the instance.</typeparam>
+    public struct PoolCollection<TInstance> : IReadOnlyCollection<TInstance> where TInstance : class
+    {
+        private readonly List<PoolContainer<TInstance>> _containers;
+
+        internal PoolCollection(List<PoolContainer<TInstance>> containers)
+        {
+            _containers = containers;
+        }
+
+        /// <summary>
+        ///     Gets the number of instances in this collection.
+        /// </summary>
+        public int Count
+        {
+            get
+            {
+                var count = 0;
+                foreach (var container in _containers)
+                    count += container.Count;
+                return count;
+            }
+        }
+
+        /// <summary>
+        ///     Copies the instances in this collection to a new array.
+        /// </summary>
+        /// <returns>An array containing the instances in this collection.</returns>
+        public TInstance[] Snapshot()
+        {
+            var result = new TInstance[Count];
+            var index = 0;
+            foreach (var instance in this)
+                result[index++] = instance;
+            return result;
+        }
+
+        /// <summary>
+        ///     Returns an enumerator that iterates through the collection.
+        /// </summary>
+        /// <returns>
+        ///     An <see cref="Enumerator" /> that can be used to iterate through the collection.
+        /// </returns>
+        public Enumerator GetEnumerator()
+        {
+            return new Enumerator(_containers);
+        }
+
+        /// <summary>
+        ///     Returns an enumerator that iterates through the collection.
+        /// </summary>
+        /// <returns>
+        ///     A <see cref="T:System.Collections.Generic.IEnumerator`1" /> that can be used to iterate through the collection.
+        /// </returns>
+        IEnumerator<TInstance> IEnumerable<TInstance>.GetEnumerator()
+        {
+            return GetEnumerator();
+        }
+
+        /// <summary>
+        ///     Returns an enumerator that iterates through a collection.
+        /// </summary>
+        /// <returns>
+        ///     An <see cref="T:System.Collections.IEnumerator" /> object that can be used to iterate through the collection.
+        /// </returns>
+        IEnumerator IEnumerable.GetEnumerator()
+        {
+            return GetEnumerator();
+        }
+
+        /// <summary>
+        ///     Enumerates the instances of a <see cref="PoolCollection{TInstance}" /> without copying them.
+        /// </summary>
+        public struct Enumerator : IEnumerator<TInstance>
+        {
+            private readonly List<PoolContainer<TInstance>> _list;
+            private List<PoolContainer<TInstance>>.Enumerator _containers;
+            private PoolContainer<TInstance>.Enumerator _items;
+            private bool _hasItems;
+
+            internal Enumerator(List<PoolContainer<TInstance>> containers)
+            {
+                _list = containers;
+                _containers = containers.GetEnumerator();
+                _items = default(PoolContainer<TInstance>.Enumerator);
+                _hasItems = false;
+            }
+
+            /// <summary>
+            ///     Gets the element in the collection at the current position of the enumerator.
+            /// </summary>
+            public TInstance Current => _hasItems ? _items.Current : null;
+
+            /// <summary>
+            ///     Gets the element in the collection at the current position of the enumerator.
+            /// </summary>
+            object IEnumerator.Current => Current;
+
+            /// <summary>
+            ///     Advances the enumerator to the next element of the collection.
+            /// </summary>
+            /// <returns>
+            ///     true if the enumerator was successfully advanced to the next element; false if the enumerator has passed the
+            ///     end of the collection.
+            /// </returns>
+            /// <exception cref="InvalidOperationException">Thrown if the collection was modified.</exception>
+            public bool MoveNext()
+            {
+                while (true)
+                {
+                    if (_hasItems && _items.MoveNext())
+                        return true;
+
+                    if (!_containers.MoveNext())
+                    {
+                        _hasItems = false;
+                        return false;
+                    }
+
+                    _items = _containers.Current.GetEnumerator();
+                    _hasItems = true;
+                }
+            }
+
+            /// <summary>
+            ///     Sets the enumerator to its initial position, which is before the first element in the collection.
+            /// </summary>
+            public void Reset()
+            {
+                this = new Enumerator(_list);
+            }
+
+            /// <summary>
+            ///     Performs application-defined tasks associated with freeing, releasing, or resetting unmanaged resources.
+            /// </summary>
+            public void Dispose()
+            {
+            }
+        }
+    }
+}
\ No newline at end of file
@@ -20,7 +20,8 @@ using System.Linq;
 namespace SampSharp.GameMode.Pools
 {
     /// <summary>
-    ///     Represents the contents of a pool.
+    ///     Represents the contents of a pool. Identified items with a key below the capacity of the container are stored in
+    ///     an array indexed by their key; other identified items are stored in a dictionary.
     /// </summary>
     /// <typeparam name="TInstance">The type of the instance.</typeparam>
     public sealed class PoolContainer<TInstance> : IEnumerable<TInstance> where TInstance : class
@@ -30,23 +31,79 @@ namespace SampSharp.GameMode.Pools
         /// </summary>
         public const int UnidentifiedId = -1;
 
+        private static readonly int[] DeBruijnPositions =
+        {
+            0, 1, 2, 53, 3, 7, 54, 27, 4, 38, 41, 8, 34, 55, 48, 28, 62, 5, 39, 46, 44, 42, 22, 9, 24, 35, 59, 56, 49, 18,
+            29, 11, 63, 52, 6, 26, 37, 40, 33, 47, 61, 45, 43, 21, 23, 58, 17, 10, 51, 25, 36, 32, 60, 20, 57, 16, 50, 31,
+            19, 15, 30, 14, 13, 12
+        };
+
         private readonly Dictionary<int, TInstance> _identifiedItems = new Dictionary<int, TInstance>();
         private readonly List<TInstance> _unidentifiedItems = new List<TInstance>();
+        private readonly TInstance[] _slots;
+        private readonly ulong[] _occupied;
+        private int _slotCount;
+        private int _version;
+
+        /// <summary>
+        ///     Initializes a new instance of the <see cref="PoolContainer{TInstance}" /> class which stores all identified
+        ///     items in a dictionary.
+        /// </summary>
+        public PoolContainer() : this(0)
+        {
+        }
+
+        /// <summary>
+        ///     Initializes a new instance of the <see cref="PoolContainer{TInstance}" /> class.
+        /// </summary>
+        /// <param name="capacity">
+        ///     The number of keys, starting at 0, of which the items are stored in an array. Items with other keys are stored
+        ///     in a dictionary.
+        /// </param>
+        /// <exception cref="System.ArgumentOutOfRangeException">Thrown if capacity is negative.</exception>
+        public PoolContainer(int capacity)
+        {
+            if (capacity < 0) throw new ArgumentOutOfRangeException(nameof(capacity));
+
+            _slots = new TInstance[capacity];
+            _occupied = new ulong[(capacity + 63)/64];
+        }
+
+        /// <summary>
+        ///     Gets the number of keys of which the items are stored in an array.
+        /// </summary>
+        public int Capacity => _slots.Length;
+
+        /// <summary>
+        ///     Gets the number of identified and unidentified items in this container.
+        /// </summary>
+        public int Count => _slotCount + _identifiedItems.Count + _unidentifiedItems.Count;
 
         /// <summary>
         ///     Gets the unidentified items.
         /// </summary>
         public IEnumerable<TInstance> UnidentifiedItems => _unidentifiedItems.AsReadOnly();
 
+        /// <summary>
+        ///     Returns an enumerator that iterates through the collection.
+        /// </summary>
+        /// <returns>
+        ///     An <see cref="Enumerator" /> that can be used to iterate through the collection.
+        /// </returns>
+        public Enumerator GetEnumerator()
+        {
+            return new Enumerator(this);
+        }
+
         /// <summary>
         ///     Returns an enumerator that iterates through the collection.
         /// </summary>
         /// <returns>
         ///     A <see cref="T:System.Collections.Generic.IEnumerator`1" /> that can be used to iterate through the collection.
         /// </returns>
-        public IEnumerator<TInstance> GetEnumerator()
+        IEnumerator<TInstance> IEnumerable<TInstance>.GetEnumerator()
         {
-            return _identifiedItems.Values.Concat(_unidentifiedItems).GetEnumerator();
+            return GetEnumerator();
         }
 
         /// <summary>
@@ -69,12 +126,24 @@ namespace SampSharp.GameMode.Pools
         public void Add(int key, TInstance item)
         {
             if (key == UnidentifiedId)
+            {
                 _unidentifiedItems.Add(item);
+                _version++;
+            }
             else
             {
-                if (_identifiedItems.ContainsKey(key)) throw new ArgumentException("duplicate key", nameof(key));
+                if (Contains(key)) throw new ArgumentException("duplicate key", nameof(key));
+
+                if ((uint) key < (uint) _slots.Length)
+                {
+                    _slots[key] = item;
+                    _occupied[key >> 6] |= 1UL << key;
+                    _slotCount++;
+                }
+                else
+                    _identifiedItems.Add(key, item);
 
-                _identifiedItems.Add(key, item);
+                _version++;
             }
         }
 
@@ -85,6 +154,7 @@ namespace SampSharp.GameMode.Pools
         /// <returns>The item associated with the specified key</returns>
         public TInstance Get(int key)
         {
+            if ((uint) key < (uint) _slots.Length) return _slots[key];
             if (key == UnidentifiedId) return _unidentifiedItems.FirstOrDefault();
 
             TInstance result;
@@ -99,7 +169,21 @@ namespace SampSharp.GameMode.Pools
         /// <returns>True on success; False otherwise.</returns>
         public bool Remove(int key)
         {
-            return _identifiedItems.Remove(key);
+            if ((uint) key >= (uint) _slots.Length)
+            {
+                if (!_identifiedItems.Remove(key)) return false;
+            }
+            else
+            {
+                if (_slots[key] == null) return false;
+
+                _slots[key] = null;
+                _occupied[key >> 6] &= ~(1UL << key);
+                _slotCount--;
+            }
+
+            _version++;
+            return true;
         }
 
         /// <summary>
@@ -111,7 +195,10 @@ namespace SampSharp.GameMode.Pools
         {
             if (item == null) return false;
 
-            return _unidentifiedItems.Remove(item);
+            if (!_unidentifiedItems.Remove(item)) return false;
+
+            _version++;
+            return true;
         }
 
         /// <summary>
@@ -157,7 +244,7 @@ namespace SampSharp.GameMode.Pools
         /// <returns>True if the specified key exists; False otherwise.</returns>
         public bool Contains(int key)
         {
-            return _identifiedItems.ContainsKey(key);
+            return (uint) key < (uint) _slots.Length ? _slots[key] != null : _identifiedItems.ContainsKey(key);
         }
 
         /// <summary>
@@ -169,5 +256,120 @@ namespace SampSharp.GameMode.Pools
         {
             return _unidentifiedItems.Contains(item);
         }
+
+        /// <summary>
+        ///     Enumerates the items of a <see cref="PoolContainer{TInstance}" /> without copying them. The enumerator throws
+        ///     an <see cref="InvalidOperationException" /> if the container is modified during the enumeration.
+        /// </summary>
+        public struct Enumerator : IEnumerator<TInstance>
+        {
+            private readonly PoolContainer<TInstance> _container;
+            private readonly int _version;
+            private int _stage;
+            private int _word;
+            private ulong _bits;
+            private Dictionary<int, TInstance>.ValueCollection.Enumerator _identifiedItems;
+            private List<TInstance>.Enumerator _unidentifiedItems;
+            private TInstance _current;
+
+            internal Enumerator(PoolContainer<TInstance> container)
+            {
+                _container = container;
+                _version = container._version;
+                _stage = 0;
+                _word = -1;
+                _bits = 0;
+                _identifiedItems = container._identifiedItems.Values.GetEnumerator();
+                _unidentifiedItems = container._unidentifiedItems.GetEnumerator();
+                _current = null;
+            }
+
+            /// <summary>
+            ///     Gets the element in the collection at the current position of the enumerator.
+            /// </summary>
+            public TInstance Current => _current;
+
+            /// <summary>
+            ///     Gets the element in the collection at the current position of the enumerator.
+            /// </summary>
+            object IEnumerator.Current => Current;
+
+            /// <summary>
+            ///     Advances the enumerator to the next element of the collection.
+            /// </summary>
+            /// <returns>
+            ///     true if the enumerator was successfully advanced to the next element; false if the enumerator has passed the
+            ///     end of the collection.
+            /// </returns>
+            /// <exception cref="InvalidOperationException">Thrown if the collection was modified.</exception>
+            public bool MoveNext()
+            {
+                if (_version != _container._version)
+                    throw new InvalidOperationException("Collection was modified; enumeration operation may not execute.");
+
+                switch (_stage)
+                {
+                    case 0:
+                        // Walk the set bits of the occupancy bitset to find the items stored in the array.
+                        while (_bits == 0)
+                        {
+                            if (++_word >= _container._occupied.Length)
+                            {
+                                _stage = 1;
+                                goto case 1;
+                            }
+
+                            _bits = _container._occupied[_word];
+                        }
+
+                        var lowestBit = _bits & (ulong) -(long) _bits;
+                        _bits ^= lowestBit;
+
+                        _current =
+                            _container._slots[_word*64 + DeBruijnPositions[(lowestBit*0x022FDD63CC95386DUL) >> 58]];
+                        return true;
+                    case 1:
+                        if (_identifiedItems.MoveNext())
+                        {
+                            _current = _identifiedItems.Current;
+                            return true;
+                        }
+
+                        _stage = 2;
+                        goto case 2;
+                    case 2:
+                        if (_unidentifiedItems.MoveNext())
+                        {
+                            _current = _unidentifiedItems.Current;
+                            return true;
+                        }
+
+                        _stage = 3;
+                        _current = null;
+                        return false;
+                    default:
+                        return false;
+                }
+            }
+
+            /// <summary>
+            ///     Sets the enumerator to its initial position, which is before the first element in the collection.
+            /// </summary>
+            /// <exception cref="InvalidOperationException">Thrown if the collection was modified.</exception>
+            public void Reset()
+            {
+                if (_version != _container._version)
+                    throw new InvalidOperationException("Collection was modified; enumeration operation may not execute.");
+
+                this = new Enumerator(_container);
+            }
+
+            /// <summary>
+            ///     Performs application-defined tasks associated with freeing, releasing, or resetting unmanaged resources.
+            /// </summary>
+            public void Dispose()
+            {
+            }
+        }
     }
 }
\ No newline at end of file
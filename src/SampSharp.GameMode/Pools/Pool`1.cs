@@ -13,6 +13,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 using System;
+using System.Collections;
 using System.Collections.Generic;
 using System.Collections.ObjectModel;
 using System.Linq;
@@ -49,18 +50,10 @@ namespace SampSharp.GameMode.Pools
         }
 
         /// <summary>
-        ///     Gets a <see cref="IEnumerable{T}" /> containing all instances of type.
+        ///     Gets a live collection containing all instances of type. Use <see cref="Collection.Snapshot" /> when the pool
+        ///     is modified while iterating or when iterating from a thread other than the main thread.
         /// </summary>
-        public static IEnumerable<TInstance> All
-        {
-            get
-            {
-                lock (Lock)
-                {
-                    return Instances.OfType<TInstance>().ToArray();
-                }
-            }
-        }
+        public static Collection All => new Collection();
 
         /// <summary>
         ///     Removes this instance from the pool.
@@ -99,5 +92,134 @@ namespace SampSharp.GameMode.Pools
                 return Instances.OfType<T2>().ToList().AsReadOnly();
             }
         }
+
+        /// <summary>
+        ///     Represents a live view of the instances in a <see cref="Pool{TInstance}" />. Modifying the pool during the
+        ///     enumeration throws an <see cref="InvalidOperationException" />.
+        /// </summary>
+        public struct Collection : IReadOnlyCollection<TInstance>
+        {
+            /// <summary>
+            ///     Gets the number of instances in this collection.
+            /// </summary>
+            public int Count
+            {
+                get
+                {
+                    lock (Lock)
+                    {
+                        return Instances.Count;
+                    }
+                }
+            }
+
+            /// <summary>
+            ///     Copies the instances in this collection to a new array while holding the lock of the pool.
+            /// </summary>
+            /// <returns>An array containing the instances in this collection.</returns>
+            public TInstance[] Snapshot()
+            {
+                lock (Lock)
+                {
+                    return Instances.OfType<TInstance>().ToArray();
+                }
+            }
+
+            /// <summary>
+            ///     Returns an enumerator that iterates through the collection.
+            /// </summary>
+            /// <returns>
+            ///     An <see cref="Enumerator" /> that can be used to iterate through the collection.
+            /// </returns>
+            public Enumerator GetEnumerator()
+            {
+                return new Enumerator(Instances.GetEnumerator());
+            }
+
+            /// <summary>
+            ///     Returns an enumerator that iterates through the collection.
+            /// </summary>
+            /// <returns>
+            ///     A <see cref="T:System.Collections.Generic.IEnumerator`1" /> that can be used to iterate through the
+            ///     collection.
+            /// </returns>
+            IEnumerator<TInstance> IEnumerable<TInstance>.GetEnumerator()
+            {
+                return GetEnumerator();
+            }
+
+            /// <summary>
+            ///     Returns an enumerator that iterates through a collection.
+            /// </summary>
+            /// <returns>
+            ///     An <see cref="T:System.Collections.IEnumerator" /> object that can be used to iterate through the
+            ///     collection.
+            /// </returns>
+            IEnumerator IEnumerable.GetEnumerator()
+            {
+                return GetEnumerator();
+            }
+        }
+
+        /// <summary>
+        ///     Enumerates the instances of a <see cref="Pool{TInstance}" /> without copying them.
+        /// </summary>
+        public struct Enumerator : IEnumerator<TInstance>
+        {
+            private List<Pool<TInstance>>.Enumerator _instances;
+            private TInstance _current;
+
+            internal Enumerator(List<Pool<TInstance>>.Enumerator instances)
+            {
+                _instances = instances;
+                _current = null;
+            }
+
+            /// <summary>
+            ///     Gets the element in the collection at the current position of the enumerator.
+            /// </summary>
+            public TInstance Current => _current;
+
+            /// <summary>
+            ///     Gets the element in the collection at the current position of the enumerator.
+            /// </summary>
+            object IEnumerator.Current => Current;
+
+            /// <summary>
+            ///     Advances the enumerator to the next element of the collection.
+            /// </summary>
+            /// <returns>
+            ///     true if the enumerator was successfully advanced to the next element; false if the enumerator has passed the
+            ///     end of the collection.
+            /// </returns>
+            /// <exception cref="InvalidOperationException">Thrown if the collection was modified.</exception>
+            public bool MoveNext()
+            {
+                while (_instances.MoveNext())
+                {
+                    _current = _instances.Current as TInstance;
+                    if (_current != null)
+                        return true;
+                }
+
+                return false;
+            }
+
+            /// <summary>
+            ///     Sets the enumerator to its initial position, which is before the first element in the collection.
+            /// </summary>
+            public void Reset()
+            {
+                _instances = Instances.GetEnumerator();
+                _current = null;
+            }
+
+            /// <summary>
+            ///     Performs application-defined tasks associated with freeing, releasing, or resetting unmanaged resources.
+            /// </summary>
+            public void Dispose()
+            {
+            }
+        }
     }
 }
\ No newline at end of file
@@ -67,22 +67,43 @@ namespace SampSharp.GameMode.SAMP.Commands
         /// <returns>true if matches; false otherwise.</returns>
         public bool Matches(string commandText, bool ignoreCase = true)
         {
+            return Matches(commandText, 0, ignoreCase);
+        }
+
+        /// <summary>
+        ///     Matches the command text at the specified offset.
+        /// </summary>
+        /// <param name="commandText">The command text.</param>
+        /// <param name="offset">The offset in the command text.</param>
+        /// <param name="ignoreCase">A value indicating whether to ignore the case of the command.</param>
+        /// <returns>true if matches; false otherwise.</returns>
+        public bool Matches(string commandText, int offset, bool ignoreCase)
+        {
+            var length = commandText.Length - offset;
+
             // The command text is shorter than the full name.
-            if (commandText.Length < Length)
+            if (length < Length)
                 return false;
 
             // The command text is longer than the full name.
-            if (commandText.Length > Length)
+            if (length > Length)
             {
                 // The next character in the command text must be a space.
-                if (commandText[Length] != ' ')
+                if (commandText[offset + Length] != ' ')
+                    return false;
+            }
+
+            // The range of the command text matches the full name.
+            for (var i = 0; i < Length; i++)
+            {
+                var a = commandText[offset + i];
+                var b = FullName[i];
+
+                if (a != b && (!ignoreCase || char.ToLower(a) != char.ToLower(b)))
                     return false;
             }
 
-            // The substring of the command text matches the full name.
-            return ignoreCase
-                ? commandText.Substring(0, Length).ToLower() == FullName.ToLower()
-                : commandText.Substring(0, Length) == FullName;
+            return true;
         }
 
         #region Overrides of ValueType
@@ -0,0 +1,194 @@
+﻿// SampSharp
+// Copyright 2017 Tim Potze
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//     http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+using System;
+using System.Collections.Generic;
+using SampSharp.GameMode.World;
+
+namespace SampSharp.GameMode.SAMP.Commands
+{
+    /// <summary>
+    ///     Represents a router which finds the commands matching a command text using a prefix tree of all command paths.
+    /// </summary>
+    /// <remarks>
+    ///     Every <see cref="DefaultCommand" /> is indexed by the full names of its paths, so finding the candidate
+    ///     commands for a command text costs a single walk over the command word(s) instead of a match against every
+    ///     registered command. Other <see cref="ICommand" /> implementations don't expose their paths, and
+    ///     subclasses of <see cref="DefaultCommand" /> which override <see cref="DefaultCommand.CanInvoke" /> may
+    ///     accept other text; both are considered a candidate for every command text. Candidates are evaluated in
+    ///     order of registration, which resolves ambiguous commands exactly like evaluating every command in order
+    ///     would.
+    /// </remarks>
+    public class CommandRouter
+    {
+        private readonly Node _root = new Node();
+        private readonly List<Entry> _unindexed = new List<Entry>();
+        private readonly List<Entry> _matches = new List<Entry>();
+        private int _count;
+
+        /// <summary>
+        ///     Adds the specified command to this router.
+        /// </summary>
+        /// <param name="command">The command.</param>
+        public void Add(ICommand command)
+        {
+            if (command == null) throw new ArgumentNullException(nameof(command));
+
+            var index = _count++;
+            var defaultCommand = command as DefaultCommand;
+
+            if (defaultCommand?.Names == null || OverridesCanInvoke(defaultCommand))
+            {
+                _unindexed.Add(new Entry(command, index, null, true));
+                return;
+            }
+
+            foreach (var path in defaultCommand.Names)
+            {
+                var node = _root;
+                foreach (var character in path.FullName)
+                {
+                    var key = char.ToUpperInvariant(character);
+
+                    Node child;
+                    if (!node.Children.TryGetValue(key, out child))
+                        node.Children[key] = child = new Node();
+
+                    node = child;
+                }
+
+                node.Entries.Add(new Entry(command, index, path.FullName, defaultCommand.IsCaseIgnored));
+            }
+        }
+
+        /// <summary>
+        ///     Removes all commands from this router.
+        /// </summary>
+        public void Clear()
+        {
+            _root.Children.Clear();
+            _root.Entries.Clear();
+            _unindexed.Clear();
+            _count = 0;
+        }
+
+        /// <summary>
+        ///     Gets the command for the specified command text.
+        /// </summary>
+        /// <param name="player">The player.</param>
+        /// <param name="commandText">The command text.</param>
+        /// <returns>
+        ///     The first command, in order of registration, which can be invoked with the command text; otherwise the
+        ///     last command which optionally can be invoked; otherwise null.
+        /// </returns>
+        public ICommand Find(BasePlayer player, string commandText)
+        {
+            if (commandText == null) throw new ArgumentNullException(nameof(commandText));
+
+            // The matches are collected in a buffer which is reused by every lookup.
+            var matches = _matches;
+            matches.Clear();
+
+            var start = 0;
+            while (start < commandText.Length && commandText[start] == '/')
+                start++;
+
+            // Walk the tree. A path matches if the text ends or continues with a space after the path.
+            var node = _root;
+            for (var i = start;; i++)
+            {
+                if (node.Entries.Count > 0 && (i == commandText.Length || commandText[i] == ' '))
+                    foreach (var entry in node.Entries)
+                        if (entry.IsCaseIgnored ||
+                            string.CompareOrdinal(commandText, start, entry.FullName, 0, entry.FullName.Length) == 0)
+                            matches.Add(entry);
+
+                if (i == commandText.Length ||
+                    !node.Children.TryGetValue(char.ToUpperInvariant(commandText[i]), out node))
+                    break;
+            }
+
+            if (matches.Count > 1)
+                matches.Sort(EntryIndexComparer.Instance);
+
+            // Merge the matches with the unindexed commands, both of which are in order of registration.
+            ICommand candidate = null;
+            ICommand previous = null;
+            for (int u = 0, m = 0; u < _unindexed.Count || m < matches.Count;)
+            {
+                var entry = m == matches.Count || (u < _unindexed.Count && _unindexed[u].Index < matches[m].Index)
+                    ? _unindexed[u++]
+                    : matches[m++];
+
+                // A command with multiple matching paths is only evaluated once.
+                if (entry.Command == previous)
+                    continue;
+                previous = entry.Command;
+
+                switch (entry.Command.CanInvoke(player, commandText))
+                {
+                    case CommandCallableResponse.True:
+                        return entry.Command;
+                    case CommandCallableResponse.Optional:
+                        candidate = entry.Command;
+                        break;
+                }
+            }
+
+            return candidate;
+        }
+
+        private static bool OverridesCanInvoke(DefaultCommand command)
+        {
+            var type = command.GetType();
+            if (type == typeof (DefaultCommand))
+                return false;
+
+            var method = type.GetMethod(nameof(DefaultCommand.CanInvoke), new[] {typeof (BasePlayer), typeof (string)});
+            return method?.DeclaringType != typeof (DefaultCommand);
+        }
+
+        private class Node
+        {
+            public readonly Dictionary<char, Node> Children = new Dictionary<char, Node>();
+            public readonly List<Entry> Entries = new List<Entry>();
+        }
+
+        private struct Entry
+        {
+            public Entry(ICommand command, int index, string fullName, bool isCaseIgnored)
+            {
+                Command = command;
+                Index = index;
+                FullName = fullName;
+                IsCaseIgnored = isCaseIgnored;
+            }
+
+            public readonly ICommand Command;
+            public readonly int Index;
+            public readonly string FullName;
+            public readonly bool IsCaseIgnored;
+        }
+
+        private class EntryIndexComparer : IComparer<Entry>
+        {
+            public static readonly EntryIndexComparer Instance = new EntryIndexComparer();
+
+            public int Compare(Entry x, Entry y)
+            {
+                return x.Index.CompareTo(y.Index);
+            }
+        }
+    }
+}
\ No newline at end of file
@@ -28,6 +28,7 @@ namespace SampSharp.GameMode.SAMP.Commands
     {
         private static readonly Type[] SupportedReturnTypes = {typeof (bool), typeof (void)};
         private readonly List<ICommand> _commands = new List<ICommand>();
+        private readonly CommandRouter _router = new CommandRouter();
 
         /// <summary>
         /// Initializes a new instance of the <see cref="CommandsManager"/> class.
@@ -184,21 +185,7 @@ namespace SampSharp.GameMode.SAMP.Commands
         /// <returns>The found command.</returns>
         public ICommand GetCommandForText(BasePlayer player, string commandText)
         {
-            ICommand candidate = null;
-
-            foreach (var command in _commands)
-            {
-                switch (command.CanInvoke(player, commandText))
-                {
-                    case CommandCallableResponse.True:
-                        return command;
-                    case CommandCallableResponse.Optional:
-                        candidate = command;
-                        break;
-                }
-            }
-
-            return candidate;
+            return _router.Find(player, commandText);
         }
 
         #region Implementation of ICommandsManager
@@ -233,9 +220,8 @@ namespace SampSharp.GameMode.SAMP.Commands
         /// <param name="assembly">The assembly to load the commands from.</param>
         public virtual void RegisterCommands(Assembly assembly)
         {
-            foreach (
-                var method in
-                    assembly.GetTypes()
+            foreach (var method in TypeScanCache.GetMethods(assembly, "commands", a =>
+                    a.GetTypes()
                         // Get all classes in the specified assembly.
                         .Where(type => !type.IsInterface && type.IsClass && !type.IsAbstract)
                         // Select the methods in the type.
@@ -250,8 +236,7 @@ namespace SampSharp.GameMode.SAMP.Commands
                         // Only include methods which have a command attribute.
                         .Where(method => method.GetCustomAttribute<CommandAttribute>() != null)
                         // Only include methods which are static and have a player as first argument -or- are a non-static member of a player derived class.
-                        .Where(DefaultCommand.IsValidCommandMethod)
-                )
+                        .Where(DefaultCommand.IsValidCommandMethod)))
             {
                 var attribute = method.GetCustomAttribute<CommandAttribute>();
 
@@ -281,6 +266,7 @@ namespace SampSharp.GameMode.SAMP.Commands
 
             FrameworkLog.WriteLine(FrameworkMessageLevel.Debug, $"Registering command {command}");
             _commands.Add(command);
+            _router.Add(command);
         }
 
         /// <summary>
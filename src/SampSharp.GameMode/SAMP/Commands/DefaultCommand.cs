@@ -13,7 +13,9 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 using System;
+using System.Collections.Generic;
 using System.Linq;
+using System.Linq.Expressions;
 using System.Reflection;
 using SampSharp.GameMode.SAMP.Commands.Parameters;
 using SampSharp.GameMode.SAMP.Commands.ParameterTypes;
@@ -28,6 +30,14 @@ namespace SampSharp.GameMode.SAMP.Commands
     public class DefaultCommand : ICommand
     {
         private readonly string _displayName;
+        private CommandInvoker _compiledInvoker;
+        private bool _isInvokerCompiled;
+
+        /// <summary>
+        ///     Parses the arguments from the command text at the specified offset and, unless dryRun is set, invokes the
+        ///     command method. Returns null if the arguments could not be parsed.
+        /// </summary>
+        private delegate bool? CommandInvoker(BasePlayer player, string commandText, int offset, bool dryRun);
 
         /// <summary>
         ///     Initializes a new instance of the <see cref="DefaultCommand" /> class.
@@ -78,6 +88,7 @@ namespace SampSharp.GameMode.SAMP.Commands
             }
 
             PermissionCheckers = (permissionCheckers?.Where(p => p != null).ToArray() ?? new IPermissionChecker[0]);
+            UseCompiledInvoker = true;
         }
 
         /// <summary>
@@ -123,6 +134,13 @@ namespace SampSharp.GameMode.SAMP.Commands
         /// </summary>
         public IPermissionChecker[] PermissionCheckers { get; }
 
+        /// <summary>
+        ///     Gets or sets a value indicating whether this command should be invoked trough a compiled delegate. The
+        ///     delegate is only compiled if the type of every parameter implements
+        ///     <see cref="ICommandParameterType{T}" />; otherwise the method is invoked using reflection. Defaults to true.
+        /// </summary>
+        public bool UseCompiledInvoker { get; set; }
+
         /// <summary>
         ///     Determines whether the specified method is a valid command method.
         /// </summary>
@@ -135,6 +153,135 @@ namespace SampSharp.GameMode.SAMP.Commands
                    (!method.IsStatic && typeof (BasePlayer).IsAssignableFrom(method.DeclaringType));
         }
 
+        private CommandInvoker GetCompiledInvoker()
+        {
+            if (!UseCompiledInvoker)
+                return null;
+
+            if (!_isInvokerCompiled)
+            {
+                _compiledInvoker = CompileInvoker();
+                _isInvokerCompiled = true;
+            }
+
+            return _compiledInvoker;
+        }
+
+        private CommandInvoker CompileInvoker()
+        {
+            var player = Expression.Parameter(typeof (BasePlayer), "player");
+            var commandText = Expression.Parameter(typeof (string), "commandText");
+            var offset = Expression.Parameter(typeof (int), "offset");
+            var dryRun = Expression.Parameter(typeof (bool), "dryRun");
+            var returnTarget = Expression.Label(typeof (bool?));
+
+            var variables = new List<ParameterExpression>();
+            var body = new List<Expression>();
+            var arguments = new List<Expression>();
+
+            var methodParameters = Method.GetParameters();
+            var skipCount = methodParameters.Length - Parameters.Length;
+
+            if (!IsMethodMemberOfPlayer)
+                arguments.Add(Expression.Convert(player, methodParameters[0].ParameterType));
+
+            for (var i = 0; i < Parameters.Length; i++)
+            {
+                var parameter = Parameters[i];
+                var parameterType = methodParameters[i + skipCount].ParameterType;
+                var parserType = GetTypedParameterType(parameter.CommandParameterType, parameterType);
+
+                // The compiled invoker can only be used if every parameter can be parsed from an offset.
+                if (parserType == null)
+                    return null;
+
+                var value = Expression.Variable(parserType.GetGenericArguments()[0]);
+                var argument = Expression.Variable(parameterType);
+                variables.Add(value);
+                variables.Add(argument);
+
+                // if (parser.Parse(commandText, ref offset, out value)) argument = value;
+                // else if optional: argument = default value; else return null;
+                body.Add(Expression.IfThenElse(
+                    Expression.Call(Expression.Constant(parameter.CommandParameterType, parserType),
+                        parserType.GetMethod("Parse"), commandText, offset, value),
+                    Expression.Assign(argument, ConvertIfNeeded(value, parameterType)),
+                    parameter.IsOptional
+                        ? Expression.Assign(argument, GetDefaultValueExpression(parameter.DefaultValue, parameterType))
+                        : (Expression) Expression.Return(returnTarget, Expression.Constant(null, typeof (bool?)))));
+
+                arguments.Add(argument);
+            }
+
+            var instance = IsMethodMemberOfPlayer && !Method.IsStatic
+                ? Expression.Convert(player, Method.DeclaringType)
+                : null;
+            var call = Expression.Call(instance, Method, arguments);
+
+            // Mirror the result handling of the reflection path: a returned bool is passed on, anything else is true.
+            Expression result;
+            if (Method.ReturnType == typeof (bool))
+                result = Expression.Convert(call, typeof (bool?));
+            else if (Method.ReturnType.IsValueType && Nullable.GetUnderlyingType(Method.ReturnType) == null)
+                result = Expression.Block(call, Expression.Constant(true, typeof (bool?)));
+            else
+                result = Expression.Convert(
+                    Expression.Coalesce(Expression.TypeAs(call, typeof (bool?)), Expression.Constant(true)),
+                    typeof (bool?));
+
+            body.Add(Expression.Label(returnTarget,
+                Expression.Condition(dryRun, Expression.Constant(true, typeof (bool?)), result)));
+
+            return Expression.Lambda<CommandInvoker>(Expression.Block(variables, body), player, commandText, offset,
+                dryRun).Compile();
+        }
+
+        private static Type GetTypedParameterType(ICommandParameterType commandParameterType, Type parameterType)
+        {
+            foreach (var type in commandParameterType.GetType().GetInterfaces())
+            {
+                if (!type.IsGenericType || type.GetGenericTypeDefinition() != typeof (ICommandParameterType<>))
+                    continue;
+
+                var valueType = type.GetGenericArguments()[0];
+                if (parameterType.IsAssignableFrom(valueType) ||
+                    (!valueType.IsValueType && valueType.IsAssignableFrom(parameterType)))
+                    return type;
+            }
+
+            return null;
+        }
+
+        private static Expression ConvertIfNeeded(Expression value, Type type)
+        {
+            return value.Type == type ? value : Expression.Convert(value, type);
+        }
+
+        private static Expression GetDefaultValueExpression(object defaultValue, Type type)
+        {
+            if (defaultValue == null)
+                return Expression.Default(type);
+
+            return type.IsInstanceOfType(defaultValue)
+                ? (Expression) Expression.Constant(defaultValue, type)
+                : Expression.Convert(Expression.Constant(defaultValue, typeof (object)), type);
+        }
+
+        private int GetArgumentsOffset(string commandText, bool ignoreCase)
+        {
+            var offset = 0;
+            while (offset < commandText.Length && commandText[offset] == '/')
+                offset++;
+
+            foreach (var name in Names)
+            {
+                if (name.Matches(commandText, offset, ignoreCase))
+                    return offset + name.Length;
+            }
+
+            return -1;
+        }
+
         private bool GetArguments(string commandText, out object[] arguments)
         {
             arguments = new object[Parameters.Length];
@@ -261,8 +408,24 @@ namespace SampSharp.GameMode.SAMP.Commands
         /// <returns>A value indicating whether this instance can be invoked.</returns>
         public virtual CommandCallableResponse CanInvoke(BasePlayer player, string commandText)
         {
-            if (PermissionCheckers.Where(p => p.Message == null).Any(p => !p.Check(player)))
-                return CommandCallableResponse.False;
+            foreach (var p in PermissionCheckers)
+            {
+                if (p.Message == null && !p.Check(player))
+                    return CommandCallableResponse.False;
+            }
+
+            var invoker = GetCompiledInvoker();
+            if (invoker != null)
+            {
+                var offset = GetArgumentsOffset(commandText, IsCaseIgnored);
+
+                if (offset < 0)
+                    return CommandCallableResponse.False;
+
+                return invoker(player, commandText, offset, true) != null
+                    ? CommandCallableResponse.True
+                    : CommandCallableResponse.Optional;
+            }
 
             commandText = commandText.TrimStart('/');
 
@@ -294,6 +457,17 @@ namespace SampSharp.GameMode.SAMP.Commands
                     return SendPermissionDeniedMessage(p, player);
             }
 
+            var invoker = GetCompiledInvoker();
+            if (invoker != null)
+            {
+                var offset = GetArgumentsOffset(commandText, true);
+
+                if (offset < 0)
+                    return false;
+
+                return invoker(player, commandText, offset, false) ?? SendUsageMessage(player);
+            }
+
             commandText = commandText.TrimStart('/');
 
             object[] arguments;
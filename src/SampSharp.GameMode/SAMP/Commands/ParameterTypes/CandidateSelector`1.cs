@@ -0,0 +1,85 @@
+﻿// SampSharp
+// Copyright 2017 Tim Potze
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//     http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+namespace SampSharp.GameMode.SAMP.Commands.ParameterTypes
+{
+    /// <summary>
+    ///     Selects a single candidate by narrowing down the candidates trough the match levels returned by
+    ///     <see cref="ParameterTypeHelper.GetMatchLevel" /> until no ambiguities remain, without building candidate lists.
+    /// </summary>
+    /// <typeparam name="T">The type of the candidates.</typeparam>
+    internal struct CandidateSelector<T>
+    {
+        private int _count1;
+        private int _count2;
+        private int _count3;
+        private int _count4;
+        private T _last1;
+        private T _last2;
+        private T _last3;
+        private T _last4;
+
+        /// <summary>
+        ///     Adds the specified candidate at the specified match level.
+        /// </summary>
+        public void Add(T candidate, int level)
+        {
+            if (level >= 1)
+            {
+                _count1++;
+                _last1 = candidate;
+            }
+            if (level >= 2)
+            {
+                _count2++;
+                _last2 = candidate;
+            }
+            if (level >= 3)
+            {
+                _count3++;
+                _last3 = candidate;
+            }
+            if (level >= 4)
+            {
+                _count4++;
+                _last4 = candidate;
+            }
+        }
+
+        /// <summary>
+        ///     Returns the number of remaining candidates. If a single candidate remains, it is stored in the result.
+        /// </summary>
+        public int Select(out T result)
+        {
+            if (_count1 <= 1)
+            {
+                result = _last1;
+                return _count1;
+            }
+            if (_count2 <= 1)
+            {
+                result = _last2;
+                return _count2;
+            }
+            if (_count3 <= 1)
+            {
+                result = _last3;
+                return _count3;
+            }
+
+            result = _last4;
+            return _count4;
+        }
+    }
+}
\ No newline at end of file
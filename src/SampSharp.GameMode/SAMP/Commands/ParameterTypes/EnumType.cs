@@ -21,8 +21,14 @@ namespace SampSharp.GameMode.SAMP.Commands.ParameterTypes
     ///     Represents an enum command parameter.
     /// </summary>
     /// <typeparam name="T">The enum type.</typeparam>
-    public class EnumType<T> : ICommandParameterType where T : struct, IConvertible
+    public class EnumType<T> : ICommandParameterType<T> where T : struct, IConvertible
     {
+        private static readonly T[] Values = typeof (T).IsEnum ? (T[]) Enum.GetValues(typeof (T)) : new T[0];
+        private static readonly string[] Names = Values.Select(v => v.ToString()).ToArray();
+
+        private static readonly string[] UnderlyingValues =
+            Values.Select(v => Convert.ChangeType(v, Enum.GetUnderlyingType(typeof (T))).ToString()).ToArray();
+
         /// <summary>
         ///     Initializes a new instance of the <see cref="EnumType{T}" /> class.
         /// </summary>
@@ -54,53 +60,67 @@ namespace SampSharp.GameMode.SAMP.Commands.ParameterTypes
         /// </returns>
         public bool Parse(ref string commandText, out object output)
         {
-            var text = commandText.TrimStart();
-            output = null;
-
-            if (string.IsNullOrEmpty(text))
+            var offset = 0;
+            T value;
+            if (!Parse(commandText, ref offset, out value))
+            {
+                output = null;
                 return false;
+            }
 
-            var word = text.Split(' ').First();
-            var lowerWord = word.ToLower();
+            commandText = offset == commandText.Length ? string.Empty : commandText.Substring(offset);
+            output = value;
+            return true;
+        }
 
-            // find all candiates containing the input word, case insensitive.
-            var candidates =
-                typeof (T).GetEnumValues()
-                    .OfType<object>()
-                    .Where(v => v.ToString().ToLower().Contains(lowerWord))
-                    .ToList();
+        #endregion
 
-            // in case of ambiguities find all candiates containing the input word, case sensitive.
-            if (candidates.Count > 1)
-            {
-                candidates = candidates.Where(v => v.ToString().Contains(word)).ToList();
-            }
+        #region Implementation of ICommandParameterType<T>
 
-            // in case of ambiguities find all candiates matching exactly the input word, case insensitive.
-            if (candidates.Count > 1)
-            {
-                candidates = candidates.Where(v => v.ToString().ToLower() == lowerWord).ToList();
-            }
+        /// <summary>
+        ///     Gets the value for the occurance of this parameter type at the specified offset in the commandText. On
+        ///     success the offset is moved past the processed text and any trailing spaces; otherwise the offset is left
+        ///     unchanged.
+        /// </summary>
+        /// <param name="commandText">The command text.</param>
+        /// <param name="offset">The offset in the command text.</param>
+        /// <param name="output">The output.</param>
+        /// <returns>
+        ///     true if parsed successfully; false otherwise.
+        /// </returns>
+        public bool Parse(string commandText, ref int offset, out T output)
+        {
+            var start = ParameterTypeHelper.SkipWhiteSpace(commandText, offset);
+            var end = ParameterTypeHelper.FindWordEnd(commandText, start);
+            output = default(T);
 
-            // in case of ambiguities find all candiates matching exactly the input word, case sensitive.
-            if (candidates.Count > 1)
-            {
-                candidates = candidates.Where(v => v.ToString() == word).ToList();
-            }
+            if (start == end)
+                return false;
+
+            // find the value of which the name contains the input word with the least ambiguity. See
+            // ParameterTypeHelper.GetMatchLevel for the order in which the candidates are narrowed down.
+            var candidates = new CandidateSelector<T>();
+            for (var i = 0; i < Values.Length; i++)
+                candidates.Add(Values[i], ParameterTypeHelper.GetMatchLevel(Names[i], commandText, start, end - start));
+
+            T candidate;
+            var count = candidates.Select(out candidate);
 
-            // if also testing against underlying values, loop trough every value, convert it to the underlying type and compare.
+            // if also testing against underlying values, loop trough every value and compare its underlying value.
             if (TestForValue)
             {
-                candidates.AddRange(
-                    typeof (T).GetEnumValues()
-                        .OfType<object>()
-                        .Where(t => Convert.ChangeType(t, Enum.GetUnderlyingType(typeof (T))).ToString() == word));
+                for (var i = 0; i < Values.Length; i++)
+                {
+                    if (ParameterTypeHelper.EqualsRange(UnderlyingValues[i], commandText, start, end - start, false) &&
+                        count++ == 0)
+                        candidate = Values[i];
+                }
             }
 
-            if (candidates.Count == 1)
+            if (count == 1)
             {
-                output = candidates.First();
-                commandText = commandText.Substring(word.Length).TrimStart(' ');
+                output = candidate;
+                offset = ParameterTypeHelper.SkipSpaces(commandText, end);
                 return true;
             }
 
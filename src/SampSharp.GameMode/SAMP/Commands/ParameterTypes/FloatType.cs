@@ -20,8 +20,14 @@ namespace SampSharp.GameMode.SAMP.Commands.ParameterTypes
     /// <summary>
     ///     Represents a float command parameter.
     /// </summary>
-    public class FloatType : ICommandParameterType
+    public class FloatType : ICommandParameterType<float>
     {
+        private static readonly double[] PowersOf10 =
+        {
+            1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18,
+            1e19, 1e20, 1e21, 1e22
+        };
+
         #region Implementation of ICommandParameterType
 
         /// <summary>
@@ -35,14 +41,162 @@ namespace SampSharp.GameMode.SAMP.Commands.ParameterTypes
         /// </returns>
         public bool Parse(ref string commandText, out object output)
         {
-            var text = commandText.TrimStart();
-            output = null;
+            var offset = 0;
+            float value;
+            if (!Parse(commandText, ref offset, out value))
+            {
+                output = null;
+                return false;
+            }
+
+            commandText = offset == commandText.Length ? string.Empty : commandText.Substring(offset);
+            output = value;
+            return true;
+        }
+
+        #endregion
+
+        #region Implementation of ICommandParameterType<float>
+
+        /// <summary>
+        ///     Gets the value for the occurance of this parameter type at the specified offset in the commandText. On
+        ///     success the offset is moved past the processed text and any trailing spaces; otherwise the offset is left
+        ///     unchanged.
+        /// </summary>
+        /// <param name="commandText">The command text.</param>
+        /// <param name="offset">The offset in the command text.</param>
+        /// <param name="output">The output.</param>
+        /// <returns>
+        ///     true if parsed successfully; false otherwise.
+        /// </returns>
+        public bool Parse(string commandText, ref int offset, out float output)
+        {
+            var start = ParameterTypeHelper.SkipWhiteSpace(commandText, offset);
+            var end = ParameterTypeHelper.FindWordEnd(commandText, start);
+            output = 0;
 
-            if (string.IsNullOrEmpty(text))
+            if (start == end)
                 return false;
 
-            var word = text.Split(' ').First();
+            // Unify input culture.
+            var commaCount = 0;
+            var dotCount = 0;
+            var firstComma = -1;
+            var firstDot = -1;
+            for (var i = start; i < end; i++)
+            {
+                if (commandText[i] == ',')
+                {
+                    if (commaCount++ == 0)
+                        firstComma = i;
+                }
+                else if (commandText[i] == '.')
+                {
+                    if (dotCount++ == 0)
+                        firstDot = i;
+                }
+            }
+
+            char decimalSeparator;
+            char thousandsSeparator;
+            if (commaCount > 0 && dotCount > 0)
+            {
+                // the first separator is the thousands separator.
+                decimalSeparator = firstComma < firstDot ? '.' : ',';
+                thousandsSeparator = firstComma < firstDot ? ',' : '.';
+            }
+            else if (commaCount > 0)
+            {
+                // a single comma is a decimal separator, multiple commas are thousands separators.
+                decimalSeparator = commaCount == 1 ? ',' : '\0';
+                thousandsSeparator = commaCount == 1 ? '\0' : ',';
+            }
+            else
+            {
+                // a single dot is a decimal separator, multiple dots are thousands separators.
+                decimalSeparator = dotCount == 1 ? '.' : '\0';
+                thousandsSeparator = dotCount == 1 ? '\0' : '.';
+            }
+
+            // Parse the number
+            if (TryParseDecimal(commandText, start, end, decimalSeparator, thousandsSeparator, out output) ||
+                TryParseFallback(commandText.Substring(start, end - start), out output))
+            {
+                offset = ParameterTypeHelper.SkipSpaces(commandText, end);
+                return true;
+            }
 
+            return false;
+        }
+
+        #endregion
+
+        /// <summary>
+        ///     Parses plain decimal numbers of up to 15 significant digits without allocating. The result equals parsing
+        ///     the number as a double and narrowing it to a float. Returns false for any other input, which should then be
+        ///     parsed by <see cref="TryParseFallback" />.
+        /// </summary>
+        private static bool TryParseDecimal(string text, int start, int end, char decimalSeparator,
+            char thousandsSeparator, out float output)
+        {
+            output = 0;
+
+            var negative = false;
+            if (text[start] == '-' || text[start] == '+')
+            {
+                negative = text[start] == '-';
+                start++;
+            }
+
+            long mantissa = 0;
+            var digits = 0;
+            var scale = 0;
+            var hasDigits = false;
+            var hasDecimalSeparator = false;
+            for (var i = start; i < end; i++)
+            {
+                var c = text[i];
+
+                if (c == thousandsSeparator)
+                    continue;
+
+                if (c == decimalSeparator)
+                {
+                    if (hasDecimalSeparator)
+                        return false;
+
+                    hasDecimalSeparator = true;
+                    continue;
+                }
+
+                if (c < '0' || c > '9')
+                    return false;
+
+                hasDigits = true;
+
+                if (hasDecimalSeparator)
+                    scale++;
+
+                // Leading zeros are not significant.
+                if (mantissa == 0 && c == '0')
+                    continue;
+
+                if (++digits > 15)
+                    return false;
+
+                mantissa = mantissa*10 + (c - '0');
+            }
+
+            if (!hasDigits || scale >= PowersOf10.Length)
+                return false;
+
+            var value = mantissa/PowersOf10[scale];
+            output = (float) (negative ? -value : value);
+            return true;
+        }
+
+        private static bool TryParseFallback(string word, out float output)
+        {
             // Unify input culture.
             var preProcessedWord = word;
             var commaCount = preProcessedWord.Count(c => c == ',');
@@ -71,18 +225,7 @@ namespace SampSharp.GameMode.SAMP.Commands.ParameterTypes
                 // dot is thousands separator, comma is decimal separator.
             }
 
-            // Parse the number
-            float number;
-            if (float.TryParse(preProcessedWord, NumberStyles.Float, CultureInfo.InvariantCulture, out number))
-            {
-                commandText = commandText.Substring(word.Length).TrimStart(' ');
-                output = number;
-                return true;
-            }
-
-            return false;
+            return float.TryParse(preProcessedWord, NumberStyles.Float, CultureInfo.InvariantCulture, out output);
         }
-
-        #endregion
     }
 }
\ No newline at end of file
@@ -0,0 +1,39 @@
+﻿// SampSharp
+// Copyright 2017 Tim Potze
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//     http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+namespace SampSharp.GameMode.SAMP.Commands.ParameterTypes
+{
+    /// <summary>
+    ///     Contains methods for a command parameter type which parses its value directly from an offset in the command
+    ///     text.
+    /// </summary>
+    /// <typeparam name="T">The type of the parsed value.</typeparam>
+    /// <remarks>
+    ///     Commands of which all parameter types implement this interface are invoked trough a compiled delegate instead
+    ///     of reflection.
+    /// </remarks>
+    public interface ICommandParameterType<T> : ICommandParameterType
+    {
+        /// <summary>
+        ///     Gets the value for the occurance of this parameter type at the specified offset in the commandText. On
+        ///     success the offset is moved past the processed text and any trailing spaces; otherwise the offset is left
+        ///     unchanged.
+        /// </summary>
+        /// <param name="commandText">The command text.</param>
+        /// <param name="offset">The offset in the command text.</param>
+        /// <param name="output">The output.</param>
+        /// <returns>true if parsed successfully; false otherwise.</returns>
+        bool Parse(string commandText, ref int offset, out T output);
+    }
+}
\ No newline at end of file
@@ -12,19 +12,13 @@
 // WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
 // See the License for the specific language governing permissions and
 // limitations under the License.
-using System.Globalization;
-using System.Linq;
-
 namespace SampSharp.GameMode.SAMP.Commands.ParameterTypes
 {
     /// <summary>
     ///     Represents an integer command parameter.
     /// </summary>
-    public class IntegerType : ICommandParameterType
+    public class IntegerType : ICommandParameterType<int>
     {
-        private static readonly char[] Base10Characters = "1234567890,.-".ToCharArray();
-        private static readonly char[] Base16Characters = "1234567890abcdef".ToCharArray();
-
         #region Implementation of ICommandParameterType
 
         /// <summary>
@@ -38,44 +32,71 @@ namespace SampSharp.GameMode.SAMP.Commands.ParameterTypes
         /// </returns>
         public bool Parse(ref string commandText, out object output)
         {
-            var text = commandText.TrimStart();
-            output = null;
-
-            if (string.IsNullOrEmpty(text))
+            var offset = 0;
+            int value;
+            if (!Parse(commandText, ref offset, out value))
+            {
+                output = null;
                 return false;
+            }
 
-            var word = text.Split(' ').First();
+            commandText = offset == commandText.Length ? string.Empty : commandText.Substring(offset);
+            output = value;
+            return true;
+        }
+
+        #endregion
 
-            int number;
+        #region Implementation of ICommandParameterType<int>
+
+        /// <summary>
+        ///     Gets the value for the occurance of this parameter type at the specified offset in the commandText. On
+        ///     success the offset is moved past the processed text and any trailing spaces; otherwise the offset is left
+        ///     unchanged.
+        /// </summary>
+        /// <param name="commandText">The command text.</param>
+        /// <param name="offset">The offset in the command text.</param>
+        /// <param name="output">The output.</param>
+        /// <returns>
+        ///     true if parsed successfully; false otherwise.
+        /// </returns>
+        public bool Parse(string commandText, ref int offset, out int output)
+        {
+            var start = ParameterTypeHelper.SkipWhiteSpace(commandText, offset);
+            var end = ParameterTypeHelper.FindWordEnd(commandText, start);
 
             // Regular base 10 numbers (eg. 14143)
-            if (word.All(Base10Characters.Contains) && int.TryParse(word, out number))
+            if (ParameterTypeHelper.TryParseInteger(commandText, start, end, false, out output))
             {
-                commandText = commandText.Substring(word.Length).TrimStart(' ');
-                output = number;
+                offset = ParameterTypeHelper.SkipSpaces(commandText, end);
                 return true;
             }
 
             // Base 16 (hexidecimal) numbers. Can be prefixed with '0x', '#' or postfixed with 'H' or 'h'.
-            string base16Word = null;
-            if (word.Length > 2 && word.StartsWith("0x"))
-                base16Word = word.Substring(2);
-            else if (word.Length > 1 && word.StartsWith("#"))
-                base16Word = word.Substring(1);
-            else if (word.Length > 1 && word.ToLower().EndsWith("h"))
-                base16Word = word.Substring(0, word.Length - 1);
+            var length = end - start;
+            var base16Start = -1;
+            var base16End = end;
+            if (length > 2 && commandText[start] == '0' && commandText[start + 1] == 'x')
+                base16Start = start + 2;
+            else if (length > 1 && commandText[start] == '#')
+                base16Start = start + 1;
+            else if (length > 1 && (commandText[end - 1] == 'h' || commandText[end - 1] == 'H'))
+            {
+                base16Start = start;
+                base16End = end - 1;
+            }
 
-            if (base16Word != null && base16Word.ToLower().All(Base16Characters.Contains) &&
-                int.TryParse(base16Word, NumberStyles.AllowHexSpecifier, CultureInfo.InvariantCulture, out number))
+            if (base16Start >= 0 &&
+                ParameterTypeHelper.TryParseHexInteger(commandText, base16Start, base16End, out output))
             {
-                commandText = commandText.Substring(word.Length).TrimStart(' ');
-                output = number;
+                offset = ParameterTypeHelper.SkipSpaces(commandText, end);
                 return true;
             }
 
+            output = 0;
             return false;
         }
 
         #endregion
     }
-}
+}
\ No newline at end of file
@@ -0,0 +1,179 @@
+﻿// SampSharp
+// Copyright 2017 Tim Potze
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//     http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+namespace SampSharp.GameMode.SAMP.Commands.ParameterTypes
+{
+    /// <summary>
+    ///     Contains methods for reading from a range of a command text without allocating substrings.
+    /// </summary>
+    internal static class ParameterTypeHelper
+    {
+        /// <summary>
+        ///     Returns the offset of the first non-whitespace character at or after the specified offset.
+        /// </summary>
+        public static int SkipWhiteSpace(string text, int offset)
+        {
+            while (offset < text.Length && char.IsWhiteSpace(text[offset]))
+                offset++;
+            return offset;
+        }
+
+        /// <summary>
+        ///     Returns the offset of the first non-space character at or after the specified offset.
+        /// </summary>
+        public static int SkipSpaces(string text, int offset)
+        {
+            while (offset < text.Length && text[offset] == ' ')
+                offset++;
+            return offset;
+        }
+
+        /// <summary>
+        ///     Returns the offset of the first space at or after the specified offset, or the length of the text.
+        /// </summary>
+        public static int FindWordEnd(string text, int offset)
+        {
+            while (offset < text.Length && text[offset] != ' ')
+                offset++;
+            return offset;
+        }
+
+        /// <summary>
+        ///     Parses the base 10 integer in the specified range of the text. The range may only contain an optional sign
+        ///     followed by digits.
+        /// </summary>
+        public static bool TryParseInteger(string text, int start, int end, bool allowPlusSign, out int value)
+        {
+            value = 0;
+
+            var negative = false;
+            if (start < end && (text[start] == '-' || (allowPlusSign && text[start] == '+')))
+            {
+                negative = text[start] == '-';
+                start++;
+            }
+
+            if (start == end)
+                return false;
+
+            long number = 0;
+            for (var i = start; i < end; i++)
+            {
+                var c = text[i];
+                if (c < '0' || c > '9')
+                    return false;
+
+                number = number*10 + (c - '0');
+
+                if (number > 2147483648L)
+                    return false;
+            }
+
+            if (negative)
+                number = -number;
+
+            if (number > int.MaxValue)
+                return false;
+
+            value = (int) number;
+            return true;
+        }
+
+        /// <summary>
+        ///     Parses the hexadecimal integer in the specified range of the text. The range may only contain hexadecimal
+        ///     digits.
+        /// </summary>
+        public static bool TryParseHexInteger(string text, int start, int end, out int value)
+        {
+            value = 0;
+
+            if (start == end)
+                return false;
+
+            long number = 0;
+            for (var i = start; i < end; i++)
+            {
+                var c = text[i];
+                int digit;
+                if (c >= '0' && c <= '9')
+                    digit = c - '0';
+                else if (c >= 'a' && c <= 'f')
+                    digit = c - 'a' + 10;
+                else if (c >= 'A' && c <= 'F')
+                    digit = c - 'A' + 10;
+                else
+                    return false;
+
+                number = number*16 + digit;
+
+                if (number > uint.MaxValue)
+                    return false;
+            }
+
+            value = unchecked((int) (uint) number);
+            return true;
+        }
+
+        /// <summary>
+        ///     Determines whether the specified value contains the specified range of the text.
+        /// </summary>
+        public static bool ContainsRange(string value, string text, int start, int length, bool ignoreCase)
+        {
+            for (var i = 0; i <= value.Length - length; i++)
+                if (EqualsRange(value, i, text, start, length, ignoreCase))
+                    return true;
+
+            return false;
+        }
+
+        /// <summary>
+        ///     Determines whether the specified value equals the specified range of the text.
+        /// </summary>
+        public static bool EqualsRange(string value, string text, int start, int length, bool ignoreCase)
+        {
+            return value.Length == length && EqualsRange(value, 0, text, start, length, ignoreCase);
+        }
+
+        /// <summary>
+        ///     Returns the number of consecutive candidate filters the specified value passes when matched against the
+        ///     specified range of the text, or 0 if it isn't a candidate. The filters are, in order: contains (case
+        ///     insensitive), contains (case sensitive), equals (case insensitive) and equals (case sensitive).
+        /// </summary>
+        public static int GetMatchLevel(string value, string text, int start, int length)
+        {
+            if (!ContainsRange(value, text, start, length, true))
+                return 0;
+            if (!ContainsRange(value, text, start, length, false))
+                return 1;
+            if (!EqualsRange(value, text, start, length, true))
+                return 2;
+            return EqualsRange(value, text, start, length, false) ? 4 : 3;
+        }
+
+        private static bool EqualsRange(string value, int valueStart, string text, int start, int length,
+            bool ignoreCase)
+        {
+            for (var i = 0; i < length; i++)
+            {
+                var a = value[valueStart + i];
+                var b = text[start + i];
+
+                if (a != b && (!ignoreCase || char.ToLower(a) != char.ToLower(b)))
+                    return false;
+            }
+
+            return true;
+        }
+    }
+}
\ No newline at end of file
@@ -12,8 +12,6 @@
 // WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
 // See the License for the specific language governing permissions and
 // limitations under the License.
-using System.Globalization;
-using System.Linq;
 using SampSharp.GameMode.World;
 
 namespace SampSharp.GameMode.SAMP.Commands.ParameterTypes
@@ -21,7 +19,7 @@ namespace SampSharp.GameMode.SAMP.Commands.ParameterTypes
     /// <summary>
     ///     Represents a player command parameter.
     /// </summary>
-    public class PlayerType : ICommandParameterType
+    public class PlayerType : ICommandParameterType<BasePlayer>
     {
         #region Implementation of ICommandParameterType
 
@@ -36,52 +34,67 @@ namespace SampSharp.GameMode.SAMP.Commands.ParameterTypes
         /// </returns>
         public bool Parse(ref string commandText, out object output)
         {
-            var text = commandText.TrimStart();
+            var offset = 0;
+            BasePlayer value;
+            if (!Parse(commandText, ref offset, out value))
+            {
+                output = null;
+                return false;
+            }
+
+            commandText = offset == commandText.Length ? string.Empty : commandText.Substring(offset);
+            output = value;
+            return true;
+        }
+
+        #endregion
+
+        #region Implementation of ICommandParameterType<BasePlayer>
+
+        /// <summary>
+        ///     Gets the value for the occurance of this parameter type at the specified offset in the commandText. On
+        ///     success the offset is moved past the processed text and any trailing spaces; otherwise the offset is left
+        ///     unchanged.
+        /// </summary>
+        /// <param name="commandText">The command text.</param>
+        /// <param name="offset">The offset in the command text.</param>
+        /// <param name="output">The output.</param>
+        /// <returns>
+        ///     true if parsed successfully; false otherwise.
+        /// </returns>
+        public bool Parse(string commandText, ref int offset, out BasePlayer output)
+        {
+            var start = ParameterTypeHelper.SkipWhiteSpace(commandText, offset);
+            var end = ParameterTypeHelper.FindWordEnd(commandText, start);
             output = null;
 
-            if (string.IsNullOrEmpty(text))
+            if (start == end)
                 return false;
 
-            var word = text.Split(' ').First();
-
             // find a player with a matching id.
             int id;
-            if (int.TryParse(word, NumberStyles.Integer, CultureInfo.InvariantCulture, out id))
+            if (ParameterTypeHelper.TryParseInteger(commandText, start, end, true, out id))
             {
                 var player = BasePlayer.Find(id);
                 if (player != null)
                 {
                     output = player;
-                    commandText = commandText.Substring(word.Length).TrimStart(' ');
+                    offset = ParameterTypeHelper.SkipSpaces(commandText, end);
                     return true;
                 }
             }
 
-            var lowerWord = word.ToLower();
+            // find the player of which the name contains the input word with the least ambiguity. See
+            // ParameterTypeHelper.GetMatchLevel for the order in which the candidates are narrowed down.
+            var candidates = new CandidateSelector<BasePlayer>();
+            foreach (var player in BasePlayer.All)
+                candidates.Add(player, ParameterTypeHelper.GetMatchLevel(player.Name, commandText, start, end - start));
 
-            // find all candiates containing the input word, case insensitive.
-            var candidates = BasePlayer.All.Where(p => p.Name.ToLower().Contains(lowerWord))
-                .ToList();
-
-            // in case of ambiguities find all candiates containing the input word, case sensitive.
-            if (candidates.Count > 1)
-                candidates = candidates.Where(p => p.Name.Contains(word)).ToList();
-
-            // in case of ambiguities find all candiates matching exactly the input word, case insensitive.
-            if (candidates.Count > 1)
-                candidates = candidates.Where(p => p.Name.ToLower() == lowerWord).ToList();
-
-            // in case of ambiguities find all candiates matching exactly the input word, case sensitive.
-            if (candidates.Count > 1)
-                candidates = candidates.Where(p => p.Name == word).ToList();
-
-            if (candidates.Count == 1)
+            BasePlayer candidate;
+            if (candidates.Select(out candidate) == 1)
             {
-                output = candidates.First();
-
-                commandText = word.Length == commandText.Length
-                    ? string.Empty
-                    : commandText.Substring(word.Length).TrimStart(' ');
+                output = candidate;
+                offset = ParameterTypeHelper.SkipSpaces(commandText, end);
                 return true;
             }
 
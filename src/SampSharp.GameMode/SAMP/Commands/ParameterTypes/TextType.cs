@@ -17,7 +17,7 @@ namespace SampSharp.GameMode.SAMP.Commands.ParameterTypes
     /// <summary>
     ///     Represents a text command parameter.
     /// </summary>
-    public class TextType : ICommandParameterType
+    public class TextType : ICommandParameterType<string>
     {
         #region Implementation of ICommandParameterType
 
@@ -32,16 +32,50 @@ namespace SampSharp.GameMode.SAMP.Commands.ParameterTypes
         /// </returns>
         public bool Parse(ref string commandText, out object output)
         {
-            var text = commandText.Trim();
+            var offset = 0;
+            string value;
+            if (!Parse(commandText, ref offset, out value))
+            {
+                output = null;
+                return false;
+            }
+
+            commandText = offset == commandText.Length ? string.Empty : commandText.Substring(offset);
+            output = value;
+            return true;
+        }
+
+        #endregion
+
+        #region Implementation of ICommandParameterType<string>
+
+        /// <summary>
+        ///     Gets the value for the occurance of this parameter type at the specified offset in the commandText. On
+        ///     success the offset is moved past the processed text and any trailing spaces; otherwise the offset is left
+        ///     unchanged.
+        /// </summary>
+        /// <param name="commandText">The command text.</param>
+        /// <param name="offset">The offset in the command text.</param>
+        /// <param name="output">The output.</param>
+        /// <returns>
+        ///     true if parsed successfully; false otherwise.
+        /// </returns>
+        public bool Parse(string commandText, ref int offset, out string output)
+        {
+            var start = ParameterTypeHelper.SkipWhiteSpace(commandText, offset);
+            var end = commandText.Length;
+
+            while (end > start && char.IsWhiteSpace(commandText[end - 1]))
+                end--;
 
-            if (string.IsNullOrEmpty(text))
+            if (start == end)
             {
                 output = null;
                 return false;
             }
 
-            output = text;
-            commandText = string.Empty;
+            output = commandText.Substring(start, end - start);
+            offset = commandText.Length;
             return true;
         }
 
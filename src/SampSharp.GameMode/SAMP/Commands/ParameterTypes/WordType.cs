@@ -12,14 +12,12 @@
 // WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
 // See the License for the specific language governing permissions and
 // limitations under the License.
-using System.Linq;
-
 namespace SampSharp.GameMode.SAMP.Commands.ParameterTypes
 {
     /// <summary>
     ///     Represents a word command parameter.
     /// </summary>
-    public class WordType : ICommandParameterType
+    public class WordType : ICommandParameterType<string>
     {
         #region Implementation of ICommandParameterType
 
@@ -34,19 +32,48 @@ namespace SampSharp.GameMode.SAMP.Commands.ParameterTypes
         /// </returns>
         public bool Parse(ref string commandText, out object output)
         {
-            var text = commandText.TrimStart();
-
-            if (string.IsNullOrEmpty(text))
+            var offset = 0;
+            string value;
+            if (!Parse(commandText, ref offset, out value))
             {
                 output = null;
                 return false;
             }
 
-            var word = text.Split(' ').First();
+            commandText = offset == commandText.Length ? string.Empty : commandText.Substring(offset);
+            output = value;
+            return true;
+        }
+
+        #endregion
+
+        #region Implementation of ICommandParameterType<string>
+
+        /// <summary>
+        ///     Gets the value for the occurance of this parameter type at the specified offset in the commandText. On
+        ///     success the offset is moved past the processed text and any trailing spaces; otherwise the offset is left
+        ///     unchanged.
+        /// </summary>
+        /// <param name="commandText">The command text.</param>
+        /// <param name="offset">The offset in the command text.</param>
+        /// <param name="output">The output.</param>
+        /// <returns>
+        ///     true if parsed successfully; false otherwise.
+        /// </returns>
+        public bool Parse(string commandText, ref int offset, out string output)
+        {
+            var start = ParameterTypeHelper.SkipWhiteSpace(commandText, offset);
+
+            if (start == commandText.Length)
+            {
+                output = null;
+                return false;
+            }
 
-            commandText = commandText.Substring(word.Length).TrimStart(' ');
+            var end = ParameterTypeHelper.FindWordEnd(commandText, start);
 
-            output = word;
+            output = commandText.Substring(start, end - start);
+            offset = ParameterTypeHelper.SkipSpaces(commandText, end);
             return true;
         }
 
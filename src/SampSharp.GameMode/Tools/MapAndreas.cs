@@ -22,10 +22,11 @@ namespace SampSharp.GameMode.Tools
     ///     Contains methods for reading SA height map files.
     /// </summary>
     /// <remarks>
-    ///     If MapAndreas 1.2(.1) is loaded, the plugin will be used instead of
-    ///     the managed logic. This is to save your precious resources. Most of
-    ///     this logic has been copied from MapAndreas v1.2 released at
-    ///     http://forum.sa-mp.com/showthread.php?t=275492
+    ///     If MapAndreas 1.2(.1) is loaded, the plugin will be used. Otherwise the
+    ///     height map file is memory mapped by SampSharp, which makes loading
+    ///     instant and shares the map data between servers running on the same
+    ///     machine. The lookup logic has been copied from MapAndreas v1.2
+    ///     released at http://forum.sa-mp.com/showthread.php?t=275492
     /// </remarks>
     public static partial class MapAndreas
     {
@@ -33,8 +34,13 @@ namespace SampSharp.GameMode.Tools
         private const string MinimalFile = "scriptfiles/SAmin.hmap";
         private static MapAndreasMode _mode;
         private static bool _usePlugin;
-        private static FileStream _fileStream;
-        private static ushort[] _data;
+
+        private enum FindMode
+        {
+            Nearest = 0,
+            Average = 1,
+            Bilinear = 2
+        }
 
         private static bool IsPluginLoaded()
         {
@@ -66,55 +72,25 @@ namespace SampSharp.GameMode.Tools
                 return;
             }
 
+            // The file is mapped rather than read; NoBuffer mode therefore behaves exactly like Full mode.
+            string file;
             switch (mode)
             {
                 case MapAndreasMode.Full:
-                    try
-                    {
-                        using (var memstream = new FileStream(FullFile, FileMode.Open))
-                        {
-                            _data = new ushort[memstream.Length/2];
-                            var buffer = new byte[2];
-                            var loc = 0;
-                            while ((memstream.Read(buffer, 0, 2)) == 2)
-                                _data[loc++] = BitConverter.ToUInt16(buffer, 0);
-                        }
-                    }
-                    catch (Exception e)
-                    {
-                        _mode = MapAndreasMode.None;
-                        throw new FileLoadException("Couldn't load " + FullFile, e);
-                    }
+                case MapAndreasMode.NoBuffer:
+                    file = FullFile;
                     break;
                 case MapAndreasMode.Minimal:
-                    try
-                    {
-                        using (var memstream = new FileStream(MinimalFile, FileMode.Open))
-                        {
-                            _data = new ushort[memstream.Length/2];
-                            var buffer = new byte[2];
-                            var loc = 0;
-                            while ((memstream.Read(buffer, 0, 2)) == 2)
-                                _data[loc++] = BitConverter.ToUInt16(buffer, 0);
-                        }
-                    }
-                    catch (Exception e)
-                    {
-                        _mode = MapAndreasMode.None;
-                        throw new FileLoadException("Couldn't load " + MinimalFile, e);
-                    }
-                    break;
-                case MapAndreasMode.NoBuffer:
-                    try
-                    {
-                        _fileStream = new FileStream(FullFile, FileMode.Open);
-                    }
-                    catch (Exception e)
-                    {
-                        _mode = MapAndreasMode.None;
-                        throw new FileLoadException("Couldn't load " + MinimalFile, e);
-                    }
+                    file = MinimalFile;
                     break;
+                default:
+                    return;
+            }
+
+            if (!InteropProvider.HeightMapLoad(file))
+            {
+                _mode = MapAndreasMode.None;
+                throw new FileLoadException("Couldn't load " + file);
             }
         }
 
@@ -132,17 +108,9 @@ namespace SampSharp.GameMode.Tools
                 return;
             }
 
-            switch (_mode)
-            {
-                case MapAndreasMode.NoBuffer:
-                    _fileStream.Dispose();
-                    break;
-                default:
-                    _data = null;
-                    break;
-            }
+            if (_mode != MapAndreasMode.None)
+                InteropProvider.HeightMapUnload();
 
-            _data = null;
             _mode = MapAndreasMode.None;
         }
 
@@ -162,27 +130,8 @@ namespace SampSharp.GameMode.Tools
                 MapAndreasInternal.Instance.FindZ(x, y, out result);
                 return result;
             }
-            // check for a co-ord outside the map
-            if (x < -3000.0f || x > 3000.0f || y > 3000.0f || y < -3000.0f) return 0.0f;
 
-            // get row/col on 6000x6000 grid
-            var iGridX = ((int) x) + 3000;
-            var iGridY = (((int) y) - 3000)*-1;
-            int iDataPos;
-
-            switch (_mode)
-            {
-                case MapAndreasMode.Full:
-                    iDataPos = (iGridY*6000) + iGridX;
-                    // for every Y, increment by the number of cols, add the col index.
-                    return _data[iDataPos]/100.0f; // the data is a float stored as ushort * 100
-
-                case MapAndreasMode.Minimal:
-                    iDataPos = ((iGridY/3)*2000) + iGridX/3;
-                    // for every Y, increment by the number of cols, add the col index.
-                    return _data[iDataPos]/100.0f; // the data is a float stored as ushort * 100
-            }
-            return 0.0f;
+            return InteropProvider.HeightMapFindZ(x, y);
         }
 
         /// <summary>
@@ -204,6 +153,22 @@ namespace SampSharp.GameMode.Tools
             point = Find(point);
         }
 
+        /// <summary>
+        ///     Finds highest Z point (ground level) for every provided point.
+        /// </summary>
+        /// <param name="points">The points to look at, stored as pairs of X- and Y-coordinates.</param>
+        /// <param name="heights">The array to store the ground level of every point in.</param>
+        /// <exception cref="ArgumentNullException">Thrown if <paramref name="points" /> or <paramref name="heights" /> is null.</exception>
+        /// <exception cref="ArgumentException">Thrown if <paramref name="heights" /> can't hold a result for every point.</exception>
+        /// <remarks>
+        ///     Unless the MapAndreas plugin is loaded, the points are processed using SIMD instructions (SSE2 or AVX2),
+        ///     which makes this considerably faster than calling <see cref="Find(float,float)" /> for every point.
+        /// </remarks>
+        public static void Find(float[] points, float[] heights)
+        {
+            FindArray(points, heights, FindMode.Nearest);
+        }
+
         /// <summary>
         ///     Calculates a linear approximation of the ground level at the provided point.
         /// </summary>
@@ -221,21 +186,7 @@ namespace SampSharp.GameMode.Tools
                 return result;
             }
 
-            float gridsize = _mode == MapAndreasMode.Full ? 1 : 3;
-
-            // Get the Z value of 2 neighbor grids
-            var p1 = Find(x, y);
-            var p2 = x < 0.0f ? Find(x + gridsize, y) : Find(x - gridsize, y);
-            var p3 = y < 0.0f ? Find(x, y + gridsize) : Find(x, y - gridsize);
-
-            // Filter the decimal part only
-            var xx = x%1;
-            var yy = y%1;
-            if (xx < 0) x = -xx; //Pointless? shouldn't it be xx = -xx? TODO: figure that out
-            if (yy < 0) y = -yy;
-
-            // Calculate a linear approximation of the z coordinate
-            return p1 + xx*(p1 - p2) + yy*(p1 - p3);
+            return InteropProvider.HeightMapFindAverageZ(x, y);
         }
 
         /// <summary>
@@ -258,41 +209,141 @@ namespace SampSharp.GameMode.Tools
         }
 
         /// <summary>
-        ///     Set the highest Z point at the provided point.
+        ///     Calculates a linear approximation of the ground level at every provided point.
+        /// </summary>
+        /// <param name="points">The points to look at, stored as pairs of X- and Y-coordinates.</param>
+        /// <param name="heights">The array to store the approximate ground level of every point in.</param>
+        /// <exception cref="ArgumentNullException">Thrown if <paramref name="points" /> or <paramref name="heights" /> is null.</exception>
+        /// <exception cref="ArgumentException">Thrown if <paramref name="heights" /> can't hold a result for every point.</exception>
+        public static void FindAverage(float[] points, float[] heights)
+        {
+            FindArray(points, heights, FindMode.Average);
+        }
+
+        /// <summary>
+        ///     Calculates the ground level at the provided point by bilinear interpolation between the surrounding
+        ///     points of the height map.
         /// </summary>
         /// <param name="x">X-coordinate of the point.</param>
         /// <param name="y">Y-coordinate of the point.</param>
-        /// <param name="z">Z-coordinate of the hight at the provided point.</param>
-        /// <returns>True on success; False otherwise.</returns>
-        public static bool SetZ(float x, float y, float z)
+        /// <returns>The interpolated ground level at the given point.</returns>
+        public static float FindBilinear(float x, float y)
         {
+            if (_mode == MapAndreasMode.None) return 0;
+
             if (_usePlugin)
             {
-                return MapAndreasInternal.Instance.SetZ(x, y, z);
+                // The plugin has no interpolation; interpolate between the neighbouring grid points.
+                float gridsize = _mode == MapAndreasMode.Minimal ? 3 : 1;
+                var gridX = (x + 3000)/gridsize;
+                var gridY = (3000 - y)/gridsize;
+                var cellX = (float) Math.Floor(gridX);
+                var cellY = (float) Math.Floor(gridY);
+                var fx = gridX - cellX;
+                var fy = gridY - cellY;
+
+                // Sample the middle of the cells to stay clear of rounding at cell borders.
+                var x0 = cellX*gridsize - 3000 + gridsize/2;
+                var y0 = 3000 - cellY*gridsize - gridsize/2;
+                var h00 = Find(x0, y0);
+                var h01 = Find(x0 + gridsize, y0);
+                var h10 = Find(x0, y0 - gridsize);
+                var h11 = Find(x0 + gridsize, y0 - gridsize);
+
+                var top = h00 + (h01 - h00)*fx;
+                var bottom = h10 + (h11 - h10)*fx;
+                return top + (bottom - top)*fy;
             }
 
-            if (x < -3000.0f || x > 3000.0f || y > 3000.0f || y < -3000.0f) return false;
-            if (z < 0 || z > 655.35) return false;
+            return InteropProvider.HeightMapFindBilinearZ(x, y);
+        }
 
-            // get row/col on 6000x6000 grid
-            var iGridX = ((int) x) + 3000;
-            var iGridY = -(((int) y) - 3000);
-            int iDataPos;
+        /// <summary>
+        ///     Calculates the ground level at the provided point by bilinear interpolation between the surrounding
+        ///     points of the height map.
+        /// </summary>
+        /// <param name="point">The point to look at.</param>
+        /// <returns>The interpolated ground level at the given point.</returns>
+        public static Vector3 FindBilinear(Vector3 point)
+        {
+            return new Vector3(point.X, point.Y, FindBilinear(point.X, point.Y));
+        }
 
-            if (_mode == MapAndreasMode.Full)
+        /// <summary>
+        ///     Calculates the ground level at every provided point by bilinear interpolation between the surrounding
+        ///     points of the height map.
+        /// </summary>
+        /// <param name="points">The points to look at, stored as pairs of X- and Y-coordinates.</param>
+        /// <param name="heights">The array to store the interpolated ground level of every point in.</param>
+        /// <exception cref="ArgumentNullException">Thrown if <paramref name="points" /> or <paramref name="heights" /> is null.</exception>
+        /// <exception cref="ArgumentException">Thrown if <paramref name="heights" /> can't hold a result for every point.</exception>
+        /// <remarks>
+        ///     Unless the MapAndreas plugin is loaded, the points are processed using SIMD instructions (SSE2 or AVX2),
+        ///     which makes this considerably faster than calling <see cref="FindBilinear(float,float)" /> for every point.
+        /// </remarks>
+        public static void FindBilinear(float[] points, float[] heights)
+        {
+            FindArray(points, heights, FindMode.Bilinear);
+        }
+
+        private static void FindArray(float[] points, float[] heights, FindMode mode)
+        {
+            if (points == null) throw new ArgumentNullException(nameof(points));
+            if (heights == null) throw new ArgumentNullException(nameof(heights));
+            if (heights.Length < points.Length/2)
+                throw new ArgumentException("Array is too small to hold the results.", nameof(heights));
+
+            if (_mode == MapAndreasMode.None)
             {
-                iDataPos = (iGridY*6000) + iGridX;
-                _data[iDataPos] = (ushort) (z*100.0f + 0.5); // Add 0.5 to round it properly
-                return true;
+                Array.Clear(heights, 0, points.Length/2);
+                return;
             }
-            if (_mode == MapAndreasMode.Minimal)
+
+            if (_usePlugin)
             {
-                iDataPos = ((iGridY/3)*2000) + iGridX/3; // skip every 2nd and 3rd line
-                _data[iDataPos] = (ushort) (z*100.0f + 0.5); // Add 0.5 to round it properly
-                return true;
+                for (var i = 0; i < points.Length/2; i++)
+                {
+                    var x = points[i*2];
+                    var y = points[i*2 + 1];
+                    switch (mode)
+                    {
+                        case FindMode.Average:
+                            heights[i] = FindAverage(x, y);
+                            break;
+                        case FindMode.Bilinear:
+                            heights[i] = FindBilinear(x, y);
+                            break;
+                        default:
+                            heights[i] = Find(x, y);
+                            break;
+                    }
+                }
+                return;
+            }
+
+            // A single internal call for the whole batch.
+            InteropProvider.HeightMapFindZArray(points, heights, (int) mode);
+        }
+
+        /// <summary>
+        ///     Set the highest Z point at the provided point.
+        /// </summary>
+        /// <param name="x">X-coordinate of the point.</param>
+        /// <param name="y">Y-coordinate of the point.</param>
+        /// <param name="z">Z-coordinate of the hight at the provided point.</param>
+        /// <returns>True on success; False otherwise.</returns>
+        /// <remarks>
+        ///     Changes are only made in memory and are lost once the map is unloaded, unless saved using
+        ///     <see cref="Save" />.
+        /// </remarks>
+        public static bool SetZ(float x, float y, float z)
+        {
+            if (_usePlugin)
+            {
+                return MapAndreasInternal.Instance.SetZ(x, y, z);
             }
 
-            return false;
+            return _mode != MapAndreasMode.None && InteropProvider.HeightMapSetZ(x, y, z);
         }
 
         /// <summary>
@@ -316,20 +367,7 @@ namespace SampSharp.GameMode.Tools
                 return MapAndreasInternal.Instance.SaveCurrentHMap(file);
             }
 
-            try
-            {
-                using (var stream = new FileStream(file, FileMode.Create, FileAccess.Write))
-                {
-                    foreach (var v in _data)
-                        stream.Write(BitConverter.GetBytes(v), 0, 2);
-                }
-
-                return true;
-            }
-            catch (Exception)
-            {
-                return false;
-            }
+            return _mode != MapAndreasMode.None && InteropProvider.HeightMapSave(file);
         }
     }
 }
\ No newline at end of file
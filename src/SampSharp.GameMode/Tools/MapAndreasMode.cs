@@ -35,7 +35,8 @@ namespace SampSharp.GameMode.Tools
         Full = 3,
 
         /// <summary>
-        ///     Does not buffer the map data in memory.
+        ///     Does not buffer the map data in memory. The full file is memory mapped, which makes this mode
+        ///     identical to <see cref="Full" /> unless the MapAndreas plugin is loaded.
         /// </summary>
         NoBuffer = 4
     }
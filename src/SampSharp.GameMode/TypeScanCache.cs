@@ -0,0 +1,206 @@
+﻿// SampSharp
+// Copyright 2017 Tim Potze
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//     http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Linq;
+using System.Reflection;
+using System.Text;
+
+namespace SampSharp.GameMode
+{
+    /// <summary>
+    ///     Caches the results of reflection scans over assemblies on disk. The cache of an assembly is keyed by the
+    ///     module version id (MVID) of the assembly and of the assemblies it references; if any of them is rebuilt,
+    ///     the assembly is scanned again.
+    /// </summary>
+    internal static class TypeScanCache
+    {
+        private const string FileExtension = ".typecache";
+
+        /// <summary>
+        ///     Gets the types in the specified category of the specified assembly. If the category has not been cached,
+        ///     the types are found using the specified scan.
+        /// </summary>
+        public static Type[] GetTypes(Assembly assembly, string category, Func<Assembly, IEnumerable<Type>> scan)
+        {
+            var entry = GetEntry(assembly);
+
+            string[] names;
+            if (entry != null && entry.Values.TryGetValue(category, out names))
+            {
+                var types = new Type[names.Length];
+                for (var i = 0; i < names.Length; i++)
+                    if ((types[i] = assembly.GetType(names[i], false)) == null)
+                        break;
+
+                if (types.All(t => t != null))
+                    return types;
+            }
+
+            var result = scan(assembly).ToArray();
+            Store(entry, category, result.Select(t => t.FullName));
+            return result;
+        }
+
+        /// <summary>
+        ///     Gets the methods in the specified category of the specified assembly. If the category has not been
+        ///     cached, the methods are found using the specified scan.
+        /// </summary>
+        public static MethodInfo[] GetMethods(Assembly assembly, string category,
+            Func<Assembly, IEnumerable<MethodInfo>> scan)
+        {
+            var entry = GetEntry(assembly);
+            var module = assembly.ManifestModule;
+
+            string[] tokens;
+            if (entry != null && entry.Values.TryGetValue(category, out tokens))
+            {
+                var methods = new MethodInfo[tokens.Length];
+                try
+                {
+                    for (var i = 0; i < tokens.Length; i++)
+                        methods[i] = module.ResolveMethod(int.Parse(tokens[i])) as MethodInfo;
+                }
+                catch (ArgumentException)
+                {
+                }
+
+                if (methods.All(m => m != null))
+                    return methods;
+            }
+
+            var result = scan(assembly).ToArray();
+
+            // Metadata tokens are only stored for single-module assemblies.
+            if (result.All(m => m.Module == module))
+                Store(entry, category, result.Select(m => m.MetadataToken.ToString()));
+
+            return result;
+        }
+
+        private static Entry GetEntry(Assembly assembly)
+        {
+            var directory = FrameworkConfiguration.TypeCacheDirectory;
+            if (string.IsNullOrEmpty(directory) || assembly.IsDynamic)
+                return null;
+
+            var path = Path.Combine(directory, assembly.GetName().Name + FileExtension);
+            var entry = new Entry(path, GetKey(assembly));
+
+            try
+            {
+                if (File.Exists(path))
+                    entry.Read();
+            }
+            catch (Exception e)
+            {
+                FrameworkLog.WriteLine(FrameworkMessageLevel.Warning, "Could not read type cache {0}: {1}", path,
+                    e.Message);
+                entry.Values.Clear();
+            }
+
+            return entry;
+        }
+
+        private static void Store(Entry entry, string category, IEnumerable<string> values)
+        {
+            if (entry == null)
+                return;
+
+            entry.Values[category] = values.ToArray();
+
+            try
+            {
+                entry.Write();
+            }
+            catch (Exception e)
+            {
+                FrameworkLog.WriteLine(FrameworkMessageLevel.Warning, "Could not write type cache {0}: {1}",
+                    entry.Path, e.Message);
+            }
+        }
+
+        private static string GetKey(Assembly assembly)
+        {
+            var key = new StringBuilder(assembly.ManifestModule.ModuleVersionId.ToString("N"));
+
+            // Types may inherit attributes and interfaces from referenced assemblies.
+            foreach (var reference in assembly.GetReferencedAssemblies())
+            {
+                Assembly referenced = null;
+                try
+                {
+                    referenced = Assembly.Load(reference);
+                }
+                catch (Exception)
+                {
+                }
+
+                key.Append(' ');
+                key.Append(referenced?.ManifestModule.ModuleVersionId.ToString("N") ?? reference.FullName);
+            }
+
+            return key.ToString();
+        }
+
+        private class Entry
+        {
+            public Entry(string path, string key)
+            {
+                Path = path;
+                Key = key;
+            }
+
+            public string Path { get; }
+
+            public string Key { get; }
+
+            public Dictionary<string, string[]> Values { get; } = new Dictionary<string, string[]>();
+
+            public void Read()
+            {
+                var lines = File.ReadAllLines(Path);
+
+                // A cache built against other builds of the assemblies is stale.
+                if (lines.Length == 0 || lines[0] != Key)
+                    return;
+
+                foreach (var group in lines.Skip(1)
+                    .Select(line => line.Split(new[] {'\t'}, 2))
+                    .Where(parts => parts.Length == 2)
+                    .GroupBy(parts => parts[0]))
+                {
+                    Values[group.Key] = group.Select(parts => parts[1]).Where(value => value.Length > 0).ToArray();
+                }
+            }
+
+            public void Write()
+            {
+                Directory.CreateDirectory(System.IO.Path.GetDirectoryName(System.IO.Path.GetFullPath(Path)));
+
+                // Every category is written at least once so that empty categories are cached as well.
+                var lines = new List<string> {Key};
+                foreach (var pair in Values)
+                {
+                    lines.Add(pair.Key + "\t");
+                    lines.AddRange(pair.Value.Select(value => pair.Key + "\t" + value));
+                }
+
+                File.WriteAllLines(Path, lines);
+            }
+        }
+    }
+}
\ No newline at end of file
@@ -21,6 +21,7 @@ namespace SampSharp.GameMode.World
     /// <summary>
     ///     Represents a SA-MP actor.
     /// </summary>
+    [PoolCapacity(Max)]
     public partial class Actor : IdentifiedPool<Actor>, IWorldObject
     {
         /// <summary>
@@ -28,6 +28,7 @@ namespace SampSharp.GameMode.World
     /// <summary>
     ///     Represents a SA-MP player.
     /// </summary>
+    [PoolCapacity(Max)]
     public partial class BasePlayer : IdentifiedPool<BasePlayer>, IWorldObject
     {
         /// <summary>
@@ -119,6 +120,43 @@ namespace SampSharp.GameMode.World
         /// </summary>
         public static int PoolSize => PlayerInternal.Instance.GetPlayerPoolSize();
 
+        /// <summary>
+        ///     Gets or sets the minimum number of milliseconds between two <see cref="Update" /> events of a player
+        ///     which doesn't have its own <see cref="UpdateInterval" />. The default is read from
+        ///     player_update_interval in server.cfg; 0 raises the event for every update.
+        /// </summary>
+        /// <remarks>
+        ///     Updates arriving within the interval are dropped by the plugin and return the value returned for the
+        ///     last update which wasn't dropped.
+        /// </remarks>
+        public static int DefaultUpdateInterval
+        {
+            get { return InteropProvider.PlayerUpdateGetDefaultInterval(); }
+            set
+            {
+                if (value < 0)
+                    throw new ArgumentOutOfRangeException(nameof(value));
+
+                InteropProvider.PlayerUpdateSetDefaultInterval(value);
+            }
+        }
+
+        /// <summary>
+        ///     Gets or sets the minimum number of milliseconds between two <see cref="Update" /> events of this
+        ///     Player, or -1 to use the <see cref="DefaultUpdateInterval" />.
+        /// </summary>
+        public virtual int UpdateInterval
+        {
+            get { return InteropProvider.PlayerUpdateGetInterval(Id); }
+            set
+            {
+                if (value < -1)
+                    throw new ArgumentOutOfRangeException(nameof(value));
+
+                InteropProvider.PlayerUpdateSetInterval(Id, value);
+            }
+        }
+
         #endregion
 
         #region Players properties
@@ -156,8 +194,18 @@ namespace SampSharp.GameMode.World
         /// </summary>
         public virtual int Interior
         {
-            get { return PlayerInternal.Instance.GetPlayerInterior(Id); }
-            set { PlayerInternal.Instance.SetPlayerInterior(Id, value); }
+            get
+            {
+                int interior;
+                return PlayerSnapshot.TryGetInterior(Id, out interior)
+                    ? interior
+                    : PlayerInternal.Instance.GetPlayerInterior(Id);
+            }
+            set
+            {
+                PlayerInternal.Instance.SetPlayerInterior(Id, value);
+                PlayerSnapshot.SetInterior(Id, value);
+            }
         }
 
         /// <summary>
@@ -165,8 +213,18 @@ namespace SampSharp.GameMode.World
         /// </summary>
         public virtual int VirtualWorld
         {
-            get { return PlayerInternal.Instance.GetPlayerVirtualWorld(Id); }
-            set { PlayerInternal.Instance.SetPlayerVirtualWorld(Id, value); }
+            get
+            {
+                int virtualWorld;
+                return PlayerSnapshot.TryGetVirtualWorld(Id, out virtualWorld)
+                    ? virtualWorld
+                    : PlayerInternal.Instance.GetPlayerVirtualWorld(Id);
+            }
+            set
+            {
+                PlayerInternal.Instance.SetPlayerVirtualWorld(Id, value);
+                PlayerSnapshot.SetVirtualWorld(Id, value);
+            }
         }
 
         /// <summary>
@@ -177,10 +235,15 @@ namespace SampSharp.GameMode.World
             get
             {
                 float health;
-                PlayerInternal.Instance.GetPlayerHealth(Id, out health);
+                if (!PlayerSnapshot.TryGetHealth(Id, out health))
+                    PlayerInternal.Instance.GetPlayerHealth(Id, out health);
                 return health;
             }
-            set { PlayerInternal.Instance.SetPlayerHealth(Id, value); }
+            set
+            {
+                PlayerInternal.Instance.SetPlayerHealth(Id, value);
+                PlayerSnapshot.SetHealth(Id, value);
+            }
         }
 
         /// <summary>
@@ -191,10 +254,15 @@ namespace SampSharp.GameMode.World
             get
             {
                 float armour;
-                PlayerInternal.Instance.GetPlayerArmour(Id, out armour);
+                if (!PlayerSnapshot.TryGetArmour(Id, out armour))
+                    PlayerInternal.Instance.GetPlayerArmour(Id, out armour);
                 return armour;
             }
-            set { PlayerInternal.Instance.SetPlayerArmour(Id, value); }
+            set
+            {
+                PlayerInternal.Instance.SetPlayerArmour(Id, value);
+                PlayerSnapshot.SetArmour(Id, value);
+            }
         }
 
         /// <summary>
@@ -535,11 +603,19 @@ namespace SampSharp.GameMode.World
         {
             get
             {
+                Vector3 position;
+                if (PlayerSnapshot.TryGetPosition(Id, out position))
+                    return position;
+
                 float x, y, z;
                 PlayerInternal.Instance.GetPlayerPos(Id, out x, out y, out z);
                 return new Vector3(x, y, z);
             }
-            set { PlayerInternal.Instance.SetPlayerPos(Id, value.X, value.Y, value.Z); }
+            set
+            {
+                PlayerInternal.Instance.SetPlayerPos(Id, value.X, value.Y, value.Z);
+                PlayerSnapshot.SetPosition(Id, value);
+            }
         }
 
         #endregion
@@ -26,6 +26,7 @@ namespace SampSharp.GameMode.World
     /// <summary>
     ///     Represents a SA-MP vehicle.
     /// </summary>
+    [PoolCapacity(Max)]
     public partial class BaseVehicle : IdentifiedPool<BaseVehicle>, IWorldObject
     {
         /// <summary>
@@ -72,9 +73,13 @@ namespace SampSharp.GameMode.World
         /// <summary>
         ///     Gets the passengers of this <see cref="BaseVehicle" />. (not the driver)
         /// </summary>
+        /// <remarks>
+        ///     The passengers are found among the players connected when this property is read, so the pool can be
+        ///     changed while looping over them.
+        /// </remarks>
         public IEnumerable<BasePlayer> Passengers
         {
-            get { return BasePlayer.All.Where(p => p.Vehicle == this).Where(player => player.VehicleSeat > 0); }
+            get { return BasePlayer.All.Snapshot().Where(p => p.Vehicle == this).Where(player => player.VehicleSeat > 0); }
         }
 
         /// <summary>
@@ -21,6 +21,7 @@ namespace SampSharp.GameMode.World
     /// <summary>
     ///     Represents a gang zone.
     /// </summary>
+    [PoolCapacity(Max)]
     public partial class GangZone : IdentifiedPool<GangZone>
     {
         /// <summary>
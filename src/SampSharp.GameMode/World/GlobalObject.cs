@@ -23,6 +23,7 @@ namespace SampSharp.GameMode.World
     /// <summary>
     ///     Represents a global object
     /// </summary>
+    [PoolCapacity(Max)]
     public partial class GlobalObject : IdentifiedPool<GlobalObject>, IGameObject
     {
         /// <summary>
@@ -21,6 +21,7 @@ namespace SampSharp.GameMode.World
     /// <summary>
     ///     Represents a SA-MP pickup.
     /// </summary>
+    [PoolCapacity(Max)]
     public partial class Pickup : IdentifiedPool<Pickup>, IWorldObject
     {
         /// <summary>
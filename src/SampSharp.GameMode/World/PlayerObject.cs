@@ -23,6 +23,7 @@ namespace SampSharp.GameMode.World
     /// <summary>
     ///     Represents a player-object.
     /// </summary>
+    [PoolCapacity(Max)]
     public partial class PlayerObject : IdentifiedOwnedPool<PlayerObject, BasePlayer>, IGameObject
     {
         /// <summary>
@@ -0,0 +1,195 @@
+﻿// SampSharp
+// Copyright 2017 Tim Potze
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//     http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+using SampSharp.GameMode.API;
+
+namespace SampSharp.GameMode.World
+{
+    /// <summary>
+    ///     Contains methods for capturing the state of all players in a single call to the plugin.
+    /// </summary>
+    /// <remarks>
+    ///     While snapshot mode is enabled, the plugin captures the position, health, armour, virtual world and interior of
+    ///     every connected player at the start of every server tick. The <see cref="BasePlayer.Position" />,
+    ///     <see cref="BasePlayer.Health" />, <see cref="BasePlayer.Armour" />, <see cref="BasePlayer.VirtualWorld" /> and
+    ///     <see cref="BasePlayer.Interior" /> properties then read from the snapshot instead of invoking a native. Values
+    ///     reported by the client after the start of the tick are not visible until the next capture; call
+    ///     <see cref="Capture" /> to refresh the snapshot on demand. Values set through these properties are written to the
+    ///     snapshot as well.
+    /// </remarks>
+    public static class PlayerSnapshot
+    {
+        private const int Capacity = BasePlayer.Max;
+
+        private const int FloatX = 0;
+        private const int FloatY = 1;
+        private const int FloatZ = 2;
+        private const int FloatHealth = 3;
+        private const int FloatArmour = 4;
+        private const int FloatFields = 5;
+
+        private const int IntConnected = 0;
+        private const int IntVirtualWorld = 1;
+        private const int IntInterior = 2;
+        private const int IntFields = 3;
+
+        // Structures of arrays: field f of player p is stored at f * Capacity + p.
+        private static float[] _floats;
+        private static int[] _ints;
+
+        /// <summary>
+        ///     Gets a value indicating whether snapshot mode is enabled.
+        /// </summary>
+        public static bool IsEnabled => _floats != null;
+
+        /// <summary>
+        ///     Enables snapshot mode and captures the state of all players.
+        /// </summary>
+        public static void Enable()
+        {
+            if (IsEnabled)
+                return;
+
+            var floats = new float[FloatFields*Capacity];
+            var ints = new int[IntFields*Capacity];
+
+            InteropProvider.PlayerSnapshotAttach(floats, ints);
+
+            _floats = floats;
+            _ints = ints;
+
+            Capture();
+        }
+
+        /// <summary>
+        ///     Disables snapshot mode.
+        /// </summary>
+        public static void Disable()
+        {
+            if (!IsEnabled)
+                return;
+
+            InteropProvider.PlayerSnapshotDetach();
+
+            _floats = null;
+            _ints = null;
+        }
+
+        /// <summary>
+        ///     Captures the state of all players. Does nothing if snapshot mode is disabled.
+        /// </summary>
+        /// <returns>The number of player slots captured.</returns>
+        public static int Capture()
+        {
+            return IsEnabled ? InteropProvider.PlayerSnapshotCapture() : 0;
+        }
+
+        private static bool IsCaptured(int playerid)
+        {
+            var ints = _ints;
+            return ints != null && (uint) playerid < Capacity && ints[IntConnected*Capacity + playerid] != 0;
+        }
+
+        internal static bool TryGetPosition(int playerid, out Vector3 position)
+        {
+            if (!IsCaptured(playerid))
+            {
+                position = Vector3.Zero;
+                return false;
+            }
+
+            position = new Vector3(_floats[FloatX*Capacity + playerid], _floats[FloatY*Capacity + playerid],
+                _floats[FloatZ*Capacity + playerid]);
+            return true;
+        }
+
+        internal static bool TryGetHealth(int playerid, out float health)
+        {
+            return TryGetFloat(FloatHealth, playerid, out health);
+        }
+
+        internal static bool TryGetArmour(int playerid, out float armour)
+        {
+            return TryGetFloat(FloatArmour, playerid, out armour);
+        }
+
+        internal static bool TryGetVirtualWorld(int playerid, out int virtualWorld)
+        {
+            return TryGetInt(IntVirtualWorld, playerid, out virtualWorld);
+        }
+
+        internal static bool TryGetInterior(int playerid, out int interior)
+        {
+            return TryGetInt(IntInterior, playerid, out interior);
+        }
+
+        internal static void SetPosition(int playerid, Vector3 position)
+        {
+            if (!IsCaptured(playerid))
+                return;
+
+            _floats[FloatX*Capacity + playerid] = position.X;
+            _floats[FloatY*Capacity + playerid] = position.Y;
+            _floats[FloatZ*Capacity + playerid] = position.Z;
+        }
+
+        internal static void SetHealth(int playerid, float health)
+        {
+            if (IsCaptured(playerid))
+                _floats[FloatHealth*Capacity + playerid] = health;
+        }
+
+        internal static void SetArmour(int playerid, float armour)
+        {
+            if (IsCaptured(playerid))
+                _floats[FloatArmour*Capacity + playerid] = armour;
+        }
+
+        internal static void SetVirtualWorld(int playerid, int virtualWorld)
+        {
+            if (IsCaptured(playerid))
+                _ints[IntVirtualWorld*Capacity + playerid] = virtualWorld;
+        }
+
+        internal static void SetInterior(int playerid, int interior)
+        {
+            if (IsCaptured(playerid))
+                _ints[IntInterior*Capacity + playerid] = interior;
+        }
+
+        private static bool TryGetFloat(int field, int playerid, out float value)
+        {
+            if (!IsCaptured(playerid))
+            {
+                value = 0;
+                return false;
+            }
+
+            value = _floats[field*Capacity + playerid];
+            return true;
+        }
+
+        private static bool TryGetInt(int field, int playerid, out int value)
+        {
+            if (!IsCaptured(playerid))
+            {
+                value = 0;
+                return false;
+            }
+
+            value = _ints[field*Capacity + playerid];
+            return true;
+        }
+    }
+}
\ No newline at end of file
@@ -21,6 +21,7 @@ namespace SampSharp.GameMode.World
     /// <summary>
     ///     Represents a player text label.
     /// </summary>
+    [PoolCapacity(Max)]
     public partial class PlayerTextLabel : IdentifiedOwnedPool<PlayerTextLabel, BasePlayer>
     {
         /// <summary>
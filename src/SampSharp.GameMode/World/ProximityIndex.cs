@@ -0,0 +1,214 @@
+﻿// SampSharp
+// Copyright 2017 Tim Potze
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//     http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+using System;
+using System.Collections.Generic;
+using SampSharp.GameMode.API;
+using SampSharp.GameMode.Pools;
+
+namespace SampSharp.GameMode.World
+{
+    /// <summary>
+    ///     Contains methods for finding the players and vehicles near a point using the plugin's proximity index.
+    /// </summary>
+    /// <remarks>
+    ///     The plugin stores the positions of players and vehicles in a uniform grid. The positions of players and
+    ///     vehicles reported as moved by OnPlayerUpdate, OnUnoccupiedVehicleUpdate, OnVehicleSpawn and related
+    ///     callbacks are read once per query, and every position is read again at least once per second. Call
+    ///     <see cref="Invalidate" /> after teleporting players or vehicles or creating vehicles to have the change
+    ///     reflected by the next query.
+    /// </remarks>
+    public static class ProximityIndex
+    {
+        private const int Players = 0;
+        private const int Vehicles = 1;
+
+        private static int[] _buffer = new int[64];
+
+        /// <summary>
+        ///     Marks every position in the index as changed.
+        /// </summary>
+        public static void Invalidate()
+        {
+            InteropProvider.ProximityInvalidate();
+        }
+
+        /// <summary>
+        ///     Adds the players within the specified <paramref name="range" /> of the specified
+        ///     <paramref name="position" /> to the specified <paramref name="result" /> list.
+        /// </summary>
+        /// <param name="position">The position.</param>
+        /// <param name="range">The range.</param>
+        /// <param name="result">The list to add the players to.</param>
+        /// <param name="virtualWorld">The virtual world to search, or -1 to search every virtual world.</param>
+        /// <returns>The number of players added.</returns>
+        public static int GetPlayersInRange(Vector3 position, float range, IList<BasePlayer> result,
+            int virtualWorld = -1)
+        {
+            if (result == null)
+                throw new ArgumentNullException(nameof(result));
+
+            return AddRange(result, QueryRadius(Players, position, range, virtualWorld));
+        }
+
+        /// <summary>
+        ///     Adds the vehicles within the specified <paramref name="range" /> of the specified
+        ///     <paramref name="position" /> to the specified <paramref name="result" /> list.
+        /// </summary>
+        /// <param name="position">The position.</param>
+        /// <param name="range">The range.</param>
+        /// <param name="result">The list to add the vehicles to.</param>
+        /// <param name="virtualWorld">The virtual world to search, or -1 to search every virtual world.</param>
+        /// <returns>The number of vehicles added.</returns>
+        public static int GetVehiclesInRange(Vector3 position, float range, IList<BaseVehicle> result,
+            int virtualWorld = -1)
+        {
+            if (result == null)
+                throw new ArgumentNullException(nameof(result));
+
+            return AddRange(result, QueryRadius(Vehicles, position, range, virtualWorld));
+        }
+
+        /// <summary>
+        ///     Adds the players within the box between the specified <paramref name="min" /> and
+        ///     <paramref name="max" /> corners to the specified <paramref name="result" /> list.
+        /// </summary>
+        /// <param name="min">The minimum corner of the box.</param>
+        /// <param name="max">The maximum corner of the box.</param>
+        /// <param name="result">The list to add the players to.</param>
+        /// <param name="virtualWorld">The virtual world to search, or -1 to search every virtual world.</param>
+        /// <returns>The number of players added.</returns>
+        public static int GetPlayersInBox(Vector3 min, Vector3 max, IList<BasePlayer> result, int virtualWorld = -1)
+        {
+            if (result == null)
+                throw new ArgumentNullException(nameof(result));
+
+            return AddRange(result, QueryBox(Players, min, max, virtualWorld));
+        }
+
+        /// <summary>
+        ///     Adds the vehicles within the box between the specified <paramref name="min" /> and
+        ///     <paramref name="max" /> corners to the specified <paramref name="result" /> list.
+        /// </summary>
+        /// <param name="min">The minimum corner of the box.</param>
+        /// <param name="max">The maximum corner of the box.</param>
+        /// <param name="result">The list to add the vehicles to.</param>
+        /// <param name="virtualWorld">The virtual world to search, or -1 to search every virtual world.</param>
+        /// <returns>The number of vehicles added.</returns>
+        public static int GetVehiclesInBox(Vector3 min, Vector3 max, IList<BaseVehicle> result, int virtualWorld = -1)
+        {
+            if (result == null)
+                throw new ArgumentNullException(nameof(result));
+
+            return AddRange(result, QueryBox(Vehicles, min, max, virtualWorld));
+        }
+
+        /// <summary>
+        ///     Adds at most <paramref name="count" /> players closest to the specified <paramref name="position" /> to
+        ///     the specified <paramref name="result" /> list, closest first.
+        /// </summary>
+        /// <param name="position">The position.</param>
+        /// <param name="count">The maximum number of players to add.</param>
+        /// <param name="result">The list to add the players to.</param>
+        /// <param name="virtualWorld">The virtual world to search, or -1 to search every virtual world.</param>
+        /// <returns>The number of players added.</returns>
+        public static int GetNearestPlayers(Vector3 position, int count, IList<BasePlayer> result,
+            int virtualWorld = -1)
+        {
+            if (result == null)
+                throw new ArgumentNullException(nameof(result));
+
+            return AddRange(result, Nearest(Players, position, count, virtualWorld));
+        }
+
+        /// <summary>
+        ///     Adds at most <paramref name="count" /> vehicles closest to the specified <paramref name="position" /> to
+        ///     the specified <paramref name="result" /> list, closest first.
+        /// </summary>
+        /// <param name="position">The position.</param>
+        /// <param name="count">The maximum number of vehicles to add.</param>
+        /// <param name="result">The list to add the vehicles to.</param>
+        /// <param name="virtualWorld">The virtual world to search, or -1 to search every virtual world.</param>
+        /// <returns>The number of vehicles added.</returns>
+        public static int GetNearestVehicles(Vector3 position, int count, IList<BaseVehicle> result,
+            int virtualWorld = -1)
+        {
+            if (result == null)
+                throw new ArgumentNullException(nameof(result));
+
+            return AddRange(result, Nearest(Vehicles, position, count, virtualWorld));
+        }
+
+        private static int QueryRadius(int kind, Vector3 position, float range, int virtualWorld)
+        {
+            if (range < 0)
+                throw new ArgumentOutOfRangeException(nameof(range));
+
+            int count;
+            while ((count = InteropProvider.ProximityQueryRadius(kind, position.X, position.Y, position.Z, range,
+                virtualWorld, _buffer)) > _buffer.Length)
+                Grow(count);
+
+            return count;
+        }
+
+        private static int QueryBox(int kind, Vector3 min, Vector3 max, int virtualWorld)
+        {
+            int count;
+            while ((count = InteropProvider.ProximityQueryBox(kind, min.X, min.Y, min.Z, max.X, max.Y, max.Z,
+                virtualWorld, _buffer)) > _buffer.Length)
+                Grow(count);
+
+            return count;
+        }
+
+        private static int Nearest(int kind, Vector3 position, int count, int virtualWorld)
+        {
+            if (count < 0)
+                throw new ArgumentOutOfRangeException(nameof(count));
+
+            if (count > _buffer.Length)
+                Grow(count);
+
+            return InteropProvider.ProximityNearest(kind, position.X, position.Y, position.Z, count, virtualWorld,
+                _buffer);
+        }
+
+        private static void Grow(int count)
+        {
+            var length = _buffer.Length;
+            while (length < count)
+                length *= 2;
+
+            _buffer = new int[length];
+        }
+
+        private static int AddRange<T>(IList<T> result, int count) where T : IdentifiedPool<T>
+        {
+            var added = 0;
+            for (var i = 0; i < count; i++)
+            {
+                // Players and vehicles created outside of the game mode have no instance.
+                var instance = IdentifiedPool<T>.Find(_buffer[i]);
+                if (instance == null)
+                    continue;
+
+                result.Add(instance);
+                added++;
+            }
+
+            return added;
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,149 @@
+﻿// SampSharp
+// Copyright 2017 Tim Potze
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//     http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+using SampSharp.GameMode.API;
+using SampSharp.GameMode.Pools;
+
+namespace SampSharp.GameMode.World
+{
+    /// <summary>
+    ///     Represents an object which is streamed to players by the plugin's <see cref="Streamer" />. Unlike
+    ///     <see cref="GlobalObject" />, the number of streamed objects is unlimited.
+    /// </summary>
+    public class StreamedObject : IdentifiedPool<StreamedObject>, IWorldObject
+    {
+        /// <summary>
+        ///     The default stream distance.
+        /// </summary>
+        public const float DefaultStreamDistance = 300;
+
+        private Vector3 _position;
+        private Vector3 _rotation;
+
+        /// <summary>
+        ///     Initializes a new instance of the <see cref="StreamedObject" /> class.
+        /// </summary>
+        /// <param name="modelid">The modelid.</param>
+        /// <param name="position">The position.</param>
+        /// <param name="rotation">The rotation.</param>
+        /// <param name="virtualWorld">The virtual world. Use -1 for all worlds.</param>
+        /// <param name="interior">The interior. Use -1 for all interiors.</param>
+        /// <param name="streamDistance">The distance within which the object is created for a player.</param>
+        /// <param name="drawDistance">The draw distance.</param>
+        public StreamedObject(int modelid, Vector3 position, Vector3 rotation, int virtualWorld = -1, int interior = -1,
+            float streamDistance = DefaultStreamDistance, float drawDistance = 0)
+        {
+            Streamer.AssertStreamDistance(streamDistance);
+
+            ModelId = modelid;
+            VirtualWorld = virtualWorld;
+            Interior = interior;
+            StreamDistance = streamDistance;
+            DrawDistance = drawDistance;
+            _position = position;
+            _rotation = rotation;
+
+            Id = InteropProvider.StreamerAddObject(modelid, position.X, position.Y, position.Z, rotation.X, rotation.Y,
+                rotation.Z, virtualWorld, interior, streamDistance, drawDistance);
+        }
+
+        /// <summary>
+        ///     Gets the model of this <see cref="StreamedObject" />.
+        /// </summary>
+        public int ModelId { get; }
+
+        /// <summary>
+        ///     Gets the virtual world of this <see cref="StreamedObject" />.
+        /// </summary>
+        public int VirtualWorld { get; }
+
+        /// <summary>
+        ///     Gets the interior of this <see cref="StreamedObject" />.
+        /// </summary>
+        public int Interior { get; }
+
+        /// <summary>
+        ///     Gets the distance within which this <see cref="StreamedObject" /> is created for a player.
+        /// </summary>
+        public float StreamDistance { get; }
+
+        /// <summary>
+        ///     Gets the draw distance of this <see cref="StreamedObject" />.
+        /// </summary>
+        public float DrawDistance { get; }
+
+        /// <summary>
+        ///     Gets or sets the position of this <see cref="StreamedObject" />.
+        /// </summary>
+        public virtual Vector3 Position
+        {
+            get { return _position; }
+            set
+            {
+                AssertNotDisposed();
+
+                _position = value;
+                InteropProvider.StreamerSetPosition(Id, value.X, value.Y, value.Z);
+            }
+        }
+
+        /// <summary>
+        ///     Gets or sets the rotation of this <see cref="StreamedObject" />.
+        /// </summary>
+        public virtual Vector3 Rotation
+        {
+            get { return _rotation; }
+            set
+            {
+                AssertNotDisposed();
+
+                _rotation = value;
+                InteropProvider.StreamerSetRotation(Id, value.X, value.Y, value.Z);
+            }
+        }
+
+        /// <summary>
+        ///     Gets a value indicating whether this <see cref="StreamedObject" /> is visible to the specified
+        ///     <paramref name="player" />.
+        /// </summary>
+        /// <param name="player">The player.</param>
+        /// <returns>True if the object has been created for the player; False otherwise.</returns>
+        public virtual bool IsVisibleFor(BasePlayer player)
+        {
+            return Streamer.IsVisible(Id, player);
+        }
+
+        /// <summary>
+        ///     Performs tasks associated with freeing, releasing, or resetting unmanaged resources.
+        /// </summary>
+        /// <param name="disposing">Whether managed resources should be disposed.</param>
+        protected override void Dispose(bool disposing)
+        {
+            base.Dispose(disposing);
+
+            InteropProvider.StreamerRemove(Id);
+        }
+
+        /// <summary>
+        ///     Returns a string that represents the current object.
+        /// </summary>
+        /// <returns>
+        ///     A string that represents the current object.
+        /// </returns>
+        public override string ToString()
+        {
+            return $"StreamedObject(Id: {Id}, Model: {ModelId})";
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,173 @@
+﻿// SampSharp
+// Copyright 2017 Tim Potze
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//     http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+using System;
+using SampSharp.GameMode.API;
+using SampSharp.GameMode.Events;
+using SampSharp.GameMode.Pools;
+
+namespace SampSharp.GameMode.World
+{
+    /// <summary>
+    ///     Represents a pickup which is streamed to players by the plugin's <see cref="Streamer" />. Unlike
+    ///     <see cref="Pickup" />, the number of streamed pickups is unlimited.
+    /// </summary>
+    /// <remarks>
+    ///     The pickup is created as a global pickup while it is visible to at least one player, so it is also visible to
+    ///     other players in range in the same virtual world.
+    /// </remarks>
+    public class StreamedPickup : IdentifiedPool<StreamedPickup>, IWorldObject
+    {
+        /// <summary>
+        ///     The default stream distance.
+        /// </summary>
+        public const float DefaultStreamDistance = 100;
+
+        private Vector3 _position;
+
+        /// <summary>
+        ///     Occurs when the <see cref="OnPickUp" /> is being called.
+        ///     Called when a player picks up this <see cref="StreamedPickup" />.
+        /// </summary>
+        public event EventHandler<PlayerEventArgs> PickUp;
+
+        /// <summary>
+        ///     Initializes a new instance of the <see cref="StreamedPickup" /> class.
+        /// </summary>
+        /// <param name="model">The model of the pickup.</param>
+        /// <param name="type">The pickup spawn type.</param>
+        /// <param name="position">The position.</param>
+        /// <param name="virtualWorld">The virtual world. Use -1 for all worlds.</param>
+        /// <param name="interior">The interior. Use -1 for all interiors.</param>
+        /// <param name="streamDistance">The distance within which the pickup is created for a player.</param>
+        public StreamedPickup(int model, int type, Vector3 position, int virtualWorld = -1, int interior = -1,
+            float streamDistance = DefaultStreamDistance)
+        {
+            Streamer.AssertStreamDistance(streamDistance);
+
+            Model = model;
+            SpawnType = type;
+            VirtualWorld = virtualWorld;
+            Interior = interior;
+            StreamDistance = streamDistance;
+            _position = position;
+
+            Id = InteropProvider.StreamerAddPickup(model, type, position.X, position.Y, position.Z, virtualWorld,
+                interior, streamDistance);
+        }
+
+        /// <summary>
+        ///     Gets the model of this <see cref="StreamedPickup" />.
+        /// </summary>
+        public int Model { get; }
+
+        /// <summary>
+        ///     Gets the spawn type of this <see cref="StreamedPickup" />.
+        /// </summary>
+        public int SpawnType { get; }
+
+        /// <summary>
+        ///     Gets the virtual world of this <see cref="StreamedPickup" />.
+        /// </summary>
+        public int VirtualWorld { get; }
+
+        /// <summary>
+        ///     Gets the interior of this <see cref="StreamedPickup" />.
+        /// </summary>
+        public int Interior { get; }
+
+        /// <summary>
+        ///     Gets the distance within which this <see cref="StreamedPickup" /> is created for a player.
+        /// </summary>
+        public float StreamDistance { get; }
+
+        /// <summary>
+        ///     Gets or sets the position of this <see cref="StreamedPickup" />. Setting the position recreates the pickup.
+        /// </summary>
+        public virtual Vector3 Position
+        {
+            get { return _position; }
+            set
+            {
+                AssertNotDisposed();
+
+                _position = value;
+                InteropProvider.StreamerSetPosition(Id, value.X, value.Y, value.Z);
+            }
+        }
+
+        /// <summary>
+        ///     Gets a value indicating whether this <see cref="StreamedPickup" /> is visible to the specified
+        ///     <paramref name="player" />.
+        /// </summary>
+        /// <param name="player">The player.</param>
+        /// <returns>True if the pickup has been created for the player; False otherwise.</returns>
+        public virtual bool IsVisibleFor(BasePlayer player)
+        {
+            return Streamer.IsVisible(Id, player);
+        }
+
+        /// <summary>
+        ///     Gets the <see cref="StreamedPickup" /> which is currently created as the pickup with the specified
+        ///     <paramref name="pickupid" />.
+        /// </summary>
+        /// <param name="pickupid">The id of the pickup in the server's pickup pool.</param>
+        /// <returns>The streamed pickup, or null if the pickup wasn't created by the streamer.</returns>
+        public static StreamedPickup FindByPickupId(int pickupid)
+        {
+            // Skip the call to the plugin for game modes which don't stream pickups.
+            if (All.Count == 0)
+                return null;
+
+            var id = InteropProvider.StreamerFindPickup(pickupid);
+
+            return id < 0 ? null : Find(id);
+        }
+
+        /// <summary>
+        ///     Performs tasks associated with freeing, releasing, or resetting unmanaged resources.
+        /// </summary>
+        /// <param name="disposing">Whether managed resources should be disposed.</param>
+        protected override void Dispose(bool disposing)
+        {
+            base.Dispose(disposing);
+
+            InteropProvider.StreamerRemove(Id);
+        }
+
+        /// <summary>
+        ///     Returns a string that represents the current object.
+        /// </summary>
+        /// <returns>
+        ///     A string that represents the current object.
+        /// </returns>
+        public override string ToString()
+        {
+            return $"StreamedPickup(Id: {Id}, Model: {Model})";
+        }
+
+        #region Events
+
+        /// <summary>
+        ///     Raises the <see cref="PickUp" /> event.
+        /// </summary>
+        /// <param name="e">An <see cref="PlayerEventArgs" /> that contains the event data. </param>
+        public virtual void OnPickUp(PlayerEventArgs e)
+        {
+            PickUp?.Invoke(this, e);
+        }
+
+        #endregion
+    }
+}
\ No newline at end of file
@@ -0,0 +1,175 @@
+﻿// SampSharp
+// Copyright 2017 Tim Potze
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//     http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+using System;
+using SampSharp.GameMode.API;
+using SampSharp.GameMode.Pools;
+using SampSharp.GameMode.SAMP;
+
+namespace SampSharp.GameMode.World
+{
+    /// <summary>
+    ///     Represents a 3d text label which is streamed to players by the plugin's <see cref="Streamer" />. Unlike
+    ///     <see cref="TextLabel" />, the number of streamed text labels is unlimited.
+    /// </summary>
+    public class StreamedTextLabel : IdentifiedPool<StreamedTextLabel>, IWorldObject
+    {
+        /// <summary>
+        ///     The default stream distance.
+        /// </summary>
+        public const float DefaultStreamDistance = 100;
+
+        private Color _color;
+        private Vector3 _position;
+        private string _text;
+
+        /// <summary>
+        ///     Initializes a new instance of the <see cref="StreamedTextLabel" /> class.
+        /// </summary>
+        /// <param name="text">The text.</param>
+        /// <param name="color">The color.</param>
+        /// <param name="position">The position.</param>
+        /// <param name="drawDistance">The draw distance.</param>
+        /// <param name="virtualWorld">The virtual world. Use -1 for all worlds.</param>
+        /// <param name="interior">The interior. Use -1 for all interiors.</param>
+        /// <param name="testLOS">if set to <c>true</c> the line of sight should be tested before drawing.</param>
+        /// <param name="streamDistance">The distance within which the text label is created for a player.</param>
+        public StreamedTextLabel(string text, Color color, Vector3 position, float drawDistance, int virtualWorld = -1,
+            int interior = -1, bool testLOS = true, float streamDistance = DefaultStreamDistance)
+        {
+            if (text == null)
+                throw new ArgumentNullException(nameof(text));
+            Streamer.AssertStreamDistance(streamDistance);
+
+            _text = text;
+            _color = color;
+            _position = position;
+            DrawDistance = drawDistance;
+            VirtualWorld = virtualWorld;
+            Interior = interior;
+            TestLOS = testLOS;
+            StreamDistance = streamDistance;
+
+            Id = InteropProvider.StreamerAddLabel(text, color, position.X, position.Y, position.Z, drawDistance,
+                virtualWorld, interior, testLOS, streamDistance);
+        }
+
+        /// <summary>
+        ///     Gets or sets the text of this <see cref="StreamedTextLabel" />.
+        /// </summary>
+        public virtual string Text
+        {
+            get { return _text; }
+            set
+            {
+                if (value == null)
+                    throw new ArgumentNullException(nameof(value));
+                AssertNotDisposed();
+
+                _text = value;
+                InteropProvider.StreamerSetLabelText(Id, _text, _color);
+            }
+        }
+
+        /// <summary>
+        ///     Gets or sets the color of this <see cref="StreamedTextLabel" />.
+        /// </summary>
+        public virtual Color Color
+        {
+            get { return _color; }
+            set
+            {
+                AssertNotDisposed();
+
+                _color = value;
+                InteropProvider.StreamerSetLabelText(Id, _text, _color);
+            }
+        }
+
+        /// <summary>
+        ///     Gets or sets the position of this <see cref="StreamedTextLabel" />. Setting the position recreates the
+        ///     text label.
+        /// </summary>
+        public virtual Vector3 Position
+        {
+            get { return _position; }
+            set
+            {
+                AssertNotDisposed();
+
+                _position = value;
+                InteropProvider.StreamerSetPosition(Id, value.X, value.Y, value.Z);
+            }
+        }
+
+        /// <summary>
+        ///     Gets the draw distance of this <see cref="StreamedTextLabel" />.
+        /// </summary>
+        public float DrawDistance { get; }
+
+        /// <summary>
+        ///     Gets the virtual world of this <see cref="StreamedTextLabel" />.
+        /// </summary>
+        public int VirtualWorld { get; }
+
+        /// <summary>
+        ///     Gets the interior of this <see cref="StreamedTextLabel" />.
+        /// </summary>
+        public int Interior { get; }
+
+        /// <summary>
+        ///     Gets a value indicating whether the line of sight is tested before drawing this
+        ///     <see cref="StreamedTextLabel" />.
+        /// </summary>
+        public bool TestLOS { get; }
+
+        /// <summary>
+        ///     Gets the distance within which this <see cref="StreamedTextLabel" /> is created for a player.
+        /// </summary>
+        public float StreamDistance { get; }
+
+        /// <summary>
+        ///     Gets a value indicating whether this <see cref="StreamedTextLabel" /> is visible to the specified
+        ///     <paramref name="player" />.
+        /// </summary>
+        /// <param name="player">The player.</param>
+        /// <returns>True if the text label has been created for the player; False otherwise.</returns>
+        public virtual bool IsVisibleFor(BasePlayer player)
+        {
+            return Streamer.IsVisible(Id, player);
+        }
+
+        /// <summary>
+        ///     Performs tasks associated with freeing, releasing, or resetting unmanaged resources.
+        /// </summary>
+        /// <param name="disposing">Whether managed resources should be disposed.</param>
+        protected override void Dispose(bool disposing)
+        {
+            base.Dispose(disposing);
+
+            InteropProvider.StreamerRemove(Id);
+        }
+
+        /// <summary>
+        ///     Returns a string that represents the current object.
+        /// </summary>
+        /// <returns>
+        ///     A string that represents the current object.
+        /// </returns>
+        public override string ToString()
+        {
+            return $"StreamedTextLabel(Id: {Id}, Text: {Text})";
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,103 @@
+﻿// SampSharp
+// Copyright 2017 Tim Potze
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//     http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+using System;
+using SampSharp.GameMode.API;
+
+namespace SampSharp.GameMode.World
+{
+    /// <summary>
+    ///     Contains methods for controlling the plugin's streamer, which streams an unlimited number of
+    ///     <see cref="StreamedObject" />, <see cref="StreamedPickup" /> and <see cref="StreamedTextLabel" /> instances
+    ///     onto the server's limited entity pools.
+    /// </summary>
+    /// <remarks>
+    ///     Streamed items are stored in a spatial grid in the plugin. At the end of every server tick the plugin
+    ///     recomputes the visible set of every player who moved, changed virtual world or interior, or is near an item
+    ///     that was added, moved or removed, and creates and destroys the entities accordingly. At most 500 objects, 128
+    ///     pickups and 500 text labels, the closest ones, are visible to a player at once.
+    /// </remarks>
+    public static class Streamer
+    {
+        /// <summary>
+        ///     The default number of entities created per player per tick.
+        /// </summary>
+        public const int DefaultBudget = 50;
+
+        /// <summary>
+        ///     The largest allowed stream distance.
+        /// </summary>
+        public const float MaxStreamDistance = 3000;
+
+        private static int _budget = DefaultBudget;
+
+        /// <summary>
+        ///     Gets or sets the number of entities created per player per tick. Items left out are created during the next
+        ///     ticks, closest first.
+        /// </summary>
+        public static int Budget
+        {
+            get { return _budget; }
+            set
+            {
+                if (value < 1)
+                    throw new ArgumentOutOfRangeException(nameof(value));
+
+                InteropProvider.StreamerSetBudget(value);
+                _budget = value;
+            }
+        }
+
+        /// <summary>
+        ///     Updates the items visible to the specified <paramref name="player" /> immediately, for instance after the
+        ///     player has been teleported.
+        /// </summary>
+        /// <param name="player">The player.</param>
+        public static void Update(BasePlayer player)
+        {
+            if (player == null)
+                throw new ArgumentNullException(nameof(player));
+
+            InteropProvider.StreamerUpdate(player.Id);
+        }
+
+        /// <summary>
+        ///     Gets the number of items visible to the specified <paramref name="player" />.
+        /// </summary>
+        /// <param name="player">The player.</param>
+        /// <returns>The number of items visible to the player.</returns>
+        public static int GetVisibleCount(BasePlayer player)
+        {
+            if (player == null)
+                throw new ArgumentNullException(nameof(player));
+
+            return InteropProvider.StreamerGetVisibleCount(player.Id);
+        }
+
+        internal static void AssertStreamDistance(float streamDistance)
+        {
+            if (!(streamDistance > 0 && streamDistance <= MaxStreamDistance))
+                throw new ArgumentOutOfRangeException(nameof(streamDistance), streamDistance,
+                    $"The stream distance must be greater than 0 and at most {MaxStreamDistance}.");
+        }
+
+        internal static bool IsVisible(int id, BasePlayer player)
+        {
+            if (player == null)
+                throw new ArgumentNullException(nameof(player));
+
+            return InteropProvider.StreamerIsVisible(id, player.Id);
+        }
+    }
+}
\ No newline at end of file
@@ -21,6 +21,7 @@ namespace SampSharp.GameMode.World
     /// <summary>
     ///     Represents a 3d text label.
     /// </summary>
+    [PoolCapacity(Max)]
     public partial class TextLabel : IdentifiedPool<TextLabel>
     {
         /// <summary>
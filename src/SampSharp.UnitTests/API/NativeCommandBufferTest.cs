@@ -0,0 +1,186 @@
+﻿// SampSharp
+// Copyright 2017 Tim Potze
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//     http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+using System;
+using System.Collections.Generic;
+using System.Linq;
+using System.Threading;
+using Microsoft.VisualStudio.TestTools.UnitTesting;
+using SampSharp.GameMode.API;
+using SampSharp.GameMode.Controllers;
+
+namespace SampSharp.UnitTests.API
+{
+    [TestClass]
+    public class NativeCommandBufferTest : FakeInteropFixture
+    {
+        private class TestNative : INative
+        {
+            public TestNative(int handle, params Type[] parameterTypes)
+            {
+                Handle = handle;
+                ParameterTypes = parameterTypes;
+            }
+
+            #region Implementation of INative
+
+            public int Handle { get; }
+
+            public string Name => "TestNative";
+
+            public Type[] ParameterTypes { get; }
+
+            public int Invoke(params object[] arguments)
+            {
+                throw new NotImplementedException();
+            }
+
+            public float InvokeFloat(params object[] arguments)
+            {
+                throw new NotImplementedException();
+            }
+
+            public bool InvokeBool(params object[] arguments)
+            {
+                throw new NotImplementedException();
+            }
+
+            #endregion
+        }
+
+        private class BufferInterop : FakeInterop
+        {
+            private int[] _buffer;
+
+            public List<int[]> Flushes { get; } = new List<int[]>();
+
+            #region Overrides of FakeInterop
+
+            public override void CommandBufferAttach(int[] buffer)
+            {
+                CommandBufferFlush();
+                _buffer = buffer;
+            }
+
+            public override int CommandBufferFlush()
+            {
+                if (_buffer == null || _buffer[0] == 0)
+                    return 0;
+
+                Flushes.Add(_buffer.Skip(1).Take(_buffer[0]).ToArray());
+                _buffer[0] = 0;
+                return 1;
+            }
+
+            #endregion
+        }
+
+        // The command buffer stays attached to the provider it was first attached to; share it between the tests.
+        private static readonly BufferInterop Interop = new BufferInterop();
+
+        [TestInitialize]
+        public void Initialize()
+        {
+            // Calls from other threads than the main thread are synchronized; run the tests as the main thread.
+            typeof (SyncController).GetProperty(nameof(SyncController.MainThread))
+                .SetValue(null, Thread.CurrentThread);
+
+            UseInterop(Interop);
+
+            // Empty the buffer left behind by other tests.
+            NativeCommandBuffer.Flush();
+            Interop.Flushes.Clear();
+        }
+
+        [TestMethod]
+        public void EncodeTest()
+        {
+            var native = new TestNative(7, typeof (int), typeof (float), typeof (bool), typeof (string));
+
+            NativeCommandBuffer.Add(native, 3, 1.5f, true, "abc");
+            NativeCommandBuffer.Add(native, 4, 2, false, "");
+
+            Assert.AreEqual(12, NativeCommandBuffer.Length);
+            NativeCommandBuffer.Flush();
+            Assert.AreEqual(0, NativeCommandBuffer.Length);
+
+            CollectionAssert.AreEqual(new[]
+            {
+                7, 3, BitConverter.ToInt32(BitConverter.GetBytes(1.5f), 0), 1, 3, 'a' | ('b' << 16), 'c',
+                7, 4, BitConverter.ToInt32(BitConverter.GetBytes(2f), 0), 0, 0
+            }, Interop.Flushes.Single());
+        }
+
+        [TestMethod]
+        public void ParamsTest()
+        {
+            var native = new TestNative(2, Enumerable.Repeat(typeof (int), 6).ToArray());
+
+            NativeCommandBuffer.Add(native, 1, 2, 3, 4, 5, 6);
+            NativeCommandBuffer.Flush();
+
+            CollectionAssert.AreEqual(new[] {2, 1, 2, 3, 4, 5, 6}, Interop.Flushes.Single());
+        }
+
+        [TestMethod]
+        public void FullBufferTest()
+        {
+            var native = new TestNative(1, typeof (string));
+            var text = new string('x', 10000);
+
+            // Each call takes 5002 elements; the buffer flushes itself when the next call doesn't fit.
+            for (var i = 0; i < 4; i++)
+                NativeCommandBuffer.Add(native, text);
+            NativeCommandBuffer.Flush();
+
+            Assert.AreEqual(4, Interop.Flushes.Sum(f => f.Length)/5002);
+            Assert.IsTrue(Interop.Flushes.Count > 1);
+        }
+
+        [TestMethod]
+        public void LargeCommandTest()
+        {
+            var native = new TestNative(1, typeof (string));
+            var text = new string('x', 100000);
+
+            NativeCommandBuffer.Add(native, text);
+            NativeCommandBuffer.Flush();
+
+            Assert.AreEqual(1 + 1 + 50000, Interop.Flushes.Single().Length);
+        }
+
+        [TestMethod]
+        [ExpectedException(typeof (ArgumentException))]
+        public void ArgumentCountTest()
+        {
+            NativeCommandBuffer.Add(new TestNative(1, typeof (int), typeof (int)), 1);
+        }
+
+        [TestMethod]
+        public void ArgumentTypeTest()
+        {
+            try
+            {
+                NativeCommandBuffer.Add(new TestNative(1, typeof (int)), 1.5f);
+                Assert.Fail("Expected ArgumentException");
+            }
+            catch (ArgumentException)
+            {
+            }
+
+            // The rejected call must not be queued.
+            Assert.AreEqual(0, NativeCommandBuffer.Length);
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,103 @@
+﻿// SampSharp
+// Copyright 2017 Tim Potze
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//     http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+using System;
+using System.Linq;
+using Microsoft.VisualStudio.TestTools.UnitTesting;
+using SampSharp.GameMode.API;
+
+namespace SampSharp.UnitTests.API
+{
+    [TestClass]
+    public class NativeProfilerTest : FakeInteropFixture
+    {
+        private class ProfilerInterop : FakeInterop
+        {
+            public long[][] Stats { get; set; } = new long[0][];
+
+            public int SampleInterval { get; private set; }
+
+            #region Overrides of FakeInterop
+
+            public override void NativeProfilerStart(int sampleInterval)
+            {
+                SampleInterval = sampleInterval;
+            }
+
+            public override void NativeProfilerStop()
+            {
+            }
+
+            public override int NativeProfilerGetStats(long[] result)
+            {
+                for (var i = 0; i < Stats.Length && (i + 1) * 6 <= result.Length; i++)
+                    Array.Copy(Stats[i], 0, result, i * 6, 6);
+
+                return Stats.Length;
+            }
+
+            #endregion
+        }
+
+        private ProfilerInterop _interop;
+
+        [TestInitialize]
+        public void Initialize()
+        {
+            _interop = UseInterop(new ProfilerInterop());
+        }
+
+        [TestMethod]
+        public void StartStopTest()
+        {
+            NativeProfiler.Start(4);
+
+            Assert.IsTrue(NativeProfiler.IsRunning);
+            Assert.AreEqual(4, _interop.SampleInterval);
+
+            NativeProfiler.Stop();
+
+            Assert.IsFalse(NativeProfiler.IsRunning);
+        }
+
+        [TestMethod]
+        [ExpectedException(typeof (ArgumentOutOfRangeException))]
+        public void InvalidSampleIntervalTest()
+        {
+            NativeProfiler.Start(0);
+        }
+
+        [TestMethod]
+        public void GetStatisticsTest()
+        {
+            // More natives than fit in the initial buffer; each handle's timed calls took handle microseconds.
+            _interop.Stats = Enumerable.Range(0, 100)
+                .Select(h => new long[] {h, 16 * (h + 1), h + 1, 1000L * h * (h + 1), 1000L * h, 0})
+                .ToArray();
+
+            var stats = NativeProfiler.GetStatistics();
+
+            Assert.AreEqual(100, stats.Length);
+            CollectionAssert.AreEqual(Enumerable.Range(0, 100).Reverse().ToArray(),
+                stats.Select(s => s.Handle).ToArray());
+
+            var top = stats[0];
+            Assert.AreEqual(1600, top.Calls);
+            Assert.AreEqual(100, top.SampledCalls);
+            Assert.AreEqual(TimeSpan.FromMilliseconds(9.9), top.InvokeTime);
+            Assert.AreEqual(TimeSpan.FromMilliseconds(0.099), top.MaxInvokeTime);
+            Assert.AreEqual(TimeSpan.FromMilliseconds(9.9 * 16), top.EstimatedTotalTime);
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,199 @@
+﻿// SampSharp
+// Copyright 2017 Tim Potze
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//     http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+using System;
+using System.Collections.Generic;
+using System.Linq;
+using System.Reflection;
+using Microsoft.VisualStudio.TestTools.UnitTesting;
+using SampSharp.GameMode;
+using SampSharp.GameMode.API;
+using SampSharp.GameMode.Display;
+using SampSharp.GameMode.SAMP;
+using SampSharp.GameMode.World;
+
+namespace SampSharp.UnitTests.Display
+{
+    [TestClass]
+    public class TextDrawTest
+    {
+        private class RecordingNativeLoader : INativeLoader
+        {
+            private readonly List<RecordingNative> _natives = new List<RecordingNative>();
+
+            public static List<string> Calls { get; } = new List<string>();
+
+            #region Implementation of INativeLoader
+
+            public INative Load(string name, int[] sizes, Type[] parameterTypes)
+            {
+                var native = new RecordingNative(_natives.Count, name, parameterTypes);
+                _natives.Add(native);
+                return native;
+            }
+
+            public INative Get(int handle)
+            {
+                return _natives[handle];
+            }
+
+            public bool Exists(string name)
+            {
+                return true;
+            }
+
+            #endregion
+        }
+
+        private class RecordingNative : INative
+        {
+            public RecordingNative(int handle, string name, Type[] parameterTypes)
+            {
+                Handle = handle;
+                Name = name;
+                ParameterTypes = parameterTypes;
+            }
+
+            #region Implementation of INative
+
+            public int Handle { get; }
+
+            public string Name { get; }
+
+            public Type[] ParameterTypes { get; }
+
+            public int Invoke(params object[] arguments)
+            {
+                RecordingNativeLoader.Calls.Add(Name);
+                return 1;
+            }
+
+            public float InvokeFloat(params object[] arguments)
+            {
+                return Invoke(arguments);
+            }
+
+            public bool InvokeBool(params object[] arguments)
+            {
+                return Invoke(arguments) != 0;
+            }
+
+            #endregion
+        }
+
+        private static readonly RecordingNativeLoader Loader = new RecordingNativeLoader();
+
+        private TextDraw _textDraw;
+
+        private static List<string> Calls => RecordingNativeLoader.Calls;
+
+        private static void UpdateHud(TextDraw textDraw)
+        {
+            textDraw.Text = "Health: 100";
+            textDraw.ForeColor = Color.Red;
+            textDraw.LetterSize = new Vector2(0.5f, 1.5f);
+            textDraw.BoxColor = Color.Black;
+            textDraw.Outline = 1;
+        }
+
+        [TestInitialize]
+        public void Initialize()
+        {
+            Native.NativeLoader = Loader;
+
+            _textDraw = new TextDraw(new Vector2(100, 100), "Health");
+            _textDraw.Show(new BasePlayer());
+            _textDraw.Show(new BasePlayer());
+
+            Calls.Clear();
+        }
+
+        [TestCleanup]
+        public void Cleanup()
+        {
+            _textDraw.Dispose();
+            Native.NativeLoader = new NoNativeLoader();
+        }
+
+        [TestMethod]
+        public void ImmediateTest()
+        {
+            UpdateHud(_textDraw);
+
+            // Every property is applied and shown to both players.
+            Assert.AreEqual(15, Calls.Count);
+            Assert.AreEqual(10, Calls.Count(c => c == "TextDrawShowForPlayer"));
+        }
+
+        [TestMethod]
+        public void RetainedTest()
+        {
+            _textDraw.IsRetained = true;
+            UpdateHud(_textDraw);
+
+            Assert.AreEqual(0, Calls.Count);
+
+            _textDraw.Flush();
+
+            // The properties are applied once and the textdraw is shown once to both players.
+            Assert.AreEqual(7, Calls.Count);
+            Assert.AreEqual(2, Calls.Count(c => c == "TextDrawShowForPlayer"));
+        }
+
+        [TestMethod]
+        public void CoalesceTest()
+        {
+            _textDraw.IsRetained = true;
+            _textDraw.Text = "a";
+            _textDraw.Text = "b";
+            _textDraw.Width = 10;
+            _textDraw.Height = 20;
+            _textDraw.Flush();
+
+            CollectionAssert.AreEqual(
+                new[] {"TextDrawTextSize", "TextDrawSetString", "TextDrawShowForPlayer", "TextDrawShowForPlayer"},
+                Calls);
+        }
+
+        [TestMethod]
+        public void PositionTest()
+        {
+            _textDraw.IsRetained = true;
+            _textDraw.ForeColor = Color.Red;
+            _textDraw.Position = new Vector2(200, 200);
+            _textDraw.Text = "Moved";
+            _textDraw.Flush();
+
+            CollectionAssert.AreEqual(
+                new[]
+                {
+                    "TextDrawDestroy", "TextDrawCreate", "TextDrawColor", "TextDrawShowForPlayer",
+                    "TextDrawShowForPlayer"
+                },
+                Calls);
+        }
+
+        [TestMethod]
+        public void TickTest()
+        {
+            _textDraw.IsRetained = true;
+            UpdateHud(_textDraw);
+
+            typeof (BaseMode).GetMethod("OnTick", BindingFlags.NonPublic | BindingFlags.Instance, null, Type.EmptyTypes,
+                null).Invoke(new TestGameMode(), null);
+
+            Assert.AreEqual(7, Calls.Count);
+        }
+    }
+}
\ No newline at end of file
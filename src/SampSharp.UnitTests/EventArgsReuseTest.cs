@@ -0,0 +1,91 @@
+﻿// SampSharp
+// Copyright 2017 Tim Potze
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//     http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+using System.Collections.Generic;
+using System.Reflection;
+using Microsoft.VisualStudio.TestTools.UnitTesting;
+using SampSharp.GameMode.API;
+using SampSharp.GameMode.Events;
+using SampSharp.GameMode.World;
+
+namespace SampSharp.UnitTests
+{
+    [TestClass]
+    public class EventArgsReuseTest
+    {
+        private static readonly MethodInfo OnPlayerUpdateMethod = typeof (TestGameMode).GetMethod("OnPlayerUpdate",
+            BindingFlags.Instance | BindingFlags.NonPublic, null, new[] {typeof (int)}, null);
+
+        private static bool OnPlayerUpdate(TestGameMode gameMode, int playerid)
+        {
+            return (bool) OnPlayerUpdateMethod.Invoke(gameMode, new object[] {playerid});
+        }
+
+        [TestInitialize]
+        public void Initialize()
+        {
+            Native.NativeLoader = new NoNativeLoader();
+            BasePlayer.Register<BasePlayer>();
+        }
+
+        [TestMethod]
+        public void ReuseTest()
+        {
+            var gameMode = new TestGameMode {ReuseEventArgs = true};
+            var received = new List<PlayerUpdateEventArgs>();
+
+            gameMode.PlayerUpdate += (sender, args) =>
+            {
+                // The first update prevents propagation; the flag must not leak into the next update.
+                Assert.IsFalse(args.PreventPropagation);
+                args.PreventPropagation = received.Count == 0;
+                received.Add(args);
+            };
+
+            Assert.IsFalse(OnPlayerUpdate(gameMode, 0));
+            Assert.IsTrue(OnPlayerUpdate(gameMode, 0));
+            Assert.AreSame(received[0], received[1]);
+        }
+
+        [TestMethod]
+        public void NoReuseTest()
+        {
+            var gameMode = new TestGameMode();
+            var received = new List<PlayerUpdateEventArgs>();
+
+            gameMode.PlayerUpdate += (sender, args) => received.Add(args);
+
+            OnPlayerUpdate(gameMode, 0);
+            OnPlayerUpdate(gameMode, 0);
+            Assert.AreNotSame(received[0], received[1]);
+        }
+
+        [TestMethod]
+        public void ReentrantTest()
+        {
+            var gameMode = new TestGameMode {ReuseEventArgs = true};
+            var received = new List<PlayerUpdateEventArgs>();
+
+            gameMode.PlayerUpdate += (sender, args) =>
+            {
+                received.Add(args);
+                if (received.Count == 1)
+                    OnPlayerUpdate(gameMode, 0);
+            };
+
+            OnPlayerUpdate(gameMode, 0);
+            Assert.AreNotSame(received[0], received[1]);
+        }
+    }
+}
\ No newline at end of file
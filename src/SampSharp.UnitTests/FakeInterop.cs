@@ -0,0 +1,266 @@
+﻿// SampSharp
+// Copyright 2017 Tim Potze
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//     http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+using System;
+using SampSharp.GameMode.API;
+
+namespace SampSharp.UnitTests
+{
+    public class FakeInterop : IInterop
+    {
+        #region Implementation of IInterop
+
+        public virtual int LoadNative(string name, string format, int[] sizes)
+        {
+            throw new NotImplementedException();
+        }
+
+        public virtual int InvokeNative(int handle, object[] args)
+        {
+            throw new NotImplementedException();
+        }
+
+        public virtual bool NativeExists(string name)
+        {
+            throw new NotImplementedException();
+        }
+
+        public virtual bool RegisterExtension(object extension)
+        {
+            throw new NotImplementedException();
+        }
+
+        public virtual int SetTimer(int interval, bool repeat, object args)
+        {
+            throw new NotImplementedException();
+        }
+
+        public virtual bool KillTimer(int timerid)
+        {
+            throw new NotImplementedException();
+        }
+
+        public virtual void Print(string msg)
+        {
+            throw new NotImplementedException();
+        }
+
+        public virtual void SetCodepage(string codepage)
+        {
+            throw new NotImplementedException();
+        }
+
+        public virtual bool HeightMapLoad(string path)
+        {
+            throw new NotImplementedException();
+        }
+
+        public virtual void HeightMapUnload()
+        {
+            throw new NotImplementedException();
+        }
+
+        public virtual float HeightMapFindZ(float x, float y)
+        {
+            throw new NotImplementedException();
+        }
+
+        public virtual float HeightMapFindAverageZ(float x, float y)
+        {
+            throw new NotImplementedException();
+        }
+
+        public virtual float HeightMapFindBilinearZ(float x, float y)
+        {
+            throw new NotImplementedException();
+        }
+
+        public virtual void HeightMapFindZArray(float[] points, float[] heights, int mode)
+        {
+            throw new NotImplementedException();
+        }
+
+        public virtual bool HeightMapSetZ(float x, float y, float z)
+        {
+            throw new NotImplementedException();
+        }
+
+        public virtual bool HeightMapSave(string path)
+        {
+            throw new NotImplementedException();
+        }
+
+        public virtual void PlayerSnapshotAttach(float[] floats, int[] ints)
+        {
+            throw new NotImplementedException();
+        }
+
+        public virtual void PlayerSnapshotDetach()
+        {
+            throw new NotImplementedException();
+        }
+
+        public virtual int PlayerSnapshotCapture()
+        {
+            throw new NotImplementedException();
+        }
+
+        public virtual void CommandBufferAttach(int[] buffer)
+        {
+            throw new NotImplementedException();
+        }
+
+        public virtual void CommandBufferDetach()
+        {
+            throw new NotImplementedException();
+        }
+
+        public virtual int CommandBufferFlush()
+        {
+            throw new NotImplementedException();
+        }
+
+        public virtual int StreamerAddObject(int modelid, float x, float y, float z, float rotationX, float rotationY,
+            float rotationZ, int virtualWorld, int interior, float streamDistance, float drawDistance)
+        {
+            throw new NotImplementedException();
+        }
+
+        public virtual int StreamerAddPickup(int modelid, int type, float x, float y, float z, int virtualWorld,
+            int interior, float streamDistance)
+        {
+            throw new NotImplementedException();
+        }
+
+        public virtual int StreamerAddLabel(string text, int color, float x, float y, float z, float drawDistance,
+            int virtualWorld, int interior, bool testLOS, float streamDistance)
+        {
+            throw new NotImplementedException();
+        }
+
+        public virtual bool StreamerRemove(int id)
+        {
+            throw new NotImplementedException();
+        }
+
+        public virtual bool StreamerSetPosition(int id, float x, float y, float z)
+        {
+            throw new NotImplementedException();
+        }
+
+        public virtual bool StreamerSetRotation(int id, float rotationX, float rotationY, float rotationZ)
+        {
+            throw new NotImplementedException();
+        }
+
+        public virtual bool StreamerSetLabelText(int id, string text, int color)
+        {
+            throw new NotImplementedException();
+        }
+
+        public virtual void StreamerSetBudget(int budget)
+        {
+            throw new NotImplementedException();
+        }
+
+        public virtual void StreamerUpdate(int playerid)
+        {
+            throw new NotImplementedException();
+        }
+
+        public virtual bool StreamerIsVisible(int id, int playerid)
+        {
+            throw new NotImplementedException();
+        }
+
+        public virtual int StreamerFindPickup(int pickupid)
+        {
+            throw new NotImplementedException();
+        }
+
+        public virtual int StreamerGetVisibleCount(int playerid)
+        {
+            throw new NotImplementedException();
+        }
+
+        public virtual int ProximityQueryRadius(int kind, float x, float y, float z, float range, int world,
+            int[] result)
+        {
+            throw new NotImplementedException();
+        }
+
+        public virtual int ProximityQueryBox(int kind, float minX, float minY, float minZ, float maxX, float maxY,
+            float maxZ, int world, int[] result)
+        {
+            throw new NotImplementedException();
+        }
+
+        public virtual int ProximityNearest(int kind, float x, float y, float z, int count, int world, int[] result)
+        {
+            throw new NotImplementedException();
+        }
+
+        public virtual void ProximityInvalidate()
+        {
+            throw new NotImplementedException();
+        }
+
+        public virtual void PlayerUpdateSetDefaultInterval(int interval)
+        {
+            throw new NotImplementedException();
+        }
+
+        public virtual int PlayerUpdateGetDefaultInterval()
+        {
+            throw new NotImplementedException();
+        }
+
+        public virtual bool PlayerUpdateSetInterval(int playerid, int interval)
+        {
+            throw new NotImplementedException();
+        }
+
+        public virtual int PlayerUpdateGetInterval(int playerid)
+        {
+            throw new NotImplementedException();
+        }
+
+        public virtual void NativeProfilerStart(int sampleInterval)
+        {
+            throw new NotImplementedException();
+        }
+
+        public virtual void NativeProfilerStop()
+        {
+            throw new NotImplementedException();
+        }
+
+        public virtual void NativeProfilerReset()
+        {
+            throw new NotImplementedException();
+        }
+
+        public virtual int NativeProfilerGetStats(long[] result)
+        {
+            throw new NotImplementedException();
+        }
+
+        public virtual void NativeProfilerDump(int count)
+        {
+            throw new NotImplementedException();
+        }
+
+        #endregion
+    }
+}
\ No newline at end of file
@@ -0,0 +1,53 @@
+﻿// SampSharp
+// Copyright 2017 Tim Potze
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//     http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+using Microsoft.VisualStudio.TestTools.UnitTesting;
+using SampSharp.GameMode.API;
+
+namespace SampSharp.UnitTests
+{
+    /// <summary>
+    ///     Base class of tests which run against a <see cref="FakeInterop" />. The interop provider is restored after
+    ///     every test.
+    /// </summary>
+    public abstract class FakeInteropFixture
+    {
+        private IInterop _provider;
+
+        [TestInitialize]
+        public void SaveInteropProvider()
+        {
+            Native.NativeLoader = new NoNativeLoader();
+            _provider = InteropProvider.Provider;
+        }
+
+        [TestCleanup]
+        public void RestoreInteropProvider()
+        {
+            InteropProvider.Provider = _provider;
+        }
+
+        /// <summary>
+        ///     Makes the specified <paramref name="interop" /> the interop provider for the rest of the test.
+        /// </summary>
+        /// <typeparam name="T">The type of the interop.</typeparam>
+        /// <param name="interop">The interop.</param>
+        /// <returns>The interop.</returns>
+        protected static T UseInterop<T>(T interop) where T : FakeInterop
+        {
+            InteropProvider.Provider = interop;
+            return interop;
+        }
+    }
+}
\ No newline at end of file
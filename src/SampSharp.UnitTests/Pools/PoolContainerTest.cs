@@ -0,0 +1,123 @@
+﻿// SampSharp
+// Copyright 2017 Tim Potze
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//     http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+using System.Linq;
+using Microsoft.VisualStudio.TestTools.UnitTesting;
+using SampSharp.GameMode.Pools;
+
+namespace SampSharp.UnitTests.Pools
+{
+    [TestClass]
+    public class PoolContainerTest
+    {
+        private class Item
+        {
+        }
+
+        [TestMethod]
+        public void GetTest()
+        {
+            var container = new PoolContainer<Item>(100);
+            var a = new Item();
+            var b = new Item();
+            var c = new Item();
+
+            container.Add(0, a);
+            container.Add(99, b);
+            container.Add(100, c);
+
+            Assert.AreEqual(a, container.Get(0));
+            Assert.AreEqual(b, container.Get(99));
+            Assert.AreEqual(c, container.Get(100));
+            Assert.IsNull(container.Get(1));
+            Assert.IsNull(container.Get(5000));
+            Assert.AreEqual(3, container.Count);
+        }
+
+        [TestMethod]
+        public void EnumerateTest()
+        {
+            var container = new PoolContainer<Item>(200);
+            var items = Enumerable.Range(0, 10).Select(i => new Item()).ToArray();
+            var unidentified = new Item();
+
+            // Keys spread over multiple words of the occupancy bitset and the dictionary.
+            var keys = new[] {0, 1, 63, 64, 65, 127, 128, 199, 200, 1000};
+            for (var i = 0; i < keys.Length; i++)
+                container.Add(keys[i], items[i]);
+            container.Add(PoolContainer<Item>.UnidentifiedId, unidentified);
+
+            CollectionAssert.AreEqual(items.Concat(new[] {unidentified}).ToArray(), container.ToArray());
+        }
+
+        [TestMethod]
+        public void RemoveTest()
+        {
+            var container = new PoolContainer<Item>(100);
+            var a = new Item();
+
+            container.Add(64, a);
+
+            Assert.IsTrue(container.Contains(64));
+            Assert.IsTrue(container.Remove(64));
+            Assert.IsFalse(container.Remove(64));
+            Assert.IsFalse(container.Contains(64));
+            Assert.AreEqual(0, container.Count);
+            Assert.AreEqual(0, container.Count());
+        }
+
+        [TestMethod]
+        public void MoveTest()
+        {
+            var container = new PoolContainer<Item>(100);
+            var a = new Item();
+
+            container.Add(PoolContainer<Item>.UnidentifiedId, a);
+            container.MoveUnidentified(a, 10);
+            Assert.AreEqual(a, container.Get(10));
+
+            container.Move(10, 150);
+            Assert.IsNull(container.Get(10));
+            Assert.AreEqual(a, container.Get(150));
+
+            container.Move(150, 20);
+            Assert.IsNull(container.Get(150));
+            Assert.AreEqual(a, container.Get(20));
+            Assert.AreEqual(1, container.Count);
+        }
+
+        [TestMethod]
+        [ExpectedException(typeof (System.ArgumentException))]
+        public void DuplicateKeyTest()
+        {
+            var container = new PoolContainer<Item>(100);
+
+            container.Add(5, new Item());
+            container.Add(5, new Item());
+        }
+
+        [TestMethod]
+        [ExpectedException(typeof (System.InvalidOperationException))]
+        public void ModifyDuringEnumerationTest()
+        {
+            var container = new PoolContainer<Item>(100);
+
+            container.Add(1, new Item());
+            container.Add(2, new Item());
+
+            foreach (var item in container)
+                container.Remove(2);
+        }
+    }
+}
\ No newline at end of file
@@ -13,6 +13,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 using System;
+using System.Linq;
 using Microsoft.VisualStudio.TestTools.UnitTesting;
 using SampSharp.GameMode.SAMP.Commands.ParameterTypes;
 
@@ -26,12 +27,36 @@ namespace SampSharp.UnitTests.SAMP.Commands.Arguments
 
             Prepare(parameter);
 
+            var originalCommandText = commandText;
             object output;
             var result = parameter.Parse(ref commandText, out output);
 
             Assert.AreEqual(expectedResult, result, "Unexpected result");
             Assert.AreEqual(expectedOutput, output, "Unexpected output");
             Assert.AreEqual(expectedRemainder, commandText, "Unexpected command text remainder");
+
+            TestOffset(parameter, originalCommandText, expectedResult, expectedOutput, expectedRemainder);
+        }
+
+        private static void TestOffset(T parameter, string commandText, bool expectedResult, object expectedOutput,
+            string expectedRemainder)
+        {
+            // Parse the same text trough ICommandParameterType<>.Parse, prefixed with text which should be skipped.
+            var type = typeof (T).GetInterfaces()
+                .FirstOrDefault(i => i.IsGenericType && i.GetGenericTypeDefinition() == typeof (ICommandParameterType<>));
+
+            if (type == null)
+                return;
+
+            const string prefix = "/cmd ";
+            var arguments = new object[] {prefix + commandText, prefix.Length, null};
+            var result = (bool) type.GetMethod("Parse").Invoke(parameter, arguments);
+            var offset = (int) arguments[1];
+
+            Assert.AreEqual(expectedResult, result, "Unexpected result at offset");
+            Assert.AreEqual(expectedOutput, result ? arguments[2] : null, "Unexpected output at offset");
+            Assert.AreEqual(expectedRemainder, (prefix + commandText).Substring(result ? offset : prefix.Length),
+                "Unexpected command text remainder at offset");
         }
 
         protected virtual void Prepare(T commandParameterType)
@@ -0,0 +1,200 @@
+﻿// SampSharp
+// Copyright 2017 Tim Potze
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//     http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+using Microsoft.VisualStudio.TestTools.UnitTesting;
+using SampSharp.GameMode.API;
+using SampSharp.GameMode.SAMP.Commands;
+using SampSharp.GameMode.World;
+
+namespace SampSharp.UnitTests.SAMP.Commands
+{
+    [TestClass]
+    public class CommandRouterTest
+    {
+        public static void NoArguments(BasePlayer player)
+        {
+        }
+
+        public static void OneArgument(BasePlayer player, int value)
+        {
+        }
+
+        private static DefaultCommand CreateCommand(string methodName, bool ignoreCase, params string[] paths)
+        {
+            var names = new CommandPath[paths.Length];
+            for (var i = 0; i < paths.Length; i++)
+                names[i] = new CommandPath(paths[i]);
+
+            return new DefaultCommand(names, null, ignoreCase, null, typeof (CommandRouterTest).GetMethod(methodName),
+                null);
+        }
+
+        private class TextCommand : ICommand
+        {
+            private readonly string _text;
+
+            public TextCommand(string text)
+            {
+                _text = text;
+            }
+
+            public CommandCallableResponse CanInvoke(BasePlayer player, string commandText)
+            {
+                return commandText == _text ? CommandCallableResponse.True : CommandCallableResponse.False;
+            }
+
+            public bool Invoke(BasePlayer player, string commandText)
+            {
+                return true;
+            }
+        }
+
+        private class AliasCommand : DefaultCommand
+        {
+            public AliasCommand()
+                : base(new[] {new CommandPath("teleport")}, null, true, null,
+                    typeof (CommandRouterTest).GetMethod("NoArguments"), null)
+            {
+            }
+
+            public override CommandCallableResponse CanInvoke(BasePlayer player, string commandText)
+            {
+                return commandText == "/tp" ? CommandCallableResponse.True : base.CanInvoke(player, commandText);
+            }
+        }
+
+        [TestInitialize]
+        public void Initialize()
+        {
+            Native.NativeLoader = new NoNativeLoader();
+        }
+
+        [TestMethod]
+        public void FindByPathTest()
+        {
+            var router = new CommandRouter();
+            var help = CreateCommand("NoArguments", true, "help");
+            var admin = CreateCommand("NoArguments", true, "admin kick", "ak");
+            router.Add(help);
+            router.Add(admin);
+
+            Assert.AreEqual(help, router.Find(new BasePlayer(), "/help"));
+            Assert.AreEqual(admin, router.Find(new BasePlayer(), "/admin kick"));
+            Assert.AreEqual(admin, router.Find(new BasePlayer(), "/ak"));
+            Assert.IsNull(router.Find(new BasePlayer(), "/admin"));
+            Assert.IsNull(router.Find(new BasePlayer(), "/helpme"));
+            Assert.IsNull(router.Find(new BasePlayer(), "/hel"));
+            Assert.IsNull(router.Find(new BasePlayer(), "/"));
+        }
+
+        [TestMethod]
+        public void FindIgnoreCaseTest()
+        {
+            var router = new CommandRouter();
+            var ignoreCase = CreateCommand("NoArguments", true, "help");
+            var matchCase = CreateCommand("NoArguments", false, "Stats");
+            router.Add(ignoreCase);
+            router.Add(matchCase);
+
+            Assert.AreEqual(ignoreCase, router.Find(new BasePlayer(), "/HeLp"));
+            Assert.AreEqual(matchCase, router.Find(new BasePlayer(), "/Stats"));
+            Assert.IsNull(router.Find(new BasePlayer(), "/stats"));
+        }
+
+        [TestMethod]
+        public void FindWithArgumentsTest()
+        {
+            var router = new CommandRouter();
+            var command = CreateCommand("OneArgument", true, "give money");
+            router.Add(command);
+
+            Assert.AreEqual(command, router.Find(new BasePlayer(), "/give money 100"));
+
+            // Missing arguments; the command is returned as an optional candidate.
+            Assert.AreEqual(command, router.Find(new BasePlayer(), "/give money"));
+            Assert.IsNull(router.Find(new BasePlayer(), "/give moneys 100"));
+        }
+
+        [TestMethod]
+        public void FindAmbiguousTest()
+        {
+            var router = new CommandRouter();
+            var group = CreateCommand("OneArgument", true, "vehicle");
+            var nested = CreateCommand("OneArgument", true, "vehicle spawn");
+            router.Add(group);
+            router.Add(nested);
+
+            Assert.AreEqual(group, router.Find(new BasePlayer(), "/vehicle 5"));
+
+            // "spawn 5" is not a valid argument for the group command.
+            Assert.AreEqual(nested, router.Find(new BasePlayer(), "/vehicle spawn 5"));
+
+            // Neither can be invoked; the last optional candidate is found.
+            Assert.AreEqual(nested, router.Find(new BasePlayer(), "/vehicle spawn x"));
+            Assert.AreEqual(group, router.Find(new BasePlayer(), "/vehicle x"));
+        }
+
+        [TestMethod]
+        public void FindInOrderOfRegistrationTest()
+        {
+            var router = new CommandRouter();
+            var first = CreateCommand("NoArguments", true, "a");
+            var second = CreateCommand("NoArguments", true, "a b");
+            router.Add(first);
+            router.Add(second);
+
+            // Both can be invoked; the first registered command is found.
+            Assert.AreEqual(first, router.Find(new BasePlayer(), "/a b"));
+        }
+
+        [TestMethod]
+        public void FindCustomCommandTest()
+        {
+            var router = new CommandRouter();
+            var custom = new TextCommand("/custom");
+            router.Add(custom);
+
+            Assert.AreEqual(custom, router.Find(new BasePlayer(), "/custom"));
+            Assert.IsNull(router.Find(new BasePlayer(), "/other"));
+        }
+
+        [TestMethod]
+        public void FindOverriddenCanInvokeTest()
+        {
+            var router = new CommandRouter();
+            var help = CreateCommand("NoArguments", true, "help");
+            var alias = new AliasCommand();
+            router.Add(help);
+            router.Add(alias);
+
+            Assert.AreEqual(alias, router.Find(new BasePlayer(), "/tp"));
+            Assert.AreEqual(alias, router.Find(new BasePlayer(), "/teleport"));
+            Assert.AreEqual(help, router.Find(new BasePlayer(), "/help"));
+        }
+
+        [TestMethod]
+        public void FindMergesInOrderOfRegistrationTest()
+        {
+            var router = new CommandRouter();
+            var indexed = CreateCommand("NoArguments", true, "custom");
+            var custom = new TextCommand("/custom");
+            router.Add(custom);
+            router.Add(indexed);
+
+            // Both can be invoked; the unindexed command was registered first.
+            Assert.AreEqual(custom, router.Find(new BasePlayer(), "/custom"));
+            Assert.AreEqual(indexed, router.Find(new BasePlayer(), "/CUSTOM"));
+        }
+    }
+}
\ No newline at end of file
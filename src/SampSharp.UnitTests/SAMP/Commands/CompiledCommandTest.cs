@@ -0,0 +1,124 @@
+﻿// SampSharp
+// Copyright 2017 Tim Potze
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//     http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+using System.Globalization;
+using Microsoft.VisualStudio.TestTools.UnitTesting;
+using SampSharp.GameMode.API;
+using SampSharp.GameMode.SAMP.Commands;
+using SampSharp.GameMode.World;
+
+namespace SampSharp.UnitTests.SAMP.Commands
+{
+    [TestClass]
+    public class CompiledCommandTest
+    {
+        public enum TestEnum
+        {
+            ValueA,
+            ValueB
+        }
+
+        private static string _result;
+
+        public static void Arguments(BasePlayer player, int a, float b, TestEnum c, string d)
+        {
+            _result = string.Format(CultureInfo.InvariantCulture, "{0}|{1}|{2}|{3}", a, b, c, d);
+        }
+
+        public static bool Optional(BasePlayer player, int a, int b = 5)
+        {
+            _result = $"{a}|{b}";
+            return false;
+        }
+
+        public static int NonBoolean(BasePlayer player, string word, string text)
+        {
+            _result = $"{word}|{text}";
+            return 0;
+        }
+
+        private static DefaultCommand CreateCommand(string methodName, bool compiled)
+        {
+            return new DefaultCommand(new[] {new CommandPath("cmd")}, null, true, null,
+                typeof (CompiledCommandTest).GetMethod(methodName), null) {UseCompiledInvoker = compiled};
+        }
+
+        private static void TestInvoke(string methodName, string commandText, bool expectedResult,
+            string expectedArguments)
+        {
+            foreach (var compiled in new[] {false, true})
+            {
+                _result = null;
+
+                var command = CreateCommand(methodName, compiled);
+
+                Assert.AreEqual(CommandCallableResponse.True, command.CanInvoke(new BasePlayer(), commandText));
+                Assert.AreEqual(expectedResult, command.Invoke(new BasePlayer(), commandText));
+                Assert.AreEqual(expectedArguments, _result, compiled ? "Compiled invoker" : "Reflection invoker");
+            }
+        }
+
+        private static void TestCanInvoke(string methodName, string commandText, CommandCallableResponse expected)
+        {
+            foreach (var compiled in new[] {false, true})
+            {
+                var command = CreateCommand(methodName, compiled);
+
+                Assert.AreEqual(expected, command.CanInvoke(new BasePlayer(), commandText),
+                    compiled ? "Compiled invoker" : "Reflection invoker");
+            }
+        }
+
+        [TestInitialize]
+        public void Initialize()
+        {
+            Native.NativeLoader = new NoNativeLoader();
+        }
+
+        [TestMethod]
+        public void ArgumentsTest()
+        {
+            TestInvoke("Arguments", "/cmd 12 3.5 ValueB some text ", true, "12|3.5|ValueB|some text");
+        }
+
+        [TestMethod]
+        public void CaseTest()
+        {
+            TestInvoke("Arguments", "/CMD 0x1f 1,5 b text", true, "31|1.5|ValueB|text");
+        }
+
+        [TestMethod]
+        public void OptionalTest()
+        {
+            TestInvoke("Optional", "/cmd 1", false, "1|5");
+            TestInvoke("Optional", "/cmd 1 2", false, "1|2");
+        }
+
+        [TestMethod]
+        public void NonBooleanResultTest()
+        {
+            TestInvoke("NonBoolean", "/cmd one two three", true, "one|two three");
+        }
+
+        [TestMethod]
+        public void CanInvokeTest()
+        {
+            TestCanInvoke("Arguments", "/cmd 12 3.5 ValueB", CommandCallableResponse.Optional);
+            TestCanInvoke("Arguments", "/cmd text 3.5 ValueB text", CommandCallableResponse.Optional);
+            TestCanInvoke("Arguments", "/other 12 3.5 ValueB text", CommandCallableResponse.False);
+            TestCanInvoke("Optional", "/cmd", CommandCallableResponse.Optional);
+            TestCanInvoke("Optional", "/cmd 1", CommandCallableResponse.True);
+        }
+    }
+}
\ No newline at end of file
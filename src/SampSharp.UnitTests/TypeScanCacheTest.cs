@@ -0,0 +1,99 @@
+﻿// SampSharp
+// Copyright 2017 Tim Potze
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//     http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+using System;
+using System.IO;
+using System.Linq;
+using Microsoft.VisualStudio.TestTools.UnitTesting;
+using SampSharp.GameMode.API;
+using SampSharp.GameMode.SAMP;
+using SampSharp.GameMode.SAMP.Commands;
+using SampSharp.GameMode.World;
+
+namespace SampSharp.UnitTests
+{
+    [TestClass]
+    public class TypeScanCacheTest
+    {
+        private string _directory;
+
+        private string CacheFile => Path.Combine(_directory, typeof (TypeScanCacheTest).Assembly.GetName().Name + ".typecache");
+
+        [Command("typecachetest")]
+        public static void TypeCacheTestCommand(BasePlayer player)
+        {
+        }
+
+        private static string[] RegisterCommands()
+        {
+            var manager = new CommandsManager(new TestGameMode());
+            manager.RegisterCommands<TypeScanCacheTest>();
+
+            return manager.Commands.Select(c => c.ToString()).ToArray();
+        }
+
+        [TestInitialize]
+        public void Initialize()
+        {
+            Native.NativeLoader = new NoNativeLoader();
+
+            _directory = Path.Combine(Path.GetTempPath(), Path.GetRandomFileName());
+            Server.Config.Set("typecache", _directory);
+        }
+
+        [TestCleanup]
+        public void Cleanup()
+        {
+            Server.Config.Set("typecache", string.Empty);
+
+            if (Directory.Exists(_directory))
+                Directory.Delete(_directory, true);
+        }
+
+        [TestMethod]
+        public void ColdBootTest()
+        {
+            var commands = RegisterCommands();
+
+            Assert.AreEqual(1, commands.Length);
+            Assert.IsTrue(File.Exists(CacheFile));
+            Assert.IsTrue(File.ReadAllLines(CacheFile).Contains("commands\t" +
+                typeof (TypeScanCacheTest).GetMethod(nameof(TypeCacheTestCommand)).MetadataToken));
+        }
+
+        [TestMethod]
+        public void WarmBootTest()
+        {
+            RegisterCommands();
+
+            // Replace the cached commands; a warm boot must not scan the assembly again.
+            var key = File.ReadAllLines(CacheFile)[0];
+            File.WriteAllLines(CacheFile, new[] {key, "commands\t"});
+
+            Assert.AreEqual(0, RegisterCommands().Length);
+        }
+
+        [TestMethod]
+        public void StaleCacheTest()
+        {
+            var key = Guid.NewGuid().ToString("N");
+
+            Directory.CreateDirectory(_directory);
+            File.WriteAllLines(CacheFile, new[] {key, "commands\t"});
+
+            Assert.AreEqual(1, RegisterCommands().Length);
+            Assert.AreNotEqual(key, File.ReadAllLines(CacheFile)[0]);
+        }
+    }
+}
\ No newline at end of file
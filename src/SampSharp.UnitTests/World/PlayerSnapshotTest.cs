@@ -0,0 +1,110 @@
+﻿// SampSharp
+// Copyright 2017 Tim Potze
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//     http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+using Microsoft.VisualStudio.TestTools.UnitTesting;
+using SampSharp.GameMode;
+using SampSharp.GameMode.API;
+using SampSharp.GameMode.World;
+
+namespace SampSharp.UnitTests.World
+{
+    [TestClass]
+    public class PlayerSnapshotTest : FakeInteropFixture
+    {
+        private class SnapshotInterop : FakeInterop
+        {
+            private float[] _floats;
+            private int[] _ints;
+
+            public int Captures { get; private set; }
+
+            #region Overrides of FakeInterop
+
+            public override void PlayerSnapshotAttach(float[] floats, int[] ints)
+            {
+                _floats = floats;
+                _ints = ints;
+            }
+
+            public override void PlayerSnapshotDetach()
+            {
+                _floats = null;
+                _ints = null;
+            }
+
+            public override int PlayerSnapshotCapture()
+            {
+                var capacity = _ints.Length/3;
+
+                // Player 3 is connected at (1, 2, 3) with 50 health, 25 armour, in virtual world 7 and interior 2.
+                _ints[3] = 1;
+                _floats[3] = 1;
+                _floats[capacity + 3] = 2;
+                _floats[2*capacity + 3] = 3;
+                _floats[3*capacity + 3] = 50;
+                _floats[4*capacity + 3] = 25;
+                _ints[capacity + 3] = 7;
+                _ints[2*capacity + 3] = 2;
+
+                Captures++;
+                return 4;
+            }
+
+            #endregion
+        }
+
+        [TestInitialize]
+        public void Initialize()
+        {
+            BasePlayer.Register<BasePlayer>();
+        }
+
+        [TestCleanup]
+        public void Cleanup()
+        {
+            PlayerSnapshot.Disable();
+        }
+
+        [TestMethod]
+        public void CaptureTest()
+        {
+            var interop = UseInterop(new SnapshotInterop());
+
+            PlayerSnapshot.Enable();
+
+            Assert.IsTrue(PlayerSnapshot.IsEnabled);
+            Assert.AreEqual(1, interop.Captures);
+            Assert.AreEqual(4, PlayerSnapshot.Capture());
+
+            var player = BasePlayer.FindOrCreate(3);
+            Assert.AreEqual(new Vector3(1, 2, 3), player.Position);
+            Assert.AreEqual(50, player.Health);
+            Assert.AreEqual(25, player.Armour);
+            Assert.AreEqual(7, player.VirtualWorld);
+            Assert.AreEqual(2, player.Interior);
+        }
+
+        [TestMethod]
+        public void DisableTest()
+        {
+            UseInterop(new SnapshotInterop());
+
+            PlayerSnapshot.Enable();
+            PlayerSnapshot.Disable();
+
+            Assert.IsFalse(PlayerSnapshot.IsEnabled);
+            Assert.AreEqual(0, PlayerSnapshot.Capture());
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,127 @@
+﻿// SampSharp
+// Copyright 2017 Tim Potze
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//     http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+using System;
+using System.Collections.Generic;
+using Microsoft.VisualStudio.TestTools.UnitTesting;
+using SampSharp.GameMode.World;
+
+namespace SampSharp.UnitTests.World
+{
+    [TestClass]
+    public class PlayerUpdateIntervalTest : FakeInteropFixture
+    {
+        private class UpdateIntervalInterop : FakeInterop
+        {
+            public List<string> Calls { get; } = new List<string>();
+
+            #region Overrides of FakeInterop
+
+            public override void PlayerUpdateSetDefaultInterval(int interval)
+            {
+                Calls.Add($"SetDefaultInterval {interval}");
+            }
+
+            public override int PlayerUpdateGetDefaultInterval()
+            {
+                return 50;
+            }
+
+            public override bool PlayerUpdateSetInterval(int playerid, int interval)
+            {
+                Calls.Add($"SetInterval {playerid} {interval}");
+                return true;
+            }
+
+            public override int PlayerUpdateGetInterval(int playerid)
+            {
+                return playerid == 320 ? 200 : -1;
+            }
+
+            #endregion
+        }
+
+        private UpdateIntervalInterop _interop;
+
+        [TestInitialize]
+        public void Initialize()
+        {
+            BasePlayer.Register<BasePlayer>();
+            _interop = UseInterop(new UpdateIntervalInterop());
+        }
+
+        [TestMethod]
+        public void UpdateIntervalTest()
+        {
+            var player = BasePlayer.FindOrCreate(320);
+
+            player.UpdateInterval = 200;
+            player.UpdateInterval = 0;
+
+            Assert.AreEqual(200, player.UpdateInterval);
+            Assert.AreEqual(-1, BasePlayer.FindOrCreate(321).UpdateInterval);
+            CollectionAssert.AreEqual(new[] {"SetInterval 320 200", "SetInterval 320 0"}, _interop.Calls);
+        }
+
+        [TestMethod]
+        public void FollowDefaultUpdateIntervalTest()
+        {
+            BasePlayer.FindOrCreate(320).UpdateInterval = -1;
+
+            CollectionAssert.AreEqual(new[] {"SetInterval 320 -1"}, _interop.Calls);
+        }
+
+        [TestMethod]
+        public void UpdateIntervalOutOfRangeTest()
+        {
+            var player = BasePlayer.FindOrCreate(320);
+
+            try
+            {
+                player.UpdateInterval = -2;
+                Assert.Fail("An interval below -1 was accepted.");
+            }
+            catch (ArgumentOutOfRangeException)
+            {
+            }
+
+            Assert.AreEqual(0, _interop.Calls.Count);
+        }
+
+        [TestMethod]
+        public void DefaultUpdateIntervalTest()
+        {
+            BasePlayer.DefaultUpdateInterval = 100;
+            BasePlayer.DefaultUpdateInterval = 0;
+
+            Assert.AreEqual(50, BasePlayer.DefaultUpdateInterval);
+            CollectionAssert.AreEqual(new[] {"SetDefaultInterval 100", "SetDefaultInterval 0"}, _interop.Calls);
+        }
+
+        [TestMethod]
+        public void DefaultUpdateIntervalOutOfRangeTest()
+        {
+            try
+            {
+                BasePlayer.DefaultUpdateInterval = -1;
+                Assert.Fail("A negative default interval was accepted.");
+            }
+            catch (ArgumentOutOfRangeException)
+            {
+            }
+
+            Assert.AreEqual(0, _interop.Calls.Count);
+        }
+    }
+}
\ No newline at end of file
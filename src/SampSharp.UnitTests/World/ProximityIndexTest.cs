@@ -0,0 +1,128 @@
+﻿// SampSharp
+// Copyright 2017 Tim Potze
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//     http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+using System;
+using System.Collections.Generic;
+using System.Linq;
+using Microsoft.VisualStudio.TestTools.UnitTesting;
+using SampSharp.GameMode;
+using SampSharp.GameMode.API;
+using SampSharp.GameMode.World;
+
+namespace SampSharp.UnitTests.World
+{
+    [TestClass]
+    public class ProximityIndexTest : FakeInteropFixture
+    {
+        private class ProximityInterop : FakeInterop
+        {
+            public int[] Ids { get; set; } = new int[0];
+
+            public List<string> Calls { get; } = new List<string>();
+
+            private int Fill(int[] result, int count)
+            {
+                for (var i = 0; i < count && i < result.Length; i++)
+                    result[i] = Ids[i];
+
+                return count;
+            }
+
+            #region Overrides of FakeInterop
+
+            public override int ProximityQueryRadius(int kind, float x, float y, float z, float range, int world,
+                int[] result)
+            {
+                Calls.Add($"QueryRadius {kind} {x} {y} {z} {range} {world} {result.Length}");
+                return Fill(result, Ids.Length);
+            }
+
+            public override int ProximityQueryBox(int kind, float minX, float minY, float minZ, float maxX, float maxY,
+                float maxZ, int world, int[] result)
+            {
+                Calls.Add($"QueryBox {kind} {minX} {minY} {minZ} {maxX} {maxY} {maxZ} {world}");
+                return Fill(result, Ids.Length);
+            }
+
+            public override int ProximityNearest(int kind, float x, float y, float z, int count, int world,
+                int[] result)
+            {
+                Calls.Add($"Nearest {kind} {x} {y} {z} {count} {world}");
+                return Fill(result, Math.Min(count, Ids.Length));
+            }
+
+            #endregion
+        }
+
+        private ProximityInterop _interop;
+
+        [TestInitialize]
+        public void Initialize()
+        {
+            BasePlayer.Register<BasePlayer>();
+            _interop = UseInterop(new ProximityInterop());
+        }
+
+        [TestMethod]
+        public void RangeTest()
+        {
+            var players = Enumerable.Range(200, 100).Select(BasePlayer.FindOrCreate).ToArray();
+            _interop.Ids = players.Select(p => p.Id).ToArray();
+
+            var result = new List<BasePlayer>();
+            Assert.AreEqual(100, ProximityIndex.GetPlayersInRange(new Vector3(1, 2, 3), 50, result, 4));
+
+            // The buffer is grown and the query repeated when more players are found than fit.
+            CollectionAssert.AreEqual(players, result);
+            Assert.IsTrue(_interop.Calls.Last().StartsWith("QueryRadius 0 1 2 3 50 4 "));
+            Assert.IsTrue(int.Parse(_interop.Calls.Last().Split(' ').Last()) >= 100);
+        }
+
+        [TestMethod]
+        public void BoxTest()
+        {
+            var player = BasePlayer.FindOrCreate(300);
+
+            // Players without an instance are left out.
+            _interop.Ids = new[] {300, 301};
+
+            var result = new List<BasePlayer>();
+            Assert.AreEqual(1, ProximityIndex.GetPlayersInBox(new Vector3(-1, -2, -3), new Vector3(1, 2, 3), result));
+
+            CollectionAssert.AreEqual(new[] {player}, result);
+            CollectionAssert.AreEqual(new[] {"QueryBox 0 -1 -2 -3 1 2 3 -1"}, _interop.Calls);
+        }
+
+        [TestMethod]
+        public void NearestTest()
+        {
+            var players = new[] {BasePlayer.FindOrCreate(310), BasePlayer.FindOrCreate(311)};
+            _interop.Ids = players.Select(p => p.Id).ToArray();
+
+            var result = new List<BasePlayer>();
+            Assert.AreEqual(1, ProximityIndex.GetNearestPlayers(new Vector3(1, 2, 3), 1, result));
+            Assert.AreEqual(2, ProximityIndex.GetNearestPlayers(new Vector3(1, 2, 3), 5, result));
+
+            CollectionAssert.AreEqual(new[] {players[0], players[0], players[1]}, result);
+            CollectionAssert.AreEqual(new[] {"Nearest 0 1 2 3 1 -1", "Nearest 0 1 2 3 5 -1"}, _interop.Calls);
+        }
+
+        [TestMethod]
+        [ExpectedException(typeof (ArgumentNullException))]
+        public void NullResultTest()
+        {
+            ProximityIndex.GetVehiclesInRange(Vector3.Zero, 50, null);
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,199 @@
+﻿// SampSharp
+// Copyright 2017 Tim Potze
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//     http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+using System;
+using System.Collections.Generic;
+using Microsoft.VisualStudio.TestTools.UnitTesting;
+using SampSharp.GameMode;
+using SampSharp.GameMode.API;
+using SampSharp.GameMode.SAMP;
+using SampSharp.GameMode.World;
+
+namespace SampSharp.UnitTests.World
+{
+    [TestClass]
+    public class StreamerTest : FakeInteropFixture
+    {
+        private class StreamerInterop : FakeInterop
+        {
+            private int _nextId;
+
+            public List<string> Calls { get; } = new List<string>();
+
+            public HashSet<int> Items { get; } = new HashSet<int>();
+
+            public Dictionary<int, int> Pickups { get; } = new Dictionary<int, int>();
+
+            #region Overrides of FakeInterop
+
+            public override int StreamerAddObject(int modelid, float x, float y, float z, float rotationX,
+                float rotationY, float rotationZ, int virtualWorld, int interior, float streamDistance,
+                float drawDistance)
+            {
+                Calls.Add($"AddObject {modelid} {x} {y} {z} {virtualWorld} {interior} {streamDistance}");
+                Items.Add(_nextId);
+                return _nextId++;
+            }
+
+            public override int StreamerAddPickup(int modelid, int type, float x, float y, float z, int virtualWorld,
+                int interior, float streamDistance)
+            {
+                Calls.Add($"AddPickup {modelid} {type} {x} {y} {z} {virtualWorld} {interior} {streamDistance}");
+                Items.Add(_nextId);
+                return _nextId++;
+            }
+
+            public override int StreamerAddLabel(string text, int color, float x, float y, float z,
+                float drawDistance, int virtualWorld, int interior, bool testLOS, float streamDistance)
+            {
+                Calls.Add($"AddLabel {text} {x} {y} {z} {virtualWorld} {interior} {streamDistance}");
+                Items.Add(_nextId);
+                return _nextId++;
+            }
+
+            public override bool StreamerRemove(int id)
+            {
+                Calls.Add($"Remove {id}");
+                return Items.Remove(id);
+            }
+
+            public override bool StreamerSetPosition(int id, float x, float y, float z)
+            {
+                Calls.Add($"SetPosition {id} {x} {y} {z}");
+                return Items.Contains(id);
+            }
+
+            public override bool StreamerSetRotation(int id, float rotationX, float rotationY, float rotationZ)
+            {
+                Calls.Add($"SetRotation {id} {rotationX} {rotationY} {rotationZ}");
+                return Items.Contains(id);
+            }
+
+            public override bool StreamerSetLabelText(int id, string text, int color)
+            {
+                Calls.Add($"SetLabelText {id} {text}");
+                return Items.Contains(id);
+            }
+
+            public override void StreamerSetBudget(int budget)
+            {
+                Calls.Add($"SetBudget {budget}");
+            }
+
+            public override int StreamerFindPickup(int pickupid)
+            {
+                int id;
+                return Pickups.TryGetValue(pickupid, out id) ? id : -1;
+            }
+
+            #endregion
+        }
+
+        private StreamerInterop _interop;
+
+        [TestInitialize]
+        public void Initialize()
+        {
+            _interop = UseInterop(new StreamerInterop());
+        }
+
+        [TestCleanup]
+        public void Cleanup()
+        {
+            foreach (var item in StreamedObject.All.Snapshot())
+                item.Dispose();
+            foreach (var item in StreamedPickup.All.Snapshot())
+                item.Dispose();
+            foreach (var item in StreamedTextLabel.All.Snapshot())
+                item.Dispose();
+        }
+
+        [TestMethod]
+        public void AddTest()
+        {
+            var obj = new StreamedObject(1337, new Vector3(1, 2, 3), Vector3.Zero, 4, 5, 200);
+            var pickup = new StreamedPickup(1239, 2, new Vector3(6, 7, 8));
+            var label = new StreamedTextLabel("text", Color.White, new Vector3(9, 10, 11), 50, 0, 0);
+
+            CollectionAssert.AreEqual(new[]
+            {
+                "AddObject 1337 1 2 3 4 5 200",
+                "AddPickup 1239 2 6 7 8 -1 -1 100",
+                "AddLabel text 9 10 11 0 0 100"
+            }, _interop.Calls);
+
+            Assert.AreEqual(obj, StreamedObject.Find(0));
+            Assert.AreEqual(pickup, StreamedPickup.Find(1));
+            Assert.AreEqual(label, StreamedTextLabel.Find(2));
+        }
+
+        [TestMethod]
+        public void UpdateTest()
+        {
+            var obj = new StreamedObject(1337, Vector3.Zero, Vector3.Zero);
+            var label = new StreamedTextLabel("text", Color.White, Vector3.Zero, 50);
+
+            obj.Position = new Vector3(1, 2, 3);
+            obj.Rotation = new Vector3(0, 0, 90);
+            label.Text = "other";
+
+            CollectionAssert.AreEqual(new[] {"SetPosition 0 1 2 3", "SetRotation 0 0 0 90", "SetLabelText 1 other"},
+                _interop.Calls.GetRange(2, 3));
+            Assert.AreEqual(new Vector3(1, 2, 3), obj.Position);
+            Assert.AreEqual("other", label.Text);
+        }
+
+        [TestMethod]
+        public void DisposeTest()
+        {
+            var obj = new StreamedObject(1337, Vector3.Zero, Vector3.Zero);
+
+            obj.Dispose();
+
+            Assert.AreEqual("Remove 0", _interop.Calls[1]);
+            Assert.AreEqual(0, _interop.Items.Count);
+            Assert.IsNull(StreamedObject.Find(0));
+        }
+
+        [TestMethod]
+        public void FindByPickupIdTest()
+        {
+            Assert.IsNull(StreamedPickup.FindByPickupId(12));
+
+            var pickup = new StreamedPickup(1239, 2, Vector3.Zero);
+            _interop.Pickups[12] = pickup.Id;
+
+            Assert.AreEqual(pickup, StreamedPickup.FindByPickupId(12));
+            Assert.IsNull(StreamedPickup.FindByPickupId(13));
+        }
+
+        [TestMethod]
+        public void BudgetTest()
+        {
+            Streamer.Budget = 10;
+
+            Assert.AreEqual(10, Streamer.Budget);
+            Assert.AreEqual("SetBudget 10", _interop.Calls[0]);
+
+            Streamer.Budget = Streamer.DefaultBudget;
+        }
+
+        [TestMethod]
+        [ExpectedException(typeof (ArgumentOutOfRangeException))]
+        public void StreamDistanceTest()
+        {
+            new StreamedObject(1337, Vector3.Zero, Vector3.Zero, streamDistance: Streamer.MaxStreamDistance + 1);
+        }
+    }
+}
\ No newline at end of file
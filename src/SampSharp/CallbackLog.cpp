@@ -0,0 +1,146 @@
+// SampSharp
+// Copyright 2017 Tim Potze
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "CallbackLog.h"
+#include <chrono>
+#include <string.h>
+#include <sampgdk/sampgdk.h>
+
+using std::string;
+using sampgdk::logprintf;
+
+FILE *CallbackLog::file_;
+std::map<string, uint16_t> CallbackLog::names_;
+uint64_t CallbackLog::lastTime_;
+
+bool CallbackLog::Open(string path) {
+    if (file_) {
+        return false;
+    }
+
+    file_ = fopen(path.c_str(), "wb");
+
+    if (!file_) {
+        logprintf("[SampSharp] ERROR: Could not open callback log %s.",
+            path.c_str());
+        return false;
+    }
+
+    // Publics arrive at a high rate; buffer generously to keep the number of
+    // writes down.
+    setvbuf(file_, NULL, _IOFBF, 1 << 20);
+
+    names_.clear();
+    lastTime_ = 0;
+    GetDelta();
+
+    Write<uint32_t>(CALLBACK_LOG_MAGIC);
+    Write<uint32_t>(CALLBACK_LOG_VERSION);
+
+    logprintf("Recording callbacks to %s.", path.c_str());
+    return true;
+}
+
+void CallbackLog::Close() {
+    if (!file_) {
+        return;
+    }
+
+    fclose(file_);
+    file_ = NULL;
+    names_.clear();
+}
+
+void CallbackLog::WritePublic(const char *name, cell *params) {
+    uint16_t id = GetNameId(name);
+    uint8_t param_count = (uint8_t)(params[0] / sizeof(cell));
+
+    Write<uint8_t>(CALLBACK_LOG_PUBLIC);
+    Write<uint32_t>(GetDelta());
+    Write<uint16_t>(id);
+    Write<uint8_t>(param_count);
+    Write(&params[1], param_count * sizeof(cell));
+}
+
+void CallbackLog::WriteString(int param, const char *value, int length) {
+    if (length > 0xffff) {
+        length = 0xffff;
+    }
+
+    Write<uint8_t>(CALLBACK_LOG_STRING);
+    Write<uint8_t>((uint8_t)param);
+    Write<uint16_t>((uint16_t)length);
+    Write(value, length);
+}
+
+void CallbackLog::WriteArray(int param, const cell *value, int length) {
+    if (length > 0xffff) {
+        length = 0xffff;
+    }
+
+    Write<uint8_t>(CALLBACK_LOG_ARRAY);
+    Write<uint8_t>((uint8_t)param);
+    Write<uint16_t>((uint16_t)length);
+    Write(value, length * sizeof(cell));
+}
+
+void CallbackLog::WriteNative(const char *name, cell retval) {
+    uint16_t id = GetNameId(name);
+
+    Write<uint8_t>(CALLBACK_LOG_NATIVE);
+    Write<uint16_t>(id);
+    Write<cell>(retval);
+}
+
+void CallbackLog::WriteTick() {
+    Write<uint8_t>(CALLBACK_LOG_TICK);
+    Write<uint32_t>(GetDelta());
+}
+
+uint16_t CallbackLog::GetNameId(const char *name) {
+    std::map<string, uint16_t>::iterator iter = names_.find(name);
+
+    if (iter != names_.end()) {
+        return iter->second;
+    }
+
+    uint16_t id = (uint16_t)names_.size();
+    uint8_t length = (uint8_t)strnlen(name, 0xff);
+    names_[name] = id;
+
+    Write<uint8_t>(CALLBACK_LOG_NAME);
+    Write<uint16_t>(id);
+    Write<uint8_t>(length);
+    Write(name, length);
+
+    return id;
+}
+
+uint32_t CallbackLog::GetDelta() {
+    uint64_t now = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    uint64_t delta = lastTime_ ? now - lastTime_ : 0;
+
+    lastTime_ = now;
+    return delta > 0xffffffff ? 0xffffffff : (uint32_t)delta;
+}
+
+void CallbackLog::Write(const void *data, size_t size) {
+    if (fwrite(data, 1, size, file_) != size) {
+        logprintf("[SampSharp] ERROR: Could not write to callback log; "
+            "recording stopped.");
+        Close();
+    }
+}
@@ -0,0 +1,101 @@
+// SampSharp
+// Copyright 2017 Tim Potze
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdio.h>
+#include <stdint.h>
+#include <map>
+#include <string>
+#include <sdk/amx/amx.h>
+
+#pragma once
+
+/* Callback logs are binary files starting with the CALLBACK_LOG_MAGIC and
+ * CALLBACK_LOG_VERSION (both uint32), followed by a sequence of records. Every
+ * record starts with a uint8 record type. All values are little endian.
+ *
+ * CALLBACK_LOG_NAME:    uint16 id, uint8 length, char[length] name
+ *     Assigns an id to a public or native name. Written before the first
+ *     record which refers to the id.
+ * CALLBACK_LOG_PUBLIC:  uint32 delta, uint16 name id, uint8 param count,
+ *                       cell[param count] params
+ *     A public call. The delta is the number of microseconds elapsed since the
+ *     previous public or tick record.
+ * CALLBACK_LOG_STRING:  uint8 param index, uint16 length, char[length] value
+ * CALLBACK_LOG_ARRAY:   uint8 param index, uint16 length, cell[length] value
+ *     The payload referenced by a parameter of the preceding public call, or
+ *     the value stored in a reference parameter by the preceding native.
+ * CALLBACK_LOG_NATIVE:  uint16 name id, cell return value
+ *     The value returned by a native called by the game mode or the plugin.
+ * CALLBACK_LOG_TICK:    uint32 delta
+ *     A server tick. */
+#define CALLBACK_LOG_MAGIC                  (0x4C435353) /* SSCL */
+#define CALLBACK_LOG_VERSION                (2)
+
+#define CALLBACK_LOG_NAME                   (1)
+#define CALLBACK_LOG_PUBLIC                 (2)
+#define CALLBACK_LOG_STRING                 (3)
+#define CALLBACK_LOG_ARRAY                  (4)
+#define CALLBACK_LOG_NATIVE                 (5)
+#define CALLBACK_LOG_TICK                   (6)
+
+/* The environment variable SampSharpHost sets while replaying a log. */
+#define CALLBACK_LOG_REPLAY_ENV             "SAMPSHARP_REPLAY"
+
+/* Records callback traffic to a binary log which can be replayed by
+ * SampSharpHost. */
+class CallbackLog {
+public:
+    /* Opens the log file at the specified path for recording. */
+    static bool Open(std::string path);
+    /* Flushes and closes the log file. */
+    static void Close();
+    /* Gets a value indicating whether traffic is being recorded. */
+    static bool IsOpen() {
+        return file_ != NULL;
+    }
+    /* Writes a public call. The payloads of the call must be written directly
+     * after this call. */
+    static void WritePublic(const char *name, cell *params);
+    /* Writes a string referenced by a parameter of the last public call or
+     * native. */
+    static void WriteString(int param, const char *value, int length);
+    /* Writes an array referenced by a parameter of the last public call or
+     * native. */
+    static void WriteArray(int param, const cell *value, int length);
+    /* Writes the value returned by a native. The values the native stored in
+     * its reference parameters must be written directly after this call. */
+    static void WriteNative(const char *name, cell retval);
+    /* Writes the value the last native stored in a reference parameter. */
+    static void WriteRef(int param, cell value) {
+        WriteArray(param, &value, 1);
+    }
+    static void WriteRef(int param, float value) {
+        WriteRef(param, amx_ftoc(value));
+    }
+    /* Writes a server tick. */
+    static void WriteTick();
+
+private:
+    static uint16_t GetNameId(const char *name);
+    static uint32_t GetDelta();
+    static void Write(const void *data, size_t size);
+    template<typename T> static void Write(T value) {
+        Write(&value, sizeof(T));
+    }
+
+    static FILE *file_;
+    static std::map<std::string, uint16_t> names_;
+    static uint64_t lastTime_;
+};
@@ -30,6 +30,18 @@ string Config::gameModeClass_;
 string Config::codepage_;
 string Config::debuggerEnable_;
 string Config::debuggerAddress_;
+string Config::recordFile_;
+string Config::splitHost_;
+string Config::splitSyncCallbacks_;
+string Config::splitCachedCallbacks_;
+string Config::playerUpdateInterval_;
+string Config::slowTickThreshold_;
+string Config::watchdogTimeout_;
+string Config::watchdogAbort_;
+string Config::preload_;
+string Config::monoOptimize_;
+string Config::monoLlvm_;
+string Config::monoSimd_;
 
 string Config::GetEnv(const char *name) {
     string result = "";
@@ -66,6 +78,12 @@ void Config::Read()
     codepage_ = "cp1252";
     debuggerEnable_ = "0";
     debuggerAddress_ = "0.0.0.0:7776";
+    splitSyncCallbacks_ = "OnGameModeInit OnGameModeExit OnRconCommand "
+        "OnPlayerText OnPlayerCommandText OnPlayerRequestClass "
+        "OnPlayerRequestSpawn OnVehicleMod OnVehiclePaintjob "
+        "OnVehicleRespray";
+    splitCachedCallbacks_ = "OnPlayerUpdate OnUnoccupiedVehicleUpdate "
+        "OnPlayerWeaponShot";
 
     server_cfg.GetOptionAsString("gamemode", tmpGameMode);
     server_cfg.GetOptionAsString("trace_level", traceLevel_);
@@ -74,12 +92,37 @@ void Config::Read()
     server_cfg.GetOptionAsString("codepage", codepage_);
     server_cfg.GetOptionAsString("debugger", debuggerEnable_);
     server_cfg.GetOptionAsString("debugger_address", debuggerAddress_);
+    server_cfg.GetOptionAsString("record_file", recordFile_);
+    server_cfg.GetOptionAsString("split_host", splitHost_);
+    server_cfg.GetOptionAsString("split_sync_callbacks", splitSyncCallbacks_);
+    server_cfg.GetOptionAsString("split_cached_callbacks",
+        splitCachedCallbacks_);
+    server_cfg.GetOptionAsString("player_update_interval",
+        playerUpdateInterval_);
+    server_cfg.GetOptionAsString("slow_tick_threshold", slowTickThreshold_);
+    server_cfg.GetOptionAsString("watchdog_timeout", watchdogTimeout_);
+    server_cfg.GetOptionAsString("watchdog_abort", watchdogAbort_);
+    server_cfg.GetOptionAsString("preload", preload_);
+    server_cfg.GetOptionAsString("mono_optimize", monoOptimize_);
+    server_cfg.GetOptionAsString("mono_llvm", monoLlvm_);
+    server_cfg.GetOptionAsString("mono_simd", monoSimd_);
 
     string env = GetEnv("gamemode");
     if (env.length() > 0) {
         tmpGameMode = env;
     }
 
+    // The JIT options can be overridden per process, which is how the
+    // benchmark mode of SampSharpHost compares them.
+    const char *jit_options[] = { "mono_optimize", "mono_llvm", "mono_simd" };
+    string *jit_values[] = { &monoOptimize_, &monoLlvm_, &monoSimd_ };
+    for (int i = 0; i < 3; i++) {
+        env = GetEnv(jit_options[i]);
+        if (env.length() > 0) {
+            *jit_values[i] = env;
+        }
+    }
+
     std::stringstream gamemode_stream(tmpGameMode);
 
     std::getline(gamemode_stream, gameModeNamespace_, ':');
@@ -113,3 +156,46 @@ string Config::GetDebuggerEnable() {
 string Config::GetDebuggerAddress() {
     return debuggerAddress_;
 }
+string Config::GetRecordFile() {
+    return recordFile_;
+}
+string Config::GetSplitHost() {
+    return splitHost_;
+}
+string Config::GetSplitSyncCallbacks() {
+    return splitSyncCallbacks_;
+}
+string Config::GetSplitCachedCallbacks() {
+    return splitCachedCallbacks_;
+}
+string Config::GetPlayerUpdateInterval() {
+    return playerUpdateInterval_;
+}
+
+string Config::GetSlowTickThreshold() {
+    return slowTickThreshold_;
+}
+
+string Config::GetWatchdogTimeout() {
+    return watchdogTimeout_;
+}
+
+string Config::GetWatchdogAbort() {
+    return watchdogAbort_;
+}
+
+string Config::GetPreload() {
+    return preload_;
+}
+
+string Config::GetMonoOptimize() {
+    return monoOptimize_;
+}
+
+string Config::GetMonoLlvm() {
+    return monoLlvm_;
+}
+
+string Config::GetMonoSimd() {
+    return monoSimd_;
+}
@@ -31,6 +31,18 @@ public:
     static std::string GetCodepage();
     static std::string GetDebuggerEnable();
     static std::string GetDebuggerAddress();
+    static std::string GetRecordFile();
+    static std::string GetSplitHost();
+    static std::string GetSplitSyncCallbacks();
+    static std::string GetSplitCachedCallbacks();
+    static std::string GetPlayerUpdateInterval();
+    static std::string GetSlowTickThreshold();
+    static std::string GetWatchdogTimeout();
+    static std::string GetWatchdogAbort();
+    static std::string GetPreload();
+    static std::string GetMonoOptimize();
+    static std::string GetMonoLlvm();
+    static std::string GetMonoSimd();
 private:
     static std::string monoAssemblyDir_;
     static std::string monoConfigDir_;
@@ -40,4 +52,16 @@ private:
     static std::string codepage_;
     static std::string debuggerEnable_;
     static std::string debuggerAddress_;
+    static std::string recordFile_;
+    static std::string splitHost_;
+    static std::string splitSyncCallbacks_;
+    static std::string splitCachedCallbacks_;
+    static std::string playerUpdateInterval_;
+    static std::string slowTickThreshold_;
+    static std::string watchdogTimeout_;
+    static std::string watchdogAbort_;
+    static std::string preload_;
+    static std::string monoOptimize_;
+    static std::string monoLlvm_;
+    static std::string monoSimd_;
 };
@@ -0,0 +1,227 @@
+// SampSharp
+// Copyright 2017 Tim Potze
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ErrorLog.h"
+#include <chrono>
+#include <iostream>
+#include "platforms.h"
+
+using std::string;
+
+ErrorLog::Slot ErrorLog::slots_[ERROR_LOG_CAPACITY];
+std::atomic<size_t> ErrorLog::head_;
+size_t ErrorLog::tail_;
+std::atomic<unsigned int> ErrorLog::dropped_;
+std::atomic<unsigned int> ErrorLog::droppedTotal_;
+std::atomic<bool> ErrorLog::running_;
+std::thread ErrorLog::thread_;
+FILE *ErrorLog::file_;
+
+void ErrorLog::Start() {
+    if (running_) {
+        return;
+    }
+
+    for (size_t i = 0; i < ERROR_LOG_CAPACITY; i++) {
+        slots_[i].sequence.store(i, std::memory_order_relaxed);
+        slots_[i].entry = NULL;
+    }
+
+    head_.store(0, std::memory_order_relaxed);
+    tail_ = 0;
+    dropped_ = 0;
+    droppedTotal_ = 0;
+    running_ = true;
+
+    thread_ = std::thread(Run);
+}
+
+void ErrorLog::Stop() {
+    if (!running_) {
+        return;
+    }
+
+    // The writer thread drains the buffer before it exits.
+    running_ = false;
+    thread_.join();
+
+    if (file_) {
+        fclose(file_);
+        file_ = NULL;
+    }
+}
+
+bool ErrorLog::Write(const char *header, const char *text) {
+    if (!running_) {
+        Entry entry;
+        entry.time = time(0);
+        entry.header = header;
+        entry.text = text;
+
+        WriteEntry(entry);
+        std::cout.flush();
+
+        if (file_) {
+            fclose(file_);
+            file_ = NULL;
+        }
+        return true;
+    }
+
+    Entry *entry = new Entry;
+    entry->time = time(0);
+    entry->header = header;
+    entry->text = text;
+
+    if (!Enqueue(entry)) {
+        delete entry;
+        dropped_++;
+        droppedTotal_++;
+        return false;
+    }
+    return true;
+}
+
+/* The ring buffer is a bounded multi-producer queue. Every slot carries a
+ * sequence number: a slot at position pos may be filled by a producer when its
+ * sequence equals pos and may be read by the writer thread when it equals
+ * pos + 1. After reading, the sequence is advanced by the capacity of the
+ * buffer, which makes the slot available for the next lap. */
+bool ErrorLog::Enqueue(Entry *entry) {
+    size_t pos = head_.load(std::memory_order_relaxed);
+    Slot *slot;
+
+    for (;;) {
+        slot = &slots_[pos & (ERROR_LOG_CAPACITY - 1)];
+        size_t sequence = slot->sequence.load(std::memory_order_acquire);
+        ptrdiff_t diff = (ptrdiff_t)sequence - (ptrdiff_t)pos;
+
+        if (diff == 0) {
+            if (head_.compare_exchange_weak(pos, pos + 1,
+                std::memory_order_relaxed)) {
+                break;
+            }
+        }
+        else if (diff < 0) {
+            // The writer thread has not caught up; the buffer is full.
+            return false;
+        }
+        else {
+            pos = head_.load(std::memory_order_relaxed);
+        }
+    }
+
+    slot->entry = entry;
+    slot->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+ErrorLog::Entry *ErrorLog::Dequeue() {
+    Slot *slot = &slots_[tail_ & (ERROR_LOG_CAPACITY - 1)];
+
+    if (slot->sequence.load(std::memory_order_acquire) != tail_ + 1) {
+        return NULL;
+    }
+
+    Entry *entry = slot->entry;
+    slot->entry = NULL;
+    slot->sequence.store(tail_ + ERROR_LOG_CAPACITY,
+        std::memory_order_release);
+    tail_++;
+
+    return entry;
+}
+
+void ErrorLog::Run() {
+    while (running_) {
+        if (!WriteQueued()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+    }
+
+    WriteQueued();
+}
+
+bool ErrorLog::WriteQueued() {
+    bool written = false;
+    Entry *entry;
+
+    // Write everything which is queued before flushing once for the batch.
+    while ((entry = Dequeue()) != NULL) {
+        WriteEntry(*entry);
+        delete entry;
+        written = true;
+    }
+
+    unsigned int dropped = dropped_.exchange(0);
+    if (dropped) {
+        WriteDropped(dropped);
+        written = true;
+    }
+
+    if (written) {
+        std::cout.flush();
+        if (file_) {
+            fflush(file_);
+        }
+    }
+
+    return written;
+}
+
+void ErrorLog::WriteEntry(const Entry &entry) {
+    /* Print error to console. Cannot print the exception to logprintf; the
+     * buffer is too small.
+     */
+    std::cout << "[SampSharp] " << entry.header << ":\n"
+        << entry.text << "\n";
+
+    tm _Tm;
+
+#if SAMPSHARP_WINDOWS
+    localtime_s(&_Tm, &entry.time);
+#elif SAMPSHARP_LINUX
+    _Tm = *localtime_r(&entry.time, &_Tm);
+#endif
+
+    char timestamp[32];
+    strftime(timestamp, sizeof(timestamp), "[%d/%m/%Y %H:%M:%S] ", &_Tm);
+
+    string line = string(timestamp).append(entry.header).append(":\r\n")
+        .append(entry.text).append("\r\n");
+    WriteFile(line.c_str(), line.length());
+}
+
+void ErrorLog::WriteDropped(unsigned int count) {
+    char message[128];
+    snprintf(message, sizeof(message), "%u error messages were dropped; the "
+        "error log could not keep up.", count);
+
+    std::cout << "[SampSharp] " << message << "\n";
+
+    string line = string(message).append("\r\n");
+    WriteFile(line.c_str(), line.length());
+}
+
+void ErrorLog::WriteFile(const char *data, size_t size) {
+    if (!file_) {
+        file_ = fopen(ERROR_LOG_FILE, "ab");
+        if (!file_) {
+            return;
+        }
+    }
+
+    fwrite(data, 1, size, file_);
+}
@@ -0,0 +1,82 @@
+// SampSharp
+// Copyright 2017 Tim Potze
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stddef.h>
+#include <stdio.h>
+#include <time.h>
+#include <atomic>
+#include <string>
+#include <thread>
+
+#pragma once
+
+/* The number of messages which can be queued. Must be a power of two. */
+#define ERROR_LOG_CAPACITY                  (1024)
+/* The file messages are appended to. */
+#define ERROR_LOG_FILE                      "SampSharp_errors.log"
+
+/* Writes errors to the console and the error log on a background thread. The
+ * server thread queues messages in a lock-free ring buffer and never waits for
+ * the console or the disk; when the buffer is full, messages are dropped and
+ * counted instead. */
+class ErrorLog {
+public:
+    /* Starts the writer thread. */
+    static void Start();
+    /* Writes the queued messages, stops the writer thread and closes the log
+     * file. */
+    static void Stop();
+    /* Gets a value indicating whether the writer thread is running. */
+    static bool IsRunning() {
+        return running_;
+    }
+    /* Queues a message. The header is printed to the console and the log file,
+     * followed by the text on a new line. If the writer thread is not running,
+     * the message is written immediately. Returns false if the message was
+     * dropped. */
+    static bool Write(const char *header, const char *text);
+    /* Gets the number of messages dropped since the writer thread started. */
+    static unsigned int GetDroppedCount() {
+        return droppedTotal_;
+    }
+
+private:
+    struct Entry {
+        time_t time;
+        std::string header;
+        std::string text;
+    };
+    struct Slot {
+        std::atomic<size_t> sequence;
+        Entry *entry;
+    };
+
+    static bool Enqueue(Entry *entry);
+    static Entry *Dequeue();
+    static void Run();
+    static bool WriteQueued();
+    static void WriteEntry(const Entry &entry);
+    static void WriteDropped(unsigned int count);
+    static void WriteFile(const char *data, size_t size);
+
+    static Slot slots_[ERROR_LOG_CAPACITY];
+    static std::atomic<size_t> head_;
+    static size_t tail_;
+    static std::atomic<unsigned int> dropped_;
+    static std::atomic<unsigned int> droppedTotal_;
+    static std::atomic<bool> running_;
+    static std::thread thread_;
+    static FILE *file_;
+};
@@ -0,0 +1,202 @@
+// SampSharp
+// Copyright 2017 Tim Potze
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ExceptionThrottle.h"
+#include <chrono>
+#include <stdio.h>
+#include <mono/metadata/appdomain.h>
+#include <mono/metadata/class.h>
+#include <mono/metadata/debug-helpers.h>
+#include <mono/metadata/exception.h>
+#include <mono/metadata/mono-debug.h>
+#include "ErrorLog.h"
+
+using std::string;
+
+std::map<ExceptionThrottle::Fingerprint, ExceptionThrottle::Window>
+    ExceptionThrottle::windows_;
+MonoClassField *ExceptionThrottle::traceIpsField_;
+uint64_t ExceptionThrottle::lastFlush_;
+
+bool ExceptionThrottle::Fingerprint::operator<(
+    const Fingerprint &other) const {
+    if (klass != other.klass) {
+        return klass < other.klass;
+    }
+    if (method != other.method) {
+        return method < other.method;
+    }
+    if (offset != other.offset) {
+        return offset < other.offset;
+    }
+    return callback < other.callback;
+}
+
+bool ExceptionThrottle::Report(MonoDomain *domain, const char *methodname,
+    MonoObject *exception) {
+    Fingerprint fingerprint = GetFingerprint(domain, methodname, exception);
+    uint64_t now = GetTime();
+
+    std::map<Fingerprint, Window>::iterator iter = windows_.find(fingerprint);
+
+    if (iter == windows_.end()) {
+        Window &window = windows_[fingerprint];
+        window.start = now;
+        window.suppressed = 0;
+        window.description = GetDescription(fingerprint);
+        return true;
+    }
+
+    Window &window = iter->second;
+
+    // The window may have ended since the last flush.
+    if (now - window.start >= EXCEPTION_THROTTLE_WINDOW * 1000) {
+        if (window.suppressed) {
+            WriteSummary(window, now);
+        }
+        window.start = now;
+        window.suppressed = 0;
+        return true;
+    }
+
+    window.suppressed++;
+    return false;
+}
+
+void ExceptionThrottle::Flush(bool force) {
+    uint64_t now = GetTime();
+
+    // Flush is called every tick; there is no need to walk the windows more
+    // than once a second.
+    if (!force && now - lastFlush_ < 1000) {
+        return;
+    }
+    lastFlush_ = now;
+
+    std::map<Fingerprint, Window>::iterator iter = windows_.begin();
+    while (iter != windows_.end()) {
+        Window &window = iter->second;
+
+        if (force || now - window.start >= EXCEPTION_THROTTLE_WINDOW * 1000) {
+            if (window.suppressed) {
+                WriteSummary(window, now);
+            }
+
+            // The next exception of this fingerprint is printed in full.
+            windows_.erase(iter++);
+        }
+        else {
+            ++iter;
+        }
+    }
+}
+
+void ExceptionThrottle::Clear() {
+    Flush(true);
+    windows_.clear();
+}
+
+ExceptionThrottle::Fingerprint ExceptionThrottle::GetFingerprint(
+    MonoDomain *domain, const char *methodname, MonoObject *exception) {
+    Fingerprint fingerprint;
+    fingerprint.klass = mono_object_get_class(exception);
+    fingerprint.method = NULL;
+    fingerprint.offset = 0;
+    fingerprint.callback = methodname;
+
+    if (!traceIpsField_) {
+        traceIpsField_ = mono_class_get_field_from_name(
+            mono_get_exception_class(), "trace_ips");
+    }
+
+    if (!traceIpsField_) {
+        return fingerprint;
+    }
+
+    // The trace_ips of an exception start with the instruction pointer of the
+    // frame which threw it. Resolving it is much cheaper than building the
+    // stack trace.
+    MonoArray *ips = NULL;
+    mono_field_get_value(exception, traceIpsField_, &ips);
+
+    if (!ips || mono_array_length(ips) == 0) {
+        return fingerprint;
+    }
+
+    char *ip = mono_array_get(ips, char *, 0);
+    MonoJitInfo *info = mono_jit_info_table_find(domain, ip);
+
+    if (!info) {
+        return fingerprint;
+    }
+
+    fingerprint.method = mono_jit_info_get_method(info);
+    fingerprint.callback.clear();
+
+    uint32_t native_offset = (uint32_t)(ip -
+        (char *)mono_jit_info_get_code_start(info));
+    int32_t il_offset = mono_debug_il_offset_from_address(fingerprint.method,
+        domain, native_offset);
+
+    // Without debugging symbols, fall back to the native offset, stored as a
+    // negative number to keep it apart from IL offsets.
+    fingerprint.offset = il_offset >= 0
+        ? il_offset
+        : -(int32_t)native_offset - 1;
+
+    return fingerprint;
+}
+
+string ExceptionThrottle::GetDescription(const Fingerprint &fingerprint) {
+    string description = string(mono_class_get_namespace(fingerprint.klass));
+    if (description.length()) {
+        description.append(".");
+    }
+    description.append(mono_class_get_name(fingerprint.klass)).append(" in ");
+
+    if (!fingerprint.method) {
+        return description.append(fingerprint.callback);
+    }
+
+    char *name = mono_method_full_name(fingerprint.method, false);
+    char offset[32];
+
+    if (fingerprint.offset >= 0) {
+        snprintf(offset, sizeof(offset), " at IL_%04x", fingerprint.offset);
+    }
+    else {
+        snprintf(offset, sizeof(offset), " at native offset 0x%x",
+            -(fingerprint.offset + 1));
+    }
+
+    description.append(name).append(offset);
+    mono_free(name);
+
+    return description;
+}
+
+void ExceptionThrottle::WriteSummary(const Window &window, uint64_t now) {
+    char summary[96];
+    snprintf(summary, sizeof(summary), "x%u in last %us (%u more not printed)",
+        window.suppressed + 1, (unsigned int)((now - window.start) / 1000),
+        window.suppressed);
+
+    ErrorLog::Write(window.description.c_str(), summary);
+}
+
+uint64_t ExceptionThrottle::GetTime() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
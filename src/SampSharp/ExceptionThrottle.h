@@ -0,0 +1,75 @@
+// SampSharp
+// Copyright 2017 Tim Potze
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdint.h>
+#include <map>
+#include <string>
+#include <mono/jit/jit.h>
+
+#pragma once
+
+/* The length of a rate limiting window in seconds. */
+#define EXCEPTION_THROTTLE_WINDOW           (10)
+
+/* Rate limits the exceptions printed to the error log. Exceptions are
+ * fingerprinted by their type, the method which threw them and the offset in
+ * that method. If the throwing method can't be resolved, the name of the
+ * callback which raised the exception is used instead. Only the first
+ * exception of a fingerprint is printed within a window; the others are
+ * counted and summarized when the window ends.
+ *
+ * Only printing is throttled; the CallbackException event of the game mode
+ * is raised for every exception. */
+class ExceptionThrottle {
+public:
+    /* Counts the specified exception. Returns true if it is the first
+     * exception of its fingerprint in the current window and should be
+     * printed. */
+    static bool Report(MonoDomain *domain, const char *methodname,
+        MonoObject *exception);
+    /* Writes the summaries of the windows which have ended. If force is true,
+     * all windows are ended. */
+    static void Flush(bool force);
+    /* Ends all windows and forgets every fingerprint. Must be called before
+     * the domain is unloaded. */
+    static void Clear();
+
+private:
+    struct Fingerprint {
+        MonoClass *klass;
+        MonoMethod *method;
+        int32_t offset;
+        /* The callback which raised the exception; only set if the method
+         * is unknown. */
+        std::string callback;
+
+        bool operator<(const Fingerprint &other) const;
+    };
+    struct Window {
+        uint64_t start;
+        uint32_t suppressed;
+        std::string description;
+    };
+
+    static Fingerprint GetFingerprint(MonoDomain *domain,
+        const char *methodname, MonoObject *exception);
+    static std::string GetDescription(const Fingerprint &fingerprint);
+    static void WriteSummary(const Window &window, uint64_t now);
+    static uint64_t GetTime();
+
+    static std::map<Fingerprint, Window> windows_;
+    static MonoClassField *traceIpsField_;
+    static uint64_t lastFlush_;
+};
@@ -19,10 +19,13 @@
 #include <iostream>
 #include <fstream>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <limits>
 #include <time.h>
 #include <mono/metadata/assembly.h>
+#include <mono/metadata/attrdefs.h>
+#include <mono/metadata/tokentype.h>
 #include <mono/metadata/threads.h>
 #include <mono/metadata/exception.h>
 #include <mono/metadata/debug-helpers.h>
@@ -30,6 +33,17 @@
 #include "MonoRuntime.h"
 #include "PathUtil.h"
 #include "Config.h"
+#include "CallbackLog.h"
+#include "ErrorLog.h"
+#include "ExceptionThrottle.h"
+#include "HeightMap.h"
+#include "PlayerSnapshot.h"
+#include "Streamer.h"
+#include "ProximityIndex.h"
+#include "PlayerUpdateThrottle.h"
+#include "NativeProfiler.h"
+#include "TickMonitor.h"
+#include "Watchdog.h"
 
 #define ERR_EXCEPTION                   (-1)
 
@@ -51,12 +65,18 @@ uint32_t GameMode::gameModeHandle_;
 GameMode::TimerMap GameMode::timers_;
 GameMode::ExtensionList GameMode::extensions_;
 GameMode::NativeList GameMode::natives_;
+uint32_t GameMode::commandBufferHandle_;
+int *GameMode::commandBuffer_;
+int GameMode::commandBufferLength_;
 
 MonoMethod *GameMode::onCallbackException_;
+bool GameMode::onCallbackExceptionSearched_;
 MonoMethod *GameMode::tickMethod_;
+MonoMethod *GameMode::timerTickMethod_;
 MonoClass *GameMode::paramLengthClass_;
 MonoMethod *GameMode::paramLengthGetMethod_;
 MonoAssembly *GameMode::assemby_;
+bool GameMode::isPrepared_;
 
 int GameMode::bootSequenceNumber_;
 
@@ -73,6 +93,110 @@ bool GameMode::Load(std::string namespaceName, std::string className) {
 
     LoadCodepage(Config::GetCodepage().c_str());
 
+    PlayerUpdateThrottle::Clear();
+    PlayerUpdateThrottle::SetEnabled(
+        Config::GetEnv(CALLBACK_LOG_REPLAY_ENV).empty());
+    int update_interval = atoi(Config::GetPlayerUpdateInterval().c_str());
+    if (update_interval > 0) {
+        PlayerUpdateThrottle::SetDefaultInterval(update_interval);
+    }
+
+    // The game mode may have been prepared while the server was starting.
+    logprintf("Loading image...");
+    string error;
+    if (!isPrepared_ && !Prepare(namespaceName, className, error)) {
+        logprintf("ERROR: %s", error.c_str());
+        return false;
+    }
+    isPrepared_ = false;
+
+    mono_domain_set(domain_, 1);
+    mono_thread_attach(domain_);
+
+    logprintf("Creating gamemode instance...");
+
+    // Add all internal calls.
+    AddInternalCall("RegisterExtension", (void *)RegisterExtension);
+    AddInternalCall("SetTimer", (void *)SetRefTimer);
+    AddInternalCall("KillTimer", (void *)KillRefTimer);
+    AddInternalCall("NativeExists", (void *)NativeExists);
+    AddInternalCall("LoadNative", (void *)LoadNative);
+    AddInternalCall("InvokeNative", (void *)InvokeNative);
+    AddInternalCall("CommandBufferAttach", (void *)AttachCommandBuffer);
+    AddInternalCall("CommandBufferDetach", (void *)DetachCommandBuffer);
+    AddInternalCall("CommandBufferFlush", (void *)FlushCommandBuffer);
+    AddInternalCall("Print", (void *)Print);
+    AddInternalCall("SetCodepage", (void *)LoadCodepage);
+    AddInternalCall("HeightMapLoad", (void *)HeightMap::Load);
+    AddInternalCall("HeightMapUnload", (void *)HeightMap::Unload);
+    AddInternalCall("HeightMapFindZ", (void *)HeightMap::FindZ);
+    AddInternalCall("HeightMapFindAverageZ", (void *)HeightMap::FindAverageZ);
+    AddInternalCall("HeightMapFindBilinearZ",
+        (void *)HeightMap::FindBilinearZ);
+    AddInternalCall("HeightMapFindZArray", (void *)HeightMap::FindZArray);
+    AddInternalCall("HeightMapSetZ", (void *)HeightMap::SetZ);
+    AddInternalCall("HeightMapSave", (void *)HeightMap::Save);
+    AddInternalCall("PlayerSnapshotAttach", (void *)PlayerSnapshot::Attach);
+    AddInternalCall("PlayerSnapshotDetach", (void *)PlayerSnapshot::Detach);
+    AddInternalCall("PlayerSnapshotCapture", (void *)PlayerSnapshot::Capture);
+    AddInternalCall("StreamerAddObject", (void *)Streamer::AddObject);
+    AddInternalCall("StreamerAddPickup", (void *)Streamer::AddPickup);
+    AddInternalCall("StreamerAddLabel", (void *)Streamer::AddLabel);
+    AddInternalCall("StreamerRemove", (void *)Streamer::Remove);
+    AddInternalCall("StreamerSetPosition", (void *)Streamer::SetPosition);
+    AddInternalCall("StreamerSetRotation", (void *)Streamer::SetRotation);
+    AddInternalCall("StreamerSetLabelText", (void *)Streamer::SetLabelText);
+    AddInternalCall("StreamerSetBudget", (void *)Streamer::SetBudget);
+    AddInternalCall("StreamerUpdate", (void *)Streamer::Update);
+    AddInternalCall("StreamerIsVisible", (void *)Streamer::IsVisible);
+    AddInternalCall("StreamerFindPickup", (void *)Streamer::FindPickup);
+    AddInternalCall("StreamerGetVisibleCount",
+        (void *)Streamer::GetVisibleCount);
+    AddInternalCall("ProximityQueryRadius",
+        (void *)ProximityIndex::QueryRadius);
+    AddInternalCall("ProximityQueryBox", (void *)ProximityIndex::QueryBox);
+    AddInternalCall("ProximityNearest", (void *)ProximityIndex::Nearest);
+    AddInternalCall("ProximityInvalidate", (void *)ProximityIndex::Invalidate);
+    AddInternalCall("PlayerUpdateSetDefaultInterval",
+        (void *)PlayerUpdateThrottle::SetDefaultInterval);
+    AddInternalCall("PlayerUpdateGetDefaultInterval",
+        (void *)PlayerUpdateThrottle::GetDefaultInterval);
+    AddInternalCall("PlayerUpdateSetInterval",
+        (void *)PlayerUpdateThrottle::SetInterval);
+    AddInternalCall("PlayerUpdateGetInterval",
+        (void *)PlayerUpdateThrottle::GetInterval);
+    AddInternalCall("NativeProfilerStart", (void *)NativeProfiler::Start);
+    AddInternalCall("NativeProfilerStop", (void *)NativeProfiler::Stop);
+    AddInternalCall("NativeProfilerReset", (void *)NativeProfiler::Reset);
+    AddInternalCall("NativeProfilerGetStats",
+        (void *)NativeProfiler::GetStats);
+    AddInternalCall("NativeProfilerDump", (void *)NativeProfiler::Dump);
+
+    // Watch for callbacks which don't return, starting with Initialize.
+    Watchdog::Start(atoi(Config::GetWatchdogTimeout().c_str()),
+        Config::GetWatchdogAbort().compare("1") == 0);
+
+    MonoObject *gamemode_obj = mono_object_new
+        (mono_domain_get(), gameMode_.klass);
+    gameModeHandle_ = mono_gchandle_new(gamemode_obj, false);
+    mono_runtime_object_init(gamemode_obj);
+
+    MonoMethod *method = LoadEvent("Initialize", 0);
+
+    if (method) {
+        MonoObject *exception = NULL;
+        CallEvent(method, gameModeHandle_, NULL, &exception);
+
+        return isLoaded_ = !exception;
+    }
+    else {
+        isLoaded_ = true;
+        return true;
+    }
+}
+
+bool GameMode::Prepare(std::string namespaceName, std::string className,
+    std::string &error) {
     // Build paths based on the specified namespace and class names.
     string dirPath = PathUtil::GetPathInBin("gamemode/");
     string libraryPath = PathUtil::GetPathInBin("gamemode/")
@@ -83,7 +207,7 @@ bool GameMode::Load(std::string namespaceName, std::string className) {
     // Check for existance of game mode.
     std::ifstream ifile(libraryPath.c_str());
     if (!ifile) {
-        logprintf("ERROR: library does not exist!");
+        error = "library does not exist!";
         return false;
     }
 
@@ -100,22 +224,20 @@ bool GameMode::Load(std::string namespaceName, std::string className) {
 
     mono_domain_set_config(domain_, dirPath.c_str(), configPath.c_str());
 
-    logprintf("Loading image...");
     assemby_ = mono_domain_assembly_open(domain_, libraryPath.c_str());
     gameMode_.image = mono_assembly_get_image(assemby_);
 
     if (!gameMode_.image) {
-        logprintf("ERROR: Couldn't open image!");
+        error = "Couldn't open image!";
         return false;
     }
 
-    logprintf("Creating gamemode instance...");
     gameMode_.klass = mono_class_from_name(gameMode_.image,
         namespaceName.c_str(), className.c_str());
 
     if (!gameMode_.klass) {
-        logprintf("ERROR: Couldn't find class %s:%s!",
-            namespaceName.c_str(), className.c_str());
+        error = "Couldn't find class " + namespaceName + ":" + className +
+            "!";
         return false;
     }
 
@@ -123,41 +245,89 @@ bool GameMode::Load(std::string namespaceName, std::string className) {
 
     if (!baseMode_.klass || strcmp("BaseMode",
         mono_class_get_name(baseMode_.klass)) != 0) {
-        logprintf("ERROR: Parent type of %s::%s is not "
-            "SampSharp.GameMode::BaseMode!",
-            namespaceName.c_str(), className.c_str());
+        error = "Parent type of " + namespaceName + "::" + className +
+            " is not SampSharp.GameMode::BaseMode!";
         return false;
     }
 
     baseMode_.image = mono_class_get_image(baseMode_.klass);
 
-    // Add all internal calls.
-    AddInternalCall("RegisterExtension", (void *)RegisterExtension);
-    AddInternalCall("SetTimer", (void *)SetRefTimer);
-    AddInternalCall("KillTimer", (void *)KillRefTimer);
-    AddInternalCall("NativeExists", (void *)NativeExists);
-    AddInternalCall("LoadNative", (void *)LoadNative);
-    AddInternalCall("InvokeNative", (void *)InvokeNative);
-    AddInternalCall("Print", (void *)Print);
-    AddInternalCall("SetCodepage", (void *)LoadCodepage);
+    isPrepared_ = true;
+    return true;
+}
 
-    MonoObject *gamemode_obj = mono_object_new
-        (mono_domain_get(), gameMode_.klass);
-    gameModeHandle_ = mono_gchandle_new(gamemode_obj, false);
-    mono_runtime_object_init(gamemode_obj);
+int GameMode::Precompile(const std::atomic<bool> &cancel) {
+    if (!isPrepared_) {
+        return 0;
+    }
 
-    MonoMethod *method = LoadEvent("Initialize", 0);
+    // The callbacks of the game mode, followed by the framework classes most
+    // game modes use while handling them.
+    MonoClass *classes[] = {
+        gameMode_.klass,
+        baseMode_.klass,
+        mono_get_string_class(),
+        mono_class_from_name(mono_get_corlib(), "System.Text",
+            "StringBuilder"),
+        mono_class_from_name(mono_get_corlib(), "System", "Math")
+    };
 
-    if (method) {
-        MonoObject *exception = NULL;
-        CallEvent(method, gameModeHandle_, NULL, &exception);
+    int count = 0;
+    for (size_t i = 0; i < sizeof(classes) / sizeof(classes[0]); i++) {
+        if (!classes[i]) {
+            continue;
+        }
 
-        return isLoaded_ = !exception;
+        MonoImage *image = mono_class_get_image(classes[i]);
+        std::set<uint32_t> generic = GetGenericMethods(image);
+
+        void *iter = NULL;
+        MonoMethod *method;
+        while ((method = mono_class_get_methods(classes[i], &iter))) {
+            if (cancel.load(std::memory_order_relaxed)) {
+                return count;
+            }
+
+            // Methods without IL and generic method definitions can't be
+            // compiled.
+            uint32_t iflags;
+            uint32_t flags = mono_method_get_flags(method, &iflags);
+            if ((flags & (MONO_METHOD_ATTR_ABSTRACT |
+                MONO_METHOD_ATTR_PINVOKE_IMPL)) ||
+                (iflags & MONO_METHOD_IMPL_ATTR_INTERNAL_CALL) ||
+                (iflags & MONO_METHOD_IMPL_ATTR_CODE_TYPE_MASK) !=
+                MONO_METHOD_IMPL_ATTR_IL ||
+                generic.count(mono_method_get_token(method))) {
+                continue;
+            }
+
+            if (mono_compile_method(method)) {
+                count++;
+            }
+        }
     }
-    else {
-        isLoaded_ = true;
-        return true;
+
+    return count;
+}
+
+std::set<uint32_t> GameMode::GetGenericMethods(MonoImage *image) {
+    std::set<uint32_t> result;
+
+    // The owner of a generic parameter is a TypeOrMethodDef coded index: the
+    // lowest bit is set for methods, the others hold the row.
+    const MonoTableInfo *table = mono_image_get_table_info(image,
+        MONO_TABLE_GENERICPARAM);
+    int rows = mono_table_info_get_rows(table);
+    for (int i = 0; i < rows; i++) {
+        uint32_t owner = mono_metadata_decode_row_col(table, i,
+            MONO_GENERICPARAM_OWNER);
+
+        if (owner & 1) {
+            result.insert(MONO_TOKEN_METHOD_DEF | (owner >> 1));
+        }
     }
+
+    return result;
 }
 
 bool GameMode::Unload() {
@@ -165,8 +335,10 @@ bool GameMode::Unload() {
         return false;
     }
 
-    // Clear found methods.
+    // Clear found methods. They belong to the domain which is about to be
+    // unloaded.
     tickMethod_ = NULL;
+    timerTickMethod_ = NULL;
     paramLengthClass_ = NULL;
     paramLengthGetMethod_ = NULL;
     onCallbackException_ = NULL;
@@ -195,7 +367,7 @@ bool GameMode::Unload() {
     logprintf("Clearing callbacks table...");
     for (CallbackMap::iterator iter = callbacks_.begin();
         iter != callbacks_.end(); iter++) {
-        iter->second->params.clear();
+        // Callbacks without a handler are stored as NULL.
         delete iter->second;
     }
     callbacks_.clear();
@@ -210,28 +382,54 @@ bool GameMode::Unload() {
         CallEvent(method, gameModeHandle_, NULL, NULL);
     }
 
+    // Commands queued while disposing have been executed; unpin the command
+    // buffer before its domain is unloaded.
+    DetachCommandBuffer();
+
+    // Dispose may still have looked up heights. Unmap the height map; the next
+    // game mode maps it again if it needs it.
+    HeightMap::Unload();
+
+    // Unpin the player snapshot buffers, which Dispose may still have read;
+    // they belong to the domain which is about to be unloaded.
+    PlayerSnapshot::Detach();
+
+    // Summarize the suppressed exceptions; the fingerprints refer to classes
+    // and methods of the domain.
+    ExceptionThrottle::Clear();
+
+    // Remove the streamed items the game mode left behind, so their entities
+    // don't outlive it.
+    Streamer::Clear();
+    ProximityIndex::Clear();
+
+    // Stop profiling along with the game mode which started it.
+    NativeProfiler::Clear();
+
+    // The watchdog refers to methods of the domain.
+    Watchdog::Stop();
+
+    // Dispose may have searched for the callback exception handler again.
+    onCallbackException_ = NULL;
+    onCallbackExceptionSearched_ = false;
+
     // Release game mode.
     mono_gchandle_free(gameModeHandle_);
 
 
     gameModeHandle_ = 0;
 
-    logprintf("Collecting garbage...");
-    mono_gc_collect(mono_gc_max_generation());
+    // A domain can't be unloaded while it is the current domain. Unloading
+    // the domain closes the assemblies and images loaded into it.
+    mono_domain_set(previousDomain_, 1);
+    mono_thread_attach(previousDomain_);
 
-    logprintf("Closing images...");
-    mono_image_close(gameMode_.image);
-    mono_image_close(baseMode_.image);
+    logprintf("Unloading domain...");
+    mono_domain_unload(domain_);
 
     logprintf("Collecting garbage...");
     mono_gc_collect(mono_gc_max_generation());
 
-    //logprintf("Closing assembly...");
-    //mono_assembly_close(assemby_);
-
-    //logprintf("Unloading domain...");
-    //mono_domain_unload(domain_);
-
     gameMode_.image = NULL;
     gameMode_.klass = NULL;
 
@@ -241,9 +439,6 @@ bool GameMode::Unload() {
     domain_ = NULL;
     assemby_ = NULL;
 
-    mono_domain_set(previousDomain_, 1);
-    mono_thread_attach(previousDomain_);
-
     isLoaded_ = false;
     return true;
 }
@@ -370,9 +565,11 @@ MonoString* GameMode::StringToMonoString(char* str, int len) {
 }
 
 char* GameMode::MonoStringToString(MonoString *str) {
+    return UnicodeToString(mono_string_chars(str), mono_string_length(str));
+}
+
+char* GameMode::UnicodeToString(const mono_unichar2 *uni_buf, int len) {
     std::vector<char> buffer;
-    mono_unichar2* uni_buf = mono_string_chars(str);
-    int len = mono_string_length(str);
     for (int i = 0; i < len; i++) {
         uint16_t c = (uint16_t)uni_buf[i];
 
@@ -459,6 +656,17 @@ int GameMode::InvokeNative(int handle, MonoArray *args_array) {
             "invalid handle"));
     }
 
+    // Execute buffered commands first so natives run in the order in which
+    // they were issued.
+    FlushPendingCommands();
+
+    // Time a sample of the calls if the profiler is enabled.
+    NativeProfiler::Clock::time_point start, invoke_start, invoke_end;
+    bool timed = NativeProfiler::IsEnabled() && NativeProfiler::Count(handle);
+    if (timed) {
+        start = NativeProfiler::Clock::now();
+    }
+
     /* Get the pointer to the native signature in the pool and check whether the
      * arguments count matches the signature. */
     NativeSignature *sig = &natives_[handle];
@@ -528,9 +736,39 @@ int GameMode::InvokeNative(int handle, MonoArray *args_array) {
         }
     }
 
+    if (timed) {
+        invoke_start = NativeProfiler::Clock::now();
+    }
+
     int return_value = sampgdk::InvokeNativeArray(sig->native, sig->format,
         params);
 
+    if (timed) {
+        invoke_end = NativeProfiler::Clock::now();
+    }
+
+    if (CallbackLog::IsOpen()) {
+        CallbackLog::WriteNative(sig->name, return_value);
+
+        // Record the output of the native as well; the game mode reads it
+        // just like the return value.
+        for (int i = 0; i < sig->param_count; i++) {
+            switch (sig->parameters[i]) {
+            case 'D': // integer reference
+                CallbackLog::WriteRef(i, (cell)*(int *)params[i]);
+                break;
+            case 'S': // non-const string (writeable)
+                CallbackLog::WriteString(i, (const char *)params[i],
+                    (int)strnlen((const char *)params[i], param_size[i]));
+                break;
+            case 'A': // array of integers reference
+                CallbackLog::WriteArray(i, (const cell *)params[i],
+                    param_size[i]);
+                break;
+            }
+        }
+    }
+
     /* Delete buffers and write reference types back to the mono arguments
      * array. */
     for (int i = 0; i < sig->param_count; i++) {
@@ -568,6 +806,11 @@ int GameMode::InvokeNative(int handle, MonoArray *args_array) {
         }
     }
 
+    if (timed) {
+        NativeProfiler::Record(handle, sig->name, start, invoke_start,
+            invoke_end, NativeProfiler::Clock::now());
+    }
+
     return return_value;
 }
 
@@ -720,15 +963,170 @@ bool GameMode::NativeExists(MonoString *name_string) {
 	return find_native_result;
 }
 
+void GameMode::AttachCommandBuffer(MonoArray *buffer) {
+    if (!buffer) {
+        mono_raise_exception(mono_get_exception_argument_null("buffer"));
+        return;
+    }
+
+    if (mono_array_length(buffer) < 2) {
+        mono_raise_exception(mono_get_exception_argument("buffer",
+            "Buffer is too small"));
+        return;
+    }
+
+    // Execute the commands in the previous buffer before replacing it.
+    FlushPendingCommands();
+    DetachCommandBuffer();
+
+    // The buffer is read after every event; pin it so the garbage collector
+    // cannot move it out from under the stored pointer.
+    commandBufferHandle_ = mono_gchandle_new((MonoObject *)buffer, true);
+    commandBuffer_ = mono_array_addr(buffer, int, 0);
+    commandBufferLength_ = (int)mono_array_length(buffer);
+}
+
+void GameMode::DetachCommandBuffer() {
+    if (!commandBuffer_) {
+        return;
+    }
+
+    mono_gchandle_free(commandBufferHandle_);
+
+    commandBufferHandle_ = 0;
+    commandBuffer_ = NULL;
+    commandBufferLength_ = 0;
+}
+
+int GameMode::FlushCommandBuffer() {
+    if (!commandBuffer_ || !commandBuffer_[0]) {
+        return 0;
+    }
+
+    /* The first element of the buffer holds the number of elements used by
+     * queued commands. Every command consists of a native handle followed by
+     * its arguments; integers take one element, strings take their length
+     * followed by their UTF-16 characters packed two per element.
+     */
+    int length = commandBuffer_[0];
+    if (length < 0 || length >= commandBufferLength_) {
+        logprintf("[SampSharp] ERROR: Command buffer is corrupt; discarded "
+            "%d elements.", length);
+        commandBuffer_[0] = 0;
+        return 0;
+    }
+
+    // Copy the commands and empty the buffer before executing them; natives
+    // may invoke callbacks which queue new commands.
+    std::vector<cell> commands(commandBuffer_ + 1,
+        commandBuffer_ + 1 + length);
+    commandBuffer_[0] = 0;
+
+    int count = 0;
+    int pos = 0;
+
+    while (pos < length) {
+        int handle = commands[pos++];
+
+        if (handle < 0 || handle >= (int)natives_.size()) {
+            logprintf("[SampSharp] ERROR: Command buffer contains invalid "
+                "native handle %d; discarded the remaining commands.", handle);
+            break;
+        }
+
+        NativeSignature *sig = &natives_[handle];
+        void *params[MAX_NATIVE_ARGS];
+        int converted = 0;
+        bool valid = true;
+
+        NativeProfiler::Clock::time_point start, invoke_start, invoke_end;
+        bool timed = NativeProfiler::IsEnabled() &&
+            NativeProfiler::Count(handle);
+        if (timed) {
+            start = NativeProfiler::Clock::now();
+        }
+
+        for (int i = 0; i < sig->param_count && valid; i++) {
+            if (pos >= length) {
+                valid = false;
+                break;
+            }
+
+            switch (sig->parameters[i]) {
+            case 'd': // integer
+                params[i] = &commands[pos++];
+                break;
+            case 's': { // const string
+                int len = commands[pos++];
+                int words = (len + 1) / 2;
+
+                if (len < 0 || pos + words > length) {
+                    valid = false;
+                    break;
+                }
+
+                params[i] = UnicodeToString(
+                    (const mono_unichar2 *)&commands[pos], len);
+                pos += words;
+                break;
+            }
+            default: // references and arrays are not supported
+                valid = false;
+                break;
+            }
+
+            if (valid) {
+                converted++;
+            }
+        }
+
+        if (valid) {
+            if (timed) {
+                invoke_start = NativeProfiler::Clock::now();
+            }
+
+            int return_value = sampgdk::InvokeNativeArray(sig->native,
+                sig->format, params);
+
+            if (timed) {
+                invoke_end = NativeProfiler::Clock::now();
+            }
+
+            if (CallbackLog::IsOpen()) {
+                CallbackLog::WriteNative(sig->name, return_value);
+            }
+
+            count++;
+        }
+
+        for (int i = 0; i < converted; i++) {
+            if (sig->parameters[i] == 's') {
+                delete[] (char *)params[i];
+            }
+        }
+
+        if (timed && valid) {
+            NativeProfiler::Record(handle, sig->name, start, invoke_start,
+                invoke_end, NativeProfiler::Clock::now());
+        }
+
+        if (!valid) {
+            logprintf("[SampSharp] ERROR: Command buffer contains an invalid "
+                "call to %s; discarded the remaining commands.", sig->name);
+            break;
+        }
+    }
+
+    return count;
+}
+
 void GameMode::ProcessTimerTick(int timerid, void *data) {
     if (!isLoaded_) {
         return;
     }
 
-    static MonoMethod *method;
-
-    if (method == NULL) {
-        method = LoadEvent("OnTimerTick", 2);
+    if (!timerTickMethod_) {
+        timerTickMethod_ = LoadEvent("OnTimerTick", 2);
     }
 
     void *args[2];
@@ -740,7 +1138,9 @@ void GameMode::ProcessTimerTick(int timerid, void *data) {
         args[1] = mono_gchandle_get_target(timer->handle);
     }
 
-    CallEvent(method, gameModeHandle_, args, NULL);
+    TickMonitor::Clock::time_point start = TickMonitor::Begin();
+    CallEvent(timerTickMethod_, gameModeHandle_, args, NULL);
+    TickMonitor::End(TickMonitor::Timer, "OnTimerTick", timerid, start);
 
     /* After OnTimerTick has been called and the timer is not repeating,
      * drop the handle and erase the timer from the map.
@@ -763,7 +1163,23 @@ void GameMode::ProcessTick() {
         tickMethod_ = LoadEvent("OnTick", 0);
     }
 
+    if (CallbackLog::IsOpen()) {
+        CallbackLog::WriteTick();
+    }
+
+    if (PlayerSnapshot::IsAttached()) {
+        PlayerSnapshot::Capture();
+    }
+
     CallEvent(tickMethod_, gameModeHandle_, NULL, NULL);
+
+    // Stream after the tick handlers so items added or moved by them are
+    // visible in this tick.
+    if (Streamer::IsActive()) {
+        Streamer::Process();
+    }
+
+    ExceptionThrottle::Flush(false);
 }
 
 void GameMode::AddInternalCall(const char * name, const void * method) {
@@ -911,6 +1327,22 @@ void GameMode::ProcessPublicCall(AMX *amx, const char *name, cell *params,
         return;
     }
 
+    // Mark the players and vehicles which moved and release the streamed
+    // entities of players who left, regardless of whether the game mode
+    // handles the callback.
+    ProximityIndex::ProcessPublicCall(name, params);
+    Streamer::ProcessPublicCall(name, params);
+
+    // Drop the updates of players which were forwarded too recently, before
+    // anything is passed to the runtime. Dropped updates are recorded all the
+    // same; they have no string or array parameters.
+    if (PlayerUpdateThrottle::Filter(name, params, retval)) {
+        if (CallbackLog::IsOpen()) {
+            CallbackLog::WritePublic(name, params);
+        }
+        return;
+    }
+
     /* OnRconCommand can sometimes end up on different theads?
      * Just to make sure, attach the current thread to the domain.
      */
@@ -963,6 +1395,10 @@ void GameMode::ProcessPublicCall(AMX *amx, const char *name, cell *params,
     }
 
     if (signature = callbacks_[name]) {
+        if (CallbackLog::IsOpen()) {
+            RecordPublicCall(amx, name, params, signature);
+        }
+
         // Handle calls without parameters.
         if (!param_count) {
             int retint = CallEvent(signature->method, signature->handle, NULL,
@@ -1079,6 +1515,50 @@ void GameMode::ProcessPublicCall(AMX *amx, const char *name, cell *params,
         if (retval != NULL && retint != -1) {
             *retval = retint;
         }
+        if (retint != -1) {
+            PlayerUpdateThrottle::StoreReturnValue(name, params, retint);
+        }
+    }
+}
+
+void GameMode::RecordPublicCall(AMX *amx, const char *name, cell *params,
+    CallbackSignature *signature) {
+    int param_count = params[0] / sizeof(cell);
+
+    CallbackLog::WritePublic(name, params);
+
+    /* Strings and arrays are passed by address; write their contents so the
+     * call can be reconstructed in another AMX.
+     */
+    for (int i = 0; i < param_count && i < (int)signature->params.size();
+        i++) {
+        cell *addr = NULL;
+        int len = 0;
+
+        switch (signature->params[i].type) {
+        case PARAM_STRING: {
+            amx_GetAddr(amx, params[i + 1], &addr);
+            amx_StrLen(addr, &len);
+
+            char *text = new char[len + 1];
+            amx_GetString(text, addr, 0, len + 1);
+            CallbackLog::WriteString(i, text, len);
+            delete[] text;
+            break;
+        }
+        case PARAM_INT_ARRAY:
+        case PARAM_FLOAT_ARRAY:
+        case PARAM_BOOL_ARRAY:
+            len = params[signature->params[i].length_idx];
+
+            if (len > 0) {
+                amx_GetAddr(amx, params[i + 1], &addr);
+                CallbackLog::WriteArray(i, addr, len);
+            }
+            break;
+        default:
+            break;
+        }
     }
 }
 
@@ -1095,35 +1575,21 @@ MonoMethod *GameMode::LoadEvent(const char *name, int param_count) {
 }
 
 void GameMode::PrintException(const char *methodname, MonoObject *exception) {
+    // Formatting the stack trace is expensive; during an exception storm only
+    // the first exception of every fingerprint is printed in full.
+    if (!ExceptionThrottle::Report(domain_, methodname, exception)) {
+        return;
+    }
+
     char *stacktrace = mono_string_to_utf8(
         mono_object_to_string(exception, NULL));
 
-    /* Print error to console. Cannot print the exception to logprintf; the
-     * buffer is too small.
-     */
-    std::cout << "[SampSharp] Exception thrown during execution of "
-        << methodname << ":" << std::endl
-        << stacktrace << std::endl;
-
-    // Append error to log file.
-    time_t now = time(0);
-    tm _Tm;
-
-#if SAMPSHARP_WINDOWS
-    localtime_s(&_Tm, &now);
-#elif SAMPSHARP_LINUX
-    _Tm = *localtime_r(&now, &_Tm);
-#endif
-
-    char timestamp[32];
-    strftime(timestamp, sizeof(timestamp), "[%d/%m/%Y %H:%M:%S]", &_Tm);
-
-    std::ofstream logfile;
-    logfile.open("SampSharp_errors.log", std::ios::app | std::ios::binary);
-    logfile << timestamp << " Exception thrown" << methodname << ":"
-        << "\r\n" << stacktrace << "\r\n";
-	logfile.close();
-	mono_free(stacktrace);
+    // The error log writes to the console and the log file on its own thread.
+    string header = string("Exception thrown during execution of ")
+        .append(methodname);
+    ErrorLog::Write(header.c_str(), stacktrace);
+
+    mono_free(stacktrace);
 }
 
 int GameMode::CallEvent(MonoMethod *method, uint32_t handle, void **params,
@@ -1132,8 +1598,14 @@ int GameMode::CallEvent(MonoMethod *method, uint32_t handle, void **params,
     assert(handle);
 
     MonoObject *exception;
+    Watchdog::Enter(method);
     MonoObject *response = mono_runtime_invoke(method,
         mono_gchandle_get_target(handle), params, &exception);
+    Watchdog::Exit();
+
+    // Execute the commands the event has queued before returning to the
+    // server.
+    FlushPendingCommands();
 
     if (exception) {
         // Return the exception.
@@ -1141,10 +1613,9 @@ int GameMode::CallEvent(MonoMethod *method, uint32_t handle, void **params,
             *exception_return = exception;
         }
 
-        // Find callback handler if it has not been found previously.
-        if (isLoaded_ && !onCallbackException_ &&
-            mono_class_get_method_from_name(baseMode_.klass,
-                "OnCallbackException", 1)) {
+        // Find callback handler if it has not been searched for previously.
+        if (isLoaded_ && !onCallbackExceptionSearched_) {
+            onCallbackExceptionSearched_ = true;
 
             void *method_iter = NULL;
             while ((onCallbackException_ = mono_class_get_methods(
@@ -1165,7 +1636,8 @@ int GameMode::CallEvent(MonoMethod *method, uint32_t handle, void **params,
             }
         }
 
-        // Invoke the callback handler if it exists.
+        // Invoke the callback handler if it exists. The handler sees every
+        // exception; only printing is throttled.
         if (isLoaded_ && onCallbackException_) {
             MonoObject *exception2;
             MonoObject *response2 = mono_runtime_invoke(onCallbackException_,
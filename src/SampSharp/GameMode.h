@@ -13,8 +13,10 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <atomic>
 #include <string>
 #include <map>
+#include <set>
 #include <vector>
 #include <mono/jit/jit.h>
 #include <mono/metadata/metadata.h>
@@ -38,6 +40,15 @@ class GameMode {
 public:
     /* Loads the game mode with the specified namespace class names. */
     static bool Load(std::string namespaceName, std::string className);
+    /* Creates the domain of the game mode with the specified namespace and
+     * class names and opens its assembly, without running any of its code.
+     * Can be called on any thread attached to the runtime before Load. */
+    static bool Prepare(std::string namespaceName, std::string className,
+        std::string &error);
+    /* Compiles the callbacks of the prepared game mode and commonly used
+     * framework methods in its domain, until cancel is set. Returns the
+     * number of compiled methods. */
+    static int Precompile(const std::atomic<bool> &cancel);
     /* Unloads the loaded game mode. */
     static bool Unload();
     /* Processes a server tick. */
@@ -49,6 +60,9 @@ public:
     static bool IsLoaded() {
         return isLoaded_;
     }
+    /* Converts MonoString to a string in the loaded codepage. The caller
+     * must delete[] the result. */
+    static char* MonoStringToString(MonoString *str);
 
     /* Internal types. */
 private:
@@ -116,12 +130,18 @@ private:
     static GameModeImage baseMode_;
     static uint32_t gameModeHandle_;
     static MonoMethod *onCallbackException_;
+    static bool onCallbackExceptionSearched_;
     static MonoMethod *tickMethod_;
+    static MonoMethod *timerTickMethod_;
     static MonoClass *paramLengthClass_;
     static MonoMethod *paramLengthGetMethod_;
     static int bootSequenceNumber_;
     static MonoDomain *previousDomain_;
     static MonoAssembly *assemby_;
+    static bool isPrepared_;
+    static uint32_t commandBufferHandle_;
+    static int *commandBuffer_;
+    static int commandBufferLength_;
     static std::map<uint16_t, uint16_t> cptouni_;
     static std::map<uint16_t, uint16_t> unitocp_;
     static bool cpwide_[256];
@@ -140,6 +160,9 @@ private:
      * a SampSharp.GameMode.API.ParameterLengthAttribute attribute attached to
      * the specified method.*/
     static int GetParamLengthIndex(MonoMethod *method, int idx);
+
+    /* Gets the tokens of the generic method definitions in an image. */
+    static std::set<uint32_t> GetGenericMethods(MonoImage *image);
     /* Calls an event with the specified method on the specified handle with the
      * specified parameters. The exception pointer will be set if an exception
      * is thrown during the executing of the event.*/
@@ -159,12 +182,25 @@ private:
     * handle. */
     static MonoMethod *FindMethodForCallback(const char *name,
         int param_count, uint32_t &handle);
-    /* Prints the specified exception to the log. */
+    /* Writes the specified public call and the strings and arrays passed to
+     * it to the callback log. */
+    static void RecordPublicCall(AMX *amx, const char *name, cell *params,
+        CallbackSignature *signature);
+    /* Prints the specified exception to the log. Exceptions of which the
+     * fingerprint has already been printed in the current window are only
+     * counted. */
     static void PrintException(const char *methodname, MonoObject *exception);
     /* Converts string to MonoString. */
     static MonoString* StringToMonoString(char* str, int len);
-    /* Converts MonoString to string. */
-    static char* MonoStringToString(MonoString *str);
+    /* Converts the specified UTF-16 characters to a string. */
+    static char* UnicodeToString(const mono_unichar2 *chars, int len);
+    /* Executes the commands in the attached command buffer if it contains
+     * any. */
+    static void FlushPendingCommands() {
+        if (commandBuffer_ && commandBuffer_[0]) {
+            FlushCommandBuffer();
+        }
+    }
 
     /* Interop/API functions. */
 private:
@@ -179,6 +215,10 @@ private:
     static int InvokeNative(int handle, MonoArray *arguments);
     static bool NativeExists(MonoString *name);
 
+    static void AttachCommandBuffer(MonoArray *buffer);
+    static void DetachCommandBuffer();
+    static int FlushCommandBuffer();
+
     static void LoadCodepage(const char *name);
 
 };
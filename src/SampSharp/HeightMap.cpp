@@ -0,0 +1,350 @@
+// SampSharp
+// Copyright 2017 Tim Potze
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "HeightMap.h"
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <mono/metadata/exception.h>
+#include <sampgdk/sampgdk.h>
+#if SAMPSHARP_WINDOWS
+#include <windows.h>
+#elif SAMPSHARP_LINUX
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+#if HEIGHTMAP_SIMD && defined _MSC_VER
+#include <intrin.h>
+#elif HEIGHTMAP_SIMD
+#include <cpuid.h>
+#endif
+
+using sampgdk::logprintf;
+
+uint16_t *HeightMap::data_;
+size_t HeightMap::size_;
+int HeightMap::width_;
+int HeightMap::step_;
+HeightMap::SimdLevel HeightMap::simdLevel_;
+#if SAMPSHARP_WINDOWS
+void *HeightMap::mapping_;
+#endif
+
+bool HeightMap::Load(MonoString *path_string) {
+    char *path = mono_string_to_utf8(path_string);
+    bool result = Map(path);
+
+    mono_free(path);
+    return result;
+}
+
+bool HeightMap::Map(const char *path) {
+    Unload();
+
+#if SAMPSHARP_WINDOWS
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL,
+        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+
+    LARGE_INTEGER size;
+    GetFileSizeEx(file, &size);
+    size_ = (size_t)size.QuadPart;
+
+    // Copy-on-write pages; SetZ must not modify the file.
+    mapping_ = CreateFileMappingA(file, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+    CloseHandle(file);
+
+    if (!mapping_) {
+        return false;
+    }
+
+    data_ = (uint16_t *)MapViewOfFile(mapping_, FILE_MAP_COPY, 0, 0, 0);
+
+    if (!data_) {
+        CloseHandle(mapping_);
+        mapping_ = NULL;
+        return false;
+    }
+#elif SAMPSHARP_LINUX
+    int file = open(path, O_RDONLY);
+
+    if (file < 0) {
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(file, &info) != 0 || info.st_size == 0) {
+        close(file);
+        return false;
+    }
+    size_ = (size_t)info.st_size;
+
+    // Copy-on-write pages; SetZ must not modify the file.
+    void *data = mmap(NULL, size_, PROT_READ | PROT_WRITE, MAP_PRIVATE, file,
+        0);
+    close(file);
+
+    if (data == MAP_FAILED) {
+        return false;
+    }
+
+    data_ = (uint16_t *)data;
+#endif
+
+    width_ = (int)sqrt((double)(size_ / sizeof(uint16_t)));
+
+    if (width_ == 0 || (size_t)width_ * width_ * sizeof(uint16_t) != size_ ||
+        HEIGHTMAP_SIZE % width_ != 0) {
+        logprintf("[SampSharp] ERROR: %s is not a valid height map.", path);
+        Unload();
+        return false;
+    }
+
+    step_ = HEIGHTMAP_SIZE / width_;
+    simdLevel_ = DetectSimdLevel();
+    return true;
+}
+
+HeightMap::SimdLevel HeightMap::DetectSimdLevel() {
+#if HEIGHTMAP_SIMD
+    unsigned int regs[4] = { 0 };
+    unsigned int max_leaf;
+
+#ifdef _MSC_VER
+    __cpuid((int *)regs, 0);
+    max_leaf = regs[0];
+    __cpuid((int *)regs, 1);
+#else
+    max_leaf = __get_cpuid_max(0, NULL);
+    __cpuid(1, regs[0], regs[1], regs[2], regs[3]);
+#endif
+
+    bool sse2 = (regs[3] & (1 << 26)) != 0;
+    bool osxsave = (regs[2] & (1 << 27)) != 0;
+    bool avx = (regs[2] & (1 << 28)) != 0;
+
+    if (!sse2) {
+        return SIMD_NONE;
+    }
+
+    // AVX2 requires the OS to save the upper halves of the ymm registers.
+    if (max_leaf < 7 || !osxsave || !avx) {
+        return SIMD_SSE2;
+    }
+
+#ifdef _MSC_VER
+    unsigned long long xcr0 = _xgetbv(0);
+    __cpuidex((int *)regs, 7, 0);
+#else
+    unsigned int xcr0_lo, xcr0_hi;
+    __asm__("xgetbv" : "=a"(xcr0_lo), "=d"(xcr0_hi) : "c"(0));
+    unsigned long long xcr0 = xcr0_lo;
+    __cpuid_count(7, 0, regs[0], regs[1], regs[2], regs[3]);
+#endif
+
+    if ((xcr0 & 6) != 6 || !(regs[1] & (1 << 5))) {
+        return SIMD_SSE2;
+    }
+
+    return SIMD_AVX2;
+#else
+    return SIMD_NONE;
+#endif
+}
+
+void HeightMap::Unload() {
+    if (!data_) {
+        return;
+    }
+
+#if SAMPSHARP_WINDOWS
+    UnmapViewOfFile(data_);
+    CloseHandle(mapping_);
+    mapping_ = NULL;
+#elif SAMPSHARP_LINUX
+    munmap(data_, size_);
+#endif
+
+    data_ = NULL;
+    size_ = 0;
+    width_ = 0;
+    step_ = 0;
+}
+
+float HeightMap::FindZ(float x, float y) {
+    if (!data_) {
+        return 0;
+    }
+
+    int index = GetIndex(x, y);
+
+    return index < 0 ? 0 : data_[index] / 100.0f;
+}
+
+float HeightMap::FindAverageZ(float x, float y) {
+    if (!data_) {
+        return 0;
+    }
+
+    // Take the heights of the cell and the neighbouring cells towards the
+    // center of the map and interpolate between them.
+    float p1 = FindZ(x, y);
+    float p2 = FindZ(x < 0 ? x + step_ : x - step_, y);
+    float p3 = FindZ(x, y < 0 ? y + step_ : y - step_);
+
+    float xx = fmodf(x, 1);
+    float yy = fmodf(y, 1);
+
+    return p1 + xx * (p1 - p2) + yy * (p1 - p3);
+}
+
+float HeightMap::FindBilinearZ(float x, float y) {
+    if (!data_ || !IsOnMap(x, y)) {
+        return 0;
+    }
+
+    // Grid coordinates; the data is stored from north to south.
+    float grid_x = (x + HEIGHTMAP_EXTENT) / step_;
+    float grid_y = (HEIGHTMAP_EXTENT - y) / step_;
+
+    int x0 = (int)grid_x;
+    int y0 = (int)grid_y;
+    float fx = grid_x - x0;
+    float fy = grid_y - y0;
+
+    int max = width_ - 1;
+    int x1 = x0 + 1 < max ? x0 + 1 : max;
+    int y1 = y0 + 1 < max ? y0 + 1 : max;
+    if (x0 > max) x0 = max;
+    if (y0 > max) y0 = max;
+
+    float h00 = data_[y0 * width_ + x0];
+    float h01 = data_[y0 * width_ + x1];
+    float h10 = data_[y1 * width_ + x0];
+    float h11 = data_[y1 * width_ + x1];
+
+    float top = h00 + (h01 - h00) * fx;
+    float bottom = h10 + (h11 - h10) * fx;
+
+    return (top + (bottom - top) * fy) / 100.0f;
+}
+
+void HeightMap::FindZArray(MonoArray *points, MonoArray *heights,
+    int mode) {
+    if (!points || !heights) {
+        mono_raise_exception(mono_get_exception_argument_null(
+            points ? "heights" : "points"));
+        return;
+    }
+
+    uintptr_t count = mono_array_length(points) / 2;
+
+    if (mono_array_length(heights) < count) {
+        mono_raise_exception(mono_get_exception_argument("heights",
+            "Array is too small to hold the results"));
+        return;
+    }
+
+    if (!count) {
+        return;
+    }
+
+    float *point = mono_array_addr(points, float, 0);
+    float *height = mono_array_addr(heights, float, 0);
+    uintptr_t done = 0;
+
+    if (!data_) {
+        memset(height, 0, count * sizeof(float));
+        return;
+    }
+
+    // Let the vector kernels handle as many points as they can; the
+    // remainder is looked up one at a time.
+#if HEIGHTMAP_SIMD
+    if (mode == HEIGHTMAP_FIND_NEAREST || mode == HEIGHTMAP_FIND_BILINEAR) {
+        bool bilinear = mode == HEIGHTMAP_FIND_BILINEAR;
+
+        switch (simdLevel_) {
+        case SIMD_AVX2:
+            done = count & ~(uintptr_t)7;
+            if (bilinear) FindBilinearAvx2(point, height, done);
+            else FindNearestAvx2(point, height, done);
+            break;
+        case SIMD_SSE2:
+            done = count & ~(uintptr_t)3;
+            if (bilinear) FindBilinearSse2(point, height, done);
+            else FindNearestSse2(point, height, done);
+            break;
+        default:
+            break;
+        }
+    }
+#endif
+
+    for (uintptr_t i = done; i < count; i++) {
+        float x = point[i * 2];
+        float y = point[i * 2 + 1];
+
+        switch (mode) {
+        case HEIGHTMAP_FIND_AVERAGE:
+            height[i] = FindAverageZ(x, y);
+            break;
+        case HEIGHTMAP_FIND_BILINEAR:
+            height[i] = FindBilinearZ(x, y);
+            break;
+        default:
+            height[i] = FindZ(x, y);
+            break;
+        }
+    }
+}
+
+bool HeightMap::SetZ(float x, float y, float z) {
+    if (!data_ || z < 0 || z > 655.35f) {
+        return false;
+    }
+
+    int index = GetIndex(x, y);
+
+    if (index < 0) {
+        return false;
+    }
+
+    data_[index] = (uint16_t)(z * 100.0f + 0.5f);
+    return true;
+}
+
+bool HeightMap::Save(MonoString *path_string) {
+    if (!data_) {
+        return false;
+    }
+
+    char *path = mono_string_to_utf8(path_string);
+    FILE *file = fopen(path, "wb");
+    mono_free(path);
+
+    if (!file) {
+        return false;
+    }
+
+    bool result = fwrite(data_, 1, size_, file) == size_;
+
+    return fclose(file) == 0 && result;
+}
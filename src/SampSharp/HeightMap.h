@@ -0,0 +1,127 @@
+// SampSharp
+// Copyright 2017 Tim Potze
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdint.h>
+#include <stddef.h>
+#include <mono/jit/jit.h>
+#include "platforms.h"
+
+#pragma once
+
+#define HEIGHTMAP_EXTENT                    (3000)
+#define HEIGHTMAP_SIZE                      (HEIGHTMAP_EXTENT * 2)
+
+#define HEIGHTMAP_FIND_NEAREST              (0)
+#define HEIGHTMAP_FIND_AVERAGE              (1)
+#define HEIGHTMAP_FIND_BILINEAR             (2)
+
+#if defined __i386__ || defined __x86_64__ || defined _M_IX86 || \
+    defined _M_X64
+#define HEIGHTMAP_SIMD                      (1)
+#else
+#define HEIGHTMAP_SIMD                      (0)
+#endif
+
+/* Provides ground level lookups on a SA height map (.hmap) file. The file is
+ * mapped into memory copy-on-write rather than read, so loading is instant,
+ * the page cache is shared between every server on the host and changes made
+ * through SetZ are never written back to the file.
+ *
+ * Height map files contain a square grid of uint16 heights in centimeters,
+ * row by row from north to south. The full map has a 1 unit grid (6000x6000),
+ * the minimal map a 3 unit grid (2000x2000).
+ *
+ * Batched lookups are vectorized using SSE2 or AVX2, depending on what the
+ * CPU supports. */
+class HeightMap {
+public:
+    /* Maps the height map file at the specified path. */
+    static bool Load(MonoString *path);
+    /* Unmaps the loaded height map. */
+    static void Unload();
+    /* Finds the ground level at the specified point. */
+    static float FindZ(float x, float y);
+    /* Calculates a linear approximation of the ground level at the specified
+     * point. */
+    static float FindAverageZ(float x, float y);
+    /* Calculates the ground level at the specified point by bilinear
+     * interpolation between the four surrounding grid points. */
+    static float FindBilinearZ(float x, float y);
+    /* Finds the ground level at every point in the specified array of x and
+     * y pairs using the specified HEIGHTMAP_FIND_* mode and stores the results
+     * in the specified heights array. */
+    static void FindZArray(MonoArray *points, MonoArray *heights, int mode);
+    /* Sets the ground level at the specified point. */
+    static bool SetZ(float x, float y, float z);
+    /* Saves the height map, including changes, to the specified path. */
+    static bool Save(MonoString *path);
+    /* Gets a value indicating whether a height map is loaded. */
+    static bool IsLoaded() {
+        return data_ != NULL;
+    }
+
+private:
+    /* Enum of supported instruction sets for batched lookups. */
+    enum SimdLevel {
+        SIMD_NONE,
+        SIMD_SSE2,
+        SIMD_AVX2
+    };
+
+    /* Gets a value indicating whether the specified point lies on the map. */
+    static bool IsOnMap(float x, float y) {
+        // Written so NaN coordinates fall outside of the map.
+        return x >= -HEIGHTMAP_EXTENT && x <= HEIGHTMAP_EXTENT &&
+            y >= -HEIGHTMAP_EXTENT && y <= HEIGHTMAP_EXTENT;
+    }
+    /* Gets the index of the cell containing the specified point or -1 if the
+     * point lies outside of the map. */
+    static int GetIndex(float x, float y) {
+        if (!IsOnMap(x, y)) {
+            return -1;
+        }
+
+        int grid_x = ((int)x + HEIGHTMAP_EXTENT) / step_;
+        int grid_y = (HEIGHTMAP_EXTENT - (int)y) / step_;
+
+        // The east and south edges fall just outside the grid.
+        if (grid_x >= width_) grid_x = width_ - 1;
+        if (grid_y >= width_) grid_y = width_ - 1;
+
+        return grid_y * width_ + grid_x;
+    }
+    static bool Map(const char *path);
+    static SimdLevel DetectSimdLevel();
+
+    /* Vectorized lookups, implemented in HeightMapSimd.cpp. The SSE2 kernels
+     * process a multiple of 4 points, the AVX2 kernels a multiple of 8. */
+    static void FindNearestSse2(const float *points, float *heights,
+        size_t count);
+    static void FindBilinearSse2(const float *points, float *heights,
+        size_t count);
+    static void FindNearestAvx2(const float *points, float *heights,
+        size_t count);
+    static void FindBilinearAvx2(const float *points, float *heights,
+        size_t count);
+
+    static uint16_t *data_;
+    static size_t size_;
+    static int width_;
+    static int step_;
+    static SimdLevel simdLevel_;
+#if SAMPSHARP_WINDOWS
+    static void *mapping_;
+#endif
+};
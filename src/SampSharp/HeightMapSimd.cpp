@@ -0,0 +1,280 @@
+// SampSharp
+// Copyright 2017 Tim Potze
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "HeightMap.h"
+
+#if HEIGHTMAP_SIMD
+
+#include <emmintrin.h>
+#include <immintrin.h>
+
+/* The kernels are compiled for their instruction set regardless of the
+ * compiler flags; HeightMap only calls them if the CPU supports it. */
+#ifdef _MSC_VER
+#define HEIGHTMAP_TARGET(x)
+#else
+#define HEIGHTMAP_TARGET(x)                 __attribute__((target(x)))
+#endif
+
+/* The kernels compute the same values as FindZ and FindBilinearZ, using the
+ * same sequence of operations, for 4 or 8 points at once. Points outside of
+ * the map have their index masked to 0 and their result masked to 0.
+ *
+ * Grid coordinates never exceed 6000, so the 16-bit minimum and multiply-add
+ * instructions are exact on them; SSE2 has no 32-bit variants. */
+
+HEIGHTMAP_TARGET("sse2")
+static inline void LoadPointsSse2(const float *points, __m128 &x, __m128 &y) {
+    __m128 a = _mm_loadu_ps(points);
+    __m128 b = _mm_loadu_ps(points + 4);
+
+    x = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+    y = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+}
+
+HEIGHTMAP_TARGET("sse2")
+static inline __m128 IsOnMapSse2(__m128 x, __m128 y) {
+    __m128 lo = _mm_set1_ps(-HEIGHTMAP_EXTENT);
+    __m128 hi = _mm_set1_ps(HEIGHTMAP_EXTENT);
+
+    return _mm_and_ps(
+        _mm_and_ps(_mm_cmpge_ps(x, lo), _mm_cmple_ps(x, hi)),
+        _mm_and_ps(_mm_cmpge_ps(y, lo), _mm_cmple_ps(y, hi)));
+}
+
+HEIGHTMAP_TARGET("sse2")
+static inline __m128 GatherSse2(const uint16_t *data, __m128i index) {
+    int32_t idx[4];
+    _mm_storeu_si128((__m128i *)idx, index);
+
+    return _mm_cvtepi32_ps(_mm_set_epi32(data[idx[3]], data[idx[2]],
+        data[idx[1]], data[idx[0]]));
+}
+
+HEIGHTMAP_TARGET("sse2")
+void HeightMap::FindNearestSse2(const float *points, float *heights,
+    size_t count) {
+    const __m128i extent = _mm_set1_epi32(HEIGHTMAP_EXTENT);
+    const __m128i max = _mm_set1_epi32(width_ - 1);
+    const __m128i width = _mm_set1_epi32(width_);
+    const __m128 step = _mm_set1_ps((float)step_);
+    const __m128 hundred = _mm_set1_ps(100.0f);
+
+    for (size_t i = 0; i < count; i += 4) {
+        __m128 x, y;
+        LoadPointsSse2(points + i * 2, x, y);
+
+        __m128 inside = IsOnMapSse2(x, y);
+
+        __m128i grid_x = _mm_add_epi32(_mm_cvttps_epi32(x), extent);
+        __m128i grid_y = _mm_sub_epi32(extent, _mm_cvttps_epi32(y));
+        grid_x = _mm_cvttps_epi32(_mm_div_ps(_mm_cvtepi32_ps(grid_x), step));
+        grid_y = _mm_cvttps_epi32(_mm_div_ps(_mm_cvtepi32_ps(grid_y), step));
+        grid_x = _mm_min_epi16(grid_x, max);
+        grid_y = _mm_min_epi16(grid_y, max);
+
+        __m128i index = _mm_add_epi32(_mm_madd_epi16(grid_y, width), grid_x);
+        index = _mm_and_si128(index, _mm_castps_si128(inside));
+
+        __m128 z = _mm_div_ps(GatherSse2(data_, index), hundred);
+        _mm_storeu_ps(heights + i, _mm_and_ps(z, inside));
+    }
+}
+
+HEIGHTMAP_TARGET("sse2")
+void HeightMap::FindBilinearSse2(const float *points, float *heights,
+    size_t count) {
+    const __m128 extent = _mm_set1_ps(HEIGHTMAP_EXTENT);
+    const __m128i one = _mm_set1_epi32(1);
+    const __m128i max = _mm_set1_epi32(width_ - 1);
+    const __m128i width = _mm_set1_epi32(width_);
+    const __m128 step = _mm_set1_ps((float)step_);
+    const __m128 hundred = _mm_set1_ps(100.0f);
+
+    for (size_t i = 0; i < count; i += 4) {
+        __m128 x, y;
+        LoadPointsSse2(points + i * 2, x, y);
+
+        __m128 inside = IsOnMapSse2(x, y);
+        __m128i mask = _mm_castps_si128(inside);
+
+        __m128 grid_x = _mm_div_ps(_mm_add_ps(x, extent), step);
+        __m128 grid_y = _mm_div_ps(_mm_sub_ps(extent, y), step);
+
+        __m128i x0 = _mm_cvttps_epi32(grid_x);
+        __m128i y0 = _mm_cvttps_epi32(grid_y);
+        __m128 fx = _mm_sub_ps(grid_x, _mm_cvtepi32_ps(x0));
+        __m128 fy = _mm_sub_ps(grid_y, _mm_cvtepi32_ps(y0));
+
+        __m128i x1 = _mm_min_epi16(_mm_add_epi32(x0, one), max);
+        __m128i y1 = _mm_min_epi16(_mm_add_epi32(y0, one), max);
+        x0 = _mm_min_epi16(x0, max);
+        y0 = _mm_min_epi16(y0, max);
+
+        __m128i row0 = _mm_madd_epi16(y0, width);
+        __m128i row1 = _mm_madd_epi16(y1, width);
+
+        __m128 h00 = GatherSse2(data_,
+            _mm_and_si128(_mm_add_epi32(row0, x0), mask));
+        __m128 h01 = GatherSse2(data_,
+            _mm_and_si128(_mm_add_epi32(row0, x1), mask));
+        __m128 h10 = GatherSse2(data_,
+            _mm_and_si128(_mm_add_epi32(row1, x0), mask));
+        __m128 h11 = GatherSse2(data_,
+            _mm_and_si128(_mm_add_epi32(row1, x1), mask));
+
+        __m128 top = _mm_add_ps(h00, _mm_mul_ps(_mm_sub_ps(h01, h00), fx));
+        __m128 bottom = _mm_add_ps(h10, _mm_mul_ps(_mm_sub_ps(h11, h10), fx));
+        __m128 z = _mm_div_ps(
+            _mm_add_ps(top, _mm_mul_ps(_mm_sub_ps(bottom, top), fy)),
+            hundred);
+
+        _mm_storeu_ps(heights + i, _mm_and_ps(z, inside));
+    }
+}
+
+HEIGHTMAP_TARGET("avx2")
+static inline void LoadPointsAvx2(const float *points, __m256 &x, __m256 &y) {
+    __m256 a = _mm256_loadu_ps(points);
+    __m256 b = _mm256_loadu_ps(points + 8);
+
+    // The shuffle works per 128-bit lane, leaving the points in the order
+    // 0 1 4 5 2 3 6 7; swap the middle quarters to restore the order.
+    x = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+    y = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+    x = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(x),
+        _MM_SHUFFLE(3, 1, 2, 0)));
+    y = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(y),
+        _MM_SHUFFLE(3, 1, 2, 0)));
+}
+
+HEIGHTMAP_TARGET("avx2")
+static inline __m256 IsOnMapAvx2(__m256 x, __m256 y) {
+    __m256 lo = _mm256_set1_ps(-HEIGHTMAP_EXTENT);
+    __m256 hi = _mm256_set1_ps(HEIGHTMAP_EXTENT);
+
+    return _mm256_and_ps(
+        _mm256_and_ps(_mm256_cmp_ps(x, lo, _CMP_GE_OQ),
+            _mm256_cmp_ps(x, hi, _CMP_LE_OQ)),
+        _mm256_and_ps(_mm256_cmp_ps(y, lo, _CMP_GE_OQ),
+            _mm256_cmp_ps(y, hi, _CMP_LE_OQ)));
+}
+
+HEIGHTMAP_TARGET("avx2")
+static inline __m256 GatherAvx2(const uint16_t *data, __m256i index,
+    __m256i last) {
+    // There is no 16-bit gather; gather 32 bits and keep the lower half. The
+    // last height in the map is read together with the one before it so the
+    // gather never reads past the end of the mapping.
+    __m256i is_last = _mm256_cmpeq_epi32(index, last);
+    __m256i shift = _mm256_and_si256(is_last, _mm256_set1_epi32(16));
+    index = _mm256_add_epi32(index, is_last);
+
+    __m256i value = _mm256_i32gather_epi32((const int *)data, index, 2);
+    value = _mm256_srlv_epi32(value, shift);
+    value = _mm256_and_si256(value, _mm256_set1_epi32(0xffff));
+
+    return _mm256_cvtepi32_ps(value);
+}
+
+HEIGHTMAP_TARGET("avx2")
+void HeightMap::FindNearestAvx2(const float *points, float *heights,
+    size_t count) {
+    const __m256i extent = _mm256_set1_epi32(HEIGHTMAP_EXTENT);
+    const __m256i max = _mm256_set1_epi32(width_ - 1);
+    const __m256i width = _mm256_set1_epi32(width_);
+    const __m256i last = _mm256_set1_epi32(width_ * width_ - 1);
+    const __m256 step = _mm256_set1_ps((float)step_);
+    const __m256 hundred = _mm256_set1_ps(100.0f);
+
+    for (size_t i = 0; i < count; i += 8) {
+        __m256 x, y;
+        LoadPointsAvx2(points + i * 2, x, y);
+
+        __m256 inside = IsOnMapAvx2(x, y);
+
+        __m256i grid_x = _mm256_add_epi32(_mm256_cvttps_epi32(x), extent);
+        __m256i grid_y = _mm256_sub_epi32(extent, _mm256_cvttps_epi32(y));
+        grid_x = _mm256_cvttps_epi32(
+            _mm256_div_ps(_mm256_cvtepi32_ps(grid_x), step));
+        grid_y = _mm256_cvttps_epi32(
+            _mm256_div_ps(_mm256_cvtepi32_ps(grid_y), step));
+        grid_x = _mm256_min_epi32(grid_x, max);
+        grid_y = _mm256_min_epi32(grid_y, max);
+
+        __m256i index = _mm256_add_epi32(_mm256_mullo_epi32(grid_y, width),
+            grid_x);
+        index = _mm256_and_si256(index, _mm256_castps_si256(inside));
+
+        __m256 z = _mm256_div_ps(GatherAvx2(data_, index, last), hundred);
+        _mm256_storeu_ps(heights + i, _mm256_and_ps(z, inside));
+    }
+}
+
+HEIGHTMAP_TARGET("avx2")
+void HeightMap::FindBilinearAvx2(const float *points, float *heights,
+    size_t count) {
+    const __m256 extent = _mm256_set1_ps(HEIGHTMAP_EXTENT);
+    const __m256i one = _mm256_set1_epi32(1);
+    const __m256i max = _mm256_set1_epi32(width_ - 1);
+    const __m256i width = _mm256_set1_epi32(width_);
+    const __m256i last = _mm256_set1_epi32(width_ * width_ - 1);
+    const __m256 step = _mm256_set1_ps((float)step_);
+    const __m256 hundred = _mm256_set1_ps(100.0f);
+
+    for (size_t i = 0; i < count; i += 8) {
+        __m256 x, y;
+        LoadPointsAvx2(points + i * 2, x, y);
+
+        __m256 inside = IsOnMapAvx2(x, y);
+        __m256i mask = _mm256_castps_si256(inside);
+
+        __m256 grid_x = _mm256_div_ps(_mm256_add_ps(x, extent), step);
+        __m256 grid_y = _mm256_div_ps(_mm256_sub_ps(extent, y), step);
+
+        __m256i x0 = _mm256_cvttps_epi32(grid_x);
+        __m256i y0 = _mm256_cvttps_epi32(grid_y);
+        __m256 fx = _mm256_sub_ps(grid_x, _mm256_cvtepi32_ps(x0));
+        __m256 fy = _mm256_sub_ps(grid_y, _mm256_cvtepi32_ps(y0));
+
+        __m256i x1 = _mm256_min_epi32(_mm256_add_epi32(x0, one), max);
+        __m256i y1 = _mm256_min_epi32(_mm256_add_epi32(y0, one), max);
+        x0 = _mm256_min_epi32(x0, max);
+        y0 = _mm256_min_epi32(y0, max);
+
+        __m256i row0 = _mm256_mullo_epi32(y0, width);
+        __m256i row1 = _mm256_mullo_epi32(y1, width);
+
+        __m256 h00 = GatherAvx2(data_,
+            _mm256_and_si256(_mm256_add_epi32(row0, x0), mask), last);
+        __m256 h01 = GatherAvx2(data_,
+            _mm256_and_si256(_mm256_add_epi32(row0, x1), mask), last);
+        __m256 h10 = GatherAvx2(data_,
+            _mm256_and_si256(_mm256_add_epi32(row1, x0), mask), last);
+        __m256 h11 = GatherAvx2(data_,
+            _mm256_and_si256(_mm256_add_epi32(row1, x1), mask), last);
+
+        __m256 top = _mm256_add_ps(h00,
+            _mm256_mul_ps(_mm256_sub_ps(h01, h00), fx));
+        __m256 bottom = _mm256_add_ps(h10,
+            _mm256_mul_ps(_mm256_sub_ps(h11, h10), fx));
+        __m256 z = _mm256_div_ps(_mm256_add_ps(top,
+            _mm256_mul_ps(_mm256_sub_ps(bottom, top), fy)), hundred);
+
+        _mm256_storeu_ps(heights + i, _mm256_and_ps(z, inside));
+    }
+}
+
+#endif
@@ -0,0 +1,542 @@
+// SampSharp
+// Copyright 2017 Tim Potze
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "HostProcess.h"
+#include <stdio.h>
+#include <string.h>
+#include <chrono>
+#include <sstream>
+#include "platforms.h"
+#if SAMPSHARP_WINDOWS
+#include <windows.h>
+#elif SAMPSHARP_LINUX
+#include <signal.h>
+#include <sys/prctl.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+/* The largest number of parameters sampgdk passes to a native. */
+#define HOST_PROCESS_MAX_PARAMS             (32)
+
+using sampgdk::logprintf;
+
+/* Natives run on behalf of the host use the fake AMX of sampgdk, like the
+ * natives the plugin calls itself. */
+extern "C" {
+    AMX *sampgdk_fakeamx_amx(void);
+    int sampgdk_fakeamx_push(int cells, cell *address);
+    void sampgdk_fakeamx_pop(cell address);
+}
+
+IpcChannel HostProcess::channel_;
+std::vector<AMX_NATIVE> HostProcess::natives_;
+std::set<std::string> HostProcess::synchronous_;
+std::set<std::string> HostProcess::cached_;
+std::map<std::string, HostProcess::Results> HostProcess::results_;
+std::deque<HostProcess::PendingCall> HostProcess::pending_;
+uint32_t HostProcess::nextId_;
+uint32_t HostProcess::awaitedId_;
+std::deque<std::vector<char> > HostProcess::overflow_;
+std::deque<uint32_t> HostProcess::overflowTypes_;
+std::vector<char> HostProcess::message_;
+std::vector<char> HostProcess::heap_;
+IpcWriter HostProcess::writer_;
+bool HostProcess::busy_;
+bool HostProcess::returned_;
+bool HostProcess::stopping_;
+#if SAMPSHARP_WINDOWS
+void *HostProcess::process_;
+#elif SAMPSHARP_LINUX
+int HostProcess::pid_;
+#endif
+
+bool HostProcess::Start(const std::string &path) {
+    if (IsRunning()) {
+        return true;
+    }
+
+    std::ostringstream name;
+#if SAMPSHARP_WINDOWS
+    name << "sampsharp-" << GetCurrentProcessId();
+#elif SAMPSHARP_LINUX
+    name << "sampsharp-" << getpid();
+#endif
+
+    if (!channel_.Create(name.str())) {
+        logprintf("ERROR: Failed to create IPC channel %s.",
+            name.str().c_str());
+        return false;
+    }
+
+    // The host registers a forwarding native for every native the server
+    // knows about; natives are identified by their index in this list.
+    int count = 0;
+    const AMX_NATIVE_INFO *natives = sampgdk_GetNatives(&count);
+
+    writer_.Clear();
+    writer_.Write<uint32_t>(count);
+    natives_.clear();
+    for (int i = 0; i < count; i++) {
+        writer_.WriteString(natives[i].name);
+        natives_.push_back(natives[i].func);
+    }
+    channel_.Write(IPC_RING_CALLS, IPC_MSG_NATIVES, writer_.GetData(),
+        writer_.GetSize());
+
+#if SAMPSHARP_WINDOWS
+    std::string command = "\"" + path + "\" -i " + name.str();
+    STARTUPINFOA startup;
+    PROCESS_INFORMATION info;
+    memset(&startup, 0, sizeof(startup));
+    startup.cb = sizeof(startup);
+
+    if (!CreateProcessA(NULL, &command[0], NULL, NULL, TRUE, 0, NULL, NULL,
+        &startup, &info)) {
+        logprintf("ERROR: Failed to start host process %s.", path.c_str());
+        channel_.Close();
+        return false;
+    }
+
+    CloseHandle(info.hThread);
+    process_ = info.hProcess;
+#elif SAMPSHARP_LINUX
+    std::string channel = name.str();
+    const char *argv[] = { path.c_str(), "-i", channel.c_str(), NULL };
+
+    pid_ = fork();
+    if (pid_ == 0) {
+        // Don't outlive the server.
+        prctl(PR_SET_PDEATHSIG, SIGKILL);
+        execv(argv[0], (char *const *)argv);
+        _exit(127);
+    }
+    if (pid_ < 0) {
+        logprintf("ERROR: Failed to start host process %s.", path.c_str());
+        pid_ = 0;
+        channel_.Close();
+        return false;
+    }
+#endif
+
+    logprintf("Started host process %s on channel %s.", path.c_str(),
+        name.str().c_str());
+    return true;
+}
+
+void HostProcess::Stop() {
+    if (!IsRunning()) {
+        return;
+    }
+
+    // Let the host handle everything which is queued; unloading the game mode
+    // may call natives as well.
+    busy_ = true;
+    stopping_ = true;
+    writer_.Clear();
+    if (Send(IPC_MSG_EXIT, writer_)) {
+        std::chrono::steady_clock::time_point start =
+            std::chrono::steady_clock::now();
+
+        for (unsigned int polls = 0; CheckAlive();) {
+            Flush();
+            if (ProcessRequests()) {
+                polls = 0;
+                continue;
+            }
+
+            if (std::chrono::steady_clock::now() - start >
+                std::chrono::milliseconds(HOST_PROCESS_EXIT_TIMEOUT)) {
+                logprintf("ERROR: The host process did not exit in time.");
+                Kill();
+                break;
+            }
+            IpcChannel::Wait(polls++);
+        }
+    }
+    else {
+        Kill();
+    }
+    busy_ = false;
+    stopping_ = false;
+
+    Close();
+}
+
+void HostProcess::SetSynchronousCallbacks(const std::string &names) {
+    SetCallbacks(names, synchronous_);
+}
+
+void HostProcess::SetCachedCallbacks(const std::string &names) {
+    SetCallbacks(names, cached_);
+}
+
+void HostProcess::SetCallbacks(const std::string &names,
+    std::set<std::string> &callbacks) {
+    std::istringstream stream(names);
+    std::string name;
+
+    callbacks.clear();
+    while (stream >> name) {
+        callbacks.insert(name);
+    }
+}
+
+void HostProcess::ProcessPublicCall(AMX *amx, const char *name, cell *params,
+    cell *retval) {
+    if (!IsRunning()) {
+        return;
+    }
+
+    // Callbacks raised by natives running on behalf of the host can't wait
+    // for the host, which is waiting for the native.
+    bool synchronous = !busy_ && synchronous_.count(name) > 0;
+    bool cached = !synchronous && cached_.count(name) > 0;
+    cell key = params[0] >= (cell)sizeof(cell) ? params[1] : 0;
+
+    unsigned char *data = amx->data
+        ? amx->data
+        : amx->base + ((AMX_HEADER *)amx->base)->dat;
+    cell heapSize = amx->hea > amx->hlw ? amx->hea - amx->hlw : 0;
+    int param_count = params[0] / sizeof(cell);
+
+    // A player reconnecting with the same id starts over.
+    if (!strcmp(name, "OnPlayerDisconnect")) {
+        for (std::map<std::string, Results>::iterator iter = results_.begin();
+            iter != results_.end(); iter++) {
+            if (!iter->first.compare(0, 8, "OnPlayer")) {
+                iter->second.erase(key);
+            }
+        }
+    }
+
+    uint32_t id = nextId_++;
+
+    writer_.Clear();
+    writer_.Write<uint8_t>(synchronous || cached ? 1 : 0);
+    writer_.Write<uint32_t>(id);
+    writer_.WriteString(name);
+    writer_.Write<cell>(retval ? *retval : 0);
+    writer_.Write<cell>(amx->hlw);
+    writer_.Write<cell>(amx->hlw + heapSize);
+    writer_.Write<uint32_t>(heapSize);
+    writer_.Write(data + amx->hlw, heapSize);
+    writer_.Write<uint32_t>(param_count);
+    writer_.Write(params + 1, param_count * sizeof(cell));
+
+    if (!Send(IPC_MSG_PUBLIC_CALL, writer_) || (!synchronous && !cached)) {
+        return;
+    }
+
+    Results &results = results_[name];
+    PendingCall call = { id, &results, key };
+    pending_.push_back(call);
+
+    if (synchronous) {
+        WaitForReturn(name, id);
+    }
+
+    // A call which timed out or isn't waited for is answered with the last
+    // value the host returned; the server's default is kept until there is
+    // one.
+    Results::const_iterator result = results.find(key);
+    if (retval && result != results.end()) {
+        *retval = result->second;
+    }
+}
+
+void HostProcess::WaitForReturn(const char *name, uint32_t id) {
+    // Setting up and tearing down the game mode may take a while.
+    bool limited = strcmp(name, "OnGameModeInit") &&
+        strcmp(name, "OnGameModeExit");
+    std::chrono::steady_clock::time_point end =
+        std::chrono::steady_clock::now() +
+        std::chrono::milliseconds(HOST_PROCESS_CALL_TIMEOUT);
+
+    busy_ = true;
+    awaitedId_ = id;
+    returned_ = false;
+    for (unsigned int polls = 0; !returned_;) {
+        Flush();
+        if (ProcessRequests()) {
+            polls = 0;
+            continue;
+        }
+
+        if ((polls & 255) == 255) {
+            if (!CheckAlive()) {
+                break;
+            }
+            if (limited && std::chrono::steady_clock::now() >= end) {
+                logprintf("WARNING: The host process did not handle %s "
+                    "within %d ms; using its previous return value.", name,
+                    HOST_PROCESS_CALL_TIMEOUT);
+                break;
+            }
+        }
+        IpcChannel::Wait(polls++);
+    }
+    busy_ = false;
+}
+
+bool HostProcess::StoreReturnValue(uint32_t id, cell retval) {
+    // Every call of which the value is sent back gets a return, in order,
+    // unless the host exits.
+    while (!pending_.empty() && pending_.front().id != id) {
+        pending_.pop_front();
+    }
+    if (pending_.empty()) {
+        return false;
+    }
+
+    PendingCall &call = pending_.front();
+    (*call.results)[call.key] = retval;
+    pending_.pop_front();
+
+    return id == awaitedId_;
+}
+
+void HostProcess::ProcessTick() {
+    if (!IsRunning() || !CheckAlive()) {
+        return;
+    }
+
+    // Ticks aren't queued up while the host is busy; it runs one tick for
+    // however many the server ran in the meantime.
+    if (!channel_.IsTickPending()) {
+        channel_.SetTickPending(true);
+        writer_.Clear();
+        Send(IPC_MSG_TICK, writer_);
+    }
+
+    std::chrono::steady_clock::time_point now =
+        std::chrono::steady_clock::now();
+    std::chrono::steady_clock::time_point end = now +
+        std::chrono::milliseconds(HOST_PROCESS_TICK_BUDGET);
+    std::chrono::steady_clock::time_point idle = now +
+        std::chrono::microseconds(HOST_PROCESS_IDLE_WAIT);
+
+    busy_ = true;
+    for (unsigned int polls = 0;;) {
+        bool flushed = Flush();
+        now = std::chrono::steady_clock::now();
+
+        if (ProcessRequests()) {
+            idle = now + std::chrono::microseconds(HOST_PROCESS_IDLE_WAIT);
+            polls = 0;
+            continue;
+        }
+
+        if ((flushed && channel_.IsHostIdle()) || now >= end || now >= idle) {
+            break;
+        }
+        IpcChannel::Wait(polls++);
+    }
+    busy_ = false;
+}
+
+bool HostProcess::Send(uint32_t type, const IpcWriter &writer) {
+    if (writer.GetSize() > IPC_MAX_MESSAGE_SIZE) {
+        logprintf("ERROR: Message of %u bytes is too large for the host "
+            "process.", writer.GetSize());
+        return false;
+    }
+
+    channel_.AddSent();
+
+    if (overflow_.empty() && channel_.TryWrite(IPC_RING_CALLS, type,
+        writer.GetData(), writer.GetSize())) {
+        return true;
+    }
+
+    // The host is busy and the ring is full; keep the message in order
+    // without blocking the server.
+    overflow_.push_back(std::vector<char>(writer.GetData(),
+        writer.GetData() + writer.GetSize()));
+    overflowTypes_.push_back(type);
+    return true;
+}
+
+bool HostProcess::Flush() {
+    while (!overflow_.empty()) {
+        std::vector<char> &message = overflow_.front();
+        if (!channel_.TryWrite(IPC_RING_CALLS, overflowTypes_.front(),
+            message.empty() ? NULL : &message[0], (uint32_t)message.size())) {
+            return false;
+        }
+
+        overflow_.pop_front();
+        overflowTypes_.pop_front();
+    }
+
+    return true;
+}
+
+bool HostProcess::ProcessRequests() {
+    uint32_t type;
+    bool processed = false;
+
+    while (channel_.Read(IPC_RING_REQUESTS, type, message_)) {
+        processed = true;
+
+        switch (type) {
+        case IPC_MSG_NATIVE_CALL:
+            InvokeNative(message_);
+            break;
+        case IPC_MSG_LOG: {
+            IpcReader reader(message_);
+            logprintf("%s", reader.ReadString().c_str());
+            break;
+        }
+        case IPC_MSG_PUBLIC_RETURN: {
+            IpcReader reader(message_);
+            uint32_t id = reader.Read<uint32_t>();
+            if (StoreReturnValue(id, reader.Read<cell>())) {
+                returned_ = true;
+                return true;
+            }
+            break;
+        }
+        }
+    }
+
+    return processed;
+}
+
+void HostProcess::InvokeNative(const std::vector<char> &data) {
+    IpcReader reader(data);
+
+    uint32_t index = reader.Read<uint32_t>();
+    uint32_t param_count = reader.Read<uint32_t>();
+    cell params[HOST_PROCESS_MAX_PARAMS + 1];
+    if (param_count > HOST_PROCESS_MAX_PARAMS) {
+        param_count = HOST_PROCESS_MAX_PARAMS;
+    }
+
+    params[0] = param_count * sizeof(cell);
+    reader.Read(params + 1, param_count * sizeof(cell));
+
+    uint32_t heapSize = reader.Read<uint32_t>() & ~(sizeof(cell) - 1);
+    heap_.resize(heapSize);
+    if (heapSize) {
+        reader.Read(&heap_[0], heapSize);
+    }
+
+    // The heap of the host's fake AMX is copied to the same addresses in the
+    // heap of ours, so the parameters don't need to be translated.
+    AMX *amx = sampgdk_fakeamx_amx();
+    cell address = 0;
+    cell retval = 0;
+    bool valid = index < natives_.size();
+
+    if (valid && heapSize) {
+        if (amx->hea != 0 ||
+            sampgdk_fakeamx_push(heapSize / sizeof(cell), &address) < 0) {
+            logprintf("ERROR: Failed to allocate %u bytes for a native call "
+                "of the host process.", heapSize);
+            valid = false;
+        }
+        else {
+            memcpy(amx->data, &heap_[0], heapSize);
+        }
+    }
+
+    if (valid) {
+        retval = natives_[index](amx, params);
+
+        if (heapSize) {
+            memcpy(&heap_[0], amx->data, heapSize);
+            sampgdk_fakeamx_pop(address);
+        }
+    }
+
+    writer_.Clear();
+    writer_.Write<cell>(retval);
+    writer_.Write<uint32_t>(heapSize);
+    writer_.Write(heap_.empty() ? NULL : &heap_[0], heapSize);
+
+    channel_.Write(IPC_RING_REPLIES, IPC_MSG_NATIVE_RETURN, writer_.GetData(),
+        writer_.GetSize());
+}
+
+bool HostProcess::CheckAlive() {
+    if (!IsRunning()) {
+        return false;
+    }
+
+#if SAMPSHARP_WINDOWS
+    bool alive = process_ && WaitForSingleObject(process_, 0) == WAIT_TIMEOUT;
+    if (!alive && process_) {
+        CloseHandle(process_);
+        process_ = NULL;
+    }
+#elif SAMPSHARP_LINUX
+    int status;
+    bool alive = pid_ > 0 && waitpid(pid_, &status, WNOHANG) == 0;
+    if (!alive) {
+        pid_ = 0;
+    }
+#endif
+
+    if (!alive) {
+        // Print whatever the host logged before it exited; it may explain
+        // why.
+        uint32_t type;
+        while (channel_.Read(IPC_RING_REQUESTS, type, message_)) {
+            if (type == IPC_MSG_LOG) {
+                IpcReader reader(message_);
+                logprintf("%s", reader.ReadString().c_str());
+            }
+        }
+
+        if (!stopping_) {
+            logprintf("ERROR: The host process has exited.");
+        }
+        Close();
+    }
+
+    return alive;
+}
+
+void HostProcess::Close() {
+    if (IsRunning()) {
+        channel_.SetClosed();
+        channel_.Close();
+    }
+
+    natives_.clear();
+    overflow_.clear();
+    overflowTypes_.clear();
+    results_.clear();
+    pending_.clear();
+}
+
+void HostProcess::Kill() {
+#if SAMPSHARP_WINDOWS
+    if (process_) {
+        TerminateProcess(process_, 1);
+        WaitForSingleObject(process_, INFINITE);
+        CloseHandle(process_);
+        process_ = NULL;
+    }
+#elif SAMPSHARP_LINUX
+    if (pid_ > 0) {
+        kill(pid_, SIGKILL);
+        waitpid(pid_, NULL, 0);
+        pid_ = 0;
+    }
+#endif
+}
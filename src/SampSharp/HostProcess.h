@@ -0,0 +1,140 @@
+// SampSharp
+// Copyright 2017 Tim Potze
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <deque>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+#include <sampgdk/sampgdk.h>
+#include "IpcChannel.h"
+
+#pragma once
+
+/* The time in milliseconds the server spends per tick running the natives
+ * called by asynchronous callbacks, timers and the tick handler of the
+ * host. */
+#define HOST_PROCESS_TICK_BUDGET            (2)
+/* The time in microseconds the server waits for the next native call of the
+ * host process before ending its tick early. */
+#define HOST_PROCESS_IDLE_WAIT              (250)
+/* The time in milliseconds the host process is given to exit. */
+#define HOST_PROCESS_EXIT_TIMEOUT           (5000)
+/* The time in milliseconds the server waits for the host to handle a
+ * synchronous callback. */
+#define HOST_PROCESS_CALL_TIMEOUT           (500)
+
+/* Runs the game mode in a separate host process, so garbage collections and
+ * slow handlers don't stall the server.
+ *
+ * The host process is the SampSharpHost server emulator started with the name
+ * of an IPC channel; it loads this plugin, which runs the Mono runtime like it
+ * would in the server. Public calls are forwarded with a copy of the AMX heap
+ * the server pushed their string and array arguments onto. Natives called in
+ * the host are forwarded with a copy of the heap of sampgdk's fake AMX and
+ * run on the server thread, after which the heap is copied back. Neither
+ * needs to know the types of the parameters.
+ *
+ * Callbacks of which the server uses the return value are synchronous: the
+ * server waits for the host to handle them, running the natives the host
+ * calls in the meantime. If the host doesn't return within
+ * HOST_PROCESS_CALL_TIMEOUT ms, the server carries on with the value the host
+ * returned last for the same callback and first parameter. OnGameModeInit and
+ * OnGameModeExit are waited for without a limit.
+ *
+ * Other callbacks are queued. Cached callbacks, which are called too often to
+ * wait for, are queued as well, but are answered straight away with the value
+ * the host returned last for the same callback and first parameter, e.g. the
+ * last OnPlayerUpdate of the same player. The return values of the remaining
+ * callbacks are ignored. The natives called while handling queued callbacks
+ * run during the ticks of the server, for at most HOST_PROCESS_TICK_BUDGET ms
+ * per tick; a tick ends early once the host is idle or hasn't called a native
+ * for HOST_PROCESS_IDLE_WAIT us, so a paused host costs the server little.
+ *
+ * Callbacks raised by natives running on behalf of the host are queued as
+ * well. */
+class HostProcess {
+public:
+    /* Starts the host process at the specified path. The names of the natives
+     * registered so far are sent to the host. */
+    static bool Start(const std::string &path);
+    /* Tells the host process to exit and waits for it to do so. */
+    static void Stop();
+    /* Gets a value indicating whether the host process is running. */
+    static bool IsRunning() {
+        return channel_.IsOpen();
+    }
+    /* Sets the callbacks which are handled synchronously from a space
+     * separated list. */
+    static void SetSynchronousCallbacks(const std::string &names);
+    /* Sets the callbacks which are answered with the last value returned by
+     * the host from a space separated list. */
+    static void SetCachedCallbacks(const std::string &names);
+    /* Forwards a public call to the host process. */
+    static void ProcessPublicCall(AMX *amx, const char *name, cell *params,
+        cell *retval);
+    /* Sends a tick to the host process and runs the natives it calls. */
+    static void ProcessTick();
+
+private:
+    /* The values returned by the host for a callback, by first
+     * parameter. */
+    typedef std::map<cell, cell> Results;
+
+    /* A call of which the host sends back the return value. */
+    struct PendingCall {
+        uint32_t id;
+        Results *results;
+        cell key;
+    };
+
+    static void SetCallbacks(const std::string &names,
+        std::set<std::string> &callbacks);
+    static void WaitForReturn(const char *name, uint32_t id);
+    static bool StoreReturnValue(uint32_t id, cell retval);
+    static bool Send(uint32_t type, const IpcWriter &writer);
+    static bool Flush();
+    static bool ProcessRequests();
+    static void InvokeNative(const std::vector<char> &data);
+    static bool CheckAlive();
+    static void Kill();
+    static void Close();
+
+    static IpcChannel channel_;
+    static std::vector<AMX_NATIVE> natives_;
+    static std::set<std::string> synchronous_;
+    static std::set<std::string> cached_;
+    static std::map<std::string, Results> results_;
+    /* The calls of which the return value hasn't arrived yet, in the order
+     * they were sent in. */
+    static std::deque<PendingCall> pending_;
+    static uint32_t nextId_;
+    static uint32_t awaitedId_;
+    /* Messages which didn't fit in the calls ring while the host was
+     * busy. */
+    static std::deque<std::vector<char> > overflow_;
+    static std::deque<uint32_t> overflowTypes_;
+    static std::vector<char> message_;
+    static std::vector<char> heap_;
+    static IpcWriter writer_;
+    static bool busy_;
+    static bool returned_;
+    static bool stopping_;
+#if SAMPSHARP_WINDOWS
+    static void *process_;
+#elif SAMPSHARP_LINUX
+    static int pid_;
+#endif
+};
@@ -0,0 +1,258 @@
+// SampSharp
+// Copyright 2017 Tim Potze
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "IpcChannel.h"
+#include <chrono>
+#include <thread>
+#if SAMPSHARP_WINDOWS
+#include <windows.h>
+#elif SAMPSHARP_LINUX
+#include <fcntl.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#define IPC_MAGIC                           (0x53504331)
+#define IPC_ALIGN(size)                     (((size) + 7) & ~7u)
+
+IpcChannel::IpcChannel()
+    : shared_(NULL), mappedSize_(0), owner_(false) {
+#if SAMPSHARP_WINDOWS
+    mapping_ = NULL;
+#endif
+}
+
+IpcChannel::~IpcChannel() {
+    Close();
+}
+
+bool IpcChannel::Create(const std::string &name) {
+    if (!Map(name, true)) {
+        return false;
+    }
+
+    shared_->magic = IPC_MAGIC;
+    shared_->size = IPC_RING_SIZE;
+    owner_ = true;
+    return true;
+}
+
+bool IpcChannel::Open(const std::string &name) {
+    if (!Map(name, false)) {
+        return false;
+    }
+
+    if (shared_->magic != IPC_MAGIC || shared_->size != IPC_RING_SIZE) {
+        Close();
+        return false;
+    }
+
+    return true;
+}
+
+bool IpcChannel::Map(const std::string &name, bool create) {
+    Close();
+
+    size_t size = sizeof(Shared) + (size_t)IPC_RINGS * IPC_RING_SIZE;
+
+#if SAMPSHARP_WINDOWS
+    std::string path = "Local\\" + name;
+    mapping_ = create
+        ? CreateFileMappingA(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE, 0,
+            (DWORD)size, path.c_str())
+        : OpenFileMappingA(FILE_MAP_ALL_ACCESS, FALSE, path.c_str());
+    if (!mapping_) {
+        return false;
+    }
+
+    void *view = MapViewOfFile(mapping_, FILE_MAP_ALL_ACCESS, 0, 0, size);
+    if (!view) {
+        CloseHandle(mapping_);
+        mapping_ = NULL;
+        return false;
+    }
+#elif SAMPSHARP_LINUX
+    std::string path = "/" + name;
+    int fd = create
+        ? shm_open(path.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600)
+        : shm_open(path.c_str(), O_RDWR, 0600);
+    if (fd < 0) {
+        return false;
+    }
+
+    if (create && ftruncate(fd, (off_t)size) != 0) {
+        close(fd);
+        shm_unlink(path.c_str());
+        return false;
+    }
+
+    void *view = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (view == MAP_FAILED) {
+        if (create) {
+            shm_unlink(path.c_str());
+        }
+        return false;
+    }
+#endif
+
+    // Newly created mappings are zero filled, which is a valid empty state
+    // for the rings and counters.
+    shared_ = (Shared *)view;
+    mappedSize_ = size;
+    name_ = name;
+    return true;
+}
+
+void IpcChannel::Close() {
+    if (!shared_) {
+        return;
+    }
+
+#if SAMPSHARP_WINDOWS
+    UnmapViewOfFile(shared_);
+    CloseHandle(mapping_);
+    mapping_ = NULL;
+#elif SAMPSHARP_LINUX
+    munmap(shared_, mappedSize_);
+    if (owner_) {
+        shm_unlink(("/" + name_).c_str());
+    }
+#endif
+
+    shared_ = NULL;
+    mappedSize_ = 0;
+    owner_ = false;
+}
+
+bool IpcChannel::TryWrite(int ring, uint32_t type, const void *data,
+    uint32_t size) {
+    if (size > IPC_MAX_MESSAGE_SIZE) {
+        return false;
+    }
+
+    Ring &r = shared_->rings[ring];
+    char *buffer = GetRingData(ring);
+
+    uint32_t expected = 0;
+    while (!r.lock.compare_exchange_weak(expected, 1,
+        std::memory_order_acquire)) {
+        expected = 0;
+    }
+
+    uint32_t head = r.head.load(std::memory_order_relaxed);
+    uint32_t tail = r.tail.load(std::memory_order_acquire);
+    uint32_t length = IPC_ALIGN(sizeof(MessageHeader) + size);
+    uint32_t offset = head & (IPC_RING_SIZE - 1);
+
+    // Messages are stored contiguously; skip the end of the ring if the
+    // message doesn't fit.
+    uint32_t skip = IPC_RING_SIZE - offset < length ? IPC_RING_SIZE - offset
+        : 0;
+
+    if (IPC_RING_SIZE - (head - tail) < skip + length) {
+        r.lock.store(0, std::memory_order_release);
+        return false;
+    }
+
+    if (skip) {
+        MessageHeader *padding = (MessageHeader *)(buffer + offset);
+        padding->size = skip;
+        padding->type = 0;
+        head += skip;
+        offset = 0;
+    }
+
+    MessageHeader *header = (MessageHeader *)(buffer + offset);
+    header->size = size;
+    header->type = type;
+    if (size) {
+        memcpy(header + 1, data, size);
+    }
+
+    r.head.store(head + length, std::memory_order_release);
+    r.lock.store(0, std::memory_order_release);
+    return true;
+}
+
+bool IpcChannel::Write(int ring, uint32_t type, const void *data,
+    uint32_t size) {
+    if (size > IPC_MAX_MESSAGE_SIZE) {
+        return false;
+    }
+
+    for (unsigned int polls = 0; !TryWrite(ring, type, data, size);
+        polls++) {
+        if (IsClosed()) {
+            return false;
+        }
+        Wait(polls);
+    }
+
+    return true;
+}
+
+bool IpcChannel::Read(int ring, uint32_t &type, std::vector<char> &data) {
+    Ring &r = shared_->rings[ring];
+    char *buffer = GetRingData(ring);
+
+    for (;;) {
+        uint32_t tail = r.tail.load(std::memory_order_relaxed);
+        if (r.head.load(std::memory_order_acquire) == tail) {
+            return false;
+        }
+
+        MessageHeader *header =
+            (MessageHeader *)(buffer + (tail & (IPC_RING_SIZE - 1)));
+
+        if (header->type == 0) {
+            r.tail.store(tail + header->size, std::memory_order_release);
+            continue;
+        }
+
+        type = header->type;
+        data.assign((char *)(header + 1), (char *)(header + 1) +
+            header->size);
+
+        r.tail.store(tail + IPC_ALIGN(sizeof(MessageHeader) + header->size),
+            std::memory_order_release);
+        return true;
+    }
+}
+
+bool IpcChannel::CanRead(int ring) const {
+    const Ring &r = shared_->rings[ring];
+    return r.head.load(std::memory_order_acquire) !=
+        r.tail.load(std::memory_order_relaxed);
+}
+
+void IpcChannel::Wait(unsigned int polls) {
+    // Spin first; a peer which is working answers within microseconds. On a
+    // single processor the peer can't answer while this process spins.
+    static const unsigned int spins =
+        std::thread::hardware_concurrency() > 1 ? 2000 : 0;
+
+    if (polls < spins) {
+        return;
+    }
+    if (polls < spins + 2000) {
+        std::this_thread::yield();
+        return;
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+}
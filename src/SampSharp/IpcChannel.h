@@ -0,0 +1,229 @@
+// SampSharp
+// Copyright 2017 Tim Potze
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <atomic>
+#include <string>
+#include <vector>
+#include "platforms.h"
+
+#pragma once
+
+/* Public calls and ticks sent by the server. */
+#define IPC_RING_CALLS                      (0)
+/* Native results sent by the server. */
+#define IPC_RING_REPLIES                    (1)
+/* Native calls, public results and log messages sent by the host. */
+#define IPC_RING_REQUESTS                   (2)
+#define IPC_RINGS                           (3)
+
+/* The size of every ring in bytes. Must be a power of two. */
+#define IPC_RING_SIZE                       (4 * 1024 * 1024)
+/* The largest message which can be sent. */
+#define IPC_MAX_MESSAGE_SIZE                (IPC_RING_SIZE / 4)
+
+#define IPC_MSG_NATIVES                     (1)
+#define IPC_MSG_PUBLIC_CALL                 (2)
+#define IPC_MSG_PUBLIC_RETURN               (3)
+#define IPC_MSG_NATIVE_CALL                 (4)
+#define IPC_MSG_NATIVE_RETURN               (5)
+#define IPC_MSG_TICK                        (6)
+#define IPC_MSG_LOG                         (7)
+#define IPC_MSG_EXIT                        (8)
+
+/* The environment variable the host process finds the channel name in. */
+#define IPC_CHANNEL_ENV                     "SAMPSHARP_CHANNEL"
+
+/* Appends values to a message. */
+class IpcWriter {
+public:
+    void Clear() {
+        data_.clear();
+    }
+    void Write(const void *data, size_t size) {
+        const char *bytes = (const char *)data;
+        data_.insert(data_.end(), bytes, bytes + size);
+    }
+    template<typename T> void Write(T value) {
+        Write(&value, sizeof(T));
+    }
+    void WriteString(const char *value) {
+        uint32_t length = (uint32_t)strlen(value);
+        Write(length);
+        Write(value, length);
+    }
+    const char *GetData() const {
+        return data_.empty() ? NULL : &data_[0];
+    }
+    uint32_t GetSize() const {
+        return (uint32_t)data_.size();
+    }
+
+private:
+    std::vector<char> data_;
+};
+
+/* Reads values from a message. Reading past the end yields zeroes. */
+class IpcReader {
+public:
+    IpcReader(const std::vector<char> &data)
+        : data_(data.empty() ? NULL : &data[0]), size_((uint32_t)data.size()),
+        position_(0) {
+    }
+    bool Read(void *data, size_t size) {
+        if (position_ + size > size_) {
+            memset(data, 0, size);
+            position_ = size_;
+            return false;
+        }
+
+        memcpy(data, data_ + position_, size);
+        position_ += (uint32_t)size;
+        return true;
+    }
+    template<typename T> T Read() {
+        T value;
+        Read(&value, sizeof(T));
+        return value;
+    }
+    std::string ReadString() {
+        uint32_t length = Read<uint32_t>();
+        if (length > size_ - position_) {
+            position_ = size_;
+            return std::string();
+        }
+
+        std::string value(data_ + position_, length);
+        position_ += length;
+        return value;
+    }
+
+private:
+    const char *data_;
+    uint32_t size_;
+    uint32_t position_;
+};
+
+/* A pair of processes connected through shared memory holding three rings of
+ * variable length messages. The server creates the channel and the host
+ * process opens it by name.
+ *
+ * Rings are lock-free single consumer queues. Writers take a spin lock which
+ * is only contended if multiple threads of a process write to the same ring.
+ * Readers and writers poll; Wait spins briefly before yielding and sleeping,
+ * which keeps round trips short while a peer is busy and idle processes
+ * cheap. */
+class IpcChannel {
+public:
+    IpcChannel();
+    ~IpcChannel();
+
+    /* Creates a channel with the specified name. */
+    bool Create(const std::string &name);
+    /* Opens an existing channel with the specified name. */
+    bool Open(const std::string &name);
+    /* Unmaps the channel and, if it was created by this process, removes
+     * it. */
+    void Close();
+    /* Gets a value indicating whether the channel is open. */
+    bool IsOpen() const {
+        return shared_ != NULL;
+    }
+
+    /* Writes a message to the specified ring. Returns false if the ring is
+     * full or the message is too large. */
+    bool TryWrite(int ring, uint32_t type, const void *data, uint32_t size);
+    /* Writes a message to the specified ring, waiting for space. Returns
+     * false if the message is too large or the channel is closed. */
+    bool Write(int ring, uint32_t type, const void *data, uint32_t size);
+    /* Reads a message from the specified ring. Returns false if the ring is
+     * empty. */
+    bool Read(int ring, uint32_t &type, std::vector<char> &data);
+    /* Gets a value indicating whether the specified ring holds a message. */
+    bool CanRead(int ring) const;
+
+    /* Counts the public calls and ticks written by the server and handled by
+     * the host; the host is idle when both are equal. */
+    void AddSent() {
+        shared_->sent.fetch_add(1, std::memory_order_release);
+    }
+    void AddProcessed() {
+        shared_->processed.fetch_add(1, std::memory_order_release);
+    }
+    bool IsHostIdle() const {
+        return shared_->processed.load(std::memory_order_acquire) ==
+            shared_->sent.load(std::memory_order_acquire);
+    }
+    /* Gets or sets whether a tick message is waiting to be handled. */
+    bool IsTickPending() const {
+        return shared_->tickPending.load(std::memory_order_acquire) != 0;
+    }
+    void SetTickPending(bool value) {
+        shared_->tickPending.store(value ? 1 : 0, std::memory_order_release);
+    }
+    /* Marks the channel as closed, which ends every wait of the peer. */
+    void SetClosed() {
+        shared_->closed.store(1, std::memory_order_release);
+    }
+    bool IsClosed() const {
+        return shared_->closed.load(std::memory_order_acquire) != 0;
+    }
+
+    /* Backs off from polling; call with the number of unsuccessful polls so
+     * far. */
+    static void Wait(unsigned int polls);
+
+private:
+    struct Ring {
+        /* The number of bytes written and read. */
+        std::atomic<uint32_t> head;
+        char pad0[60];
+        std::atomic<uint32_t> tail;
+        char pad1[60];
+        std::atomic<uint32_t> lock;
+        char pad2[60];
+    };
+    struct Shared {
+        uint32_t magic;
+        uint32_t size;
+        std::atomic<uint32_t> closed;
+        std::atomic<uint32_t> tickPending;
+        std::atomic<uint32_t> sent;
+        std::atomic<uint32_t> processed;
+        char pad[40];
+        Ring rings[IPC_RINGS];
+    };
+    /* Precedes every message in a ring. A type of 0 marks the unused space at
+     * the end of the ring when a message didn't fit. */
+    struct MessageHeader {
+        uint32_t size;
+        uint32_t type;
+    };
+
+    bool Map(const std::string &name, bool create);
+    char *GetRingData(int ring) const {
+        return (char *)(shared_ + 1) + (size_t)ring * IPC_RING_SIZE;
+    }
+
+    Shared *shared_;
+    size_t mappedSize_;
+    bool owner_;
+    std::string name_;
+#if SAMPSHARP_WINDOWS
+    void *mapping_;
+#endif
+};
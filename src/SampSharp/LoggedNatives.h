@@ -0,0 +1,132 @@
+// SampSharp
+// Copyright 2017 Tim Potze
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <sampgdk/sampgdk.h>
+#include "CallbackLog.h"
+
+#pragma once
+
+/* The natives the plugin calls by itself. Each call is written to the
+ * callback log, with the values the native stored in its reference
+ * parameters, so a recording replays them just like the natives called by
+ * the game mode. */
+struct LoggedNatives
+{
+    static inline int GetPlayerPoolSize() {
+        return Log("GetPlayerPoolSize", ::GetPlayerPoolSize());
+    }
+
+    static inline bool IsPlayerConnected(int playerid) {
+        return Log("IsPlayerConnected", ::IsPlayerConnected(playerid)) != 0;
+    }
+
+    static inline bool GetPlayerPos(int playerid, float *x, float *y,
+        float *z) {
+        bool result = ::GetPlayerPos(playerid, x, y, z);
+        Log("GetPlayerPos", result, x, y, z);
+        return result;
+    }
+
+    static inline bool GetPlayerHealth(int playerid, float *health) {
+        bool result = ::GetPlayerHealth(playerid, health);
+        Log("GetPlayerHealth", result, health);
+        return result;
+    }
+
+    static inline bool GetPlayerArmour(int playerid, float *armour) {
+        bool result = ::GetPlayerArmour(playerid, armour);
+        Log("GetPlayerArmour", result, armour);
+        return result;
+    }
+
+    static inline int GetPlayerVirtualWorld(int playerid) {
+        return Log("GetPlayerVirtualWorld", ::GetPlayerVirtualWorld(playerid));
+    }
+
+    static inline int GetPlayerInterior(int playerid) {
+        return Log("GetPlayerInterior", ::GetPlayerInterior(playerid));
+    }
+
+    static inline bool GetVehiclePos(int vehicleid, float *x, float *y,
+        float *z) {
+        bool result = ::GetVehiclePos(vehicleid, x, y, z);
+        Log("GetVehiclePos", result, x, y, z);
+        return result;
+    }
+
+    static inline int GetVehiclePoolSize() {
+        return Log("GetVehiclePoolSize", ::GetVehiclePoolSize());
+    }
+
+    static inline int GetVehicleVirtualWorld(int vehicleid) {
+        return Log("GetVehicleVirtualWorld",
+            ::GetVehicleVirtualWorld(vehicleid));
+    }
+
+    static inline int CreatePlayerObject(int playerid, int modelid, float x,
+        float y, float z, float rx, float ry, float rz, float drawDistance) {
+        return Log("CreatePlayerObject", ::CreatePlayerObject(playerid,
+            modelid, x, y, z, rx, ry, rz, drawDistance));
+    }
+
+    static inline bool DestroyPlayerObject(int playerid, int objectid) {
+        return Log("DestroyPlayerObject",
+            ::DestroyPlayerObject(playerid, objectid)) != 0;
+    }
+
+    static inline int CreatePickup(int modelid, int type, float x, float y,
+        float z, int world) {
+        return Log("CreatePickup",
+            ::CreatePickup(modelid, type, x, y, z, world));
+    }
+
+    static inline bool DestroyPickup(int pickupid) {
+        return Log("DestroyPickup", ::DestroyPickup(pickupid)) != 0;
+    }
+
+    static inline int CreatePlayer3DTextLabel(int playerid, const char *text,
+        int color, float x, float y, float z, float drawDistance,
+        int attachedPlayer, int attachedVehicle, bool testLOS) {
+        return Log("CreatePlayer3DTextLabel", ::CreatePlayer3DTextLabel(
+            playerid, text, color, x, y, z, drawDistance, attachedPlayer,
+            attachedVehicle, testLOS));
+    }
+
+    static inline bool DeletePlayer3DTextLabel(int playerid, int id) {
+        return Log("DeletePlayer3DTextLabel",
+            ::DeletePlayer3DTextLabel(playerid, id)) != 0;
+    }
+
+private:
+    static inline int Log(const char *name, int retval) {
+        if (CallbackLog::IsOpen()) {
+            CallbackLog::WriteNative(name, retval);
+        }
+        return retval;
+    }
+
+    /* Logs a native with float references from its second parameter on. */
+    static inline void Log(const char *name, bool retval, const float *a,
+        const float *b = NULL, const float *c = NULL) {
+        if (!CallbackLog::IsOpen()) {
+            return;
+        }
+
+        CallbackLog::WriteNative(name, retval);
+        CallbackLog::WriteRef(1, *a);
+        if (b) CallbackLog::WriteRef(2, *b);
+        if (c) CallbackLog::WriteRef(3, *c);
+    }
+};
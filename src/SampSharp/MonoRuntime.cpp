@@ -15,7 +15,10 @@
 
 #include "platforms.h"
 #include "MonoRuntime.h"
+#include <stdarg.h>
+#include <stdio.h>
 #include <string.h>
+#include <vector>
 #include <mono/jit/jit.h>
 #include <mono/metadata/assembly.h>
 #include <mono/metadata/mono-debug.h>
@@ -24,13 +27,18 @@
 #include "Config.h"
 
 bool MonoRuntime::isLoaded_;
+bool MonoRuntime::buffered_;
+std::mutex MonoRuntime::logMutex_;
+std::vector<std::string> MonoRuntime::log_;
 
 void MonoRuntime::Load(std::string assemblyDir, std::string configDir,
-    std::string traceLevel, std::string file) {
+    std::string traceLevel, std::string file, bool buffered) {
     if (isLoaded_) {
         return;
     }
 
+    buffered_ = buffered;
+
     if (!assemblyDir.empty() && !configDir.empty()) {
         mono_set_dirs(assemblyDir.c_str(), configDir.c_str());
     }
@@ -44,20 +52,21 @@ void MonoRuntime::Load(std::string assemblyDir, std::string configDir,
 
     std::string debugger_address = Config::GetEnv("debugger_address");
 
+    std::vector<std::string> options;
     bool has_debugger = false;
     if (Config::GetDebuggerEnable().compare("1") == 0 || debugger_address.length() > 0) {
         char* agent = new char[128];
 
 
-        sampgdk::logprintf("Soft Debugger");
-        sampgdk::logprintf("---------------");
+        Log("Soft Debugger");
+        Log("---------------");
 
         if (debugger_address.length() == 0) {
             snprintf(agent, 128,
                 "--debugger-agent=transport=dt_socket,address=%s,server=y",
                 Config::GetDebuggerAddress().c_str());
 
-            sampgdk::logprintf("Launching debugger at %s...",
+            Log("Launching debugger at %s...",
                 Config::GetDebuggerAddress().c_str());
         }
         else {
@@ -65,31 +74,86 @@ void MonoRuntime::Load(std::string assemblyDir, std::string configDir,
                 "--debugger-agent=transport=dt_socket,address=%s,server=y",
                 debugger_address.c_str());
 
-            sampgdk::logprintf("Launching debugger at %s...", debugger_address.c_str());
+            Log("Launching debugger at %s...", debugger_address.c_str());
         }
 
-        const char* jit_options[] = {
-            "--soft-breakpoints",
-            agent
-        };
-
-
-        mono_jit_parse_options(2, (char**)jit_options);
+        options.push_back("--soft-breakpoints");
+        options.push_back(agent);
 
         delete agent;
 
-        sampgdk::logprintf("Waiting for debugger to attach...");
+        Log("Waiting for debugger to attach...");
         has_debugger = true;
     }
 
+    AddJitOptions(options);
+    if (!options.empty()) {
+        std::vector<char *> args;
+        for (size_t i = 0; i < options.size(); i++) {
+            args.push_back(&options[i][0]);
+        }
+        mono_jit_parse_options((int)args.size(), &args[0]);
+    }
+
     mono_debug_init(MONO_DEBUG_FORMAT_MONO);
     mono_trace_set_level_string(traceLevel.c_str());
     MonoDomain *dom = mono_jit_init(file.c_str());
 
     if (has_debugger) {
-        sampgdk::logprintf("Debugger attached!");
-        sampgdk::logprintf("");
+        Log("Debugger attached!");
+        Log("");
     }
 
+    buffered_ = false;
     isLoaded_ = true;
 }
+
+void MonoRuntime::FlushLog() {
+    std::lock_guard<std::mutex> lock(logMutex_);
+    for (size_t i = 0; i < log_.size(); i++) {
+        sampgdk::logprintf("%s", log_[i].c_str());
+    }
+    log_.clear();
+}
+
+void MonoRuntime::Log(const char *format, ...) {
+    char message[1024];
+
+    va_list args;
+    va_start(args, format);
+    vsnprintf(message, sizeof(message), format, args);
+    va_end(args);
+
+    if (!buffered_) {
+        sampgdk::logprintf("%s", message);
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(logMutex_);
+    log_.push_back(message);
+}
+
+void MonoRuntime::AddJitOptions(std::vector<std::string> &options) {
+    // Mono.Simd intrinsics are one of the optimizations, which can be turned
+    // on or off on top of the configured set.
+    std::string optimize = Config::GetMonoOptimize();
+    std::string simd = Config::GetMonoSimd();
+    if (simd.length() > 0) {
+        if (optimize.length() > 0) {
+            optimize.append(",");
+        }
+        optimize.append(simd.compare("0") == 0 ? "-simd" : "simd");
+    }
+
+    if (optimize.length() > 0) {
+        options.push_back("--optimize=" + optimize);
+        Log("JIT optimizations: %s", optimize.c_str());
+    }
+
+    // Mono falls back to its own code generator if it wasn't built with
+    // LLVM support.
+    if (Config::GetMonoLlvm().compare("1") == 0) {
+        options.push_back("--llvm");
+        Log("JIT backend: LLVM");
+    }
+}
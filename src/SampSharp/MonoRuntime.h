@@ -13,7 +13,9 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <mutex>
 #include <string>
+#include <vector>
 #include "PathUtil.h"
 
 #pragma once
@@ -23,8 +25,22 @@ public:
     static bool IsLoaded() {
         return isLoaded_;
     }
+    /* Loads the runtime. If buffered, the messages of the runtime are kept
+     * until FlushLog is called, so the runtime can be loaded off the server
+     * thread. */
     static void Load(std::string assemblyDir, std::string configDir,
-        std::string traceLevel, std::string file);
+        std::string traceLevel, std::string file, bool buffered = false);
+    /* Prints the buffered messages. Must be called on the server thread. */
+    static void FlushLog();
 private:
+    static void Log(const char *format, ...);
+
+    /* Adds the JIT options configured in server.cfg to the options passed
+     * to the runtime. */
+    static void AddJitOptions(std::vector<std::string> &options);
+
     static bool isLoaded_;
+    static bool buffered_;
+    static std::mutex logMutex_;
+    static std::vector<std::string> log_;
 };
@@ -0,0 +1,143 @@
+// SampSharp
+// Copyright 2017 Tim Potze
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "NativeProfiler.h"
+#include <algorithm>
+#include <mono/metadata/exception.h>
+#include <sampgdk/sampgdk.h>
+
+using sampgdk::logprintf;
+
+bool NativeProfiler::enabled_;
+int NativeProfiler::sampleInterval_ = NATIVE_PROFILER_SAMPLE_INTERVAL;
+std::vector<NativeProfiler::Stats> NativeProfiler::stats_;
+
+void NativeProfiler::Record(int handle, const char *name,
+    Clock::time_point start, Clock::time_point invokeStart,
+    Clock::time_point invokeEnd, Clock::time_point end) {
+    Stats &stats = stats_[handle];
+
+    uint64_t invoke = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        invokeEnd - invokeStart).count();
+    uint64_t marshal = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        (invokeStart - start) + (end - invokeEnd)).count();
+
+    stats.sampled++;
+    stats.invoke += invoke;
+    stats.marshal += marshal;
+    if (invoke > stats.maxInvoke) {
+        stats.maxInvoke = invoke;
+    }
+    if (stats.name.empty()) {
+        stats.name = name;
+    }
+}
+
+void NativeProfiler::Start(int sampleInterval) {
+    if (sampleInterval < 1) {
+        mono_raise_exception(mono_get_exception_argument_out_of_range(
+            "sampleInterval"));
+        return;
+    }
+
+    sampleInterval_ = sampleInterval;
+    enabled_ = true;
+}
+
+void NativeProfiler::Stop() {
+    enabled_ = false;
+}
+
+void NativeProfiler::Reset() {
+    stats_.clear();
+}
+
+int NativeProfiler::GetStats(MonoArray *result) {
+    if (!result) {
+        mono_raise_exception(mono_get_exception_argument_null("result"));
+        return 0;
+    }
+
+    size_t capacity = mono_array_length(result) / NATIVE_PROFILER_STAT_FIELDS;
+    int count = 0;
+
+    for (size_t i = 0; i < stats_.size(); i++) {
+        const Stats &stats = stats_[i];
+        if (!stats.calls) {
+            continue;
+        }
+
+        if ((size_t)count < capacity) {
+            int64_t *values = mono_array_addr(result, int64_t,
+                count * NATIVE_PROFILER_STAT_FIELDS);
+            values[0] = (int64_t)i;
+            values[1] = (int64_t)stats.calls;
+            values[2] = (int64_t)stats.sampled;
+            values[3] = (int64_t)stats.invoke;
+            values[4] = (int64_t)stats.maxInvoke;
+            values[5] = (int64_t)stats.marshal;
+        }
+        count++;
+    }
+
+    return count;
+}
+
+void NativeProfiler::Dump(int count) {
+    std::vector<std::pair<uint64_t, size_t> > order;
+
+    for (size_t i = 0; i < stats_.size(); i++) {
+        const Stats &stats = stats_[i];
+        if (stats.sampled) {
+            order.push_back(std::make_pair(
+                GetEstimate(stats, stats.invoke + stats.marshal), i));
+        }
+    }
+
+    std::sort(order.begin(), order.end(),
+        std::greater<std::pair<uint64_t, size_t> >());
+    if (count >= 0 && order.size() > (size_t)count) {
+        order.resize(count);
+    }
+
+    logprintf("[SampSharp] Natives by estimated total time (1 in %d calls "
+        "timed):", sampleInterval_);
+    logprintf("[SampSharp] %-32s %10s %10s %9s %9s %8s", "native", "calls",
+        "total ms", "avg us", "max us", "marshal");
+
+    for (size_t i = 0; i < order.size(); i++) {
+        const Stats &stats = stats_[order[i].second];
+        uint64_t total = stats.invoke + stats.marshal;
+
+        logprintf("[SampSharp] %-32s %10llu %10.2f %9.2f %9.2f %7.1f%%",
+            stats.name.c_str(), (unsigned long long)stats.calls,
+            order[i].first / 1e6, stats.invoke / 1e3 / stats.sampled,
+            stats.maxInvoke / 1e3,
+            total ? stats.marshal * 100.0 / total : 0.0);
+    }
+}
+
+void NativeProfiler::Clear() {
+    enabled_ = false;
+    sampleInterval_ = NATIVE_PROFILER_SAMPLE_INTERVAL;
+    stats_.clear();
+}
+
+uint64_t NativeProfiler::GetEstimate(const Stats &stats, uint64_t time) {
+    return stats.sampled
+        ? (uint64_t)((double)time * stats.calls / stats.sampled)
+        : 0;
+}
@@ -0,0 +1,110 @@
+// SampSharp
+// Copyright 2017 Tim Potze
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <stdint.h>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <mono/jit/jit.h>
+
+#pragma once
+
+/* Every how many calls of a native a call is timed by default. */
+#define NATIVE_PROFILER_SAMPLE_INTERVAL     (16)
+/* The number of values GetStats stores per native: the handle, the number of
+ * calls, the number of timed calls, the total and the longest time spent
+ * invoking the native in timed calls and the total time spent marshaling in
+ * timed calls. Times are in nanoseconds. */
+#define NATIVE_PROFILER_STAT_FIELDS         (6)
+
+/* Counts the calls of every native the game mode invokes and times a sample
+ * of them, separating the time spent inside the native from the time spent
+ * converting its arguments and results. The totals of a native are estimated
+ * from its timed calls.
+ *
+ * The profiler is disabled by default; the cost of a call is then a single
+ * branch. When enabled, a call is counted and every sample interval-th call
+ * of each native is timed, starting with the first. */
+class NativeProfiler {
+public:
+    typedef std::chrono::steady_clock Clock;
+
+    /* Gets a value indicating whether natives are being profiled. */
+    static bool IsEnabled() {
+        return enabled_;
+    }
+    /* Counts a call of the native with the specified handle. Returns true if
+     * the call should be timed. */
+    static bool Count(int handle) {
+        if ((size_t)handle >= stats_.size()) {
+            stats_.resize(handle + 1);
+        }
+
+        Stats &stats = stats_[handle];
+        stats.calls++;
+        if (--stats.countdown > 0) {
+            return false;
+        }
+
+        stats.countdown = sampleInterval_;
+        return true;
+    }
+    /* Records the times of a timed call of the native with the specified
+     * handle: its start, the start and end of the invocation of the native
+     * and its end. */
+    static void Record(int handle, const char *name, Clock::time_point start,
+        Clock::time_point invokeStart, Clock::time_point invokeEnd,
+        Clock::time_point end);
+
+    /* Starts profiling, timing one of every sampleInterval calls of each
+     * native. */
+    static void Start(int sampleInterval);
+    /* Stops profiling. The statistics are kept. */
+    static void Stop();
+    /* Forgets the statistics. */
+    static void Reset();
+    /* Stores the statistics of the natives which have been called in the
+     * specified array (see NATIVE_PROFILER_STAT_FIELDS) and returns the
+     * number of natives, which may exceed the number which fit. */
+    static int GetStats(MonoArray *result);
+    /* Prints the natives with the highest estimated total cost to the log,
+     * at most count natives. */
+    static void Dump(int count);
+    /* Stops profiling and forgets the statistics. */
+    static void Clear();
+
+private:
+    struct Stats {
+        Stats()
+            : calls(0), sampled(0), invoke(0), maxInvoke(0), marshal(0),
+            countdown(1) {
+        }
+
+        uint64_t calls;
+        uint64_t sampled;
+        uint64_t invoke;
+        uint64_t maxInvoke;
+        uint64_t marshal;
+        int countdown;
+        std::string name;
+    };
+
+    static uint64_t GetEstimate(const Stats &stats, uint64_t time);
+
+    static bool enabled_;
+    static int sampleInterval_;
+    static std::vector<Stats> stats_;
+};
@@ -0,0 +1,130 @@
+// SampSharp
+// Copyright 2017 Tim Potze
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "PlayerSnapshot.h"
+#include <string.h>
+#include <mono/metadata/exception.h>
+#include <sampgdk/sampgdk.h>
+#include "LoggedNatives.h"
+
+uint32_t PlayerSnapshot::floatsHandle_;
+uint32_t PlayerSnapshot::intsHandle_;
+float *PlayerSnapshot::floats_;
+int *PlayerSnapshot::ints_;
+int PlayerSnapshot::capacity_;
+int PlayerSnapshot::captured_;
+
+void PlayerSnapshot::Attach(MonoArray *floats, MonoArray *ints) {
+    if (!floats || !ints) {
+        mono_raise_exception(mono_get_exception_argument_null(
+            floats ? "ints" : "floats"));
+        return;
+    }
+
+    uintptr_t capacity = mono_array_length(floats) /
+        PLAYERSNAPSHOT_FLOAT_FIELDS;
+
+    if (!capacity || mono_array_length(ints) / PLAYERSNAPSHOT_INT_FIELDS !=
+        capacity) {
+        mono_raise_exception(mono_get_exception_argument("ints",
+            "Buffers must hold the same, non-zero number of players"));
+        return;
+    }
+
+    Detach();
+
+    // The buffers are written to on every tick; pin them so the garbage
+    // collector cannot move them out from under the stored pointers.
+    floatsHandle_ = mono_gchandle_new((MonoObject *)floats, true);
+    intsHandle_ = mono_gchandle_new((MonoObject *)ints, true);
+    floats_ = mono_array_addr(floats, float, 0);
+    ints_ = mono_array_addr(ints, int, 0);
+    capacity_ = (int)capacity;
+    captured_ = 0;
+
+    memset(ints_, 0, capacity * PLAYERSNAPSHOT_INT_FIELDS * sizeof(int));
+}
+
+void PlayerSnapshot::Detach() {
+    if (!floats_) {
+        return;
+    }
+
+    mono_gchandle_free(floatsHandle_);
+    mono_gchandle_free(intsHandle_);
+
+    floatsHandle_ = 0;
+    intsHandle_ = 0;
+    floats_ = NULL;
+    ints_ = NULL;
+    capacity_ = 0;
+    captured_ = 0;
+}
+
+int PlayerSnapshot::Capture() {
+    if (!floats_) {
+        return 0;
+    }
+
+    int count = LoggedNatives::GetPlayerPoolSize() + 1;
+    if (count > capacity_) count = capacity_;
+
+    float *x = floats_ + PLAYERSNAPSHOT_FLOAT_X * capacity_;
+    float *y = floats_ + PLAYERSNAPSHOT_FLOAT_Y * capacity_;
+    float *z = floats_ + PLAYERSNAPSHOT_FLOAT_Z * capacity_;
+    float *health = floats_ + PLAYERSNAPSHOT_FLOAT_HEALTH * capacity_;
+    float *armour = floats_ + PLAYERSNAPSHOT_FLOAT_ARMOUR * capacity_;
+    int *connected = ints_ + PLAYERSNAPSHOT_INT_CONNECTED * capacity_;
+    int *world = ints_ + PLAYERSNAPSHOT_INT_VIRTUAL_WORLD * capacity_;
+    int *interior = ints_ + PLAYERSNAPSHOT_INT_INTERIOR * capacity_;
+
+    for (int i = 0; i < count; i++) {
+        if (!LoggedNatives::IsPlayerConnected(i)) {
+            connected[i] = 0;
+            continue;
+        }
+
+        LoggedNatives::GetPlayerPos(i, &x[i], &y[i], &z[i]);
+        LoggedNatives::GetPlayerHealth(i, &health[i]);
+        LoggedNatives::GetPlayerArmour(i, &armour[i]);
+        world[i] = LoggedNatives::GetPlayerVirtualWorld(i);
+        interior[i] = LoggedNatives::GetPlayerInterior(i);
+        connected[i] = 1;
+    }
+
+    // Players above the new pool size have disconnected since the last
+    // capture.
+    for (int i = count; i < captured_; i++) {
+        connected[i] = 0;
+    }
+    captured_ = count;
+
+    return count;
+}
+
+bool PlayerSnapshot::GetPosition(int playerid, float &x, float &y, float &z,
+    int &world, int &interior) {
+    if (!floats_ || playerid < 0 || playerid >= captured_ ||
+        !ints_[PLAYERSNAPSHOT_INT_CONNECTED * capacity_ + playerid]) {
+        return false;
+    }
+
+    x = floats_[PLAYERSNAPSHOT_FLOAT_X * capacity_ + playerid];
+    y = floats_[PLAYERSNAPSHOT_FLOAT_Y * capacity_ + playerid];
+    z = floats_[PLAYERSNAPSHOT_FLOAT_Z * capacity_ + playerid];
+    world = ints_[PLAYERSNAPSHOT_INT_VIRTUAL_WORLD * capacity_ + playerid];
+    interior = ints_[PLAYERSNAPSHOT_INT_INTERIOR * capacity_ + playerid];
+    return true;
+}
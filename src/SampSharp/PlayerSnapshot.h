@@ -0,0 +1,68 @@
+// SampSharp
+// Copyright 2017 Tim Potze
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdint.h>
+#include <mono/jit/jit.h>
+
+#pragma once
+
+#define PLAYERSNAPSHOT_FLOAT_X              (0)
+#define PLAYERSNAPSHOT_FLOAT_Y              (1)
+#define PLAYERSNAPSHOT_FLOAT_Z              (2)
+#define PLAYERSNAPSHOT_FLOAT_HEALTH         (3)
+#define PLAYERSNAPSHOT_FLOAT_ARMOUR         (4)
+#define PLAYERSNAPSHOT_FLOAT_FIELDS         (5)
+
+#define PLAYERSNAPSHOT_INT_CONNECTED        (0)
+#define PLAYERSNAPSHOT_INT_VIRTUAL_WORLD    (1)
+#define PLAYERSNAPSHOT_INT_INTERIOR         (2)
+#define PLAYERSNAPSHOT_INT_FIELDS           (3)
+
+/* Captures the state of every connected player into a pair of managed
+ * buffers, so the game mode can read it without invoking a native per
+ * property per player.
+ *
+ * The buffers are laid out as structures of arrays: the value of field f for
+ * player p is stored at index f * capacity + p, where capacity is the length
+ * of the buffer divided by the number of fields. The buffers are pinned while
+ * they are attached; an attached snapshot is captured at the start of every
+ * server tick. */
+class PlayerSnapshot {
+public:
+    /* Attaches the specified buffers. */
+    static void Attach(MonoArray *floats, MonoArray *ints);
+    /* Detaches and unpins the attached buffers. */
+    static void Detach();
+    /* Captures the state of every player into the attached buffers and
+     * returns the number of player slots captured. */
+    static int Capture();
+    /* Gets the captured position, virtual world and interior of the specified
+     * player. Returns false if the player wasn't connected at the last
+     * capture or no buffers are attached. */
+    static bool GetPosition(int playerid, float &x, float &y, float &z,
+        int &world, int &interior);
+    /* Gets a value indicating whether buffers are attached. */
+    static bool IsAttached() {
+        return floats_ != NULL;
+    }
+
+private:
+    static uint32_t floatsHandle_;
+    static uint32_t intsHandle_;
+    static float *floats_;
+    static int *ints_;
+    static int capacity_;
+    static int captured_;
+};
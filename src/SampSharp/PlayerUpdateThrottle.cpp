@@ -0,0 +1,139 @@
+// SampSharp
+// Copyright 2017 Tim Potze
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "PlayerUpdateThrottle.h"
+#include <string.h>
+#include <chrono>
+#include <mono/metadata/exception.h>
+
+std::vector<PlayerUpdateThrottle::Player> PlayerUpdateThrottle::players_;
+int PlayerUpdateThrottle::defaultInterval_;
+bool PlayerUpdateThrottle::enabled_ = true;
+
+bool PlayerUpdateThrottle::Filter(const char *name, cell *params,
+    cell *retval) {
+    if (!enabled_ || params[0] < (cell)sizeof(cell) ||
+        strncmp(name, "OnPlayer", 8)) {
+        return false;
+    }
+
+    int playerid = params[1];
+    if (playerid < 0 || playerid >= (int)players_.size()) {
+        return false;
+    }
+
+    Player &player = players_[playerid];
+
+    if (!strcmp(name + 8, "Update")) {
+        int interval = player.interval == PLAYER_UPDATE_DEFAULT_INTERVAL
+            ? defaultInterval_
+            : player.interval;
+        if (interval <= 0) {
+            return false;
+        }
+
+        uint64_t now = GetTime();
+        if (player.last && now - player.last < (uint64_t)interval) {
+            if (retval) {
+                *retval = player.retval;
+            }
+            return true;
+        }
+
+        player.last = now;
+        return false;
+    }
+
+    // The next player with this id starts over.
+    if (!strcmp(name + 8, "Disconnect")) {
+        Reset(player);
+    }
+
+    return false;
+}
+
+void PlayerUpdateThrottle::StoreReturnValue(const char *name, cell *params,
+    cell retval) {
+    if (params[0] < (cell)sizeof(cell) || strcmp(name, "OnPlayerUpdate")) {
+        return;
+    }
+
+    int playerid = params[1];
+    if (playerid >= 0 && playerid < (int)players_.size()) {
+        players_[playerid].retval = retval;
+    }
+}
+
+void PlayerUpdateThrottle::SetEnabled(bool enabled) {
+    enabled_ = enabled;
+}
+
+void PlayerUpdateThrottle::SetDefaultInterval(int interval) {
+    if (interval < 0) {
+        mono_raise_exception(mono_get_exception_argument_out_of_range(
+            "interval"));
+        return;
+    }
+
+    defaultInterval_ = interval;
+}
+
+int PlayerUpdateThrottle::GetDefaultInterval() {
+    return defaultInterval_;
+}
+
+bool PlayerUpdateThrottle::SetInterval(int playerid, int interval) {
+    if (interval < PLAYER_UPDATE_DEFAULT_INTERVAL) {
+        mono_raise_exception(mono_get_exception_argument_out_of_range(
+            "interval"));
+        return false;
+    }
+
+    if (playerid < 0 || playerid >= (int)players_.size()) {
+        return false;
+    }
+
+    players_[playerid].interval = interval;
+    return true;
+}
+
+int PlayerUpdateThrottle::GetInterval(int playerid) {
+    if (playerid < 0 || playerid >= (int)players_.size()) {
+        return PLAYER_UPDATE_DEFAULT_INTERVAL;
+    }
+
+    return players_[playerid].interval;
+}
+
+void PlayerUpdateThrottle::Clear() {
+    defaultInterval_ = 0;
+    players_.resize(MAX_PLAYERS);
+    for (size_t i = 0; i < players_.size(); i++) {
+        Reset(players_[i]);
+    }
+}
+
+void PlayerUpdateThrottle::Reset(Player &player) {
+    player.interval = PLAYER_UPDATE_DEFAULT_INTERVAL;
+    player.last = 0;
+    // Returning 1 lets the server sync the update to other players.
+    player.retval = 1;
+}
+
+uint64_t PlayerUpdateThrottle::GetTime() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
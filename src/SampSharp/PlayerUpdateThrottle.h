@@ -0,0 +1,72 @@
+// SampSharp
+// Copyright 2017 Tim Potze
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <stdint.h>
+#include <vector>
+#include <sampgdk/sampgdk.h>
+
+#pragma once
+
+/* The interval of a player which follows the default interval. */
+#define PLAYER_UPDATE_DEFAULT_INTERVAL      (-1)
+
+/* Limits the rate at which OnPlayerUpdate is forwarded to the game mode.
+ * Updates of a player arriving within the interval of that player since the
+ * last forwarded update are dropped before they reach the runtime and return
+ * the value the game mode returned for the last forwarded update. The game
+ * mode reads the state of a player when it handles an update, so dropped
+ * updates are coalesced into the next forwarded one.
+ *
+ * The default interval is read from player_update_interval in server.cfg; an
+ * interval of 0 forwards every update. The throttle is turned off while a
+ * callback log is replayed, so replays don't depend on the wall clock. */
+class PlayerUpdateThrottle {
+public:
+    /* Returns true if the specified public call is an update which should
+     * be dropped, in which case retval is set to the last returned value. */
+    static bool Filter(const char *name, cell *params, cell *retval);
+    /* Turns the throttle on or off. Intervals can still be changed while it
+     * is turned off. */
+    static void SetEnabled(bool enabled);
+    /* Stores the value the game mode returned for a forwarded update. */
+    static void StoreReturnValue(const char *name, cell *params, cell retval);
+    /* Sets the interval in milliseconds of players which don't have their
+     * own interval. */
+    static void SetDefaultInterval(int interval);
+    static int GetDefaultInterval();
+    /* Sets the interval in milliseconds of the specified player, or
+     * PLAYER_UPDATE_DEFAULT_INTERVAL to follow the default interval. */
+    static bool SetInterval(int playerid, int interval);
+    static int GetInterval(int playerid);
+    /* Forgets the intervals and updates of all players and resets the
+     * default interval to 0. */
+    static void Clear();
+
+private:
+    struct Player {
+        int interval;
+        /* The time in milliseconds the last update was forwarded at. */
+        uint64_t last;
+        cell retval;
+    };
+
+    static void Reset(Player &player);
+    static uint64_t GetTime();
+
+    static std::vector<Player> players_;
+    static bool enabled_;
+    static int defaultInterval_;
+};
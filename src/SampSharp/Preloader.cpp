@@ -0,0 +1,97 @@
+// SampSharp
+// Copyright 2017 Tim Potze
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "Preloader.h"
+#include <mono/jit/jit.h>
+#include <mono/metadata/appdomain.h>
+#include <mono/metadata/threads.h>
+#include <sampgdk/sampgdk.h>
+#include "Config.h"
+#include "GameMode.h"
+#include "MonoRuntime.h"
+#include "PathUtil.h"
+
+using sampgdk::logprintf;
+
+std::thread Preloader::thread_;
+std::atomic<bool> Preloader::cancel_;
+Preloader::Clock::time_point Preloader::start_;
+Preloader::Clock::time_point Preloader::loaded_;
+Preloader::Clock::time_point Preloader::prepared_;
+Preloader::Clock::time_point Preloader::end_;
+bool Preloader::isPrepared_;
+int Preloader::compiled_;
+
+void Preloader::Start() {
+    if (thread_.joinable() || MonoRuntime::IsLoaded()) {
+        return;
+    }
+
+    cancel_ = false;
+    start_ = Clock::now();
+    thread_ = std::thread(Run, Config::GetGameModeNameSpace(),
+        Config::GetGameModeClass());
+}
+
+void Preloader::Wait() {
+    if (!thread_.joinable()) {
+        return;
+    }
+
+    Clock::time_point waitStart = Clock::now();
+    cancel_ = true;
+    // Shows what the runtime is doing, such as waiting for the debugger to
+    // attach, while the server waits for it.
+    MonoRuntime::FlushLog();
+    thread_.join();
+    Clock::time_point waitEnd = Clock::now();
+    MonoRuntime::FlushLog();
+
+    // The server thread takes over as the main thread of the runtime.
+    mono_thread_set_main(mono_thread_attach(mono_get_root_domain()));
+
+    logprintf("Preloaded the runtime in %ld ms and the game mode in %ld ms, "
+        "compiled %d methods in %ld ms.", GetMilliseconds(start_, loaded_),
+        isPrepared_ ? GetMilliseconds(loaded_, prepared_) : 0L, compiled_,
+        isPrepared_ ? GetMilliseconds(prepared_, end_) : 0L);
+    // Loading would otherwise have taken until the game mode was prepared;
+    // compiling ahead of time saves time later on.
+    long waited = GetMilliseconds(waitStart, waitEnd);
+    long saved = GetMilliseconds(start_, prepared_) - waited;
+    logprintf("OnGameModeInit waited %ld ms for the preloader, saving %ld "
+        "ms.", waited, saved > 0 ? saved : 0L);
+    logprintf("");
+}
+
+void Preloader::Run(std::string namespaceName, std::string className) {
+    // The server is still logging on its own thread; the messages of the
+    // runtime, its JIT options and the debugger's status, are printed once
+    // the server waits for the preloader.
+    MonoRuntime::Load(Config::GetMonoAssemblyDir(),
+        Config::GetMonoConfigDir(), Config::GetTraceLevel(),
+        PathUtil::GetPathInBin("gamemode/").append(namespaceName)
+        .append(".dll"), true);
+    loaded_ = Clock::now();
+
+    // If preparing fails, GameMode::Load tries again and prints the error.
+    std::string error;
+    isPrepared_ = GameMode::Prepare(namespaceName, className, error);
+    prepared_ = Clock::now();
+
+    compiled_ = isPrepared_ ? GameMode::Precompile(cancel_) : 0;
+    end_ = Clock::now();
+
+    mono_thread_detach(mono_thread_current());
+}
@@ -0,0 +1,59 @@
+// SampSharp
+// Copyright 2017 Tim Potze
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+
+#pragma once
+
+/* Loads the runtime and prepares the game mode on a background thread while
+ * the server loads its other plugins, scripts and settings, so
+ * OnGameModeInit only has to wait for whatever hasn't finished yet.
+ *
+ * The thread initializes the runtime, creates the domain of the game mode,
+ * opens its assembly and then compiles the callbacks of the game mode and
+ * commonly used framework methods. Compiling stops as soon as the server
+ * thread waits for the preloader; the remaining methods are compiled on first
+ * use as usual. */
+class Preloader {
+public:
+    typedef std::chrono::steady_clock Clock;
+
+    /* Starts preloading the game mode configured in server.cfg. */
+    static void Start();
+    /* Waits for the background thread and attaches the calling thread to
+     * the runtime in its place. Does nothing if the preloader hasn't been
+     * started. */
+    static void Wait();
+
+private:
+    static void Run(std::string namespaceName, std::string className);
+    static long GetMilliseconds(Clock::time_point start,
+        Clock::time_point end) {
+        return (long)std::chrono::duration_cast<std::chrono::milliseconds>(
+            end - start).count();
+    }
+
+    static std::thread thread_;
+    static std::atomic<bool> cancel_;
+    static Clock::time_point start_;
+    static Clock::time_point loaded_;
+    static Clock::time_point prepared_;
+    static Clock::time_point end_;
+    static bool isPrepared_;
+    static int compiled_;
+};
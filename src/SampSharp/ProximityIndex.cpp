@@ -0,0 +1,413 @@
+// SampSharp
+// Copyright 2017 Tim Potze
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ProximityIndex.h"
+#include <math.h>
+#include <string.h>
+#include <algorithm>
+#include <mono/metadata/exception.h>
+#include "LoggedNatives.h"
+
+#define PROXIMITY_CELLS     (PROXIMITY_GRID_SIZE * PROXIMITY_GRID_SIZE)
+
+ProximityIndex::Index ProximityIndex::indices_[PROXIMITY_KINDS];
+std::vector<int> ProximityIndex::drivers_;
+std::vector<uint8_t> ProximityIndex::isDriver_;
+std::vector<int> ProximityIndex::cursor_;
+std::vector<ProximityIndex::Candidate> ProximityIndex::candidates_;
+
+static inline int GetCell(float value) {
+    int cell = (int)floorf((value + PROXIMITY_EXTENT) / PROXIMITY_CELL_SIZE);
+    return cell < 0
+        ? 0
+        : cell >= PROXIMITY_GRID_SIZE ? PROXIMITY_GRID_SIZE - 1 : cell;
+}
+
+void ProximityIndex::ProcessPublicCall(const char *name, cell *params) {
+    if (name[0] != 'O' || name[1] != 'n' || params[0] < (cell)sizeof(cell)) {
+        return;
+    }
+
+    Index &players = indices_[PROXIMITY_PLAYERS];
+    Index &vehicles = indices_[PROXIMITY_VEHICLES];
+    if (players.positions.empty()) {
+        Initialize(players, MAX_PLAYERS);
+        Initialize(vehicles, MAX_VEHICLES);
+        isDriver_.resize(MAX_PLAYERS);
+    }
+
+    int id = params[1];
+
+    if (!strcmp(name, "OnPlayerUpdate")) {
+        Mark(players, id);
+
+        // The vehicle the player is driving has moved as well. Which vehicle
+        // that is, is looked up when the vehicles are queried.
+        if (id >= 0 && id < MAX_PLAYERS && !isDriver_[id]) {
+            isDriver_[id] = 1;
+            drivers_.push_back(id);
+        }
+    } else if (!strcmp(name, "OnPlayerConnect") ||
+        !strcmp(name, "OnPlayerDisconnect") ||
+        !strcmp(name, "OnPlayerSpawn")) {
+        Mark(players, id);
+    } else if (!strcmp(name, "OnVehicleSpawn") ||
+        !strcmp(name, "OnVehicleDeath") ||
+        !strcmp(name, "OnUnoccupiedVehicleUpdate")) {
+        Mark(vehicles, id);
+    }
+}
+
+void ProximityIndex::Invalidate() {
+    for (int k = 0; k < PROXIMITY_KINDS; k++) {
+        indices_[k].rescan = true;
+    }
+}
+
+int ProximityIndex::QueryRadius(int kind, float x, float y, float z,
+    float range, int world, MonoArray *result) {
+    if (!CheckArguments(kind, result)) {
+        return 0;
+    }
+
+    const Index &index = Refresh(kind);
+    const float rangeSq = range * range;
+    const int length = (int)mono_array_length(result);
+    int *ids = mono_array_addr(result, int, 0);
+    int found = 0;
+
+    int cx0 = GetCell(x - range), cx1 = GetCell(x + range);
+    int cy0 = GetCell(y - range), cy1 = GetCell(y + range);
+
+    for (int cy = cy0; cy <= cy1; cy++) {
+        // The cells of a row are stored consecutively.
+        int row = cy * PROXIMITY_GRID_SIZE;
+        int end = index.cellStart[row + cx1 + 1];
+        for (int i = index.cellStart[row + cx0]; i < end; i++) {
+            const Entry &entry = index.entries[i];
+            if (world != -1 && entry.world != world) {
+                continue;
+            }
+
+            float dx = entry.x - x;
+            float dy = entry.y - y;
+            float dz = entry.z - z;
+            if (dx * dx + dy * dy + dz * dz <= rangeSq) {
+                if (found < length) {
+                    ids[found] = entry.id;
+                }
+                found++;
+            }
+        }
+    }
+
+    return found;
+}
+
+int ProximityIndex::QueryBox(int kind, float minX, float minY, float minZ,
+    float maxX, float maxY, float maxZ, int world, MonoArray *result) {
+    if (!CheckArguments(kind, result)) {
+        return 0;
+    }
+
+    const Index &index = Refresh(kind);
+    const int length = (int)mono_array_length(result);
+    int *ids = mono_array_addr(result, int, 0);
+    int found = 0;
+
+    int cx0 = GetCell(minX), cx1 = GetCell(maxX);
+    int cy0 = GetCell(minY), cy1 = GetCell(maxY);
+
+    for (int cy = cy0; cy <= cy1; cy++) {
+        int row = cy * PROXIMITY_GRID_SIZE;
+        int end = index.cellStart[row + cx1 + 1];
+        for (int i = index.cellStart[row + cx0]; i < end; i++) {
+            const Entry &entry = index.entries[i];
+            if ((world != -1 && entry.world != world) ||
+                entry.x < minX || entry.x > maxX ||
+                entry.y < minY || entry.y > maxY ||
+                entry.z < minZ || entry.z > maxZ) {
+                continue;
+            }
+
+            if (found < length) {
+                ids[found] = entry.id;
+            }
+            found++;
+        }
+    }
+
+    return found;
+}
+
+int ProximityIndex::Nearest(int kind, float x, float y, float z, int count,
+    int world, MonoArray *result) {
+    if (!CheckArguments(kind, result)) {
+        return 0;
+    }
+
+    const int length = (int)mono_array_length(result);
+    size_t k = (size_t)std::max(0, std::min(count, length));
+    if (!k) {
+        return 0;
+    }
+
+    const Index &index = Refresh(kind);
+    int cx = GetCell(x);
+    int cy = GetCell(y);
+
+    // Entries outside of the grid are stored in the border cells, so the
+    // rings around a point outside of the grid don't bound the distance.
+    bool bounded = x >= -PROXIMITY_EXTENT && x < PROXIMITY_EXTENT &&
+        y >= -PROXIMITY_EXTENT && y < PROXIMITY_EXTENT;
+
+    // Search rings of cells around the point's cell, keeping the k closest
+    // entries in a max-heap. Entries in ring r + 1 are at least r cells
+    // away, so the search ends once the k-th closest entry is closer.
+    candidates_.clear();
+    for (int r = 0; r < PROXIMITY_GRID_SIZE; r++) {
+        if (r == 0) {
+            ScanCell(index, cx, cy, x, y, z, world, k);
+        } else {
+            for (int i = cx - r; i <= cx + r; i++) {
+                ScanCell(index, i, cy - r, x, y, z, world, k);
+                ScanCell(index, i, cy + r, x, y, z, world, k);
+            }
+            for (int j = cy - r + 1; j <= cy + r - 1; j++) {
+                ScanCell(index, cx - r, j, x, y, z, world, k);
+                ScanCell(index, cx + r, j, x, y, z, world, k);
+            }
+        }
+
+        float bound = r * PROXIMITY_CELL_SIZE;
+        if (bounded && candidates_.size() == k &&
+            candidates_.front().distanceSq <= bound * bound) {
+            break;
+        }
+
+        if (cx - r <= 0 && cy - r <= 0 && cx + r >= PROXIMITY_GRID_SIZE - 1 &&
+            cy + r >= PROXIMITY_GRID_SIZE - 1) {
+            break;
+        }
+    }
+
+    std::sort_heap(candidates_.begin(), candidates_.end());
+
+    int *ids = mono_array_addr(result, int, 0);
+    for (size_t i = 0; i < candidates_.size(); i++) {
+        ids[i] = candidates_[i].id;
+    }
+
+    return (int)candidates_.size();
+}
+
+void ProximityIndex::Clear() {
+    for (int k = 0; k < PROXIMITY_KINDS; k++) {
+        Index &index = indices_[k];
+        index.positions.clear();
+        index.present.clear();
+        index.entries.clear();
+        index.cellStart.clear();
+        index.dirty.clear();
+        index.isDirty.clear();
+    }
+
+    drivers_.clear();
+    isDriver_.clear();
+}
+
+ProximityIndex::Index &ProximityIndex::Refresh(int kind) {
+    Index &index = indices_[kind];
+    if (index.positions.empty()) {
+        Initialize(indices_[PROXIMITY_PLAYERS], MAX_PLAYERS);
+        Initialize(indices_[PROXIMITY_VEHICLES], MAX_VEHICLES);
+        isDriver_.resize(MAX_PLAYERS);
+    }
+
+    if (kind == PROXIMITY_VEHICLES) {
+        for (size_t i = 0; i < drivers_.size(); i++) {
+            int vehicleid = GetPlayerVehicleID(drivers_[i]);
+            if (vehicleid > 0) {
+                Mark(index, vehicleid);
+            }
+            isDriver_[drivers_[i]] = 0;
+        }
+        drivers_.clear();
+    }
+
+    std::chrono::steady_clock::time_point now =
+        std::chrono::steady_clock::now();
+    if (now - index.lastRescan >=
+        std::chrono::milliseconds(PROXIMITY_RESCAN_INTERVAL)) {
+        index.rescan = true;
+    }
+
+    if (index.rescan) {
+        int count = kind == PROXIMITY_PLAYERS
+            ? LoggedNatives::GetPlayerPoolSize() + 1
+            : LoggedNatives::GetVehiclePoolSize() + 1;
+        if (count > (int)index.positions.size()) {
+            count = (int)index.positions.size();
+        }
+
+        for (int id = 0; id < (int)index.positions.size(); id++) {
+            index.present[id] = id < count &&
+                Read(kind, id, index.positions[id]);
+            index.isDirty[id] = 0;
+        }
+
+        index.dirty.clear();
+        index.rescan = false;
+        index.stale = true;
+        index.lastRescan = now;
+    } else if (!index.dirty.empty()) {
+        for (size_t i = 0; i < index.dirty.size(); i++) {
+            int id = index.dirty[i];
+            index.present[id] = Read(kind, id, index.positions[id]);
+            index.isDirty[id] = 0;
+        }
+
+        index.dirty.clear();
+        index.stale = true;
+    }
+
+    if (index.stale) {
+        Rebuild(index);
+    }
+
+    return index;
+}
+
+void ProximityIndex::Initialize(Index &index, int capacity) {
+    index.positions.resize(capacity);
+    index.present.assign(capacity, 0);
+    index.isDirty.assign(capacity, 0);
+    index.cellStart.assign(PROXIMITY_CELLS + 1, 0);
+    index.dirty.clear();
+    index.entries.clear();
+    index.stale = false;
+    index.rescan = true;
+}
+
+void ProximityIndex::Mark(Index &index, int id) {
+    if (id < 0 || id >= (int)index.isDirty.size() || index.isDirty[id]) {
+        return;
+    }
+
+    index.isDirty[id] = 1;
+    index.dirty.push_back(id);
+}
+
+bool ProximityIndex::Read(int kind, int id, Entry &entry) {
+    entry.id = id;
+
+    if (kind == PROXIMITY_PLAYERS) {
+        if (!LoggedNatives::IsPlayerConnected(id) ||
+            !LoggedNatives::GetPlayerPos(id, &entry.x, &entry.y,
+                &entry.z)) {
+            return false;
+        }
+        entry.world = LoggedNatives::GetPlayerVirtualWorld(id);
+    } else {
+        if (!LoggedNatives::GetVehiclePos(id, &entry.x, &entry.y,
+            &entry.z)) {
+            return false;
+        }
+        entry.world = LoggedNatives::GetVehicleVirtualWorld(id);
+    }
+
+    return true;
+}
+
+void ProximityIndex::Rebuild(Index &index) {
+    // Counting sort of the present positions by cell.
+    std::vector<int> &start = index.cellStart;
+    std::fill(start.begin(), start.end(), 0);
+
+    int count = 0;
+    for (size_t id = 0; id < index.positions.size(); id++) {
+        if (index.present[id]) {
+            const Entry &entry = index.positions[id];
+            start[GetCell(entry.y) * PROXIMITY_GRID_SIZE +
+                GetCell(entry.x) + 1]++;
+            count++;
+        }
+    }
+
+    for (int c = 0; c < PROXIMITY_CELLS; c++) {
+        start[c + 1] += start[c];
+    }
+
+    cursor_.assign(start.begin(), start.end() - 1);
+    index.entries.resize(count);
+
+    for (size_t id = 0; id < index.positions.size(); id++) {
+        if (index.present[id]) {
+            const Entry &entry = index.positions[id];
+            int c = GetCell(entry.y) * PROXIMITY_GRID_SIZE + GetCell(entry.x);
+            index.entries[cursor_[c]++] = entry;
+        }
+    }
+
+    index.stale = false;
+}
+
+bool ProximityIndex::CheckArguments(int kind, MonoArray *result) {
+    if (!result) {
+        mono_raise_exception(mono_get_exception_argument_null("result"));
+        return false;
+    }
+
+    if (kind < 0 || kind >= PROXIMITY_KINDS) {
+        mono_raise_exception(mono_get_exception_argument_out_of_range(
+            "kind"));
+        return false;
+    }
+
+    return true;
+}
+
+void ProximityIndex::ScanCell(const Index &index, int cx, int cy, float x,
+    float y, float z, int world, size_t count) {
+    if (cx < 0 || cy < 0 || cx >= PROXIMITY_GRID_SIZE ||
+        cy >= PROXIMITY_GRID_SIZE) {
+        return;
+    }
+
+    int c = cy * PROXIMITY_GRID_SIZE + cx;
+    for (int i = index.cellStart[c]; i < index.cellStart[c + 1]; i++) {
+        const Entry &entry = index.entries[i];
+        if (world != -1 && entry.world != world) {
+            continue;
+        }
+
+        float dx = entry.x - x;
+        float dy = entry.y - y;
+        float dz = entry.z - z;
+
+        Candidate candidate;
+        candidate.distanceSq = dx * dx + dy * dy + dz * dz;
+        candidate.id = entry.id;
+
+        if (candidates_.size() < count) {
+            candidates_.push_back(candidate);
+            std::push_heap(candidates_.begin(), candidates_.end());
+        } else if (candidate < candidates_.front()) {
+            std::pop_heap(candidates_.begin(), candidates_.end());
+            candidates_.back() = candidate;
+            std::push_heap(candidates_.begin(), candidates_.end());
+        }
+    }
+}
@@ -0,0 +1,120 @@
+// SampSharp
+// Copyright 2017 Tim Potze
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdint.h>
+#include <chrono>
+#include <vector>
+#include <mono/jit/jit.h>
+#include <sampgdk/sampgdk.h>
+
+#pragma once
+
+#define PROXIMITY_PLAYERS                   (0)
+#define PROXIMITY_VEHICLES                  (1)
+#define PROXIMITY_KINDS                     (2)
+
+/* The length of the sides of the grid cells in units. */
+#define PROXIMITY_CELL_SIZE                 (50.0f)
+/* The grid covers -PROXIMITY_EXTENT to PROXIMITY_EXTENT on both axes;
+ * positions outside of it are stored in the border cells. */
+#define PROXIMITY_EXTENT                    (3000.0f)
+#define PROXIMITY_GRID_SIZE                 (120)
+/* The interval in milliseconds at which every position is read again, to
+ * pick up changes which aren't reported through callbacks. */
+#define PROXIMITY_RESCAN_INTERVAL           (1000)
+
+/* Indexes the positions of players and vehicles in a uniform grid, so the
+ * game mode can find the players or vehicles near a point without invoking a
+ * position native per player or vehicle.
+ *
+ * The positions are read when the index is queried, and only for the players
+ * and vehicles which reported movement through OnPlayerUpdate,
+ * OnUnoccupiedVehicleUpdate, OnVehicleSpawn and related callbacks since the
+ * last query. Every position is read again at least once per
+ * PROXIMITY_RESCAN_INTERVAL or after Invalidate, to pick up changes made by
+ * the game mode itself, such as teleports and created vehicles.
+ *
+ * Entries are sorted by cell, row by row, so the cells in a row of a query
+ * are scanned as one contiguous range. */
+class ProximityIndex {
+public:
+    /* Marks the players and vehicles the specified callback reports changes
+     * of. */
+    static void ProcessPublicCall(const char *name, cell *params);
+    /* Marks every position as changed. */
+    static void Invalidate();
+    /* Stores the ids of the players or vehicles within the specified range of
+     * the specified point in the specified array and returns the number
+     * found, which may exceed the length of the array. */
+    static int QueryRadius(int kind, float x, float y, float z, float range,
+        int world, MonoArray *result);
+    /* Stores the ids of the players or vehicles within the specified box in
+     * the specified array and returns the number found, which may exceed the
+     * length of the array. */
+    static int QueryBox(int kind, float minX, float minY, float minZ,
+        float maxX, float maxY, float maxZ, int world, MonoArray *result);
+    /* Stores the ids of at most count players or vehicles closest to the
+     * specified point in the specified array, closest first, and returns the
+     * number stored. */
+    static int Nearest(int kind, float x, float y, float z, int count,
+        int world, MonoArray *result);
+    /* Clears the index. */
+    static void Clear();
+
+private:
+    struct Entry {
+        float x, y, z;
+        int world;
+        int id;
+    };
+    struct Index {
+        /* The position of every player or vehicle by id. */
+        std::vector<Entry> positions;
+        std::vector<uint8_t> present;
+        /* The present positions, sorted by cell. */
+        std::vector<Entry> entries;
+        /* The index of the first entry of every cell, and the number of
+         * entries. */
+        std::vector<int> cellStart;
+        std::vector<int> dirty;
+        std::vector<uint8_t> isDirty;
+        bool stale;
+        bool rescan;
+        std::chrono::steady_clock::time_point lastRescan;
+    };
+    struct Candidate {
+        float distanceSq;
+        int id;
+
+        bool operator<(const Candidate &other) const {
+            return distanceSq < other.distanceSq;
+        }
+    };
+
+    static Index &Refresh(int kind);
+    static void Initialize(Index &index, int capacity);
+    static void Mark(Index &index, int id);
+    static bool Read(int kind, int id, Entry &entry);
+    static void Rebuild(Index &index);
+    static bool CheckArguments(int kind, MonoArray *result);
+    static void ScanCell(const Index &index, int cx, int cy, float x,
+        float y, float z, int world, size_t count);
+
+    static Index indices_[PROXIMITY_KINDS];
+    static std::vector<int> drivers_;
+    static std::vector<uint8_t> isDriver_;
+    static std::vector<int> cursor_;
+    static std::vector<Candidate> candidates_;
+};
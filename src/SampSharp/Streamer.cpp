@@ -0,0 +1,636 @@
+// SampSharp
+// Copyright 2017 Tim Potze
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "Streamer.h"
+#include <math.h>
+#include <string.h>
+#include <algorithm>
+#include <mono/metadata/exception.h>
+#include <sampgdk/sampgdk.h>
+#include "GameMode.h"
+#include "LoggedNatives.h"
+#include "PlayerSnapshot.h"
+
+std::vector<Streamer::Item> Streamer::items_;
+std::vector<int> Streamer::freeIds_;
+int Streamer::itemCount_;
+Streamer::Grid Streamer::grid_;
+uint32_t Streamer::version_;
+std::vector<Streamer::PlayerState> Streamer::players_(MAX_PLAYERS);
+std::vector<int> Streamer::pickupItems_(MAX_PICKUPS, -1);
+int Streamer::processed_;
+std::vector<Streamer::Candidate> Streamer::candidates_[STREAMER_TYPES];
+std::vector<Streamer::Candidate> Streamer::created_;
+std::vector<uint32_t> Streamer::marks_;
+uint32_t Streamer::mark_;
+int Streamer::budget_ = STREAMER_DEFAULT_BUDGET;
+
+static const int visibleLimits[STREAMER_TYPES] = {
+    STREAMER_MAX_VISIBLE_OBJECTS,
+    STREAMER_MAX_VISIBLE_PICKUPS,
+    STREAMER_MAX_VISIBLE_LABELS
+};
+
+static inline int GetCell(float value) {
+    return (int)floorf(value / STREAMER_CELL_SIZE);
+}
+
+int Streamer::AddObject(int modelid, float x, float y, float z, float rx,
+    float ry, float rz, int world, int interior, float streamDistance,
+    float drawDistance) {
+    if (!CheckDistance(streamDistance)) {
+        return -1;
+    }
+
+    Item item = Item();
+    item.type = STREAMER_TYPE_OBJECT;
+    item.modelid = modelid;
+    item.x = x;
+    item.y = y;
+    item.z = z;
+    item.rx = rx;
+    item.ry = ry;
+    item.rz = rz;
+    item.world = world;
+    item.interior = interior;
+    item.streamDistance = streamDistance;
+    item.drawDistance = drawDistance;
+
+    return Insert(item);
+}
+
+int Streamer::AddPickup(int modelid, int type, float x, float y, float z,
+    int world, int interior, float streamDistance) {
+    if (!CheckDistance(streamDistance)) {
+        return -1;
+    }
+
+    Item item = Item();
+    item.type = STREAMER_TYPE_PICKUP;
+    item.modelid = modelid;
+    item.pickupType = type;
+    item.x = x;
+    item.y = y;
+    item.z = z;
+    item.world = world;
+    item.interior = interior;
+    item.streamDistance = streamDistance;
+
+    return Insert(item);
+}
+
+int Streamer::AddLabel(MonoString *text, int color, float x, float y,
+    float z, float drawDistance, int world, int interior, bool testLOS,
+    float streamDistance) {
+    if (!text) {
+        mono_raise_exception(mono_get_exception_argument_null("text"));
+        return -1;
+    }
+
+    if (!CheckDistance(streamDistance)) {
+        return -1;
+    }
+
+    Item item = Item();
+    item.type = STREAMER_TYPE_LABEL;
+    item.color = color;
+    item.x = x;
+    item.y = y;
+    item.z = z;
+    item.drawDistance = drawDistance;
+    item.world = world;
+    item.interior = interior;
+    item.testLOS = testLOS;
+    item.streamDistance = streamDistance;
+
+    char *buffer = GameMode::MonoStringToString(text);
+    item.text = buffer;
+    delete[] buffer;
+
+    return Insert(item);
+}
+
+bool Streamer::Remove(int id) {
+    if (!IsValid(id, -1)) {
+        return false;
+    }
+
+    DestroyEntities(id);
+    Unindex(id);
+
+    items_[id].type = -1;
+    items_[id].text.clear();
+    freeIds_.push_back(id);
+    itemCount_--;
+
+    return true;
+}
+
+bool Streamer::SetPosition(int id, float x, float y, float z) {
+    if (!IsValid(id, -1)) {
+        return false;
+    }
+
+    Unindex(id);
+
+    Item &item = items_[id];
+    item.x = x;
+    item.y = y;
+    item.z = z;
+
+    Index(id);
+
+    // Objects can be moved in place. Pickups and labels are destroyed; the
+    // next update creates them at the new position if they are still in
+    // range.
+    for (size_t i = 0; i < players_.size(); i++) {
+        VisibleMap &visible = players_[i].visible;
+        VisibleMap::iterator iter = visible.find(id);
+        if (iter == visible.end()) {
+            continue;
+        }
+
+        if (item.type == STREAMER_TYPE_OBJECT) {
+            SetPlayerObjectPos((int)i, iter->second, x, y, z);
+        } else {
+            DestroyEntity((int)i, item, iter->second);
+            visible.erase(iter);
+        }
+    }
+
+    return true;
+}
+
+bool Streamer::SetRotation(int id, float rx, float ry, float rz) {
+    if (!IsValid(id, STREAMER_TYPE_OBJECT)) {
+        return false;
+    }
+
+    Item &item = items_[id];
+    item.rx = rx;
+    item.ry = ry;
+    item.rz = rz;
+
+    for (size_t i = 0; i < players_.size(); i++) {
+        VisibleMap &visible = players_[i].visible;
+        VisibleMap::iterator iter = visible.find(id);
+        if (iter != visible.end()) {
+            SetPlayerObjectRot((int)i, iter->second, rx, ry, rz);
+        }
+    }
+
+    return true;
+}
+
+bool Streamer::SetLabelText(int id, MonoString *text, int color) {
+    if (!text) {
+        mono_raise_exception(mono_get_exception_argument_null("text"));
+        return false;
+    }
+
+    if (!IsValid(id, STREAMER_TYPE_LABEL)) {
+        return false;
+    }
+
+    Item &item = items_[id];
+    char *buffer = GameMode::MonoStringToString(text);
+    item.text = buffer;
+    item.color = color;
+    delete[] buffer;
+
+    for (size_t i = 0; i < players_.size(); i++) {
+        VisibleMap &visible = players_[i].visible;
+        VisibleMap::iterator iter = visible.find(id);
+        if (iter != visible.end()) {
+            UpdatePlayer3DTextLabelText((int)i, iter->second, item.color,
+                item.text.c_str());
+        }
+    }
+
+    return true;
+}
+
+void Streamer::SetBudget(int budget) {
+    if (budget < 1) {
+        mono_raise_exception(mono_get_exception_argument_out_of_range(
+            "budget"));
+        return;
+    }
+
+    budget_ = budget;
+}
+
+void Streamer::Update(int playerid) {
+    if (playerid < 0 || playerid >= MAX_PLAYERS ||
+        !LoggedNatives::IsPlayerConnected(playerid)) {
+        return;
+    }
+
+    UpdatePlayer(playerid, true);
+}
+
+bool Streamer::IsVisible(int id, int playerid) {
+    if (playerid < 0 || playerid >= MAX_PLAYERS) {
+        return false;
+    }
+
+    const VisibleMap &visible = players_[playerid].visible;
+    return visible.find(id) != visible.end();
+}
+
+int Streamer::GetVisibleCount(int playerid) {
+    if (playerid < 0 || playerid >= MAX_PLAYERS) {
+        return 0;
+    }
+
+    return (int)players_[playerid].visible.size();
+}
+
+int Streamer::FindPickup(int pickupid) {
+    if (pickupid < 0 || pickupid >= (int)pickupItems_.size()) {
+        return -1;
+    }
+
+    return pickupItems_[pickupid];
+}
+
+void Streamer::Process() {
+    int count = LoggedNatives::GetPlayerPoolSize() + 1;
+    if (count > MAX_PLAYERS) count = MAX_PLAYERS;
+
+    for (int i = 0; i < count; i++) {
+        if (LoggedNatives::IsPlayerConnected(i)) {
+            UpdatePlayer(i, false);
+        } else if (players_[i].connected) {
+            ReleasePlayer(i);
+        }
+    }
+
+    // Players above the new pool size have disconnected since the last
+    // update.
+    for (int i = count; i < processed_; i++) {
+        if (players_[i].connected) {
+            ReleasePlayer(i);
+        }
+    }
+    processed_ = count;
+}
+
+void Streamer::ProcessPublicCall(const char *name, cell *params) {
+    if (strcmp(name, "OnPlayerDisconnect") ||
+        params[0] < (cell)sizeof(cell)) {
+        return;
+    }
+
+    int playerid = params[1];
+    if (playerid >= 0 && playerid < MAX_PLAYERS &&
+        players_[playerid].connected) {
+        ReleasePlayer(playerid);
+    }
+}
+
+void Streamer::Clear() {
+    for (size_t i = 0; i < players_.size(); i++) {
+        PlayerState &state = players_[i];
+        for (VisibleMap::iterator iter = state.visible.begin();
+            iter != state.visible.end(); iter++) {
+            DestroyEntity((int)i, items_[iter->first], iter->second);
+        }
+        state.visible.clear();
+        state.connected = false;
+    }
+
+    items_.clear();
+    freeIds_.clear();
+    grid_.clear();
+    marks_.clear();
+    itemCount_ = 0;
+    processed_ = 0;
+    mark_ = 0;
+    budget_ = STREAMER_DEFAULT_BUDGET;
+}
+
+int Streamer::Insert(const Item &item) {
+    int id;
+    if (freeIds_.empty()) {
+        id = (int)items_.size();
+        items_.push_back(item);
+        marks_.push_back(0);
+    } else {
+        id = freeIds_.back();
+        freeIds_.pop_back();
+        items_[id] = item;
+    }
+
+    itemCount_++;
+    Index(id);
+
+    return id;
+}
+
+bool Streamer::IsValid(int id, int type) {
+    return id >= 0 && id < (int)items_.size() && items_[id].type >= 0 &&
+        (type < 0 || items_[id].type == type);
+}
+
+void Streamer::Index(int id) {
+    const Item &item = items_[id];
+    const float d = item.streamDistance;
+
+    CellEntry entry;
+    entry.x = item.x;
+    entry.y = item.y;
+    entry.z = item.z;
+    entry.streamDistanceSq = d * d;
+    entry.id = id;
+    entry.type = item.type;
+
+    CellKey key;
+    key.world = item.world;
+    key.interior = item.interior;
+
+    for (key.x = GetCell(item.x - d); key.x <= GetCell(item.x + d); key.x++) {
+        for (key.y = GetCell(item.y - d); key.y <= GetCell(item.y + d);
+            key.y++) {
+            grid_[key].push_back(entry);
+        }
+    }
+
+    version_++;
+}
+
+void Streamer::Unindex(int id) {
+    const Item &item = items_[id];
+    const float d = item.streamDistance;
+
+    CellKey key;
+    key.world = item.world;
+    key.interior = item.interior;
+
+    for (key.x = GetCell(item.x - d); key.x <= GetCell(item.x + d); key.x++) {
+        for (key.y = GetCell(item.y - d); key.y <= GetCell(item.y + d);
+            key.y++) {
+            Grid::iterator cell = grid_.find(key);
+            if (cell == grid_.end()) {
+                continue;
+            }
+
+            Cell &entries = cell->second;
+            for (size_t i = 0; i < entries.size(); i++) {
+                if (entries[i].id == id) {
+                    entries[i] = entries.back();
+                    entries.pop_back();
+                    break;
+                }
+            }
+
+            if (entries.empty()) {
+                grid_.erase(cell);
+            }
+        }
+    }
+
+    version_++;
+}
+
+void Streamer::UpdatePlayer(int playerid, bool force) {
+    PlayerState &state = players_[playerid];
+
+    float x, y, z;
+    int world, interior;
+    if (!PlayerSnapshot::GetPosition(playerid, x, y, z, world, interior)) {
+        LoggedNatives::GetPlayerPos(playerid, &x, &y, &z);
+        world = LoggedNatives::GetPlayerVirtualWorld(playerid);
+        interior = LoggedNatives::GetPlayerInterior(playerid);
+    }
+
+    // Skip the update if nothing that affects the visible set has changed
+    // since the last one.
+    float mx = x - state.x;
+    float my = y - state.y;
+    float mz = z - state.z;
+    if (!force && state.connected && !state.pending &&
+        state.version == version_ && state.world == world &&
+        state.interior == interior && mx * mx + my * my + mz * mz <
+        STREAMER_UPDATE_DISTANCE * STREAMER_UPDATE_DISTANCE) {
+        return;
+    }
+
+    state.connected = true;
+    state.x = x;
+    state.y = y;
+    state.z = z;
+    state.world = world;
+    state.interior = interior;
+    state.version = version_;
+
+    // Collect the items in range from the player's cell in the player's world
+    // and interior and in the cells matching every world or interior.
+    for (int t = 0; t < STREAMER_TYPES; t++) {
+        candidates_[t].clear();
+    }
+
+    const int worlds[2] = { world, -1 };
+    const int interiors[2] = { interior, -1 };
+
+    CellKey key;
+    key.x = GetCell(x);
+    key.y = GetCell(y);
+
+    for (int w = 0; w < 2; w++) {
+        for (int n = 0; n < 2; n++) {
+            if ((w && world == -1) || (n && interior == -1)) {
+                continue;
+            }
+
+            key.world = worlds[w];
+            key.interior = interiors[n];
+
+            Grid::const_iterator cell = grid_.find(key);
+            if (cell == grid_.end()) {
+                continue;
+            }
+
+            const Cell &entries = cell->second;
+            for (size_t i = 0; i < entries.size(); i++) {
+                const CellEntry &entry = entries[i];
+                float dx = entry.x - x;
+                float dy = entry.y - y;
+                float dz = entry.z - z;
+                float distanceSq = dx * dx + dy * dy + dz * dz;
+
+                if (distanceSq <= entry.streamDistanceSq) {
+                    Candidate candidate;
+                    candidate.distanceSq = distanceSq;
+                    candidate.id = entry.id;
+                    candidates_[entry.type].push_back(candidate);
+                }
+            }
+        }
+    }
+
+    if (++mark_ == 0) {
+        std::fill(marks_.begin(), marks_.end(), 0);
+        mark_ = 1;
+    }
+
+    // Mark the closest items of every type up to its limit as visible. Only
+    // the items beyond the limit have to be separated from the rest; the
+    // order within the visible set doesn't matter.
+    for (int t = 0; t < STREAMER_TYPES; t++) {
+        std::vector<Candidate> &candidates = candidates_[t];
+        if ((int)candidates.size() > visibleLimits[t]) {
+            std::nth_element(candidates.begin(),
+                candidates.begin() + visibleLimits[t], candidates.end());
+            candidates.resize(visibleLimits[t]);
+        }
+
+        for (size_t i = 0; i < candidates.size(); i++) {
+            marks_[candidates[i].id] = mark_;
+        }
+    }
+
+    // Destroy the entities of the items which left the visible set before
+    // creating new ones, so their slots can be reused.
+    for (VisibleMap::iterator iter = state.visible.begin();
+        iter != state.visible.end();) {
+        if (marks_[iter->first] != mark_) {
+            DestroyEntity(playerid, items_[iter->first], iter->second);
+            iter = state.visible.erase(iter);
+        } else {
+            iter++;
+        }
+    }
+
+    created_.clear();
+    for (int t = 0; t < STREAMER_TYPES; t++) {
+        const std::vector<Candidate> &candidates = candidates_[t];
+        for (size_t i = 0; i < candidates.size(); i++) {
+            if (state.visible.find(candidates[i].id) == state.visible.end()) {
+                created_.push_back(candidates[i]);
+            }
+        }
+    }
+
+    // If the budget doesn't allow creating every new item, create the
+    // closest ones and update again on the next tick.
+    size_t count = created_.size();
+    state.pending = count > (size_t)budget_;
+    if (state.pending) {
+        count = (size_t)budget_;
+        std::nth_element(created_.begin(), created_.begin() + count,
+            created_.end());
+        std::sort(created_.begin(), created_.begin() + count);
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        int id = created_[i].id;
+        int entity;
+        if (CreateEntity(playerid, items_[id], entity)) {
+            state.visible[id] = entity;
+        }
+    }
+}
+
+void Streamer::ReleasePlayer(int playerid) {
+    PlayerState &state = players_[playerid];
+
+    // The server has destroyed the per-player entities of the player; only
+    // the shared pickups have to be released.
+    for (VisibleMap::iterator iter = state.visible.begin();
+        iter != state.visible.end(); iter++) {
+        Item &item = items_[iter->first];
+        if (item.type == STREAMER_TYPE_PICKUP) {
+            DestroyEntity(playerid, item, iter->second);
+        }
+    }
+
+    state.visible.clear();
+    state.connected = false;
+}
+
+bool Streamer::CreateEntity(int playerid, Item &item, int &entity) {
+    switch (item.type) {
+    case STREAMER_TYPE_OBJECT:
+        entity = LoggedNatives::CreatePlayerObject(playerid, item.modelid,
+            item.x, item.y, item.z, item.rx, item.ry, item.rz,
+            item.drawDistance);
+        return entity != INVALID_OBJECT_ID;
+    case STREAMER_TYPE_PICKUP:
+        entity = -1;
+        if (!item.pickupRefs) {
+            item.pickupid = LoggedNatives::CreatePickup(item.modelid,
+                item.pickupType, item.x, item.y, item.z, item.world);
+            if (item.pickupid < 0) {
+                return false;
+            }
+            if (item.pickupid < (int)pickupItems_.size()) {
+                pickupItems_[item.pickupid] = (int)(&item - &items_[0]);
+            }
+        }
+        item.pickupRefs++;
+        return true;
+    case STREAMER_TYPE_LABEL:
+        entity = LoggedNatives::CreatePlayer3DTextLabel(playerid,
+            item.text.c_str(), item.color, item.x, item.y, item.z,
+            item.drawDistance, INVALID_PLAYER_ID, INVALID_VEHICLE_ID,
+            item.testLOS);
+        return entity != INVALID_3DTEXT_ID;
+    default:
+        return false;
+    }
+}
+
+void Streamer::DestroyEntity(int playerid, Item &item, int entity) {
+    switch (item.type) {
+    case STREAMER_TYPE_OBJECT:
+        LoggedNatives::DestroyPlayerObject(playerid, entity);
+        break;
+    case STREAMER_TYPE_PICKUP:
+        if (--item.pickupRefs == 0) {
+            LoggedNatives::DestroyPickup(item.pickupid);
+            if (item.pickupid < (int)pickupItems_.size()) {
+                pickupItems_[item.pickupid] = -1;
+            }
+        }
+        break;
+    case STREAMER_TYPE_LABEL:
+        LoggedNatives::DeletePlayer3DTextLabel(playerid, entity);
+        break;
+    }
+}
+
+void Streamer::DestroyEntities(int id) {
+    Item &item = items_[id];
+    for (size_t i = 0; i < players_.size(); i++) {
+        VisibleMap &visible = players_[i].visible;
+        VisibleMap::iterator iter = visible.find(id);
+        if (iter != visible.end()) {
+            DestroyEntity((int)i, item, iter->second);
+            visible.erase(iter);
+        }
+    }
+}
+
+bool Streamer::CheckDistance(float streamDistance) {
+    if (!(streamDistance > 0 &&
+        streamDistance <= STREAMER_MAX_STREAM_DISTANCE)) {
+        mono_raise_exception(mono_get_exception_argument_out_of_range(
+            "streamDistance"));
+        return false;
+    }
+
+    return true;
+}
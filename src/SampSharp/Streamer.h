@@ -0,0 +1,209 @@
+// SampSharp
+// Copyright 2017 Tim Potze
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <mono/jit/jit.h>
+#include <sdk/amx/amx.h>
+
+#pragma once
+
+#define STREAMER_TYPE_OBJECT                (0)
+#define STREAMER_TYPE_PICKUP                (1)
+#define STREAMER_TYPE_LABEL                 (2)
+#define STREAMER_TYPES                      (3)
+
+/* The length of the sides of the grid cells in units. */
+#define STREAMER_CELL_SIZE                  (250.0f)
+/* The largest allowed stream distance. Items are indexed in every cell their
+ * stream distance overlaps. */
+#define STREAMER_MAX_STREAM_DISTANCE        (3000.0f)
+/* The default number of items created per player per tick. */
+#define STREAMER_DEFAULT_BUDGET             (50)
+/* The distance in units a player has to move before the player's visible set
+ * is recomputed. */
+#define STREAMER_UPDATE_DISTANCE            (5.0f)
+
+/* The maximum number of items of each type visible to a player at once. The
+ * pickup limit is per player; pickups are global entities shared by every
+ * player they are visible to. */
+#define STREAMER_MAX_VISIBLE_OBJECTS        (500)
+#define STREAMER_MAX_VISIBLE_PICKUPS        (128)
+#define STREAMER_MAX_VISIBLE_LABELS         (500)
+
+/* Streams an unlimited number of virtual objects, pickups and 3D text labels
+ * onto the server's limited entity pools.
+ *
+ * Items are stored in a spatial grid keyed by virtual world, interior and
+ * cell; an item is indexed in every cell its stream distance overlaps, so
+ * finding the items in range of a player takes a lookup of the player's cell.
+ * A world or interior of -1 matches every world or interior.
+ *
+ * Once per tick the visible set of every connected player is recomputed from
+ * the player snapshot, or from the position natives if no snapshot is
+ * attached, if the player moved STREAMER_UPDATE_DISTANCE units, changed world
+ * or interior, items were added, moved or removed, or items were left to be
+ * created. The closest items up to the per type limit are visible. Items which
+ * left the set are destroyed; new items are created closest first, at most
+ * budget per player per tick. Objects and labels are created as per-player
+ * entities, pickups as global entities which are destroyed when no player sees
+ * them. */
+class Streamer {
+public:
+    /* Adds an object and returns its item id. */
+    static int AddObject(int modelid, float x, float y, float z, float rx,
+        float ry, float rz, int world, int interior, float streamDistance,
+        float drawDistance);
+    /* Adds a pickup and returns its item id. */
+    static int AddPickup(int modelid, int type, float x, float y, float z,
+        int world, int interior, float streamDistance);
+    /* Adds a 3D text label and returns its item id. */
+    static int AddLabel(MonoString *text, int color, float x, float y,
+        float z, float drawDistance, int world, int interior, bool testLOS,
+        float streamDistance);
+    /* Removes the item with the specified id. */
+    static bool Remove(int id);
+    /* Moves the item with the specified id. */
+    static bool SetPosition(int id, float x, float y, float z);
+    /* Rotates the object with the specified id. */
+    static bool SetRotation(int id, float rx, float ry, float rz);
+    /* Sets the text and color of the label with the specified id. */
+    static bool SetLabelText(int id, MonoString *text, int color);
+    /* Sets the number of items created per player per tick. */
+    static void SetBudget(int budget);
+    /* Updates the visible set of the specified player immediately, for
+     * instance after the player has been teleported. */
+    static void Update(int playerid);
+    /* Gets a value indicating whether the item with the specified id is
+     * visible to the specified player. */
+    static bool IsVisible(int id, int playerid);
+    /* Gets the number of items visible to the specified player. */
+    static int GetVisibleCount(int playerid);
+    /* Gets the id of the item the specified global pickup was created for, or
+     * -1 if the pickup isn't streamed. */
+    static int FindPickup(int pickupid);
+    /* Updates the visible sets of every connected player. */
+    static void Process();
+    /* Releases the entities of a player as soon as the player disconnects,
+     * before the id of the player can be reused. */
+    static void ProcessPublicCall(const char *name, cell *params);
+    /* Removes every item. */
+    static void Clear();
+    /* Gets a value indicating whether any items exist. */
+    static bool IsActive() {
+        return itemCount_ > 0;
+    }
+
+private:
+    /* Represents a virtual item. Free slots have a type of -1. */
+    struct Item {
+        int type;
+        int world;
+        int interior;
+        float x, y, z;
+        float rx, ry, rz;
+        float streamDistance;
+        float drawDistance;
+        int modelid;
+        int pickupType;
+        int color;
+        bool testLOS;
+        std::string text;
+        /* The global pickup and the number of players it is visible to. */
+        int pickupid;
+        int pickupRefs;
+    };
+    /* Represents an item in a cell. The position and distance are copied
+     * from the item so scanning a cell doesn't touch the items. */
+    struct CellEntry {
+        float x, y, z;
+        float streamDistanceSq;
+        int id;
+        int type;
+    };
+    struct CellKey {
+        int world;
+        int interior;
+        int x;
+        int y;
+
+        bool operator==(const CellKey &other) const {
+            return world == other.world && interior == other.interior &&
+                x == other.x && y == other.y;
+        }
+    };
+    struct CellKeyHash {
+        size_t operator()(const CellKey &key) const {
+            uint32_t h = (uint32_t)key.world * 2654435761u;
+            h = (h ^ (uint32_t)key.interior) * 2246822519u;
+            h = (h ^ (uint32_t)key.x) * 3266489917u;
+            h = (h ^ (uint32_t)key.y) * 668265263u;
+            return h ^ (h >> 15);
+        }
+    };
+    typedef std::vector<CellEntry> Cell;
+    typedef std::unordered_map<CellKey, Cell, CellKeyHash> Grid;
+    struct Candidate {
+        float distanceSq;
+        int id;
+
+        bool operator<(const Candidate &other) const {
+            return distanceSq < other.distanceSq;
+        }
+    };
+    /* The entities of the items visible to a player, by item id. Pickups are
+     * stored with an entity id of -1; their entity is Item::pickupid. */
+    typedef std::unordered_map<int, int> VisibleMap;
+    struct PlayerState {
+        bool connected;
+        /* Whether the budget ran out before every visible item was
+         * created. */
+        bool pending;
+        /* The position and version of the grid at the last update. */
+        float x, y, z;
+        int world;
+        int interior;
+        uint32_t version;
+        VisibleMap visible;
+    };
+
+    static int Insert(const Item &item);
+    static bool IsValid(int id, int type);
+    static void Index(int id);
+    static void Unindex(int id);
+    static void UpdatePlayer(int playerid, bool force);
+    static void ReleasePlayer(int playerid);
+    static bool CreateEntity(int playerid, Item &item, int &entity);
+    static void DestroyEntity(int playerid, Item &item, int entity);
+    static void DestroyEntities(int id);
+    static bool CheckDistance(float streamDistance);
+
+    static std::vector<Item> items_;
+    static std::vector<int> freeIds_;
+    static int itemCount_;
+    static Grid grid_;
+    static uint32_t version_;
+    static std::vector<PlayerState> players_;
+    /* The item ids of the streamed global pickups, by pickup id. */
+    static std::vector<int> pickupItems_;
+    static int processed_;
+    static std::vector<Candidate> candidates_[STREAMER_TYPES];
+    static std::vector<Candidate> created_;
+    static std::vector<uint32_t> marks_;
+    static uint32_t mark_;
+    static int budget_;
+};
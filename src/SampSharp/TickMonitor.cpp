@@ -0,0 +1,239 @@
+// SampSharp
+// Copyright 2017 Tim Potze
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "TickMonitor.h"
+#include <string.h>
+#include <algorithm>
+#include <sampgdk/sampgdk.h>
+
+using sampgdk::logprintf;
+
+/* The upper bounds of the histogram buckets in milliseconds; the last bucket
+ * holds the longer ticks. */
+static const int bucketBounds[TICK_MONITOR_BUCKETS - 1] = {
+    1, 2, 5, 10, 20, 50, 100, 250, 500
+};
+
+int TickMonitor::threshold_;
+int TickMonitor::depth_;
+std::vector<TickMonitor::Event> TickMonitor::events_;
+uint32_t TickMonitor::eventCount_;
+TickMonitor::Clock::time_point TickMonitor::tickStart_;
+uint64_t TickMonitor::total_;
+uint64_t TickMonitor::phases_;
+TickMonitor::Clock::time_point TickMonitor::lastTick_;
+TickMonitor::Clock::time_point TickMonitor::lastReport_;
+uint32_t TickMonitor::suppressed_;
+uint8_t TickMonitor::window_[TICK_MONITOR_WINDOW];
+uint32_t TickMonitor::windowSize_;
+uint32_t TickMonitor::windowPosition_;
+uint32_t TickMonitor::buckets_[TICK_MONITOR_BUCKETS];
+uint64_t TickMonitor::max_;
+uint64_t TickMonitor::slowTicks_;
+
+void TickMonitor::SetThreshold(int threshold) {
+    if (threshold < 0) {
+        threshold = 0;
+    }
+
+    if (threshold && !threshold_) {
+        events_.clear();
+        events_.reserve(TICK_MONITOR_MAX_EVENTS);
+        eventCount_ = 0;
+        tickStart_ = Clock::time_point();
+        total_ = 0;
+        phases_ = 0;
+        lastTick_ = Clock::time_point();
+        lastReport_ = Clock::time_point();
+        suppressed_ = 0;
+        windowSize_ = 0;
+        windowPosition_ = 0;
+        memset(buckets_, 0, sizeof(buckets_));
+        max_ = 0;
+        slowTicks_ = 0;
+    }
+
+    threshold_ = threshold;
+}
+
+void TickMonitor::Record(EventKind kind, const char *name, int id,
+    Clock::time_point start) {
+    Clock::time_point end = Clock::now();
+    uint64_t duration = GetMicroseconds(end - start);
+
+    // Only top level events add to the total; nested events ran within
+    // them.
+    if (--depth_ == 0) {
+        total_ += duration;
+        if (kind == Phase) {
+            phases_ += duration;
+        }
+    }
+
+    if (tickStart_ == Clock::time_point() || start < tickStart_) {
+        tickStart_ = start;
+    }
+
+    eventCount_++;
+    if (events_.size() >= TICK_MONITOR_MAX_EVENTS) {
+        return;
+    }
+
+    Event event;
+    event.kind = kind;
+    event.id = id;
+    event.depth = depth_;
+    event.start = start;
+    event.duration = (uint32_t)duration;
+    strncpy(event.name, name ? name : "", TICK_MONITOR_NAME_LENGTH - 1);
+    event.name[TICK_MONITOR_NAME_LENGTH - 1] = '\0';
+    events_.push_back(event);
+}
+
+void TickMonitor::EndTick() {
+    if (!threshold_) {
+        return;
+    }
+
+    Clock::time_point now = Clock::now();
+    uint64_t interval = lastTick_ == Clock::time_point() ? 0
+        : GetMicroseconds(now - lastTick_);
+    lastTick_ = now;
+
+    // Replace the oldest tick of the window once it is full.
+    if (windowSize_ == TICK_MONITOR_WINDOW) {
+        buckets_[window_[windowPosition_]]--;
+    }
+    else {
+        windowSize_++;
+    }
+
+    int bucket = GetBucket(total_);
+    window_[windowPosition_] = (uint8_t)bucket;
+    buckets_[bucket]++;
+    windowPosition_ = (windowPosition_ + 1) % TICK_MONITOR_WINDOW;
+
+    if (total_ > max_) {
+        max_ = total_;
+    }
+
+    if (total_ >= (uint64_t)threshold_ * 1000) {
+        slowTicks_++;
+
+        if (lastReport_ == Clock::time_point() || now - lastReport_ >=
+            std::chrono::milliseconds(TICK_MONITOR_REPORT_INTERVAL)) {
+            Report(total_, interval);
+            lastReport_ = now;
+            suppressed_ = 0;
+        }
+        else {
+            suppressed_++;
+        }
+    }
+
+    events_.clear();
+    eventCount_ = 0;
+    tickStart_ = Clock::time_point();
+    total_ = 0;
+    phases_ = 0;
+}
+
+bool TickMonitor::CompareDuration(const Event &a, const Event &b) {
+    return a.duration > b.duration;
+}
+
+bool TickMonitor::CompareStart(const Event &a, const Event &b) {
+    return a.start != b.start ? a.start < b.start : a.depth < b.depth;
+}
+
+void TickMonitor::Report(uint64_t total, uint64_t interval) {
+    logprintf("[SampSharp] Slow tick: %.2f ms (callbacks %.2f ms, tick "
+        "%.2f ms), %.2f ms since the previous tick, %u events.",
+        total / 1000.0, (total - phases_) / 1000.0, phases_ / 1000.0,
+        interval / 1000.0, eventCount_);
+
+    // Print the longest events in the order in which they started.
+    std::vector<Event> events(events_);
+    size_t count = std::min(events.size(),
+        (size_t)TICK_MONITOR_REPORT_EVENTS);
+    std::partial_sort(events.begin(), events.begin() + count, events.end(),
+        CompareDuration);
+    events.resize(count);
+    std::sort(events.begin(), events.end(), CompareStart);
+
+    for (size_t i = 0; i < events.size(); i++) {
+        const Event &event = events[i];
+        const char *kind = event.kind == Callback ? "callback"
+            : event.kind == Timer ? "timer" : "tick";
+        int indent = 2 + 2 * std::min(event.depth, 8);
+        double offset = GetMicroseconds(event.start - tickStart_) / 1000.0;
+
+        if (event.kind == Timer) {
+            logprintf("[SampSharp] %*s+%-8.2f %8.2f ms  %s %s %d", indent, "",
+                offset, event.duration / 1000.0, kind,
+                event.name, event.id);
+        }
+        else {
+            logprintf("[SampSharp] %*s+%-8.2f %8.2f ms  %s %s", indent, "",
+                offset, event.duration / 1000.0, kind,
+                event.name);
+        }
+    }
+
+    if (eventCount_ > count) {
+        logprintf("[SampSharp]   ... and %u shorter events.",
+            (unsigned int)(eventCount_ - count));
+    }
+    if (suppressed_) {
+        logprintf("[SampSharp]   %u slow ticks since the previous report "
+            "were not reported.", suppressed_);
+    }
+}
+
+void TickMonitor::PrintHistogram() {
+    if (!threshold_) {
+        logprintf("The tick monitor is disabled. Set slow_tick_threshold in "
+            "server.cfg to enable it.");
+        return;
+    }
+
+    logprintf("Durations of the last %u ticks (threshold: %d ms, slow ticks: "
+        "%llu, longest: %.2f ms):", windowSize_, threshold_,
+        (unsigned long long)slowTicks_, max_ / 1000.0);
+
+    for (int i = 0; i < TICK_MONITOR_BUCKETS; i++) {
+        double percentage = windowSize_ ? buckets_[i] * 100.0 / windowSize_
+            : 0;
+
+        if (i < TICK_MONITOR_BUCKETS - 1) {
+            logprintf("  < %3d ms %10u %6.2f%%", bucketBounds[i], buckets_[i],
+                percentage);
+        }
+        else {
+            logprintf(" >= %3d ms %10u %6.2f%%", bucketBounds[i - 1],
+                buckets_[i], percentage);
+        }
+    }
+}
+
+int TickMonitor::GetBucket(uint64_t duration) {
+    for (int i = 0; i < TICK_MONITOR_BUCKETS - 1; i++) {
+        if (duration < (uint64_t)bucketBounds[i] * 1000) {
+            return i;
+        }
+    }
+
+    return TICK_MONITOR_BUCKETS - 1;
+}
@@ -0,0 +1,127 @@
+// SampSharp
+// Copyright 2017 Tim Potze
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdint.h>
+#include <chrono>
+#include <vector>
+
+#pragma once
+
+/* The slow tick threshold in milliseconds used unless slow_tick_threshold is
+ * set in server.cfg. */
+#define TICK_MONITOR_DEFAULT_THRESHOLD      (50)
+/* The number of ticks the histogram covers. */
+#define TICK_MONITOR_WINDOW                 (10000)
+/* The number of events recorded per tick; later events are only counted. */
+#define TICK_MONITOR_MAX_EVENTS             (512)
+/* The number of longest events printed for a slow tick. */
+#define TICK_MONITOR_REPORT_EVENTS          (20)
+/* The minimum time in milliseconds between two slow tick reports. */
+#define TICK_MONITOR_REPORT_INTERVAL        (1000)
+/* The length of the names stored for events, including the terminator. */
+#define TICK_MONITOR_NAME_LENGTH            (32)
+/* The number of buckets of the histogram. */
+#define TICK_MONITOR_BUCKETS                (10)
+
+/* Measures the time the plugin spends per server tick: the callbacks received
+ * since the previous tick and the phases of the tick itself, which are the
+ * game mode's tick handler, the timers and the run signals. Callbacks raised
+ * while another event runs, like timers or callbacks raised by natives, are
+ * nested in it and don't add to the total.
+ *
+ * The totals of the last TICK_MONITOR_WINDOW ticks are kept in a histogram.
+ * If a tick takes longer than the threshold, the longest events of the tick
+ * are printed to the log with their durations, at most once per
+ * TICK_MONITOR_REPORT_INTERVAL ms. A threshold of 0 disables the monitor; an
+ * event then costs a single branch. */
+class TickMonitor {
+public:
+    typedef std::chrono::steady_clock Clock;
+
+    enum EventKind {
+        Callback,
+        Timer,
+        Phase
+    };
+
+    /* Sets the slow tick threshold in milliseconds, or 0 to disable the
+     * monitor. The histogram is reset when the monitor is enabled. */
+    static void SetThreshold(int threshold);
+    static int GetThreshold() {
+        return threshold_;
+    }
+    /* Starts an event. Returns the start time to pass to End, which is the
+     * epoch if the monitor is disabled. */
+    static Clock::time_point Begin() {
+        if (!threshold_) {
+            return Clock::time_point();
+        }
+
+        depth_++;
+        return Clock::now();
+    }
+    /* Ends an event started by Begin. The name is copied; id is printed for
+     * timers. */
+    static void End(EventKind kind, const char *name, int id,
+        Clock::time_point start) {
+        if (start != Clock::time_point()) {
+            Record(kind, name, id, start);
+        }
+    }
+    /* Ends the current tick, adding it to the histogram and reporting it if
+     * it was slow. */
+    static void EndTick();
+    /* Prints the histogram to the log. */
+    static void PrintHistogram();
+
+private:
+    struct Event {
+        EventKind kind;
+        int id;
+        int depth;
+        Clock::time_point start;
+        /* The duration in microseconds. */
+        uint32_t duration;
+        char name[TICK_MONITOR_NAME_LENGTH];
+    };
+
+    static void Record(EventKind kind, const char *name, int id,
+        Clock::time_point start);
+    static void Report(uint64_t total, uint64_t interval);
+    static bool CompareDuration(const Event &a, const Event &b);
+    static bool CompareStart(const Event &a, const Event &b);
+    static int GetBucket(uint64_t duration);
+    static uint64_t GetMicroseconds(Clock::duration duration) {
+        return (uint64_t)std::chrono::duration_cast<
+            std::chrono::microseconds>(duration).count();
+    }
+
+    static int threshold_;
+    static int depth_;
+    static std::vector<Event> events_;
+    static uint32_t eventCount_;
+    static Clock::time_point tickStart_;
+    static uint64_t total_;
+    static uint64_t phases_;
+    static Clock::time_point lastTick_;
+    static Clock::time_point lastReport_;
+    static uint32_t suppressed_;
+    static uint8_t window_[TICK_MONITOR_WINDOW];
+    static uint32_t windowSize_;
+    static uint32_t windowPosition_;
+    static uint32_t buckets_[TICK_MONITOR_BUCKETS];
+    static uint64_t max_;
+    static uint64_t slowTicks_;
+};
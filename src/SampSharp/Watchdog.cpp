@@ -0,0 +1,292 @@
+// SampSharp
+// Copyright 2017 Tim Potze
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "Watchdog.h"
+#include <stdio.h>
+#include <string.h>
+#include <chrono>
+#include <string>
+#include <mono/metadata/debug-helpers.h>
+#include <mono/metadata/mono-debug.h>
+#include <sampgdk/sampgdk.h>
+#include "ErrorLog.h"
+#if SAMPSHARP_LINUX
+#include <errno.h>
+#endif
+
+using sampgdk::logprintf;
+
+int Watchdog::timeout_;
+bool Watchdog::abort_;
+bool Watchdog::running_;
+int Watchdog::depth_;
+std::atomic<uint32_t> Watchdog::heartbeat_;
+std::atomic<MonoMethod *> Watchdog::method_;
+std::mutex Watchdog::abortMutex_;
+bool Watchdog::aborted_;
+MonoDomain *Watchdog::domain_;
+MonoThread *Watchdog::serverThread_;
+MonoMethod *Watchdog::resetAbortMethod_;
+std::thread Watchdog::thread_;
+std::mutex Watchdog::mutex_;
+std::condition_variable Watchdog::stop_;
+bool Watchdog::stopping_;
+#if SAMPSHARP_LINUX
+pthread_t Watchdog::serverThreadId_;
+int Watchdog::signal_;
+std::atomic<bool> Watchdog::captured_;
+Watchdog::Frame Watchdog::frames_[WATCHDOG_MAX_FRAMES];
+int Watchdog::frameCount_;
+#endif
+
+void Watchdog::Start(int timeout, bool abort) {
+    Stop();
+
+    if (timeout <= 0) {
+        return;
+    }
+
+    timeout_ = timeout;
+    abort_ = abort;
+    aborted_ = false;
+    domain_ = mono_domain_get();
+    serverThread_ = mono_thread_current();
+
+    MonoClass *klass = mono_class_from_name(mono_get_corlib(),
+        "System.Threading", "Thread");
+    resetAbortMethod_ = klass
+        ? mono_class_get_method_from_name(klass, "ResetAbort", 0)
+        : NULL;
+
+#if SAMPSHARP_LINUX
+    serverThreadId_ = pthread_self();
+    if (!InstallSignalHandler()) {
+        logprintf("WARNING: No signal is available to capture the stack of "
+            "hung callbacks.");
+    }
+#endif
+
+    stopping_ = false;
+    running_ = true;
+    thread_ = std::thread(Run);
+}
+
+void Watchdog::Stop() {
+    if (!running_) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    stop_.notify_all();
+    thread_.join();
+
+    running_ = false;
+}
+
+void Watchdog::Run() {
+    typedef std::chrono::steady_clock Clock;
+
+    // Reporting and aborting call into the runtime.
+    MonoThread *thread = mono_thread_attach(domain_);
+
+    // The start of a call is the first time the watchdog sees its
+    // heartbeat, so calls are reported at most one poll interval late.
+    uint32_t observed = heartbeat_.load(std::memory_order_acquire);
+    Clock::time_point since = Clock::now();
+    bool reported = false;
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!stop_.wait_for(lock,
+        std::chrono::milliseconds(WATCHDOG_POLL_INTERVAL),
+        [] { return stopping_; })) {
+        uint32_t heartbeat = heartbeat_.load(std::memory_order_acquire);
+        if (heartbeat != observed) {
+            observed = heartbeat;
+            since = Clock::now();
+            reported = false;
+            continue;
+        }
+        if (!(heartbeat & 1) || reported) {
+            continue;
+        }
+
+        int elapsed = (int)std::chrono::duration_cast<
+            std::chrono::milliseconds>(Clock::now() - since).count();
+        if (elapsed < timeout_) {
+            continue;
+        }
+
+        reported = true;
+
+        lock.unlock();
+        Report(method_.load(std::memory_order_relaxed), elapsed);
+
+        if (abort_) {
+            Abort(heartbeat);
+        }
+        lock.lock();
+    }
+
+    lock.unlock();
+    mono_thread_detach(thread);
+}
+
+void Watchdog::Report(MonoMethod *method, int elapsed) {
+    char header[256];
+    snprintf(header, sizeof(header), "Callback %s has been running for over "
+        "%d ms", method ? mono_method_get_name(method) : "(unknown)",
+        elapsed);
+
+    std::string text;
+#if SAMPSHARP_LINUX
+    if (Capture()) {
+        for (int i = 0; i < frameCount_; i++) {
+            char *frame = mono_debug_print_stack_frame(frames_[i].method,
+                frames_[i].offset, frames_[i].domain);
+
+            if (i) {
+                text.append("\n");
+            }
+            text.append("  ").append(frame);
+            mono_free(frame);
+        }
+    }
+    else {
+        text = "The stack of the server thread could not be captured.";
+    }
+#elif SAMPSHARP_WINDOWS
+    mono_threads_request_thread_dump();
+    text = "The stacks of all threads have been printed to the console.";
+#endif
+
+    if (abort_) {
+        text.append("\nThe callback is being aborted.");
+    }
+
+    ErrorLog::Write(header, text.c_str());
+}
+
+void Watchdog::Abort(uint32_t heartbeat) {
+    std::lock_guard<std::mutex> lock(abortMutex_);
+
+    // The call may have returned while it was being reported.
+    if (heartbeat_.load(std::memory_order_acquire) != heartbeat) {
+        return;
+    }
+
+    aborted_ = true;
+    mono_thread_stop(serverThread_);
+}
+
+void Watchdog::ExitAbortable() {
+    // Ending the call and requesting its abort exclude each other; either the
+    // abort is requested before the call ends and reset here, or it isn't
+    // requested at all.
+    std::lock_guard<std::mutex> lock(abortMutex_);
+    heartbeat_.fetch_add(1, std::memory_order_release);
+
+    if (!aborted_) {
+        return;
+    }
+    aborted_ = false;
+
+    // The pending abort may be raised as ResetAbort is entered, before it
+    // runs; the abort stays requested until ResetAbort has run.
+    for (int attempt = 0; attempt < 2 && resetAbortMethod_; attempt++) {
+        MonoObject *exception = NULL;
+        mono_runtime_invoke(resetAbortMethod_, NULL, NULL, &exception);
+
+        if (!exception) {
+            break;
+        }
+    }
+}
+
+#if SAMPSHARP_LINUX
+bool Watchdog::Capture() {
+    if (!signal_) {
+        return false;
+    }
+
+    captured_.store(false, std::memory_order_release);
+    if (pthread_kill(serverThreadId_, signal_) != 0) {
+        return false;
+    }
+
+    for (int waited = 0; waited < WATCHDOG_CAPTURE_TIMEOUT; waited++) {
+        if (captured_.load(std::memory_order_acquire)) {
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    return false;
+}
+
+bool Watchdog::InstallSignalHandler() {
+    if (signal_) {
+        return true;
+    }
+
+    // Take the highest real-time signal nobody handles; Mono claims the
+    // lowest free ones.
+    for (int signal = SIGRTMAX; signal >= SIGRTMIN; signal--) {
+        struct sigaction current;
+        if (sigaction(signal, NULL, &current) != 0 ||
+            current.sa_handler != SIG_DFL) {
+            continue;
+        }
+
+        struct sigaction action;
+        memset(&action, 0, sizeof(action));
+        action.sa_sigaction = HandleSignal;
+        action.sa_flags = SA_SIGINFO | SA_RESTART;
+        sigemptyset(&action.sa_mask);
+
+        if (sigaction(signal, &action, NULL) == 0) {
+            signal_ = signal;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void Watchdog::HandleSignal(int signal, siginfo_t *info, void *context) {
+    int error = errno;
+
+    frameCount_ = 0;
+    mono_stack_walk_async_safe(AddFrame, context, NULL);
+    captured_.store(true, std::memory_order_release);
+
+    errno = error;
+}
+
+mono_bool Watchdog::AddFrame(MonoMethod *method, MonoDomain *domain,
+    void *base, int offset, void *data) {
+    if (method) {
+        Frame &frame = frames_[frameCount_++];
+        frame.method = method;
+        frame.domain = domain;
+        frame.offset = offset;
+    }
+
+    // Stop walking once the buffer is full.
+    return frameCount_ >= WATCHDOG_MAX_FRAMES;
+}
+#endif
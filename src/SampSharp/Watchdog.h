@@ -0,0 +1,131 @@
+// SampSharp
+// Copyright 2017 Tim Potze
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <mono/jit/jit.h>
+#include <mono/metadata/threads.h>
+#include "platforms.h"
+#if SAMPSHARP_LINUX
+#include <pthread.h>
+#include <signal.h>
+#endif
+
+#pragma once
+
+/* The interval in milliseconds at which the watchdog checks the server
+ * thread. */
+#define WATCHDOG_POLL_INTERVAL              (100)
+/* The maximum number of managed frames captured. */
+#define WATCHDOG_MAX_FRAMES                 (64)
+/* The time in milliseconds the watchdog waits for the server thread to
+ * capture its stack. */
+#define WATCHDOG_CAPTURE_TIMEOUT            (1000)
+
+/* Watches the server thread for callbacks which don't return. CallEvent
+ * updates a heartbeat when the outermost call into the game mode starts and
+ * ends, which costs two atomic increments per call, and an uncontended lock
+ * if aborting is enabled. A thread attached to the runtime polls the
+ * heartbeat; if a call has been running for longer than the timeout, the
+ * managed stack of the server thread is written to the error log, after
+ * which the call is optionally aborted.
+ *
+ * On Linux the server thread is interrupted by a real-time signal which
+ * isn't used by Mono; the signal handler walks the managed stack with Mono's
+ * async safe stack walk and the watchdog thread formats the frames. On
+ * Windows Mono prints the stacks of all threads to the console instead.
+ *
+ * Aborting raises a ThreadAbortException in the server thread, which only
+ * happens once the thread runs managed code again; a thread waiting in native
+ * code, like a deadlocked one, isn't recovered. The abort is reset when the
+ * outermost call returns, so the game mode keeps running. */
+class Watchdog {
+public:
+    /* Starts watching the calling thread, which must be attached to the
+     * domain of the game mode. Calls running longer than timeout
+     * milliseconds are reported and, if abort is true, aborted. */
+    static void Start(int timeout, bool abort);
+    /* Stops the watchdog thread. */
+    static void Stop();
+    /* Gets a value indicating whether the watchdog is running. */
+    static bool IsRunning() {
+        return running_;
+    }
+    /* Marks the start of a call of the specified method. */
+    static void Enter(MonoMethod *method) {
+        if (depth_++ == 0) {
+            method_.store(method, std::memory_order_relaxed);
+            heartbeat_.fetch_add(1, std::memory_order_release);
+        }
+    }
+    /* Marks the end of a call. Resets the abort of the server thread if the
+     * outermost call has been aborted. */
+    static void Exit() {
+        if (--depth_ == 0) {
+            if (abort_) {
+                ExitAbortable();
+            }
+            else {
+                heartbeat_.fetch_add(1, std::memory_order_release);
+            }
+        }
+    }
+
+private:
+    struct Frame {
+        MonoMethod *method;
+        MonoDomain *domain;
+        int offset;
+    };
+
+    static void Run();
+    static void Report(MonoMethod *method, int elapsed);
+    static void Abort(uint32_t heartbeat);
+    static void ExitAbortable();
+#if SAMPSHARP_LINUX
+    static bool Capture();
+    static bool InstallSignalHandler();
+    static void HandleSignal(int signal, siginfo_t *info, void *context);
+    static mono_bool AddFrame(MonoMethod *method, MonoDomain *domain,
+        void *base, int offset, void *data);
+#endif
+
+    static int timeout_;
+    static bool abort_;
+    static bool running_;
+    static int depth_;
+    /* Odd while the server thread runs a call. */
+    static std::atomic<uint32_t> heartbeat_;
+    static std::atomic<MonoMethod *> method_;
+    /* Guards ending a call against requesting its abort. */
+    static std::mutex abortMutex_;
+    static bool aborted_;
+    static MonoDomain *domain_;
+    static MonoThread *serverThread_;
+    static MonoMethod *resetAbortMethod_;
+    static std::thread thread_;
+    static std::mutex mutex_;
+    static std::condition_variable stop_;
+    static bool stopping_;
+#if SAMPSHARP_LINUX
+    static pthread_t serverThreadId_;
+    static int signal_;
+    static std::atomic<bool> captured_;
+    static Frame frames_[WATCHDOG_MAX_FRAMES];
+    static int frameCount_;
+#endif
+};
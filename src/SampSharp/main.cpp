@@ -17,13 +17,30 @@
 #include <fstream>
 #include <sampgdk/sampgdk.h>
 #include <assert.h>
+#include <stdlib.h>
+#include <chrono>
 #include <string.h>
 #include <iostream>
 #include "Config.h"
 #include "ConfigReader.h"
 #include "MonoRuntime.h"
 #include "GameMode.h"
+#include "CallbackLog.h"
+#include "ErrorLog.h"
+#include "HostProcess.h"
+#include "Preloader.h"
 #include "StringUtil.h"
+#include "TickMonitor.h"
+#include "Watchdog.h"
+#include "platforms.h"
+#if SAMPSHARP_WINDOWS
+#include <windows.h>
+#include <psapi.h>
+#pragma comment(lib, "psapi.lib")
+#elif SAMPSHARP_LINUX
+#include <stdio.h>
+#include <unistd.h>
+#endif
 
 
 extern void *pAMXFunctions;
@@ -37,17 +54,72 @@ bool initial_load = false;
 bool plugin_initialized = false;
 int run_signal = 0;
 AMX *signal_amx;
+/* True if the game mode runs in a host process started by this plugin. */
+bool split_mode = false;
+/* True if this plugin runs in a host process on behalf of a server. */
+bool hosted = false;
+
+/* Gets the resident memory of the server process in kilobytes. */
+unsigned long getResidentMemory() {
+#if SAMPSHARP_WINDOWS
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters,
+        sizeof(counters))) {
+        return 0;
+    }
+
+    return (unsigned long)(counters.WorkingSetSize / 1024);
+#elif SAMPSHARP_LINUX
+    unsigned long size, resident = 0;
+
+    FILE *statm = fopen("/proc/self/statm", "r");
+    if (!statm) {
+        return 0;
+    }
+    if (fscanf(statm, "%lu %lu", &size, &resident) != 2) {
+        resident = 0;
+    }
+    fclose(statm);
+
+    return resident * (sysconf(_SC_PAGESIZE) / 1024);
+#endif
+}
+
+bool isGamemodeLoaded() {
+    return split_mode ? HostProcess::IsRunning() : GameMode::IsLoaded();
+}
+
+void processPublicCall(AMX *amx, const char *name, cell *params,
+    cell *retval) {
+    TickMonitor::Clock::time_point start = TickMonitor::Begin();
+
+    if (split_mode) {
+        HostProcess::ProcessPublicCall(amx, name, params, retval);
+    }
+    else if (GameMode::IsLoaded()) {
+        GameMode::ProcessPublicCall(amx, name, params, retval);
+    }
+
+    TickMonitor::End(TickMonitor::Callback, name, 0, start);
+}
 
 void loadGamemode() {
-    if (GameMode::IsLoaded()) return;
+    if (isGamemodeLoaded()) return;
 
-    // Load empty filterscript.
-    if (!filterscript_loaded) {
+    // Load empty filterscript. The server has done so already if this plugin
+    // runs in a host process.
+    if (!filterscript_loaded && !hosted) {
         SendRconCommand("loadfs empty");
         filterscript_loaded = true;
     }
 
-    // Load mono.
+    if (split_mode) {
+        HostProcess::Start(Config::GetSplitHost());
+        return;
+    }
+
+    // Load mono, unless the preloader has done so.
+    Preloader::Wait();
     if (!MonoRuntime::IsLoaded()) {
         MonoRuntime::Load(Config::GetMonoAssemblyDir(),
             Config::GetMonoConfigDir(), Config::GetTraceLevel(),
@@ -74,7 +146,12 @@ void loadGamemode() {
 }
 
 void unloadGamemode() {
-    if (!GameMode::IsLoaded()) return;
+    if (!isGamemodeLoaded()) return;
+
+    if (split_mode) {
+        HostProcess::Stop();
+        return;
+    }
 
     string namespase = Config::GetGameModeNameSpace();
     string klass = Config::GetGameModeClass();
@@ -90,15 +167,16 @@ void unloadGamemode() {
 }
 
 bool HandleRconCommands(AMX *amx, cell *params, cell *retval) {
-    // Disable signal rcon commands for now.
-    return true;
-
-    // The plugin handles two RCON commands:
+    // The plugin handles four RCON commands:
     // sampsharpstop
     // sampsharpstart
+    // sampsharpreload
+    // sampsharpticks
     //
-    // These commands can be used to unload a SampSharp game mode, replace the
-    // DLL file and reloading the newly updated game mode.
+    // The first three commands can be used to unload a SampSharp game mode,
+    // replace the DLL file and reloading the newly updated game mode. The
+    // signals are processed during the next server tick. sampsharpticks
+    // prints the histogram of recent tick durations.
 
     char buf[64];
     cell* addr;
@@ -106,7 +184,7 @@ bool HandleRconCommands(AMX *amx, cell *params, cell *retval) {
     amx_GetString(buf, addr, 0, 64);
 
     if (!strcmp(buf, "sampsharpstop")) {
-        if (!GameMode::IsLoaded()) {
+        if (!isGamemodeLoaded()) {
             logprintf("A gamemode must be loaded in order to stop.");
             return false;
         }
@@ -122,7 +200,7 @@ bool HandleRconCommands(AMX *amx, cell *params, cell *retval) {
             logprintf("OnGameModeInit needs to be called first.");
             return false;
         }
-        if (GameMode::IsLoaded()) {
+        if (isGamemodeLoaded()) {
             logprintf("You need to stop the gamemode before you can start it.");
             return false;
         }
@@ -133,6 +211,23 @@ bool HandleRconCommands(AMX *amx, cell *params, cell *retval) {
 
         return false;
     }
+    if (!strcmp(buf, "sampsharpreload")) {
+        if (!isGamemodeLoaded()) {
+            logprintf("A gamemode must be loaded in order to reload.");
+            return false;
+        }
+
+        logprintf("Reloading SampSharp...");
+        run_signal = 2;
+        signal_amx = amx;
+
+        return false;
+    }
+    if (!strcmp(buf, "sampsharpticks")) {
+        TickMonitor::PrintHistogram();
+
+        return false;
+    }
 
     return true;
 }
@@ -143,8 +238,9 @@ void ProcessSignals() {
         cell noParams[1];
         noParams[0] = 0;
         cell unhandledRetval;
+        unsigned long memory = getResidentMemory();
 
-        GameMode::ProcessPublicCall(signal_amx, "OnGameModeExit", noParams,
+        processPublicCall(signal_amx, "OnGameModeExit", noParams,
             &unhandledRetval);
 
         unloadGamemode();
@@ -152,7 +248,40 @@ void ProcessSignals() {
         logprintf("");
         logprintf("=================================");
         logprintf("> SampSharp gamemode has stopped!");
-        logprintf("> Replace your gamemode files and run `sampsharp start`");
+        logprintf("> Resident memory: %lu KB -> %lu KB", memory,
+            getResidentMemory());
+        logprintf("> Replace your gamemode files and run `sampsharpstart`");
+        logprintf("=================================");
+        logprintf("");
+
+        run_signal = 0;
+    }
+    else if (run_signal == 2) {
+        cell noParams[1];
+        noParams[0] = 0;
+        cell unhandledRetval;
+        unsigned long memory = getResidentMemory();
+        std::chrono::steady_clock::time_point start =
+            std::chrono::steady_clock::now();
+
+        processPublicCall(signal_amx, "OnGameModeExit", noParams,
+            &unhandledRetval);
+
+        unloadGamemode();
+        unsigned long unloadedMemory = getResidentMemory();
+
+        loadGamemode();
+
+        processPublicCall(signal_amx, "OnGameModeInit", noParams,
+            &unhandledRetval);
+
+        logprintf("");
+        logprintf("=================================");
+        logprintf("> SampSharp gamemode has been reloaded in %ld ms!",
+            (long)std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start).count());
+        logprintf("> Resident memory: %lu KB -> %lu KB (unloaded: %lu KB)",
+            memory, getResidentMemory(), unloadedMemory);
         logprintf("=================================");
         logprintf("");
 
@@ -165,7 +294,7 @@ void ProcessSignals() {
         noParams[0] = 0;
         cell unhandledRetval;
 
-        GameMode::ProcessPublicCall(signal_amx, "OnGameModeInit", noParams,
+        processPublicCall(signal_amx, "OnGameModeInit", noParams,
             &unhandledRetval);
 
         run_signal = 0;
@@ -226,22 +355,71 @@ PLUGIN_EXPORT bool PLUGIN_CALL Load(void **ppData) {
 
     Config::Read();
 
+    ErrorLog::Start();
+
+    string slow_tick_threshold = Config::GetSlowTickThreshold();
+    TickMonitor::SetThreshold(slow_tick_threshold.length() > 0
+        ? atoi(slow_tick_threshold.c_str())
+        : TICK_MONITOR_DEFAULT_THRESHOLD);
+
+    // Callbacks are recorded by the host process in split mode.
+    hosted = Config::GetEnv(IPC_CHANNEL_ENV).length() > 0;
+    split_mode = !hosted && Config::GetSplitHost().length() > 0;
+    if (split_mode) {
+        HostProcess::SetSynchronousCallbacks(Config::GetSplitSyncCallbacks());
+        HostProcess::SetCachedCallbacks(Config::GetSplitCachedCallbacks());
+        logprintf("Running the game mode in host process %s.",
+            Config::GetSplitHost().c_str());
+        logprintf("");
+    }
+
+    string record_file = Config::GetRecordFile();
+    if (record_file.length() > 0 && !split_mode) {
+        CallbackLog::Open(record_file);
+    }
+
+    // Load the runtime and the game mode while the server loads the rest.
+    if (Config::GetPreload().compare("1") == 0 && !split_mode) {
+        Preloader::Start();
+    }
+
     plugin_initialized = true;
     return true;
 }
 
 PLUGIN_EXPORT void PLUGIN_CALL Unload() {
+    Preloader::Wait();
     if (plugin_initialized) {
+        HostProcess::Stop();
         GameMode::Unload();
     }
+    // The watchdog keeps running if the game mode failed to load.
+    Watchdog::Stop();
+    CallbackLog::Close();
+    ErrorLog::Stop();
     sampgdk::Unload();
 }
 
 PLUGIN_EXPORT void PLUGIN_CALL ProcessTick() {
     if (plugin_initialized) {
-        GameMode::ProcessTick();
+        TickMonitor::Clock::time_point start = TickMonitor::Begin();
+        if (split_mode) {
+            HostProcess::ProcessTick();
+        }
+        else {
+            GameMode::ProcessTick();
+        }
+        TickMonitor::End(TickMonitor::Phase, "OnTick", 0, start);
+
+        start = TickMonitor::Begin();
         sampgdk::ProcessTick();
+        TickMonitor::End(TickMonitor::Phase, "timers", 0, start);
+
+        start = TickMonitor::Begin();
         ProcessSignals();
+        TickMonitor::End(TickMonitor::Phase, "signals", 0, start);
+
+        TickMonitor::EndTick();
     }
 }
 
@@ -270,16 +448,15 @@ PLUGIN_EXPORT bool PLUGIN_CALL OnPublicCall(AMX *amx, const char *name,
     // If a SampSharp game mode has been loaded and the game mode exit callback
     // has been received, pass it trough to the SampSharp game mode before
     // unloading the game mode instance.
-    else if (GameMode::IsLoaded() && !strcmp(name, "OnGameModeExit")) {
+    else if (isGamemodeLoaded() && !strcmp(name, "OnGameModeExit")) {
         // Process call before actually unloading the gamemode.
-        GameMode::ProcessPublicCall(amx, name, params, retval);
+        processPublicCall(amx, name, params, retval);
 
         unloadGamemode();
         return true;
     }
 
-    if (GameMode::IsLoaded())
-        GameMode::ProcessPublicCall(amx, name, params, retval);
+    processPublicCall(amx, name, params, retval);
 
     return true;
 }
@@ -0,0 +1,545 @@
+// SampSharp
+// Copyright 2017 Tim Potze
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "AmxEnvironment.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+#define STKMARGIN                           ((cell)(16 * sizeof(cell)))
+
+std::vector<cell> AmxEnvironment::amxData_;
+AmxEnvironment::NativeList AmxEnvironment::natives_;
+void *AmxEnvironment::amxExports_[PLUGIN_AMX_EXPORT_UTF8Put + 1];
+void *AmxEnvironment::pluginData_[256];
+AMX AmxEnvironment::amx_;
+AMX_HEADER AmxEnvironment::amxHeader_;
+AMX_NATIVE AmxEnvironment::stubs_[MAX_HOST_NATIVES];
+int AmxEnvironment::players_;
+AmxEnvironment::NativeHandler AmxEnvironment::nativeHandler_;
+AmxEnvironment::LogHandler AmxEnvironment::logHandler_;
+
+/* Fills a table with a distinct native function for every scripted native
+ * slot. Natives receive no context other than the AMX and the parameters, so
+ * each slot needs its own entry point. The range is split in halves to keep
+ * the template recursion shallow. */
+template<int Begin, int Count> struct NativeStubTable {
+    static void Fill(AMX_NATIVE *table) {
+        NativeStubTable<Begin, Count / 2>::Fill(table);
+        NativeStubTable<Begin + Count / 2, Count - Count / 2>::Fill(table);
+    }
+};
+
+template<int Begin> struct NativeStubTable<Begin, 1> {
+    static void Fill(AMX_NATIVE *table) {
+        table[Begin] = &AmxEnvironment::NativeStub<Begin>;
+    }
+};
+
+template<int Begin> struct NativeStubTable<Begin, 0> {
+    static void Fill(AMX_NATIVE *table) {
+    }
+};
+
+void AmxEnvironment::Initialize(int players) {
+    players_ = players;
+
+    NativeStubTable<0, MAX_HOST_NATIVES>::Fill(stubs_);
+
+    for (int i = 0; i <= PLUGIN_AMX_EXPORT_UTF8Put; i++) {
+        amxExports_[i] = (void *)Unsupported;
+    }
+
+    amxExports_[PLUGIN_AMX_EXPORT_Allot] = (void *)Allot;
+    amxExports_[PLUGIN_AMX_EXPORT_Exec] = (void *)Exec;
+    amxExports_[PLUGIN_AMX_EXPORT_FindNative] = (void *)FindNative;
+    amxExports_[PLUGIN_AMX_EXPORT_FindPublic] = (void *)FindPublic;
+    amxExports_[PLUGIN_AMX_EXPORT_GetAddr] = (void *)GetAddr;
+    amxExports_[PLUGIN_AMX_EXPORT_GetString] = (void *)GetString;
+    amxExports_[PLUGIN_AMX_EXPORT_NumNatives] = (void *)NumEntries;
+    amxExports_[PLUGIN_AMX_EXPORT_NumPublics] = (void *)NumEntries;
+    amxExports_[PLUGIN_AMX_EXPORT_NumPubVars] = (void *)NumEntries;
+    amxExports_[PLUGIN_AMX_EXPORT_NumTags] = (void *)NumEntries;
+    amxExports_[PLUGIN_AMX_EXPORT_Push] = (void *)Push;
+    amxExports_[PLUGIN_AMX_EXPORT_PushString] = (void *)PushAmxString;
+    amxExports_[PLUGIN_AMX_EXPORT_RaiseError] = (void *)RaiseError;
+    amxExports_[PLUGIN_AMX_EXPORT_Register] = (void *)Register;
+    amxExports_[PLUGIN_AMX_EXPORT_Release] = (void *)Release;
+    amxExports_[PLUGIN_AMX_EXPORT_SetString] = (void *)SetString;
+    amxExports_[PLUGIN_AMX_EXPORT_StrLen] = (void *)StrLen;
+
+    pluginData_[PLUGIN_DATA_LOGPRINTF] = (void *)Log;
+    pluginData_[PLUGIN_DATA_AMX_EXPORTS] = amxExports_;
+    pluginData_[PLUGIN_DATA_CALLPUBLIC_FS] = (void *)CallPublic;
+    pluginData_[PLUGIN_DATA_CALLPUBLIC_GM] = (void *)CallPublic;
+
+    // The game mode AMX has no code, publics or natives; only a data section
+    // which is used as heap for string and array arguments.
+    amxData_.assign(HOST_AMX_DATA_SIZE / sizeof(cell), 0);
+
+    memset(&amxHeader_, 0, sizeof(amxHeader_));
+    amxHeader_.magic = AMX_MAGIC;
+    amxHeader_.file_version = MIN_FILE_VERSION;
+    amxHeader_.amx_version = MIN_AMX_VERSION;
+    amxHeader_.defsize = sizeof(AMX_FUNCSTUBNT);
+    amxHeader_.publics = sizeof(AMX_HEADER);
+    amxHeader_.natives = sizeof(AMX_HEADER);
+    amxHeader_.libraries = sizeof(AMX_HEADER);
+    amxHeader_.pubvars = sizeof(AMX_HEADER);
+    amxHeader_.tags = sizeof(AMX_HEADER);
+    amxHeader_.nametable = sizeof(AMX_HEADER);
+    amxHeader_.size = sizeof(AMX_HEADER);
+
+    memset(&amx_, 0, sizeof(amx_));
+    amx_.base = (unsigned char *)&amxHeader_;
+    amx_.data = (unsigned char *)&amxData_[0];
+    amx_.stp = HOST_AMX_DATA_SIZE;
+    amx_.stk = amx_.stp;
+    amx_.hea = 0;
+    amx_.hlw = 0;
+    amx_.flags = AMX_FLAG_NTVREG | AMX_FLAG_RELOC;
+
+    NativeScript native;
+    native.ref_count = 0;
+    native.return_index = 0;
+    native.calls = 0;
+    native.check_player = false;
+
+    // Natives the plugin relies on during boot and while capturing player
+    // snapshots.
+    native.name = "SendRconCommand";
+    native.retval = 1;
+    SetNative(native);
+
+    native.name = "GetMaxPlayers";
+    native.retval = players;
+    SetNative(native);
+
+    native.name = "GetPlayerPoolSize";
+    native.retval = players - 1;
+    SetNative(native);
+
+    native.name = "IsPlayerConnected";
+    native.retval = 1;
+    native.check_player = true;
+    SetNative(native);
+
+    native.name = "IsPlayerNPC";
+    native.retval = 0;
+    native.check_player = false;
+    SetNative(native);
+}
+
+void **AmxEnvironment::GetPluginData() {
+    return pluginData_;
+}
+
+bool AmxEnvironment::SetNative(const NativeScript &native) {
+    for (NativeList::iterator iter = natives_.begin(); iter != natives_.end();
+        iter++) {
+        if (iter->name == native.name) {
+            *iter = native;
+            return true;
+        }
+    }
+
+    if (natives_.size() >= MAX_HOST_NATIVES) {
+        Log("ERROR: Too many scripted natives (max %d).", MAX_HOST_NATIVES);
+        return false;
+    }
+
+    natives_.push_back(native);
+    return true;
+}
+
+void AmxEnvironment::RegisterNatives() {
+    std::vector<AMX_NATIVE_INFO> list;
+
+    for (size_t i = 0; i < natives_.size(); i++) {
+        AMX_NATIVE_INFO info;
+        info.name = natives_[i].name.c_str();
+        info.func = stubs_[i];
+        list.push_back(info);
+    }
+
+    AMX_NATIVE_INFO terminator = { NULL, NULL };
+    list.push_back(terminator);
+
+    // Call trough the export table; plugins hook amx_Register to find out
+    // which natives exist.
+    typedef int (AMXAPI *RegisterFunc)(AMX *, const AMX_NATIVE_INFO *, int);
+    ((RegisterFunc)amxExports_[PLUGIN_AMX_EXPORT_Register])(&amx_, &list[0],
+        -1);
+}
+
+cell AmxEnvironment::PushString(const char *value) {
+    cell amx_addr;
+    cell *phys_addr;
+
+    if (PushAmxString(&amx_, &amx_addr, &phys_addr, value, 0, 0) !=
+        AMX_ERR_NONE) {
+        Log("ERROR: Game mode AMX heap exhausted.");
+        return 0;
+    }
+
+    return amx_addr;
+}
+
+cell AmxEnvironment::PushArray(const cell *values, int length) {
+    cell amx_addr;
+    cell *phys_addr;
+
+    if (Allot(&amx_, length > 0 ? length : 1, &amx_addr, &phys_addr) !=
+        AMX_ERR_NONE) {
+        Log("ERROR: Game mode AMX heap exhausted.");
+        return 0;
+    }
+
+    if (length > 0) {
+        memcpy(phys_addr, values, length * sizeof(cell));
+    }
+
+    return amx_addr;
+}
+
+void AmxEnvironment::ReleaseHeap() {
+    amx_.hea = amx_.hlw;
+}
+
+bool AmxEnvironment::MirrorHeap(cell address, const void *data, cell size) {
+    if (address < 0 || size < 0 ||
+        amx_.stk < address + size + STKMARGIN) {
+        Log("ERROR: Game mode AMX heap exhausted.");
+        return false;
+    }
+
+    if (size > 0) {
+        memcpy(amx_.data + address, data, size);
+    }
+    amx_.hea = address + size;
+    return true;
+}
+
+void AmxEnvironment::Log(const char *format, ...) {
+    va_list args;
+    va_start(args, format);
+
+    if (logHandler_) {
+        char message[1024];
+        vsnprintf(message, sizeof(message), format, args);
+        va_end(args);
+
+        logHandler_(message);
+        return;
+    }
+
+    vprintf(format, args);
+    va_end(args);
+
+    printf("\n");
+}
+
+cell AmxEnvironment::InvokeNative(int index, AMX *amx, cell *params) {
+    NativeScript &native = natives_[index];
+    native.calls++;
+
+    cell retval;
+    if (nativeHandler_ && nativeHandler_(index, amx, params, &retval)) {
+        return retval;
+    }
+
+    int param_count = params[0] / sizeof(cell);
+
+    for (int i = 0; i < native.ref_count; i++) {
+        NativeRef &ref = native.refs[i];
+        cell *addr;
+
+        if (ref.param < 1 || ref.param > param_count ||
+            GetAddr(amx, params[ref.param], &addr) != AMX_ERR_NONE) {
+            continue;
+        }
+
+        *addr = ref.value;
+    }
+
+    if (native.return_index < native.returns.size()) {
+        size_t call = native.return_index++;
+
+        if (call < native.outputs.size()) {
+            const std::vector<NativeOutput> &outputs = native.outputs[call];
+
+            for (size_t i = 0; i < outputs.size(); i++) {
+                const NativeOutput &output = outputs[i];
+                cell *addr;
+
+                if (output.param < 1 || output.param > param_count ||
+                    output.cells.empty() || GetAddr(amx,
+                    params[output.param], &addr) != AMX_ERR_NONE) {
+                    continue;
+                }
+
+                memcpy(addr, &output.cells[0],
+                    output.cells.size() * sizeof(cell));
+            }
+        }
+
+        return native.returns[call];
+    }
+
+    if (native.check_player) {
+        return param_count > 0 && params[1] >= 0 && params[1] < players_
+            ? native.retval
+            : 0;
+    }
+
+    return native.retval;
+}
+
+int AMXAPI AmxEnvironment::Allot(AMX *amx, int cells, cell *amx_addr,
+    cell **phys_addr) {
+    unsigned char *data = amx->data
+        ? amx->data
+        : amx->base + ((AMX_HEADER *)amx->base)->dat;
+
+    if (amx->stk < (cell)(amx->hea + cells * sizeof(cell) + STKMARGIN)) {
+        return AMX_ERR_MEMORY;
+    }
+
+    *amx_addr = amx->hea;
+    *phys_addr = (cell *)(data + amx->hea);
+    amx->hea += cells * sizeof(cell);
+
+    return AMX_ERR_NONE;
+}
+
+int AMXAPI AmxEnvironment::Release(AMX *amx, cell amx_addr) {
+    if (amx->hea > amx_addr) {
+        amx->hea = amx_addr;
+    }
+
+    return AMX_ERR_NONE;
+}
+
+int AMXAPI AmxEnvironment::Exec(AMX *amx, cell *retval, int index) {
+    // There's no code to execute; pop whatever was pushed for the call.
+    amx->stk += amx->paramcount * sizeof(cell);
+    amx->paramcount = 0;
+
+    if (retval) {
+        *retval = 0;
+    }
+
+    return index == AMX_EXEC_MAIN ? AMX_ERR_NONE : AMX_ERR_INDEX;
+}
+
+int AMXAPI AmxEnvironment::FindNative(AMX *amx, const char *name,
+    int *index) {
+    for (size_t i = 0; i < natives_.size(); i++) {
+        if (amx == &amx_ && natives_[i].name == name) {
+            *index = (int)i;
+            return AMX_ERR_NONE;
+        }
+    }
+
+    *index = 0x7fffffff;
+    return AMX_ERR_NOTFOUND;
+}
+
+int AMXAPI AmxEnvironment::FindPublic(AMX *amx, const char *name,
+    int *index) {
+    // The emulated game mode has no publics. Plugins which forge publics
+    // (such as sampgdk) take over from here.
+    *index = 0x7fffffff;
+
+    if (!amx || !name || !*name) {
+        return AMX_ERR_PARAMS;
+    }
+
+    return AMX_ERR_NOTFOUND;
+}
+
+int AMXAPI AmxEnvironment::GetAddr(AMX *amx, cell amx_addr,
+    cell **phys_addr) {
+    unsigned char *data = amx->data
+        ? amx->data
+        : amx->base + ((AMX_HEADER *)amx->base)->dat;
+
+    if ((amx_addr >= amx->hea && amx_addr < amx->stk) || amx_addr < 0 ||
+        amx_addr >= amx->stp) {
+        *phys_addr = NULL;
+        return AMX_ERR_MEMACCESS;
+    }
+
+    *phys_addr = (cell *)(data + amx_addr);
+    return AMX_ERR_NONE;
+}
+
+int AMXAPI AmxEnvironment::GetString(char *dest, const cell *source,
+    int use_wchar, size_t size) {
+    size_t i = 0;
+
+    if ((ucell)*source > UNPACKEDMAX) {
+        // Packed string; characters are stored big endian within the cells.
+        for (;;) {
+            cell c = source[i / sizeof(cell)];
+            char ch = (char)(c >> ((sizeof(cell) - 1 - (i % sizeof(cell))) * 8));
+
+            if (ch == '\0' || i + 1 >= size) {
+                break;
+            }
+            dest[i++] = ch;
+        }
+    }
+    else {
+        for (; source[i] != 0 && i + 1 < size; i++) {
+            dest[i] = (char)source[i];
+        }
+    }
+
+    if (size > 0) {
+        dest[i] = '\0';
+    }
+
+    return AMX_ERR_NONE;
+}
+
+int AMXAPI AmxEnvironment::SetString(cell *dest, const char *source, int pack,
+    int use_wchar, size_t size) {
+    size_t len = strlen(source);
+
+    if (size == 0) {
+        return AMX_ERR_NONE;
+    }
+
+    if (len >= size) {
+        len = size - 1;
+    }
+
+    if (pack) {
+        memset(dest, 0, ((len + sizeof(cell)) / sizeof(cell)) * sizeof(cell));
+
+        for (size_t i = 0; i < len; i++) {
+            dest[i / sizeof(cell)] |= (cell)(unsigned char)source[i] <<
+                ((sizeof(cell) - 1 - (i % sizeof(cell))) * 8);
+        }
+    }
+    else {
+        for (size_t i = 0; i < len; i++) {
+            dest[i] = (cell)(unsigned char)source[i];
+        }
+        dest[len] = 0;
+    }
+
+    return AMX_ERR_NONE;
+}
+
+int AMXAPI AmxEnvironment::StrLen(const cell *cstring, int *length) {
+    int len = 0;
+
+    if ((ucell)*cstring > UNPACKEDMAX) {
+        for (;;) {
+            cell c = cstring[len / sizeof(cell)];
+            if (((c >> ((sizeof(cell) - 1 - (len % sizeof(cell))) * 8)) &
+                0xff) == 0) {
+                break;
+            }
+            len++;
+        }
+    }
+    else {
+        while (cstring[len] != 0) {
+            len++;
+        }
+    }
+
+    *length = len;
+    return AMX_ERR_NONE;
+}
+
+int AMXAPI AmxEnvironment::Push(AMX *amx, cell value) {
+    unsigned char *data = amx->data
+        ? amx->data
+        : amx->base + ((AMX_HEADER *)amx->base)->dat;
+
+    if (amx->hea + STKMARGIN > amx->stk) {
+        return AMX_ERR_STACKERR;
+    }
+
+    amx->stk -= sizeof(cell);
+    amx->paramcount++;
+    *(cell *)(data + amx->stk) = value;
+
+    return AMX_ERR_NONE;
+}
+
+int AMXAPI AmxEnvironment::PushAmxString(AMX *amx, cell *amx_addr,
+    cell **phys_addr, const char *string, int pack, int use_wchar) {
+    int cells = pack
+        ? (int)((strlen(string) + sizeof(cell)) / sizeof(cell))
+        : (int)strlen(string) + 1;
+
+    cell addr;
+    cell *phys;
+    int error = Allot(amx, cells, &addr, &phys);
+
+    if (error != AMX_ERR_NONE) {
+        return error;
+    }
+
+    SetString(phys, string, pack, use_wchar, cells * sizeof(cell));
+
+    if (amx_addr) {
+        *amx_addr = addr;
+    }
+    if (phys_addr) {
+        *phys_addr = phys;
+    }
+
+    return amx == &amx_ ? AMX_ERR_NONE : Push(amx, addr);
+}
+
+int AMXAPI AmxEnvironment::Register(AMX *amx, const AMX_NATIVE_INFO *nativelist,
+    int number) {
+    int count = 0;
+
+    for (int i = 0; nativelist[i].name != NULL && (i < number || number == -1);
+        i++) {
+        count++;
+    }
+
+    Log("Registered %d natives.", count);
+    return AMX_ERR_NONE;
+}
+
+int AMXAPI AmxEnvironment::RaiseError(AMX *amx, int error) {
+    if (error != AMX_ERR_NONE) {
+        amx->error = error;
+    }
+
+    return AMX_ERR_NONE;
+}
+
+int AMXAPI AmxEnvironment::NumEntries(AMX *amx, int *number) {
+    *number = 0;
+    return AMX_ERR_NONE;
+}
+
+int AMXAPI AmxEnvironment::Unsupported() {
+    return AMX_ERR_NOTFOUND;
+}
+
+int AmxEnvironment::CallPublic(char *name) {
+    return 0;
+}
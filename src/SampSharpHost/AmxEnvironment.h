@@ -0,0 +1,148 @@
+// SampSharp
+// Copyright 2017 Tim Potze
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string>
+#include <vector>
+#include <sdk/plugin.h>
+
+#pragma once
+
+#define MAX_HOST_NATIVES                    (2048)
+#define MAX_HOST_NATIVE_REFS                (8)
+#define HOST_AMX_DATA_SIZE                  (256 * 1024)
+
+/* Emulates the parts of the SA-MP server's AMX environment a plugin relies on:
+ * the AMX export table, the game mode AMX instance and a table of natives
+ * whose behaviour is defined by a scenario script. */
+class AmxEnvironment {
+public:
+    /* Represents a reference parameter a scripted native writes to. */
+    struct NativeRef {
+        int param;
+        cell value;
+    };
+    /* Represents the values a call to a native wrote to a reference
+     * parameter. */
+    struct NativeOutput {
+        int param;
+        std::vector<cell> cells;
+    };
+    /* Represents the scripted behaviour of a native. */
+    struct NativeScript {
+        std::string name;
+        cell retval;
+        NativeRef refs[MAX_HOST_NATIVE_REFS];
+        int ref_count;
+        /* If true, retval is only returned if the first parameter is the id
+         * of a connected player; 0 is returned otherwise. */
+        bool check_player;
+        /* If not empty, these values are returned in order instead of retval
+         * until the list is exhausted. Used to replay recorded traffic. */
+        std::vector<cell> returns;
+        /* The values to write to the reference parameters with each value in
+         * returns. May be shorter than returns. */
+        std::vector<std::vector<NativeOutput> > outputs;
+        size_t return_index;
+        unsigned long calls;
+    };
+    /* Holds a collection of scripted natives. */
+    typedef std::vector<NativeScript> NativeList;
+    /* Handles a call to the native at the specified index instead of its
+     * script. Returns false to fall back to the script. */
+    typedef bool (*NativeHandler)(int index, AMX *amx, cell *params,
+        cell *retval);
+    /* Handles a formatted log message instead of printing it. */
+    typedef void (*LogHandler)(const char *message);
+
+    /* Initializes the export table and the game mode AMX. */
+    static void Initialize(int players);
+    /* Gets the plugin data array to pass to a plugin's Load export. */
+    static void **GetPluginData();
+    /* Gets the game mode AMX instance. */
+    static AMX *GetAmx() {
+        return &amx_;
+    }
+    /* Adds or replaces the behaviour of the native with the specified name. */
+    static bool SetNative(const NativeScript &native);
+    /* Registers all scripted natives with the game mode AMX. Plugins hooking
+     * amx_Register pick up the natives at this point. */
+    static void RegisterNatives();
+    /* Gets the scripted natives. */
+    static const NativeList &GetNatives() {
+        return natives_;
+    }
+    /* Pushes a string onto the heap of the game mode AMX and returns its
+     * address. */
+    static cell PushString(const char *value);
+    /* Pushes an array onto the heap of the game mode AMX and returns its
+     * address. */
+    static cell PushArray(const cell *values, int length);
+    /* Releases all heap space allocated since the last call. */
+    static void ReleaseHeap();
+    /* Copies a heap to the specified address of the game mode AMX and moves
+     * the top of the heap past it. */
+    static bool MirrorHeap(cell address, const void *data, cell size);
+    /* Prints a formatted message to the console. */
+    static void Log(const char *format, ...);
+    /* Sets the handler of native calls, or NULL to run scripts. */
+    static void SetNativeHandler(NativeHandler handler) {
+        nativeHandler_ = handler;
+    }
+    /* Sets the handler of log messages, or NULL to print them. */
+    static void SetLogHandler(LogHandler handler) {
+        logHandler_ = handler;
+    }
+
+private:
+    static cell InvokeNative(int index, AMX *amx, cell *params);
+    template<int N> static cell AMX_NATIVE_CALL NativeStub(AMX *amx,
+        cell *params) {
+        return InvokeNative(N, amx, params);
+    }
+    template<int Begin, int Count> friend struct NativeStubTable;
+
+    static int AMXAPI Allot(AMX *amx, int cells, cell *amx_addr,
+        cell **phys_addr);
+    static int AMXAPI Release(AMX *amx, cell amx_addr);
+    static int AMXAPI Exec(AMX *amx, cell *retval, int index);
+    static int AMXAPI FindNative(AMX *amx, const char *name, int *index);
+    static int AMXAPI FindPublic(AMX *amx, const char *name, int *index);
+    static int AMXAPI GetAddr(AMX *amx, cell amx_addr, cell **phys_addr);
+    static int AMXAPI GetString(char *dest, const cell *source, int use_wchar,
+        size_t size);
+    static int AMXAPI SetString(cell *dest, const char *source, int pack,
+        int use_wchar, size_t size);
+    static int AMXAPI StrLen(const cell *cstring, int *length);
+    static int AMXAPI Push(AMX *amx, cell value);
+    static int AMXAPI PushAmxString(AMX *amx, cell *amx_addr, cell **phys_addr,
+        const char *string, int pack, int use_wchar);
+    static int AMXAPI Register(AMX *amx, const AMX_NATIVE_INFO *nativelist,
+        int number);
+    static int AMXAPI RaiseError(AMX *amx, int error);
+    static int AMXAPI NumEntries(AMX *amx, int *number);
+    static int AMXAPI Unsupported();
+    static int CallPublic(char *name);
+
+    static void *amxExports_[PLUGIN_AMX_EXPORT_UTF8Put + 1];
+    static void *pluginData_[256];
+    static AMX amx_;
+    static AMX_HEADER amxHeader_;
+    static std::vector<cell> amxData_;
+    static NativeList natives_;
+    static AMX_NATIVE stubs_[MAX_HOST_NATIVES];
+    static int players_;
+    static NativeHandler nativeHandler_;
+    static LogHandler logHandler_;
+};
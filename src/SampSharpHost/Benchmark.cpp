@@ -0,0 +1,258 @@
+// SampSharp
+// Copyright 2017 Tim Potze
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "Benchmark.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fstream>
+#include <sstream>
+#include "../SampSharp/platforms.h"
+#include "AmxEnvironment.h"
+#if SAMPSHARP_WINDOWS
+#include <windows.h>
+#define popen _popen
+#define pclose _pclose
+#elif SAMPSHARP_LINUX
+#include <unistd.h>
+#endif
+
+using std::string;
+using std::vector;
+
+bool Benchmark::Load(const string &path) {
+    std::ifstream file(path.c_str());
+
+    if (!file) {
+        AmxEnvironment::Log("ERROR: Could not open configurations %s.",
+            path.c_str());
+        return false;
+    }
+
+    string line;
+    for (int line_number = 1; std::getline(file, line); line_number++) {
+        std::istringstream tokens(line);
+        Configuration configuration;
+
+        if (!(tokens >> configuration.name) || configuration.name[0] == '#') {
+            continue;
+        }
+
+        string token;
+        while (tokens >> token) {
+            size_t separator = token.find('=');
+            if (separator == string::npos || separator == 0) {
+                AmxEnvironment::Log("ERROR: Invalid option '%s' on line %d.",
+                    token.c_str(), line_number);
+                return false;
+            }
+
+            Setting setting;
+            setting.name = token.substr(0, separator);
+            setting.value = token.substr(separator + 1);
+            configuration.settings.push_back(setting);
+        }
+
+        configurations_.push_back(configuration);
+    }
+
+    if (configurations_.empty()) {
+        AmxEnvironment::Log("ERROR: No configurations in %s.", path.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+bool Benchmark::Run(const string &host, const string &plugin,
+    const string &scenario) {
+    string command = "\"" + host + "\" -p \"" + plugin + "\" \"" + scenario +
+        "\"";
+#if SAMPSHARP_LINUX
+    command.append(" 2>&1");
+#endif
+
+    bool completed = true;
+    vector<Result> results;
+
+    for (size_t i = 0; i < configurations_.size(); i++) {
+        AmxEnvironment::Log("");
+        AmxEnvironment::Log("=========");
+        AmxEnvironment::Log("%s", configurations_[i].name.c_str());
+        AmxEnvironment::Log("=========");
+
+        Result result;
+        if (!RunConfiguration(configurations_[i], command, result)) {
+            AmxEnvironment::Log("ERROR: Configuration %s failed.",
+                configurations_[i].name.c_str());
+            completed = false;
+        }
+        results.push_back(result);
+    }
+
+    PrintComparison(results);
+    return completed;
+}
+
+bool Benchmark::RunConfiguration(const Configuration &configuration,
+    const string &command, Result &result) {
+    result.completed = false;
+    result.wall = result.callbacks = result.tickAverage = result.tickP99 = 0;
+
+    for (size_t i = 0; i < configuration.settings.size(); i++) {
+        SetEnv(configuration.settings[i].name,
+            configuration.settings[i].value);
+    }
+
+    FILE *output = popen(command.c_str(), "r");
+
+    // The next configuration starts from the options in server.cfg.
+    for (size_t i = 0; i < configuration.settings.size(); i++) {
+        SetEnv(configuration.settings[i].name, "");
+    }
+
+    if (!output) {
+        return false;
+    }
+
+    char line[1024];
+    while (fgets(line, sizeof(line), output)) {
+        fputs(line, stdout);
+        ParseLine(line, result);
+    }
+    fflush(stdout);
+
+    return pclose(output) == 0 && result.completed;
+}
+
+void Benchmark::ParseLine(const char *line, Result &result) {
+    char name[64];
+    unsigned long calls;
+    double time;
+
+    if (sscanf(line, "Wall time: %lf", &result.wall) == 1) {
+        result.completed = true;
+    }
+    else if (sscanf(line, "Callbacks: %lu (%lf/s)", &calls,
+        &result.callbacks) == 2) {
+    }
+    else if (sscanf(line, "Tick avg: %lf", &result.tickAverage) == 1) {
+    }
+    else if (sscanf(line, "Tick p99: %lf", &result.tickP99) == 1) {
+    }
+    else if (sscanf(line, "%63s %lu calls %lf us/call", name, &calls,
+        &time) == 3) {
+        Stream stream;
+        stream.name = name;
+        stream.time = time;
+        result.streams.push_back(stream);
+    }
+}
+
+void Benchmark::PrintComparison(const vector<Result> &results) const {
+    AmxEnvironment::Log("");
+    AmxEnvironment::Log("Comparison");
+    AmxEnvironment::Log("---------------");
+
+    string header;
+    char cell[32];
+    for (size_t i = 0; i < configurations_.size(); i++) {
+        snprintf(cell, sizeof(cell), " %12.12s",
+            configurations_[i].name.c_str());
+        header.append(cell);
+    }
+    AmxEnvironment::Log("%-28s%s", "", header.c_str());
+
+    // Every run reports the streams of the same scenario in the same order.
+    const vector<Stream> *streams = NULL;
+    for (size_t i = 0; i < results.size() && !streams; i++) {
+        if (results[i].completed) {
+            streams = &results[i].streams;
+        }
+    }
+    if (!streams) {
+        return;
+    }
+
+    for (size_t row = 0; row < streams->size() + 3; row++) {
+        string label;
+        string values;
+
+        for (size_t i = 0; i < results.size(); i++) {
+            const Result &result = results[i];
+            double value = 0;
+
+            if (row == 0) {
+                label = "Callbacks (/s)";
+                value = result.callbacks;
+            }
+            else if (row == 1) {
+                label = "Tick avg (us)";
+                value = result.tickAverage;
+            }
+            else if (row == 2) {
+                label = "Tick p99 (us)";
+                value = result.tickP99;
+            }
+            else {
+                label = (*streams)[row - 3].name + " (us/call)";
+                if (row - 3 < result.streams.size()) {
+                    value = result.streams[row - 3].time;
+                }
+            }
+
+            if (result.completed) {
+                snprintf(cell, sizeof(cell), " %12.2f", value);
+            }
+            else {
+                snprintf(cell, sizeof(cell), " %12s", "failed");
+            }
+            values.append(cell);
+        }
+
+        AmxEnvironment::Log("%-28s%s", label.c_str(), values.c_str());
+    }
+}
+
+void Benchmark::SetEnv(const string &name, const string &value) {
+#if SAMPSHARP_WINDOWS
+    _putenv_s(name.c_str(), value.c_str());
+#elif SAMPSHARP_LINUX
+    if (value.empty()) {
+        unsetenv(name.c_str());
+    }
+    else {
+        setenv(name.c_str(), value.c_str(), 1);
+    }
+#endif
+}
+
+string Benchmark::GetExecutablePath(const char *fallback) {
+    char path[4096];
+
+#if SAMPSHARP_WINDOWS
+    DWORD length = GetModuleFileNameA(NULL, path, sizeof(path));
+    if (length > 0 && length < sizeof(path)) {
+        return string(path, length);
+    }
+#elif SAMPSHARP_LINUX
+    ssize_t length = readlink("/proc/self/exe", path, sizeof(path));
+    if (length > 0 && (size_t)length < sizeof(path)) {
+        return string(path, length);
+    }
+#endif
+
+    return fallback;
+}
@@ -0,0 +1,74 @@
+// SampSharp
+// Copyright 2017 Tim Potze
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string>
+#include <vector>
+
+#pragma once
+
+/* Runs a scenario under several JIT configurations and compares the results.
+ * Mono reads its JIT options once per process, so every configuration runs in
+ * a SampSharpHost process of its own. The options are passed in environment
+ * variables, which the plugin prefers over the values in server.cfg.
+ *
+ * Configuration files contain one configuration per line:
+ *   <name> [option=value]...
+ *
+ * The options are mono_optimize, mono_llvm and mono_simd (see server.cfg).
+ * Lines starting with # are ignored. */
+class Benchmark {
+public:
+    /* Loads the configurations from the specified file. */
+    bool Load(const std::string &path);
+    /* Runs the specified scenario under every configuration and prints a
+     * comparison. The runs use the specified host executable and plugin.
+     * Returns false if a run failed. */
+    bool Run(const std::string &host, const std::string &plugin,
+        const std::string &scenario);
+
+    /* Gets the path of the running executable, or the specified fallback if
+     * it can't be determined. */
+    static std::string GetExecutablePath(const char *fallback);
+
+private:
+    struct Setting {
+        std::string name;
+        std::string value;
+    };
+    struct Configuration {
+        std::string name;
+        std::vector<Setting> settings;
+    };
+    struct Stream {
+        std::string name;
+        double time;
+    };
+    struct Result {
+        bool completed;
+        double wall;
+        double callbacks;
+        double tickAverage;
+        double tickP99;
+        std::vector<Stream> streams;
+    };
+
+    static bool RunConfiguration(const Configuration &configuration,
+        const std::string &command, Result &result);
+    static void ParseLine(const char *line, Result &result);
+    static void SetEnv(const std::string &name, const std::string &value);
+    void PrintComparison(const std::vector<Result> &results) const;
+
+    std::vector<Configuration> configurations_;
+};
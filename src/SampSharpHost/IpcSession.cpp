@@ -0,0 +1,219 @@
+// SampSharp
+// Copyright 2017 Tim Potze
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include "IpcSession.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <map>
+#include "AmxEnvironment.h"
+
+IpcSession *IpcSession::current_;
+
+IpcSession::IpcSession() {
+}
+
+bool IpcSession::Open(const std::string &name) {
+    if (!channel_.Open(name)) {
+        AmxEnvironment::Log("ERROR: Could not open IPC channel %s.",
+            name.c_str());
+        return false;
+    }
+
+    // The plugin runs the game mode itself if it finds the channel name
+    // rather than starting another host process.
+#if SAMPSHARP_WINDOWS
+    _putenv_s(IPC_CHANNEL_ENV, name.c_str());
+#elif SAMPSHARP_LINUX
+    setenv(IPC_CHANNEL_ENV, name.c_str(), 1);
+#endif
+
+    current_ = this;
+    AmxEnvironment::SetLogHandler(ForwardLog);
+    return true;
+}
+
+bool IpcSession::ApplyNatives() {
+    uint32_t type;
+    if (!Receive(type) || type != IPC_MSG_NATIVES) {
+        AmxEnvironment::Log("ERROR: Did not receive the natives of the "
+            "server.");
+        return false;
+    }
+
+    IpcReader reader(message_);
+    uint32_t count = reader.Read<uint32_t>();
+    std::map<std::string, int> server_indices;
+
+    AmxEnvironment::NativeScript native;
+    native.retval = 0;
+    native.ref_count = 0;
+    native.check_player = false;
+    native.return_index = 0;
+    native.calls = 0;
+
+    for (uint32_t i = 0; i < count; i++) {
+        native.name = reader.ReadString();
+        server_indices[native.name] = (int)i;
+        AmxEnvironment::SetNative(native);
+    }
+
+    const AmxEnvironment::NativeList &natives = AmxEnvironment::GetNatives();
+    indices_.assign(natives.size(), -1);
+    for (size_t i = 0; i < natives.size(); i++) {
+        std::map<std::string, int>::const_iterator iter =
+            server_indices.find(natives[i].name);
+        if (iter != server_indices.end()) {
+            indices_[i] = iter->second;
+        }
+    }
+
+    AmxEnvironment::SetNativeHandler(ForwardNative);
+    return true;
+}
+
+void IpcSession::Run(PluginHost &host) {
+    uint32_t type;
+
+    while (Receive(type)) {
+        switch (type) {
+        case IPC_MSG_PUBLIC_CALL:
+            OnPublicCall(host);
+            break;
+        case IPC_MSG_TICK:
+            // Clear the flag first; the server may send the next tick while
+            // this one runs.
+            channel_.SetTickPending(false);
+            host.ProcessTick();
+            break;
+        case IPC_MSG_EXIT:
+            channel_.AddProcessed();
+            return;
+        }
+
+        channel_.AddProcessed();
+    }
+}
+
+bool IpcSession::Receive(uint32_t &type) {
+    for (unsigned int polls = 0;
+        !channel_.Read(IPC_RING_CALLS, type, message_); polls++) {
+        if (channel_.IsClosed()) {
+            return false;
+        }
+        IpcChannel::Wait(polls);
+    }
+
+    return true;
+}
+
+void IpcSession::OnPublicCall(PluginHost &host) {
+    IpcReader reader(message_);
+
+    bool returns = reader.Read<uint8_t>() != 0;
+    uint32_t id = reader.Read<uint32_t>();
+    std::string name = reader.ReadString();
+    cell retval = reader.Read<cell>();
+    cell hlw = reader.Read<cell>();
+    reader.Read<cell>();
+
+    // Arguments point into the heap of the server's AMX; a copy at the same
+    // addresses keeps them valid.
+    uint32_t heap_size = reader.Read<uint32_t>();
+    std::vector<char> heap(heap_size);
+    if (heap_size) {
+        reader.Read(&heap[0], heap_size);
+    }
+
+    uint32_t param_count = reader.Read<uint32_t>();
+    params_.assign(param_count + 1, 0);
+    params_[0] = param_count * sizeof(cell);
+    reader.Read(params_.data() + 1, param_count * sizeof(cell));
+
+    if (AmxEnvironment::MirrorHeap(hlw, heap.empty() ? NULL : &heap[0],
+        heap_size)) {
+        host.OnPublicCall(AmxEnvironment::GetAmx(), name.c_str(), &params_[0],
+            &retval);
+    }
+    AmxEnvironment::ReleaseHeap();
+
+    if (returns) {
+        writer_.Clear();
+        writer_.Write<uint32_t>(id);
+        writer_.Write<cell>(retval);
+        channel_.Write(IPC_RING_REQUESTS, IPC_MSG_PUBLIC_RETURN,
+            writer_.GetData(), writer_.GetSize());
+    }
+}
+
+bool IpcSession::ForwardNative(int index, AMX *amx, cell *params,
+    cell *retval) {
+    IpcSession &session = *current_;
+
+    if (index < 0 || index >= (int)session.indices_.size() ||
+        session.indices_[index] < 0) {
+        return false;
+    }
+
+    // Reference parameters of natives called through sampgdk point into the
+    // heap of its fake AMX, which starts at address 0.
+    unsigned char *data = amx->data
+        ? amx->data
+        : amx->base + ((AMX_HEADER *)amx->base)->dat;
+    uint32_t heap_size = amx->hea > 0 ? (uint32_t)amx->hea : 0;
+    uint32_t param_count = params[0] / sizeof(cell);
+
+    IpcWriter &writer = session.writer_;
+    writer.Clear();
+    writer.Write<uint32_t>(session.indices_[index]);
+    writer.Write<uint32_t>(param_count);
+    writer.Write(params + 1, param_count * sizeof(cell));
+    writer.Write<uint32_t>(heap_size);
+    writer.Write(data, heap_size);
+
+    *retval = 0;
+    IpcChannel &channel = session.channel_;
+    if (!channel.Write(IPC_RING_REQUESTS, IPC_MSG_NATIVE_CALL,
+        writer.GetData(), writer.GetSize())) {
+        return true;
+    }
+
+    // The server runs the native on its next tick at the latest.
+    uint32_t type;
+    std::vector<char> &reply = session.reply_;
+    for (unsigned int polls = 0;
+        !channel.Read(IPC_RING_REPLIES, type, reply); polls++) {
+        if (channel.IsClosed()) {
+            return true;
+        }
+        IpcChannel::Wait(polls);
+    }
+
+    IpcReader reader(reply);
+    *retval = reader.Read<cell>();
+    uint32_t size = reader.Read<uint32_t>();
+    reader.Read(data, size < heap_size ? size : heap_size);
+    return true;
+}
+
+void IpcSession::ForwardLog(const char *message) {
+    IpcWriter writer;
+    writer.WriteString(message);
+
+    if (!current_->channel_.Write(IPC_RING_REQUESTS, IPC_MSG_LOG,
+        writer.GetData(), writer.GetSize())) {
+        printf("%s\n", message);
+    }
+}
@@ -0,0 +1,67 @@
+// SampSharp
+// Copyright 2017 Tim Potze
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#include <string>
+#include <vector>
+#include <sdk/plugin.h>
+#include "../SampSharp/IpcChannel.h"
+#include "PluginHost.h"
+
+#pragma once
+
+#define IPC_SESSION_PLAYERS                 (1000)
+
+/* Runs a plugin on behalf of a server in split mode (see split_host in
+ * server.cfg). The server sends the names of its natives, public calls and
+ * ticks through an IPC channel; natives called by the plugin are forwarded to
+ * the server together with the heap of the AMX they're called with. */
+class IpcSession {
+public:
+    IpcSession();
+
+    /* Opens the channel with the specified name. */
+    bool Open(const std::string &name);
+    /* Waits for the natives of the server and adds them to the AMX
+     * environment. */
+    bool ApplyNatives();
+    /* Handles the public calls and ticks of the server until it tells the
+     * host to exit or closes the channel. */
+    void Run(PluginHost &host);
+
+    int GetPlayers() const {
+        return IPC_SESSION_PLAYERS;
+    }
+
+private:
+    bool Receive(uint32_t &type);
+    void OnPublicCall(PluginHost &host);
+    static bool ForwardNative(int index, AMX *amx, cell *params,
+        cell *retval);
+    static void ForwardLog(const char *message);
+
+    IpcChannel channel_;
+    /* The index of the server native of every AMX environment native, or -1
+     * if the server doesn't know it. */
+    std::vector<int> indices_;
+    std::vector<char> message_;
+    std::vector<char> reply_;
+    std::vector<cell> params_;
+    IpcWriter writer_;
+
+    /* Natives and log messages have no context; there's one session per
+     * process. */
+    static IpcSession *current_;
+};
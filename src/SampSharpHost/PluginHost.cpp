@@ -0,0 +1,130 @@
+// SampSharp
+// Copyright 2017 Tim Potze
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "PluginHost.h"
+#include "../SampSharp/platforms.h"
+#include "AmxEnvironment.h"
+
+#if SAMPSHARP_WINDOWS
+#include <windows.h>
+#elif SAMPSHARP_LINUX
+#include <dlfcn.h>
+#endif
+
+PluginHost::PluginHost()
+: handle_(NULL),
+  supports_(0),
+  supportsFunc_(NULL),
+  loadFunc_(NULL),
+  unloadFunc_(NULL),
+  processTickFunc_(NULL),
+  onPublicCallFunc_(NULL)
+{
+}
+
+PluginHost::~PluginHost() {
+    Close();
+}
+
+bool PluginHost::Open(const std::string &path) {
+    if (handle_) {
+        return false;
+    }
+
+#if SAMPSHARP_WINDOWS
+    handle_ = (void *)LoadLibraryA(path.c_str());
+#elif SAMPSHARP_LINUX
+    handle_ = dlopen(path.c_str(), RTLD_NOW);
+#endif
+
+    if (!handle_) {
+#if SAMPSHARP_WINDOWS
+        AmxEnvironment::Log("ERROR: Could not load %s (error %lu).",
+            path.c_str(), GetLastError());
+#elif SAMPSHARP_LINUX
+        AmxEnvironment::Log("ERROR: Could not load %s: %s", path.c_str(),
+            dlerror());
+#endif
+        return false;
+    }
+
+    supportsFunc_ = (SupportsFunc)FindExport("Supports");
+    loadFunc_ = (LoadFunc)FindExport("Load");
+    unloadFunc_ = (UnloadFunc)FindExport("Unload");
+    processTickFunc_ = (ProcessTickFunc)FindExport("ProcessTick");
+    onPublicCallFunc_ = (OnPublicCallFunc)FindExport("OnPublicCall");
+
+    if (!supportsFunc_ || !loadFunc_) {
+        AmxEnvironment::Log("ERROR: %s is not a SA-MP plugin.", path.c_str());
+        Close();
+        return false;
+    }
+
+    return true;
+}
+
+void PluginHost::Close() {
+    if (!handle_) {
+        return;
+    }
+
+#if SAMPSHARP_WINDOWS
+    FreeLibrary((HMODULE)handle_);
+#elif SAMPSHARP_LINUX
+    dlclose(handle_);
+#endif
+
+    handle_ = NULL;
+    supportsFunc_ = NULL;
+    loadFunc_ = NULL;
+    unloadFunc_ = NULL;
+    processTickFunc_ = NULL;
+    onPublicCallFunc_ = NULL;
+}
+
+unsigned int PluginHost::Supports() {
+    return supports_ = supportsFunc_();
+}
+
+bool PluginHost::Load(void **data) {
+    return loadFunc_(data);
+}
+
+void PluginHost::Unload() {
+    if (unloadFunc_) {
+        unloadFunc_();
+    }
+}
+
+void PluginHost::ProcessTick() {
+    if (processTickFunc_ && (supports_ & SUPPORTS_PROCESS_TICK)) {
+        processTickFunc_();
+    }
+}
+
+bool PluginHost::OnPublicCall(AMX *amx, const char *name, cell *params,
+    cell *retval) {
+    return onPublicCallFunc_
+        ? onPublicCallFunc_(amx, name, params, retval)
+        : true;
+}
+
+void *PluginHost::FindExport(const char *name) {
+#if SAMPSHARP_WINDOWS
+    return (void *)GetProcAddress((HMODULE)handle_, name);
+#elif SAMPSHARP_LINUX
+    return dlsym(handle_, name);
+#endif
+}
@@ -0,0 +1,60 @@
+// SampSharp
+// Copyright 2017 Tim Potze
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string>
+#include <sdk/plugin.h>
+
+#pragma once
+
+/* Loads a SA-MP server plugin library and exposes its exports. */
+class PluginHost {
+public:
+    PluginHost();
+    ~PluginHost();
+
+    /* Loads the plugin library at the specified path. */
+    bool Open(const std::string &path);
+    /* Unloads the plugin library. */
+    void Close();
+
+    /* Calls the Supports export of the plugin. */
+    unsigned int Supports();
+    /* Calls the Load export of the plugin. */
+    bool Load(void **data);
+    /* Calls the Unload export of the plugin. */
+    void Unload();
+    /* Calls the ProcessTick export of the plugin if it is supported. */
+    void ProcessTick();
+    /* Calls the OnPublicCall export of the plugin if it exists. */
+    bool OnPublicCall(AMX *amx, const char *name, cell *params, cell *retval);
+
+private:
+    typedef unsigned int (PLUGIN_CALL *SupportsFunc)();
+    typedef bool (PLUGIN_CALL *LoadFunc)(void **);
+    typedef void (PLUGIN_CALL *UnloadFunc)();
+    typedef void (PLUGIN_CALL *ProcessTickFunc)();
+    typedef bool (PLUGIN_CALL *OnPublicCallFunc)(AMX *, const char *, cell *,
+        cell *);
+
+    void *FindExport(const char *name);
+
+    void *handle_;
+    unsigned int supports_;
+    SupportsFunc supportsFunc_;
+    LoadFunc loadFunc_;
+    UnloadFunc unloadFunc_;
+    ProcessTickFunc processTickFunc_;
+    OnPublicCallFunc onPublicCallFunc_;
+};
@@ -0,0 +1,377 @@
+// SampSharp
+// Copyright 2017 Tim Potze
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "Replay.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iterator>
+#include <string.h>
+#include "AmxEnvironment.h"
+#include "../SampSharp/CallbackLog.h"
+
+using std::string;
+using std::vector;
+
+typedef std::chrono::steady_clock Clock;
+
+Replay::Replay()
+: offset_(0)
+{
+}
+
+bool Replay::Load(const string &path) {
+    std::ifstream file(path.c_str(), std::ios::binary);
+
+    if (!file) {
+        AmxEnvironment::Log("ERROR: Could not open callback log %s.",
+            path.c_str());
+        return false;
+    }
+
+    data_.assign(std::istreambuf_iterator<char>(file),
+        std::istreambuf_iterator<char>());
+    offset_ = 0;
+
+    uint32_t magic, version;
+    if (!Read(magic) || !Read(version) || magic != CALLBACK_LOG_MAGIC) {
+        AmxEnvironment::Log("ERROR: %s is not a callback log.", path.c_str());
+        return false;
+    }
+    if (version < 1 || version > CALLBACK_LOG_VERSION) {
+        AmxEnvironment::Log("ERROR: Unsupported callback log version %u.",
+            version);
+        return false;
+    }
+
+    bool result = ReadRecords();
+
+    // The payloads have been copied into the entries; the raw log is no
+    // longer needed.
+    vector<unsigned char>().swap(data_);
+
+    return result;
+}
+
+bool Replay::ReadRecords() {
+    uint64_t time = 0;
+    uint8_t type;
+
+    // Payloads either belong to the last public call or, if a native was
+    // called after it, are the output of that native.
+    int native = -1;
+
+    while (Read(type)) {
+        switch (type) {
+        case CALLBACK_LOG_NAME: {
+            uint16_t id;
+            uint8_t length;
+            char name[256];
+
+            if (!Read(id) || !Read(length) || !Read(name, length)) {
+                break;
+            }
+
+            name[length] = '\0';
+
+            if (names_.size() <= id) {
+                names_.resize(id + 1);
+                returns_.resize(id + 1);
+                outputs_.resize(id + 1);
+            }
+            names_[id] = name;
+            continue;
+        }
+        case CALLBACK_LOG_PUBLIC: {
+            Entry entry;
+            uint32_t delta;
+            uint8_t param_count;
+
+            if (!Read(delta) || !Read(entry.name) || !Read(param_count)) {
+                break;
+            }
+
+            entry.params.resize(param_count);
+            if (param_count && !Read(&entry.params[0],
+                param_count * sizeof(cell))) {
+                break;
+            }
+
+            time += delta;
+            native = -1;
+            entry.type = ENTRY_PUBLIC;
+            entry.time = time;
+            entries_.push_back(entry);
+            continue;
+        }
+        case CALLBACK_LOG_STRING:
+        case CALLBACK_LOG_ARRAY: {
+            Payload payload;
+            uint8_t param;
+            uint16_t length;
+
+            if (!Read(param) || !Read(length)) {
+                break;
+            }
+
+            payload.param = param;
+            payload.is_string = type == CALLBACK_LOG_STRING;
+
+            if (payload.is_string) {
+                payload.text.resize(length);
+                if (length && !Read(&payload.text[0], length)) {
+                    break;
+                }
+            }
+            else {
+                payload.cells.resize(length);
+                if (length && !Read(&payload.cells[0],
+                    length * sizeof(cell))) {
+                    break;
+                }
+            }
+
+            if (native >= 0) {
+                AmxEnvironment::NativeOutput output;
+                output.param = payload.param + 1;
+                output.cells = payload.cells;
+
+                // Strings are written back to the AMX unpacked.
+                if (payload.is_string) {
+                    for (size_t i = 0; i < payload.text.size(); i++) {
+                        output.cells.push_back(
+                            (unsigned char)payload.text[i]);
+                    }
+                    output.cells.push_back(0);
+                }
+
+                outputs_[native].back().push_back(output);
+                continue;
+            }
+
+            if (entries_.empty() || entries_.back().type != ENTRY_PUBLIC) {
+                break;
+            }
+
+            entries_.back().payloads.push_back(payload);
+            continue;
+        }
+        case CALLBACK_LOG_NATIVE: {
+            uint16_t id;
+            cell retval;
+
+            if (!Read(id) || !Read(retval) || id >= returns_.size()) {
+                break;
+            }
+
+            returns_[id].push_back(retval);
+            outputs_[id].resize(returns_[id].size());
+            native = id;
+            continue;
+        }
+        case CALLBACK_LOG_TICK: {
+            Entry entry;
+            uint32_t delta;
+
+            if (!Read(delta)) {
+                break;
+            }
+
+            time += delta;
+            native = -1;
+            entry.type = ENTRY_TICK;
+            entry.name = 0;
+            entry.time = time;
+            entries_.push_back(entry);
+            continue;
+        }
+        default:
+            break;
+        }
+
+        // A log which was not closed properly (e.g. the server crashed) ends
+        // with a partial record; replay everything before it.
+        AmxEnvironment::Log("WARNING: Callback log is truncated or corrupt at "
+            "offset %lu.", (unsigned long)offset_);
+        break;
+    }
+
+    AmxEnvironment::Log("Loaded %lu entries.", (unsigned long)entries_.size());
+    return true;
+}
+
+bool Replay::Read(void *data, size_t size) {
+    if (offset_ + size > data_.size()) {
+        return false;
+    }
+
+    memcpy(data, &data_[offset_], size);
+    offset_ += size;
+    return true;
+}
+
+void Replay::ApplyNatives() {
+    for (size_t i = 0; i < names_.size(); i++) {
+        if (returns_[i].empty()) {
+            continue;
+        }
+
+        AmxEnvironment::NativeScript native;
+        native.name = names_[i];
+        native.retval = returns_[i].back();
+        native.ref_count = 0;
+        native.returns = returns_[i];
+        native.outputs = outputs_[i];
+        native.return_index = 0;
+        native.check_player = false;
+        native.calls = 0;
+
+        AmxEnvironment::SetNative(native);
+    }
+}
+
+double Replay::Fire(PluginHost &host, const Entry &entry) {
+    cell params[MAX_REPLAY_PARAMS + 1];
+    size_t param_count = std::min(entry.params.size(),
+        (size_t)MAX_REPLAY_PARAMS);
+
+    params[0] = (cell)(param_count * sizeof(cell));
+    for (size_t i = 0; i < param_count; i++) {
+        params[i + 1] = entry.params[i];
+    }
+
+    // Strings and arrays were passed by address in the recorded AMX; copy
+    // them onto the heap of ours and point the parameters at them.
+    for (size_t i = 0; i < entry.payloads.size(); i++) {
+        const Payload &payload = entry.payloads[i];
+
+        if ((size_t)payload.param >= param_count) {
+            continue;
+        }
+
+        params[payload.param + 1] = payload.is_string
+            ? AmxEnvironment::PushString(payload.text.c_str())
+            : AmxEnvironment::PushArray(&payload.cells[0],
+                (int)payload.cells.size());
+    }
+
+    cell retval = 1;
+
+    Clock::time_point start = Clock::now();
+    host.OnPublicCall(AmxEnvironment::GetAmx(), names_[entry.name].c_str(),
+        params, &retval);
+    double elapsed = std::chrono::duration<double, std::micro>(
+        Clock::now() - start).count();
+
+    AmxEnvironment::ReleaseHeap();
+
+    return elapsed;
+}
+
+void Replay::Run(PluginHost &host) {
+    vector<Stats> stats(names_.size());
+    vector<SlowCall> slowest;
+    unsigned long callbacks = 0;
+    unsigned long ticks = 0;
+
+    AmxEnvironment::Log("Replaying %lu entries...",
+        (unsigned long)entries_.size());
+
+    Clock::time_point run_start = Clock::now();
+
+    for (vector<Entry>::const_iterator iter = entries_.begin();
+        iter != entries_.end(); iter++) {
+        if (iter->type == ENTRY_TICK) {
+            host.ProcessTick();
+            ticks++;
+            continue;
+        }
+
+        // The game mode is initialized and exited by the host itself.
+        const string &name = names_[iter->name];
+        if (name == "OnGameModeInit" || name == "OnGameModeExit") {
+            continue;
+        }
+
+        double elapsed = Fire(host, *iter);
+        callbacks++;
+
+        Stats &stat = stats[iter->name];
+        stat.calls++;
+        stat.total_time += elapsed;
+        stat.max_time = std::max(stat.max_time, elapsed);
+
+        if (slowest.size() < MAX_REPLAY_SLOWEST ||
+            elapsed > slowest.back().time) {
+            SlowCall call = { elapsed, &*iter };
+
+            if (slowest.size() == MAX_REPLAY_SLOWEST) {
+                slowest.pop_back();
+            }
+
+            vector<SlowCall>::iterator pos = slowest.begin();
+            while (pos != slowest.end() && pos->time >= elapsed) {
+                pos++;
+            }
+            slowest.insert(pos, call);
+        }
+    }
+
+    double wall = std::chrono::duration<double>(Clock::now() - run_start)
+        .count();
+    double recorded = entries_.empty()
+        ? 0
+        : entries_.back().time / 1000000.0;
+
+    AmxEnvironment::Log("");
+    AmxEnvironment::Log("Results");
+    AmxEnvironment::Log("---------------");
+    AmxEnvironment::Log("Recorded time: %.3f s", recorded);
+    AmxEnvironment::Log("Wall time:     %.3f s", wall);
+    AmxEnvironment::Log("Ticks:         %lu", ticks);
+    AmxEnvironment::Log("Callbacks:     %lu (%.0f/s)", callbacks,
+        wall > 0 ? callbacks / wall : 0.0);
+    AmxEnvironment::Log("");
+
+    for (size_t i = 0; i < stats.size(); i++) {
+        if (stats[i].calls) {
+            AmxEnvironment::Log("%-24s %10lu calls %10.2f us/call "
+                "%10.2f us max", names_[i].c_str(), stats[i].calls,
+                stats[i].total_time / stats[i].calls, stats[i].max_time);
+        }
+    }
+
+    AmxEnvironment::Log("");
+    AmxEnvironment::Log("Slowest calls");
+    AmxEnvironment::Log("---------------");
+
+    for (size_t i = 0; i < slowest.size(); i++) {
+        AmxEnvironment::Log("%10.2f us  %-24s at %.3f s", slowest[i].time,
+            names_[slowest[i].entry->name].c_str(),
+            slowest[i].entry->time / 1000000.0);
+    }
+
+    // If the game mode called natives a different number of times than it did
+    // while recording, it did not follow the recorded code paths.
+    const AmxEnvironment::NativeList &natives = AmxEnvironment::GetNatives();
+    for (size_t i = 0; i < natives.size(); i++) {
+        if (!natives[i].returns.empty() &&
+            natives[i].calls != natives[i].returns.size()) {
+            AmxEnvironment::Log("WARNING: Replay diverged; %s was called %lu "
+                "times, %lu times while recording.", natives[i].name.c_str(),
+                natives[i].calls, (unsigned long)natives[i].returns.size());
+        }
+    }
+}
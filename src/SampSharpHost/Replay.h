@@ -0,0 +1,94 @@
+// SampSharp
+// Copyright 2017 Tim Potze
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <sdk/plugin.h>
+#include "AmxEnvironment.h"
+#include "PluginHost.h"
+
+#pragma once
+
+#define MAX_REPLAY_PLAYERS                  (1000)
+#define MAX_REPLAY_PARAMS                   (255)
+#define MAX_REPLAY_SLOWEST                  (10)
+
+/* Replays a callback log recorded by the plugin (see record_file in
+ * server.cfg) against a plugin. Natives return the values which were recorded
+ * in the same order and write the recorded values to their reference
+ * parameters, so a deterministic game mode follows the exact same code paths
+ * as it did on the server. Callbacks are sent as fast as possible, with the
+ * update throttle of the plugin turned off; the updates it dropped on the
+ * server are recorded and replayed as well. */
+class Replay {
+public:
+    Replay();
+
+    /* Loads the callback log from the specified file. */
+    bool Load(const std::string &path);
+    /* Adds the natives seen in the log to the AMX environment. */
+    void ApplyNatives();
+    /* Replays the log against the specified plugin. */
+    void Run(PluginHost &host);
+
+    int GetPlayers() const {
+        return MAX_REPLAY_PLAYERS;
+    }
+
+private:
+    enum EntryType {
+        ENTRY_PUBLIC,
+        ENTRY_TICK
+    };
+    struct Payload {
+        int param;
+        bool is_string;
+        std::vector<cell> cells;
+        std::string text;
+    };
+    struct Entry {
+        EntryType type;
+        uint16_t name;
+        /* Microseconds since the start of the recording. */
+        uint64_t time;
+        std::vector<cell> params;
+        std::vector<Payload> payloads;
+    };
+    struct Stats {
+        unsigned long calls;
+        double total_time;
+        double max_time;
+    };
+    struct SlowCall {
+        double time;
+        const Entry *entry;
+    };
+
+    bool Read(void *data, size_t size);
+    template<typename T> bool Read(T &value) {
+        return Read(&value, sizeof(T));
+    }
+    bool ReadRecords();
+    double Fire(PluginHost &host, const Entry &entry);
+
+    std::vector<unsigned char> data_;
+    size_t offset_;
+    std::vector<std::string> names_;
+    std::vector<std::vector<cell> > returns_;
+    std::vector<std::vector<std::vector<AmxEnvironment::NativeOutput> > >
+        outputs_;
+    std::vector<Entry> entries_;
+};
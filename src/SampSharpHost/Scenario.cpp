@@ -0,0 +1,392 @@
+// SampSharp
+// Copyright 2017 Tim Potze
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "Scenario.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <stdlib.h>
+#include <string.h>
+#include <thread>
+#include "AmxEnvironment.h"
+#include "../SampSharp/StringUtil.h"
+
+using std::string;
+using std::vector;
+
+typedef std::chrono::steady_clock Clock;
+
+Scenario::Scenario()
+: players_(0),
+  duration_(10),
+  tickrate_(200),
+  realtime_(false)
+{
+}
+
+bool Scenario::Load(const string &path) {
+    std::ifstream file(path.c_str());
+
+    if (!file.is_open()) {
+        AmxEnvironment::Log("ERROR: Could not open scenario %s.", path.c_str());
+        return false;
+    }
+
+    string line;
+    int line_number = 0;
+
+    while (std::getline(file, line)) {
+        line_number++;
+
+        size_t comment = line.find('#');
+        if (comment != string::npos) {
+            line.erase(comment);
+        }
+
+        StringUtil::TrimString(line);
+
+        if (line.empty()) {
+            continue;
+        }
+
+        if (!ParseLine(line, line_number)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool Scenario::ParseLine(const string &line, int line_number) {
+    vector<string> tokens = Tokenize(line);
+    const string &directive = tokens[0];
+
+    if (directive == "players" && tokens.size() == 2) {
+        players_ = atoi(tokens[1].c_str());
+        return true;
+    }
+    if (directive == "duration" && tokens.size() == 2) {
+        duration_ = atof(tokens[1].c_str());
+        return true;
+    }
+    if (directive == "tickrate" && tokens.size() == 2) {
+        tickrate_ = atof(tokens[1].c_str());
+        return tickrate_ > 0;
+    }
+    if (directive == "realtime" && tokens.size() == 2) {
+        realtime_ = tokens[1] == "1";
+        return true;
+    }
+    if (directive == "native" && tokens.size() >= 3) {
+        AmxEnvironment::NativeScript native;
+        native.name = tokens[1];
+        native.retval = atoi(tokens[2].c_str());
+        native.ref_count = 0;
+        native.return_index = 0;
+        native.check_player = false;
+        native.calls = 0;
+
+        for (size_t i = 3; i < tokens.size(); i++) {
+            if (tokens[i] == "player") {
+                native.check_player = true;
+            }
+            else if (tokens[i] == "ref" && i + 2 < tokens.size() &&
+                native.ref_count < MAX_HOST_NATIVE_REFS) {
+                Argument param, value;
+                if (!ParseArgument(tokens[i + 1], param) ||
+                    param.type != ARG_INT || param.value < 1) {
+                    AmxEnvironment::Log("ERROR: Invalid ref parameter '%s' "
+                        "on line %d.", tokens[i + 1].c_str(), line_number);
+                    return false;
+                }
+                if (!ParseArgument(tokens[i + 2], value) ||
+                    value.type == ARG_STRING || value.type == ARG_PLAYERID) {
+                    AmxEnvironment::Log("ERROR: Invalid ref value '%s' on "
+                        "line %d.", tokens[i + 2].c_str(), line_number);
+                    return false;
+                }
+
+                AmxEnvironment::NativeRef &ref =
+                    native.refs[native.ref_count++];
+                ref.param = param.value;
+                ref.value = value.value;
+                i += 2;
+            }
+            else {
+                AmxEnvironment::Log("ERROR: Invalid native directive on line "
+                    "%d.", line_number);
+                return false;
+            }
+        }
+
+        natives_.push_back(native);
+        return true;
+    }
+    if ((directive == "public" && tokens.size() >= 2) ||
+        (directive == "stream" && tokens.size() >= 3)) {
+        bool stream = directive == "stream";
+
+        Event event;
+        event.name = tokens[1];
+        event.rate = stream ? atof(tokens[2].c_str()) : 0;
+        event.per_player = false;
+        event.calls = 0;
+        event.total_time = 0;
+
+        for (size_t i = stream ? 3 : 2; i < tokens.size(); i++) {
+            Argument argument;
+            if (!ParseArgument(tokens[i], argument)) {
+                AmxEnvironment::Log("ERROR: Invalid argument '%s' on line %d.",
+                    tokens[i].c_str(), line_number);
+                return false;
+            }
+
+            if (argument.type == ARG_PLAYERID) {
+                event.per_player = true;
+            }
+            event.args.push_back(argument);
+        }
+
+        if (event.args.size() > MAX_SCENARIO_ARGS ||
+            (stream && event.rate <= 0)) {
+            AmxEnvironment::Log("ERROR: Invalid %s directive on line %d.",
+                directive.c_str(), line_number);
+            return false;
+        }
+
+        (stream ? streams_ : once_).push_back(event);
+        return true;
+    }
+
+    AmxEnvironment::Log("ERROR: Unknown directive on line %d: %s", line_number,
+        line.c_str());
+    return false;
+}
+
+bool Scenario::ParseArgument(const string &token, Argument &argument) {
+    if (token.empty()) {
+        return false;
+    }
+
+    if (token == "{playerid}") {
+        argument.type = ARG_PLAYERID;
+        argument.value = 0;
+        return true;
+    }
+
+    if (token[0] == '"') {
+        if (token.size() < 2 || token[token.size() - 1] != '"') {
+            return false;
+        }
+
+        argument.type = ARG_STRING;
+        argument.text = token.substr(1, token.size() - 2);
+        argument.value = 0;
+        return true;
+    }
+
+    char *end;
+    if (token.find('.') != string::npos) {
+        float value = (float)strtod(token.c_str(), &end);
+        argument.type = ARG_FLOAT;
+        argument.value = amx_ftoc(value);
+    }
+    else {
+        argument.type = ARG_INT;
+        argument.value = (cell)strtol(token.c_str(), &end, 0);
+    }
+
+    return *end == '\0';
+}
+
+vector<string> Scenario::Tokenize(const string &line) {
+    vector<string> tokens;
+    size_t i = 0;
+
+    while (i < line.size()) {
+        while (i < line.size() && (line[i] == ' ' || line[i] == '\t')) {
+            i++;
+        }
+        if (i >= line.size()) {
+            break;
+        }
+
+        size_t start = i;
+        if (line[i] == '"') {
+            i = line.find('"', i + 1);
+            i = i == string::npos ? line.size() : i + 1;
+        }
+        else {
+            while (i < line.size() && line[i] != ' ' && line[i] != '\t') {
+                i++;
+            }
+        }
+
+        tokens.push_back(line.substr(start, i - start));
+    }
+
+    return tokens;
+}
+
+void Scenario::ApplyNatives() {
+    for (size_t i = 0; i < natives_.size(); i++) {
+        AmxEnvironment::SetNative(natives_[i]);
+    }
+}
+
+double Scenario::Fire(PluginHost &host, Event &event, int playerid) {
+    cell params[MAX_SCENARIO_ARGS + 1];
+    params[0] = (cell)(event.args.size() * sizeof(cell));
+
+    for (size_t i = 0; i < event.args.size(); i++) {
+        const Argument &argument = event.args[i];
+
+        switch (argument.type) {
+        case ARG_PLAYERID:
+            params[i + 1] = playerid;
+            break;
+        case ARG_STRING:
+            params[i + 1] = AmxEnvironment::PushString(argument.text.c_str());
+            break;
+        default:
+            params[i + 1] = argument.value;
+            break;
+        }
+    }
+
+    cell retval = 1;
+
+    Clock::time_point start = Clock::now();
+    host.OnPublicCall(AmxEnvironment::GetAmx(), event.name.c_str(), params,
+        &retval);
+    double elapsed = std::chrono::duration<double, std::micro>(
+        Clock::now() - start).count();
+
+    AmxEnvironment::ReleaseHeap();
+
+    event.calls++;
+    event.total_time += elapsed;
+    return elapsed;
+}
+
+void Scenario::Run(PluginHost &host) {
+    for (EventList::iterator iter = once_.begin(); iter != once_.end();
+        iter++) {
+        if (iter->per_player) {
+            for (int i = 0; i < players_; i++) {
+                Fire(host, *iter, i);
+            }
+        }
+        else {
+            Fire(host, *iter, 0);
+        }
+    }
+
+    /* Every stream keeps the next due time per target. Targets of a stream are
+     * spread evenly over its period so players don't all send their updates
+     * during the same tick. */
+    vector<vector<double> > due(streams_.size());
+    for (size_t i = 0; i < streams_.size(); i++) {
+        int targets = streams_[i].per_player ? players_ : 1;
+        double period = 1.0 / streams_[i].rate;
+
+        for (int j = 0; j < targets; j++) {
+            due[i].push_back(period * j / targets);
+        }
+    }
+
+    long ticks = (long)(duration_ * tickrate_);
+    double tick_period = 1.0 / tickrate_;
+    vector<double> tick_times;
+    tick_times.reserve(ticks);
+    unsigned long callbacks = 0;
+
+    AmxEnvironment::Log("Running %ld ticks at %.0f Hz with %d players...",
+        ticks, tickrate_, players_);
+
+    Clock::time_point run_start = Clock::now();
+
+    for (long tick = 0; tick < ticks; tick++) {
+        double now = tick * tick_period;
+        Clock::time_point tick_start = Clock::now();
+
+        for (size_t i = 0; i < streams_.size(); i++) {
+            double period = 1.0 / streams_[i].rate;
+
+            for (size_t j = 0; j < due[i].size(); j++) {
+                while (due[i][j] <= now) {
+                    Fire(host, streams_[i], (int)j);
+                    due[i][j] += period;
+                    callbacks++;
+                }
+            }
+        }
+
+        host.ProcessTick();
+
+        Clock::duration tick_duration = Clock::now() - tick_start;
+        tick_times.push_back(std::chrono::duration<double, std::micro>(
+            tick_duration).count());
+
+        if (realtime_) {
+            std::this_thread::sleep_until(run_start +
+                std::chrono::duration_cast<Clock::duration>(
+                std::chrono::duration<double>((tick + 1) * tick_period)));
+        }
+    }
+
+    double wall = std::chrono::duration<double>(Clock::now() - run_start)
+        .count();
+
+    if (tick_times.empty()) {
+        return;
+    }
+
+    vector<double> sorted(tick_times);
+    std::sort(sorted.begin(), sorted.end());
+
+    double total = 0;
+    for (size_t i = 0; i < sorted.size(); i++) {
+        total += sorted[i];
+    }
+
+    AmxEnvironment::Log("");
+    AmxEnvironment::Log("Results");
+    AmxEnvironment::Log("---------------");
+    AmxEnvironment::Log("Wall time:     %.3f s", wall);
+    AmxEnvironment::Log("Callbacks:     %lu (%.0f/s)", callbacks,
+        callbacks / wall);
+    AmxEnvironment::Log("Tick avg:      %.1f us", total / sorted.size());
+    AmxEnvironment::Log("Tick p50:      %.1f us", sorted[sorted.size() / 2]);
+    AmxEnvironment::Log("Tick p99:      %.1f us",
+        sorted[(size_t)(sorted.size() * 0.99)]);
+    AmxEnvironment::Log("Tick max:      %.1f us", sorted.back());
+    AmxEnvironment::Log("");
+
+    for (EventList::iterator iter = streams_.begin(); iter != streams_.end();
+        iter++) {
+        AmxEnvironment::Log("%-24s %10lu calls %10.2f us/call",
+            iter->name.c_str(), iter->calls,
+            iter->calls ? iter->total_time / iter->calls : 0.0);
+    }
+
+    const AmxEnvironment::NativeList &natives = AmxEnvironment::GetNatives();
+    for (size_t i = 0; i < natives.size(); i++) {
+        if (natives[i].calls) {
+            AmxEnvironment::Log("native %-17s %10lu calls",
+                natives[i].name.c_str(), natives[i].calls);
+        }
+    }
+}
@@ -0,0 +1,91 @@
+// SampSharp
+// Copyright 2017 Tim Potze
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string>
+#include <vector>
+#include <sdk/plugin.h>
+#include "AmxEnvironment.h"
+#include "PluginHost.h"
+
+#pragma once
+
+#define MAX_SCENARIO_ARGS                   (16)
+
+/* Represents a scripted load test: the natives available to the game mode and
+ * the callbacks to send to it at which rates.
+ *
+ * Scenario files contain one directive per line:
+ *   players <count>                     number of emulated players
+ *   duration <seconds>                  simulated run time
+ *   tickrate <hz>                       server ticks per second
+ *   realtime <0|1>                      sleep between ticks or run flat out
+ *   native <name> <ret> [ref <param> <value>]... [player]
+ *                                       script the behaviour of a native
+ *   public <name> [args...]             send a callback once at start
+ *   stream <name> <hz> [args...]        send a callback at a fixed rate
+ *
+ * Callback arguments are integers, floats (containing a dot), quoted strings
+ * or {playerid}. A callback with a {playerid} argument is sent for every
+ * emulated player. */
+class Scenario {
+public:
+    Scenario();
+
+    /* Loads the scenario from the specified file. */
+    bool Load(const std::string &path);
+    /* Adds the natives scripted by the scenario to the AMX environment. */
+    void ApplyNatives();
+    /* Runs the scenario against the specified plugin. */
+    void Run(PluginHost &host);
+
+    int GetPlayers() const {
+        return players_;
+    }
+
+private:
+    enum ArgumentType {
+        ARG_INT,
+        ARG_FLOAT,
+        ARG_STRING,
+        ARG_PLAYERID
+    };
+    struct Argument {
+        ArgumentType type;
+        cell value;
+        std::string text;
+    };
+    struct Event {
+        std::string name;
+        std::vector<Argument> args;
+        double rate;
+        bool per_player;
+        unsigned long calls;
+        double total_time;
+    };
+    typedef std::vector<Event> EventList;
+
+    bool ParseLine(const std::string &line, int line_number);
+    bool ParseArgument(const std::string &token, Argument &argument);
+    double Fire(PluginHost &host, Event &event, int playerid);
+    static std::vector<std::string> Tokenize(const std::string &line);
+
+    int players_;
+    double duration_;
+    double tickrate_;
+    bool realtime_;
+    std::vector<AmxEnvironment::NativeScript> natives_;
+    EventList once_;
+    EventList streams_;
+};
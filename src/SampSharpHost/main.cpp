@@ -0,0 +1,187 @@
+// SampSharp
+// Copyright 2017 Tim Potze
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include "../SampSharp/CallbackLog.h"
+#include "../SampSharp/platforms.h"
+#include "AmxEnvironment.h"
+#include "Benchmark.h"
+#include "IpcSession.h"
+#include "PluginHost.h"
+#include "Replay.h"
+#include "Scenario.h"
+
+using std::string;
+
+/* SampSharpHost emulates a SA-MP server well enough to load the SampSharp
+ * plugin and drive a game mode with scripted callback traffic. It's meant for
+ * load testing game modes without a server binary or connected clients.
+ *
+ * usage: SampSharpHost [-p plugin] scenario
+ *        SampSharpHost [-p plugin] -r callback-log
+ *        SampSharpHost [-p plugin] -i channel
+ *        SampSharpHost [-p plugin] -b configurations scenario
+ *
+ * With -r, a callback log recorded by the plugin (see record_file in
+ * server.cfg) is replayed instead of running a scenario.
+ *
+ * With -i, the host runs the game mode on behalf of a server in split mode
+ * (see split_host in server.cfg), which starts it with the name of the IPC
+ * channel to use.
+ *
+ * With -b, the scenario is run once for every JIT configuration in the
+ * specified file, each in a new host process, after which the results are
+ * compared (see Benchmark.h).
+ *
+ * The host should be started from the server directory; the plugin reads its
+ * configuration from server.cfg and loads the game mode from gamemode/. */
+
+static void PrintUsage() {
+    printf("usage: SampSharpHost [-p plugin] scenario\n");
+    printf("       SampSharpHost [-p plugin] -r callback-log\n");
+    printf("       SampSharpHost [-p plugin] -i channel\n");
+    printf("       SampSharpHost [-p plugin] -b configurations scenario\n");
+}
+
+int main(int argc, char **argv) {
+#if SAMPSHARP_WINDOWS
+    string plugin_path = "plugins/SampSharp.dll";
+#elif SAMPSHARP_LINUX
+    string plugin_path = "plugins/SampSharp.so";
+#endif
+    string scenario_path;
+    string replay_path;
+    string channel_name;
+    string benchmark_path;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-p") && i + 1 < argc) {
+            plugin_path = argv[++i];
+        }
+        else if (!strcmp(argv[i], "-r") && i + 1 < argc) {
+            replay_path = argv[++i];
+        }
+        else if (!strcmp(argv[i], "-i") && i + 1 < argc) {
+            channel_name = argv[++i];
+        }
+        else if (!strcmp(argv[i], "-b") && i + 1 < argc) {
+            benchmark_path = argv[++i];
+        }
+        else if (scenario_path.empty()) {
+            scenario_path = argv[i];
+        }
+        else {
+            PrintUsage();
+            return 1;
+        }
+    }
+
+    int modes = !scenario_path.empty() + !replay_path.empty() +
+        !channel_name.empty();
+    if (modes != 1 || (!benchmark_path.empty() && scenario_path.empty())) {
+        PrintUsage();
+        return 1;
+    }
+
+    if (!benchmark_path.empty()) {
+        Benchmark benchmark;
+        if (!benchmark.Load(benchmark_path)) {
+            return 1;
+        }
+
+        return benchmark.Run(Benchmark::GetExecutablePath(argv[0]),
+            plugin_path, scenario_path) ? 0 : 1;
+    }
+
+    Scenario scenario;
+    Replay replay;
+    IpcSession session;
+
+    if (!channel_name.empty()) {
+        AmxEnvironment::Initialize(session.GetPlayers());
+        if (!session.Open(channel_name) || !session.ApplyNatives()) {
+            return 1;
+        }
+    }
+    else if (!replay_path.empty()) {
+        if (!replay.Load(replay_path)) {
+            return 1;
+        }
+
+        AmxEnvironment::Initialize(replay.GetPlayers());
+        replay.ApplyNatives();
+
+        // The log holds every update the server received; the plugin
+        // passes them all on rather than throttling them a second time.
+#if SAMPSHARP_WINDOWS
+        _putenv_s(CALLBACK_LOG_REPLAY_ENV, "1");
+#elif SAMPSHARP_LINUX
+        setenv(CALLBACK_LOG_REPLAY_ENV, "1", 1);
+#endif
+    }
+    else {
+        if (!scenario.Load(scenario_path)) {
+            return 1;
+        }
+
+        AmxEnvironment::Initialize(scenario.GetPlayers());
+        scenario.ApplyNatives();
+    }
+
+    PluginHost host;
+    if (!host.Open(plugin_path)) {
+        return 1;
+    }
+
+    host.Supports();
+    if (!host.Load(AmxEnvironment::GetPluginData())) {
+        AmxEnvironment::Log("ERROR: Plugin failed to load.");
+        return 1;
+    }
+
+    // The server registers the natives of the game mode after the plugins
+    // have been loaded, after which the game mode is initialized.
+    AmxEnvironment::RegisterNatives();
+
+    if (!channel_name.empty()) {
+        // The server forwards OnGameModeInit and OnGameModeExit itself.
+        session.Run(host);
+        host.Unload();
+        host.Close();
+        return 0;
+    }
+
+    cell params[1] = { 0 };
+    cell retval;
+    AMX *amx = AmxEnvironment::GetAmx();
+
+    host.OnPublicCall(amx, "OnGameModeInit", params, &retval);
+
+    if (!replay_path.empty()) {
+        replay.Run(host);
+    }
+    else {
+        scenario.Run(host);
+    }
+
+    host.OnPublicCall(amx, "OnGameModeExit", params, &retval);
+    host.Unload();
+    host.Close();
+
+    return 0;
+}
@@ -0,0 +1,64 @@
+﻿// SampSharp
+// Copyright 2017 Tim Potze
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//     http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+using System;
+using System.Diagnostics;
+using SampSharp.GameMode.SAMP.Commands;
+using SampSharp.GameMode.World;
+
+namespace TestMode.Tests
+{
+    internal class CommandsBenchmarkTest// : ITest
+    {
+        private const int Iterations = 1000000;
+        private const string CommandText = "/bench 42 13.37 word some more text";
+
+        #region Implementation of ITest
+
+        public void Start(GameMode gameMode)
+        {
+            var method = typeof (CommandsBenchmarkTest).GetMethod(nameof(BenchCommand));
+            var command = new DefaultCommand(new[] {new CommandPath("bench")}, null, true, null, method, null);
+
+            command.UseCompiledInvoker = false;
+            Run("Invoke (reflection)", () => command.Invoke(null, CommandText));
+            Run("CanInvoke (reflection)", () => command.CanInvoke(null, CommandText));
+
+            command.UseCompiledInvoker = true;
+            Run("Invoke (compiled)", () => command.Invoke(null, CommandText));
+            Run("CanInvoke (compiled)", () => command.CanInvoke(null, CommandText));
+        }
+
+        #endregion
+
+        public static void BenchCommand(BasePlayer player, int number, float value, string word, string text)
+        {
+        }
+
+        private static void Run(string name, Action action)
+        {
+            // Warm up, which also compiles the invoker.
+            action();
+
+            var collections = GC.CollectionCount(0);
+            var stopwatch = Stopwatch.StartNew();
+            for (var i = 0; i < Iterations; i++)
+                action();
+            stopwatch.Stop();
+
+            Console.WriteLine("{0,-24} {1,8:0.0} ns/call {2,6} gen0 collections", name,
+                stopwatch.Elapsed.TotalMilliseconds*1000000/Iterations, GC.CollectionCount(0) - collections);
+        }
+    }
+}
\ No newline at end of file
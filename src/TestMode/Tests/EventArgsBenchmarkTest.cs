@@ -0,0 +1,67 @@
+﻿// SampSharp
+// Copyright 2017 Tim Potze
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//     http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+using System;
+using System.Diagnostics;
+using System.Reflection;
+using SampSharp.GameMode;
+
+namespace TestMode.Tests
+{
+    internal class EventArgsBenchmarkTest// : ITest
+    {
+        private const int Iterations = 1000000;
+
+        #region Implementation of ITest
+
+        public void Start(GameMode gameMode)
+        {
+            // The callbacks are internal; bind to them the way the plugin reaches them.
+            var onPlayerUpdate = (Func<int, bool>) Delegate.CreateDelegate(typeof (Func<int, bool>), gameMode,
+                typeof (BaseMode).GetMethod("OnPlayerUpdate", BindingFlags.Instance | BindingFlags.NonPublic, null,
+                    new[] {typeof (int)}, null));
+            var onPlayerKeyStateChange = (Func<int, int, int, bool>) Delegate.CreateDelegate(
+                typeof (Func<int, int, int, bool>), gameMode,
+                typeof (BaseMode).GetMethod("OnPlayerKeyStateChange", BindingFlags.Instance | BindingFlags.NonPublic));
+
+            var reuse = gameMode.ReuseEventArgs;
+
+            gameMode.ReuseEventArgs = false;
+            Run("OnPlayerUpdate", () => onPlayerUpdate(0));
+            Run("OnPlayerKeyStateChange", () => onPlayerKeyStateChange(0, 1, 0));
+
+            gameMode.ReuseEventArgs = true;
+            Run("OnPlayerUpdate (reuse)", () => onPlayerUpdate(0));
+            Run("OnPlayerKeyStateChange (reuse)", () => onPlayerKeyStateChange(0, 1, 0));
+
+            gameMode.ReuseEventArgs = reuse;
+        }
+
+        #endregion
+
+        private static void Run(string name, Action action)
+        {
+            action();
+
+            var collections = GC.CollectionCount(0);
+            var stopwatch = Stopwatch.StartNew();
+            for (var i = 0; i < Iterations; i++)
+                action();
+            stopwatch.Stop();
+
+            Console.WriteLine("{0,-32} {1,8:0.0} ns/call {2,6} gen0 collections", name,
+                stopwatch.Elapsed.TotalMilliseconds*1000000/Iterations, GC.CollectionCount(0) - collections);
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,87 @@
+﻿// SampSharp
+// Copyright 2017 Tim Potze
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//     http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+using System;
+using System.Diagnostics;
+using SampSharp.GameMode.Tools;
+
+namespace TestMode.Tests
+{
+    internal class MapAndreasBenchmarkTest// : ITest
+    {
+        private const int PointCount = 100000;
+        private const int Iterations = 10;
+
+        #region Implementation of ITest
+
+        public void Start(GameMode gameMode)
+        {
+            MapAndreas.Load(MapAndreasMode.Full);
+
+            var random = new Random(0);
+            var points = new float[PointCount*2];
+            var expected = new float[PointCount];
+            var heights = new float[PointCount];
+
+            for (var i = 0; i < points.Length; i++)
+                points[i] = (float) (random.NextDouble()*6000 - 3000);
+
+            var stopwatch = Stopwatch.StartNew();
+            for (var n = 0; n < Iterations; n++)
+                for (var i = 0; i < PointCount; i++)
+                    expected[i] = MapAndreas.Find(points[i*2], points[i*2 + 1]);
+            Report("Find (per point)", stopwatch);
+
+            stopwatch = Stopwatch.StartNew();
+            for (var n = 0; n < Iterations; n++)
+                MapAndreas.Find(points, heights);
+            Report("Find (batch)", stopwatch);
+
+            for (var i = 0; i < PointCount; i++)
+                if (expected[i] != heights[i])
+                {
+                    Console.WriteLine("Batch result mismatch at ({0}, {1}): {2} != {3}", points[i*2], points[i*2 + 1],
+                        heights[i], expected[i]);
+                    break;
+                }
+
+            stopwatch = Stopwatch.StartNew();
+            for (var n = 0; n < Iterations; n++)
+                for (var i = 0; i < PointCount; i++)
+                    expected[i] = MapAndreas.FindAverage(points[i*2], points[i*2 + 1]);
+            Report("FindAverage (per point)", stopwatch);
+
+            stopwatch = Stopwatch.StartNew();
+            for (var n = 0; n < Iterations; n++)
+                for (var i = 0; i < PointCount; i++)
+                    expected[i] = MapAndreas.FindBilinear(points[i*2], points[i*2 + 1]);
+            Report("FindBilinear (per point)", stopwatch);
+
+            stopwatch = Stopwatch.StartNew();
+            for (var n = 0; n < Iterations; n++)
+                MapAndreas.FindBilinear(points, heights);
+            Report("FindBilinear (batch)", stopwatch);
+
+            MapAndreas.Unload();
+        }
+
+        #endregion
+
+        private static void Report(string name, Stopwatch stopwatch)
+        {
+            Console.WriteLine("{0,-26} {1,8:0.0} ns/point", name,
+                stopwatch.Elapsed.TotalMilliseconds*1000000/(PointCount*Iterations));
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,61 @@
+﻿// SampSharp
+// Copyright 2017 Tim Potze
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//     http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+using System;
+using System.Diagnostics;
+using SampSharp.GameMode.API;
+
+namespace TestMode.Tests
+{
+    internal class NativeCommandBufferBenchmarkTest// : ITest
+    {
+        private const int Calls = 10000;
+        private const int InvalidPlayerId = 0xFFFF;
+
+        #region Implementation of ITest
+
+        public void Start(GameMode gameMode)
+        {
+            var native = Native.Load("SetPlayerPos", typeof (int), typeof (float), typeof (float), typeof (float));
+
+            Run("InvokeNative", () =>
+            {
+                for (var i = 0; i < Calls; i++)
+                    native.Invoke(InvalidPlayerId, 1.0f, 2.0f, 3.0f);
+            });
+
+            Run("NativeCommandBuffer", () =>
+            {
+                for (var i = 0; i < Calls; i++)
+                    NativeCommandBuffer.Add(native, InvalidPlayerId, 1.0f, 2.0f, 3.0f);
+                NativeCommandBuffer.Flush();
+            });
+        }
+
+        #endregion
+
+        private static void Run(string name, Action action)
+        {
+            // Warm up, which also attaches the command buffer.
+            action();
+
+            var stopwatch = Stopwatch.StartNew();
+            action();
+            stopwatch.Stop();
+
+            Console.WriteLine("{0,-20} {1,8:0.00} ms/{2} calls {3,8:0} calls/ms", name,
+                stopwatch.Elapsed.TotalMilliseconds, Calls, Calls/stopwatch.Elapsed.TotalMilliseconds);
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,89 @@
+﻿// SampSharp
+// Copyright 2017 Tim Potze
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// 
+//     http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+using System;
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.Linq;
+using SampSharp.GameMode;
+using SampSharp.GameMode.Definitions;
+using SampSharp.GameMode.World;
+
+namespace TestMode.Tests
+{
+    internal class ProximityIndexBenchmarkTest// : ITest
+    {
+        // Vehicles stand in for players, which can't be spawned in bulk.
+        private const int VehicleCount = 1000;
+        private const int Queries = 1000;
+        private const float Range = 100;
+
+        #region Implementation of ITest
+
+        public void Start(GameMode gameMode)
+        {
+            var random = new Random(0);
+            var vehicles = new List<BaseVehicle>();
+            for (var i = 0; i < VehicleCount; i++)
+                vehicles.Add(BaseVehicle.Create(VehicleModelType.Infernus, RandomPoint(random), 0, -1, -1));
+
+            var points = Enumerable.Range(0, Queries).Select(i => RandomPoint(random)).ToArray();
+            var result = new List<BaseVehicle>();
+
+            // Reads every position once.
+            ProximityIndex.Invalidate();
+            ProximityIndex.GetVehiclesInRange(Vector3.Zero, 0, result);
+
+            var found = 0;
+            var stopwatch = Stopwatch.StartNew();
+            foreach (var point in points)
+                found += BaseVehicle.All.Count(v => v.Position.DistanceTo(point) <= Range);
+            Report("Scan BaseVehicle.All", stopwatch, found);
+
+            found = 0;
+            stopwatch = Stopwatch.StartNew();
+            foreach (var point in points)
+            {
+                result.Clear();
+                found += ProximityIndex.GetVehiclesInRange(point, Range, result);
+            }
+            Report("GetVehiclesInRange", stopwatch, found);
+
+            found = 0;
+            stopwatch = Stopwatch.StartNew();
+            foreach (var point in points)
+            {
+                result.Clear();
+                found += ProximityIndex.GetNearestVehicles(point, 5, result);
+            }
+            Report("GetNearestVehicles (5)", stopwatch, found);
+
+            foreach (var vehicle in vehicles)
+                vehicle.Dispose();
+        }
+
+        #endregion
+
+        private static Vector3 RandomPoint(Random random)
+        {
+            return new Vector3(random.NextDouble()*6000 - 3000, random.NextDouble()*6000 - 3000, 10);
+        }
+
+        private static void Report(string name, Stopwatch stopwatch, int found)
+        {
+            Console.WriteLine("{0,-24} {1,8:0.0} us/query {2,6} found", name,
+                stopwatch.Elapsed.TotalMilliseconds*1000/Queries, found);
+        }
+    }
+}
\ No newline at end of file
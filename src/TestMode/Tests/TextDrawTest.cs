@@ -15,6 +15,7 @@
 using SampSharp.GameMode;
 using SampSharp.GameMode.Definitions;
 using SampSharp.GameMode.Display;
+using SampSharp.GameMode.SAMP;
 using SampSharp.GameMode.SAMP.Commands;
 using SampSharp.GameMode.World;
 
@@ -33,5 +34,19 @@ namespace TestMode.Tests
             d.Show(player);
             n.Show(player);
         }
+
+        [Command("tdhud")]
+        public static void Hud(BasePlayer player)
+        {
+            var hud = new TextDraw(new Vector2(500, 100), "Health", TextDrawFont.Normal) {IsRetained = true};
+            hud.Show(player);
+
+            // The changes are applied at the end of the tick and the textdraw is shown again only once.
+            hud.Text = $"Health: {player.Health}";
+            hud.ForeColor = Color.Red;
+            hud.LetterSize = new Vector2(0.5f, 1.5f);
+            hud.BoxColor = Color.Black;
+            hud.Outline = 1;
+        }
     }
 }
\ No newline at end of file